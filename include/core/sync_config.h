@@ -9,11 +9,17 @@ struct SyncConfig {
   static std::atomic<size_t> SYNC_INTERVAL_SECONDS;
   static std::atomic<size_t> MAX_WORKERS;
   static std::atomic<size_t> MAX_TABLES_PER_CYCLE;
+  static std::atomic<size_t> RANGE_SPLIT_MIN_ROWS;
+  static std::atomic<size_t> MONGO_CURSOR_BATCH_SIZE;
+  static std::atomic<size_t> MONGO_MEMORY_BUDGET_MB;
 
   static constexpr size_t DEFAULT_CHUNK_SIZE = 25000;
   static constexpr size_t DEFAULT_SYNC_INTERVAL = 30;
   static constexpr size_t DEFAULT_MAX_WORKERS = 4;
   static constexpr size_t DEFAULT_MAX_TABLES_PER_CYCLE = 1000;
+  static constexpr size_t DEFAULT_RANGE_SPLIT_MIN_ROWS = 1000000;
+  static constexpr size_t DEFAULT_MONGO_CURSOR_BATCH_SIZE = 1000;
+  static constexpr size_t DEFAULT_MONGO_MEMORY_BUDGET_MB = 256;
 
   static constexpr size_t MIN_CHUNK_SIZE = 100;
   static constexpr size_t MAX_CHUNK_SIZE = 100000;
@@ -23,6 +29,11 @@ struct SyncConfig {
   static constexpr size_t MAX_MAX_WORKERS = 32;
   static constexpr size_t MIN_MAX_TABLES_PER_CYCLE = 1;
   static constexpr size_t MAX_MAX_TABLES_PER_CYCLE = 10000;
+  static constexpr size_t MIN_RANGE_SPLIT_MIN_ROWS = 10000;
+  static constexpr size_t MIN_MONGO_CURSOR_BATCH_SIZE = 1;
+  static constexpr size_t MAX_MONGO_CURSOR_BATCH_SIZE = 100000;
+  static constexpr size_t MIN_MONGO_MEMORY_BUDGET_MB = 16;
+  static constexpr size_t MAX_MONGO_MEMORY_BUDGET_MB = 65536;
 
   static void setChunkSize(size_t newSize) {
     if (newSize < MIN_CHUNK_SIZE || newSize > MAX_CHUNK_SIZE) {
@@ -68,6 +79,44 @@ struct SyncConfig {
   }
 
   static size_t getMaxTablesPerCycle() { return MAX_TABLES_PER_CYCLE.load(); }
+
+  static void setRangeSplitMinRows(size_t v) {
+    if (v < MIN_RANGE_SPLIT_MIN_ROWS) {
+      throw std::invalid_argument("RANGE_SPLIT_MIN_ROWS must be at least " +
+                                  std::to_string(MIN_RANGE_SPLIT_MIN_ROWS));
+    }
+    RANGE_SPLIT_MIN_ROWS.store(v);
+  }
+
+  static size_t getRangeSplitMinRows() { return RANGE_SPLIT_MIN_ROWS.load(); }
+
+  static void setMongoCursorBatchSize(size_t v) {
+    if (v < MIN_MONGO_CURSOR_BATCH_SIZE || v > MAX_MONGO_CURSOR_BATCH_SIZE) {
+      throw std::invalid_argument(
+          "MONGO_CURSOR_BATCH_SIZE must be between " +
+          std::to_string(MIN_MONGO_CURSOR_BATCH_SIZE) + " and " +
+          std::to_string(MAX_MONGO_CURSOR_BATCH_SIZE));
+    }
+    MONGO_CURSOR_BATCH_SIZE.store(v);
+  }
+
+  static size_t getMongoCursorBatchSize() {
+    return MONGO_CURSOR_BATCH_SIZE.load();
+  }
+
+  static void setMongoMemoryBudgetMB(size_t v) {
+    if (v < MIN_MONGO_MEMORY_BUDGET_MB || v > MAX_MONGO_MEMORY_BUDGET_MB) {
+      throw std::invalid_argument(
+          "MONGO_MEMORY_BUDGET_MB must be between " +
+          std::to_string(MIN_MONGO_MEMORY_BUDGET_MB) + " and " +
+          std::to_string(MAX_MONGO_MEMORY_BUDGET_MB));
+    }
+    MONGO_MEMORY_BUDGET_MB.store(v);
+  }
+
+  static size_t getMongoMemoryBudgetMB() {
+    return MONGO_MEMORY_BUDGET_MB.load();
+  }
 };
 
 #endif
@@ -4,10 +4,13 @@
 #include "core/Config.h"
 #include "core/logger.h"
 #include "engines/database_engine.h"
+#include "sync/RowBatch.h"
 #include "sync/SchemaSync.h"
 #include "utils/connection_utils.h"
 #include <memory>
 #include <mysql/mysql.h>
+#include <string>
+#include <vector>
 
 class MySQLConnection {
   MYSQL *conn_{nullptr};
@@ -26,6 +29,109 @@ public:
   bool isValid() const { return conn_ != nullptr; }
 };
 
+// Unbuffered result set opened with mysql_use_result. Rows are read from the
+// network as they are consumed instead of being buffered client-side first,
+// so memory stays bounded by what the caller keeps. The connection cannot run
+// other statements until the stream is exhausted or destroyed; the
+// destructor discards any rows that were not read.
+class MariaDBResultStream {
+  MYSQL *conn_{nullptr};
+  MYSQL_RES *res_{nullptr};
+  unsigned int numFields_{0};
+  bool failed_{false};
+
+public:
+  MariaDBResultStream(MYSQL *conn, const std::string &query);
+  ~MariaDBResultStream();
+
+  MariaDBResultStream(const MariaDBResultStream &) = delete;
+  MariaDBResultStream &operator=(const MariaDBResultStream &) = delete;
+
+  // False if the query failed. Statements without a result set are valid
+  // streams with no columns.
+  bool isValid() const { return !failed_ || res_ != nullptr; }
+  bool failed() const { return failed_; }
+  std::string error() const { return conn_ ? mysql_error(conn_) : ""; }
+  unsigned int columnCount() const { return numFields_; }
+
+  // Returns the next row, or nullptr at the end of the result set or on a
+  // read error (see failed()). lengths() describes the returned row.
+  MYSQL_ROW fetchRow();
+  unsigned long *lengths() const { return mysql_fetch_lengths(res_); }
+
+  // Resets batch to the result's columns and fills it with up to maxRows rows
+  // (binary safe, SQL NULL kept as a NULL cell). Returns the number of rows
+  // read; 0 means the stream is exhausted.
+  size_t fetchBatch(ParallelProcessing::RowBatch &batch, size_t maxRows);
+};
+
+// Prepared statement read through the binary protocol. Result columns are
+// bound to typed buffers (integers, floating point and temporal values
+// arrive in native form) and formatted client-side, so the server does not
+// render them as text. Like MariaDBResultStream, rows are not buffered
+// client-side and the connection is busy until they are read or the next
+// execute() discards them.
+class MariaDBStatement {
+  struct ResultColumn {
+    enum class Kind { Signed, Unsigned, Float, Double, Temporal, Bytes };
+    Kind kind = Kind::Bytes;
+    enum_field_types type = MYSQL_TYPE_STRING;
+    long long integer = 0;
+    float real = 0;
+    double doubleValue = 0;
+    MYSQL_TIME time{};
+    std::vector<char> bytes;
+    unsigned long length = 0;
+    my_bool isNull = 0;
+    my_bool error = 0;
+  };
+
+  MYSQL_STMT *stmt_{nullptr};
+  std::vector<ResultColumn> columns_;
+  std::vector<MYSQL_BIND> resultBinds_;
+  bool prepared_{false};
+  bool failed_{false};
+  bool pending_{false};
+
+public:
+  MariaDBStatement(MYSQL *conn, const std::string &query);
+  ~MariaDBStatement();
+
+  MariaDBStatement(const MariaDBStatement &) = delete;
+  MariaDBStatement &operator=(const MariaDBStatement &) = delete;
+
+  // False once the statement failed to prepare, and after a failed
+  // execute() or fetch until the next execute() succeeds
+  bool isValid() const { return prepared_ && !failed_; }
+  bool failed() const { return failed_; }
+  std::string error() const;
+  unsigned int columnCount() const {
+    return static_cast<unsigned int>(columns_.size());
+  }
+
+  // Executes the statement with its placeholders bound to params as strings
+  // (the server converts them to the column types). Unread rows of a
+  // previous execution are discarded first. A failure of a previous
+  // execution does not carry over, so the statement can be re-executed.
+  bool execute(const std::vector<std::string> &params = {});
+
+  // Discards the unread rows of the current execution, which frees the
+  // connection for other statements
+  void freeResult();
+
+  // Resets batch to the result's columns and fills it with up to maxRows rows
+  // of the current execution. Returns the number of rows read; 0 means the
+  // result set is exhausted.
+  size_t fetchBatch(ParallelProcessing::RowBatch &batch, size_t maxRows);
+
+private:
+  // Initial size of string and blob buffers; longer values are read in a
+  // second step with mysql_stmt_fetch_column.
+  static constexpr unsigned long MAX_BOUND_BYTES = 64 * 1024;
+
+  void appendValue(ParallelProcessing::RowBatch &batch, unsigned int index);
+};
+
 class MariaDBEngine : public IDatabaseEngine {
   std::string connectionString_;
 
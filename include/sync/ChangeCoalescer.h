@@ -0,0 +1,44 @@
+#ifndef CHANGECOALESCER_H
+#define CHANGECOALESCER_H
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Reduces a batch of change-log entries to the final state of each key
+// before it reaches the target. Only the last change of a key survives, and
+// its operation is already the net effect: I->U->U leaves one upsert, U->D a
+// delete, D->I an upsert. I->D still leaves the delete: the log is replayed
+// from the start after a full load, so the target may already hold a row
+// that the insert only seems to create.
+//
+// Entries are added in change order with add(), keyed by their serialized
+// primary key; after finish(), keep(i) tells whether the i-th added entry
+// must be applied and elided() how many were dropped.
+class ChangeCoalescer {
+public:
+  void add(const std::string &key, char operation) {
+    size_t index = operations_.size();
+    operations_.push_back(operation);
+    lastChange_[key] = index;
+  }
+
+  void finish() {
+    keep_.assign(operations_.size(), false);
+    for (const auto &entry : lastChange_)
+      keep_[entry.second] = true;
+    elided_ = operations_.size() - lastChange_.size();
+  }
+
+  bool keep(size_t index) const { return keep_[index]; }
+  size_t elided() const { return elided_; }
+
+private:
+  std::vector<char> operations_;
+  // Index of the last change of each key
+  std::unordered_map<std::string, size_t> lastChange_;
+  std::vector<bool> keep_;
+  size_t elided_ = 0;
+};
+
+#endif
@@ -5,6 +5,7 @@
 #include "sync/ICDCHandler.h"
 #include "third_party/json.hpp"
 #include <mutex>
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -23,7 +24,8 @@ protected:
   virtual std::string getDatabaseName() const = 0;
   virtual std::vector<std::vector<std::string>>
   executeChangeLogQuery(const std::string &query) = 0;
-  virtual std::vector<std::vector<std::string>>
+  // Returns nothing when the query fails
+  virtual std::optional<std::vector<std::vector<std::string>>>
   executeSourceQuery(const std::string &query) = 0;
   virtual std::string escapeIdentifier(const std::string &name) = 0;
   virtual std::string escapeSQL(const std::string &value) = 0;
@@ -31,12 +33,21 @@ protected:
   long long getLastChangeId(pqxx::connection &pgConn, const TableInfo &table,
                             const std::string &dbEngine);
 
-  void processChangeLogBatch(pqxx::connection &pgConn, const TableInfo &table,
+  // Returns false if the batch could not be applied, in which case
+  // last_change_id must not move past it
+  bool processChangeLogBatch(pqxx::connection &pgConn, const TableInfo &table,
                              const std::vector<ChangeLogEntry> &changes,
                              const std::vector<std::string> &columnNames,
                              const std::vector<std::string> &columnTypes,
                              const std::string &dbEngine);
 
+  std::optional<size_t>
+  refetchRowsByKey(const TableInfo &table,
+                   const std::vector<std::string> &pkColumns,
+                   const std::vector<std::string> &columnNames,
+                   const std::vector<std::vector<std::string>> &keys,
+                   std::vector<std::vector<std::string>> &records);
+
   void updateLastChangeId(pqxx::connection &pgConn, const TableInfo &table,
                           long long changeId, const std::string &dbEngine);
 
@@ -6,7 +6,11 @@
 #include "sync/ParallelProcessing.h"
 #include "third_party/json.hpp"
 #include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <map>
 #include <mutex>
+#include <optional>
 #include <pqxx/pqxx>
 #include <string>
 #include <thread>
@@ -35,8 +39,8 @@ protected:
   std::mutex tableStatesMutex_;
 
   std::vector<std::thread> parallelThreads;
-  ThreadSafeQueue<DataChunk> rawDataQueue{MAX_QUEUE_SIZE};
-  ThreadSafeQueue<PreparedBatch> preparedBatchQueue{MAX_QUEUE_SIZE};
+  LockFreeRingQueue<DataChunk> rawDataQueue{MAX_QUEUE_SIZE};
+  LockFreeRingQueue<PreparedBatch> preparedBatchQueue{MAX_QUEUE_SIZE};
   ThreadSafeQueue<ProcessedResult> resultQueue{MAX_QUEUE_SIZE};
 
   static constexpr size_t MAX_QUEUE_SIZE = 10;
@@ -49,12 +53,95 @@ protected:
   static constexpr size_t MAX_INDIVIDUAL_PROCESSING = 100;
   static constexpr size_t MAX_BINARY_ERROR_PROCESSING = 50;
   static constexpr size_t STATEMENT_TIMEOUT_SECONDS = 600;
+  static constexpr size_t PIPELINE_DEPTH = 2;
+  // Keys looked up per source query when CDC re-fetches rows whose change
+  // log entry had no usable row_data
+  static constexpr size_t CDC_REFETCH_BATCH_KEYS = 500;
+  // Source change log rows deleted per statement by the purge, and the
+  // statements run per table and purge cycle
+  static constexpr size_t CHANGE_LOG_PURGE_BATCH_ROWS = 10000;
+  static constexpr size_t CHANGE_LOG_PURGE_MAX_BATCHES = 100;
+  // Change log rows a multiplexed read takes from one source per cycle;
+  // tables that are further behind catch up over the following cycles
+  static constexpr size_t CHANGE_LOG_READ_MAX_ROWS = 100000;
+  // Rows (deletes plus upserts) that CDC batches of different tables may
+  // add up to before they stop sharing one target transaction
+  static constexpr size_t CDC_GROUP_COMMIT_MAX_ROWS = 10000;
 
   static std::mutex metadataUpdateMutex;
 
+  // Converts one source value for a column whose type was resolved when the
+  // converter was compiled.
+  using ColumnConverter = std::function<std::string(const std::string &)>;
+
   virtual std::string cleanValueForPostgres(const std::string &value,
                                             const std::string &columnType) = 0;
 
+  virtual ColumnConverter compileColumnConverter(const std::string &columnType);
+
+  std::vector<ColumnConverter>
+  buildConverterPlan(const std::vector<std::string> &columnTypes);
+
+  std::unordered_map<std::string, std::string>
+  getColumnTypesFromPostgres(pqxx::work &txn, const std::string &targetTable,
+                             bool baseTypes = false);
+
+  size_t
+  deleteRecordsByKeyArrays(pqxx::work &txn, const std::string &lowerSchemaName,
+                           const std::string &lowerTableName,
+                           const std::vector<std::string> &keyColumns,
+                           const std::vector<std::vector<std::string>> &keys,
+                           size_t valueOffset);
+
+  size_t stageAndUpsert(pqxx::work &txn,
+                        const std::vector<std::vector<std::string>> &results,
+                        const std::vector<std::string> &columnNames,
+                        const std::vector<std::string> &columnTypes,
+                        const std::string &lowerSchemaName,
+                        const std::string &tableName,
+                        const std::vector<std::string> &conflictColumns,
+                        bool keyIsPrimary);
+
+  void fillCopyRow(const std::vector<std::string> &row,
+                   const std::vector<ColumnConverter> &converters,
+                   std::vector<std::optional<std::string>> &copyRow);
+
+  void fillCopyRow(const RowBatch &rows, size_t row,
+                   const std::vector<ColumnConverter> &converters,
+                   std::vector<std::optional<std::string>> &copyRow);
+
+  // Fills batch with the next chunk of a full load and, when the load is
+  // checkpointed, lastKey with the key of its last row. Returns false once
+  // no chunk follows; a final short chunk may still be in batch.
+  using ChunkFetcher =
+      std::function<bool(RowBatch &batch, std::vector<std::string> &lastKey)>;
+
+  // Called by the write stage after a chunk has been committed.
+  using ChunkWritten =
+      std::function<void(pqxx::connection &pgConn, const PreparedBatch &)>;
+
+  bool runFullLoadPipeline(const std::string &lowerSchemaName,
+                           const std::string &tableName,
+                           const std::string &sourceSchemaName,
+                           const std::vector<std::string> &columnNames,
+                           const std::vector<std::string> &columnTypes,
+                           const ChunkFetcher &fetchChunk,
+                           const ChunkWritten &onChunkWritten);
+
+  virtual void writePreparedBatch(pqxx::connection &pgConn,
+                                  const PreparedBatch &batch,
+                                  const std::vector<std::string> &columnNames,
+                                  const std::vector<std::string> &columnTypes,
+                                  const std::string &lowerSchemaName,
+                                  const std::string &tableName,
+                                  const std::string &sourceSchemaName);
+
+  size_t copyRowsToTable(
+      pqxx::connection &pgConn, const std::vector<std::string> &columnNames,
+      const std::string &lowerSchemaName, const std::string &tableName,
+      const std::function<bool(std::vector<std::optional<std::string>> &)>
+          &nextRow);
+
   bool isTableProcessingActive(const std::string &tableKey) {
     std::lock_guard<std::mutex> lock(tableStatesMutex_);
     auto it = tableProcessingStates_.find(tableKey);
@@ -71,12 +158,22 @@ protected:
     tableProcessingStates_.erase(tableKey);
   }
 
+  // Group commit of the CDC batches submitted by concurrent table workers:
+  // each batch is queued, and a worker that finds no commit running applies
+  // everything queued so far, its own batch included.
+  struct QueuedCDCBatch;
+  std::mutex cdcCommitMutex_;
+  std::condition_variable cdcCommitDone_;
+  std::vector<QueuedCDCBatch *> cdcCommitQueue_;
+  bool cdcCommitRunning_ = false;
+
 public:
   DatabaseToPostgresSync() = default;
   virtual ~DatabaseToPostgresSync() = default;
 
   void startParallelProcessing();
   void shutdownParallelProcessing();
+  void logQueueWaitStats();
 
   std::vector<std::string> parseJSONArray(const std::string &jsonArray);
 
@@ -89,6 +186,165 @@ public:
                           const std::string &schema_name,
                           const std::string &table_name);
 
+  static std::vector<size_t>
+  findKeyPositions(const std::vector<std::string> &columnNames,
+                   const std::vector<std::string> &keyColumns);
+
+  // How a source engine writes a string literal for a key value: quotes
+  // doubled only, backslashes escaped as well (MariaDB), or with an N prefix
+  // when the value is not ASCII (MSSQL)
+  enum class KeyLiteralStyle { Standard, BackslashEscapes, NationalUnicode };
+
+  static std::string quoteKeyLiteral(const std::string &value,
+                                     KeyLiteralStyle style);
+
+  static std::string
+  buildKeysetPredicate(const std::vector<std::string> &quotedColumns,
+                       const std::vector<std::string> &quotedValues);
+
+  std::vector<std::string>
+  loadFullLoadCheckpoint(pqxx::connection &pgConn,
+                         const std::string &schemaName,
+                         const std::string &tableName,
+                         const std::string &dbEngine,
+                         const std::vector<std::string> &keyColumns,
+                         bool *resumable = nullptr);
+
+  bool resumesFullLoad(pqxx::connection &pgConn, const TableInfo &table,
+                       const std::string &dbEngine,
+                       const std::vector<std::string> &keyColumns);
+
+  void saveFullLoadCheckpoint(pqxx::connection &pgConn,
+                              const std::string &schemaName,
+                              const std::string &tableName,
+                              const std::string &dbEngine,
+                              const std::vector<std::string> &keyColumns,
+                              const std::vector<std::string> &keyValues);
+
+  void clearFullLoadCheckpoint(pqxx::connection &pgConn,
+                               const std::string &schemaName,
+                               const std::string &tableName,
+                               const std::string &dbEngine);
+
+  void retryFullLoad(pqxx::connection &pgConn, const std::string &schemaName,
+                     const std::string &tableName,
+                     const std::string &dbEngine);
+
+  // One source ds_change_log and the CDC progress of the tables it logs:
+  // for every (schema_name, table_name), the lowest last_change_id applied
+  // by any catalog entry reading it. Log rows at or below that id are no
+  // longer needed by anyone.
+  struct ChangeLogSource {
+    std::string connectionString;
+    std::map<std::pair<std::string, std::string>, long long> appliedChangeIds;
+
+    long long minAppliedChangeId() const {
+      long long minId = -1;
+      for (const auto &entry : appliedChangeIds)
+        if (minId < 0 || entry.second < minId)
+          minId = entry.second;
+      return minId < 0 ? 0 : minId;
+    }
+  };
+
+  std::map<std::string, ChangeLogSource> getChangeLogSources(
+      pqxx::connection &pgConn, const std::string &dbEngine,
+      const std::function<std::string(const std::string &)> &sourceKey,
+      bool listeningOnly = false);
+
+  void recordChangeLogPurge(pqxx::connection &pgConn,
+                            const std::string &dbEngine,
+                            const std::string &schemaName,
+                            const std::string &tableName, size_t purgedRows,
+                            long long logRows);
+
+  // What one multiplexed read of a source change log found for a table: its
+  // (change_id, operation, pk_values, row_data) rows after the table's own
+  // last_change_id, in change_id order, and the change_id up to which the
+  // log is known to be complete (see dispatchChangeLog). A table without
+  // rows has nothing to apply this cycle.
+  struct DispatchedChanges {
+    std::vector<std::vector<std::string>> rows;
+    long long readUpTo = 0;
+  };
+
+  // Tables covered by the last multiplexed read, keyed by schema.table
+  std::unordered_map<std::string, DispatchedChanges> dispatchedChanges_;
+  std::mutex dispatchedChangesMutex_;
+
+  void dispatchChangeLog(pqxx::connection &pgConn, const std::string &dbEngine,
+                         const ChangeLogSource &source,
+                         std::vector<std::vector<std::string>> &logRows,
+                         long long committedUpTo);
+  bool takeDispatchedChanges(const std::string &tableKey,
+                             DispatchedChanges &changes);
+  bool hasNoDispatchedChanges(const std::string &tableKey);
+  void clearDispatchedChanges();
+
+  // Per-table scheduling of a transfer pass through the engine's
+  // TableScheduler
+  void keepDueTables(const std::string &dbEngine,
+                     std::vector<TableInfo> &tables);
+  void completeDueTables(const std::string &dbEngine,
+                         const std::vector<TableInfo> &tables);
+
+  // Slice (lowerBound, upperBound] of a table's leading primary key column
+  // that is loaded as an independent task. A missing bound leaves that side
+  // of the range open.
+  struct KeyRange {
+    std::optional<std::string> lowerBound;
+    std::optional<std::string> upperBound;
+  };
+
+  // Shared by the range tasks of one table; the task that brings remaining
+  // to zero finalizes the table.
+  struct KeyRangeProgress {
+    std::atomic<size_t> remaining{0};
+    std::atomic<bool> failed{false};
+  };
+
+  static std::vector<KeyRange>
+  buildKeyRanges(const std::vector<std::string> &boundaries);
+
+  static std::string buildKeyRangePredicate(const std::string &quotedColumn,
+                                            const KeyRange &range,
+                                            KeyLiteralStyle style);
+
+  // One table's share of a CDC apply: the rows to delete and upsert and the
+  // progress that is merged into its catalog sync_metadata once they are
+  // on the target. Tables without a primary key leave pkColumns empty and
+  // give each delete as the row hash followed by every column value.
+  struct CDCApplyBatch {
+    std::string schemaName;
+    std::string tableName;
+    std::string lowerSchemaName;
+    std::string lowerTableName;
+    std::vector<std::string> columnNames;
+    std::vector<std::string> columnTypes;
+    std::vector<std::string> pkColumns;
+    std::vector<std::vector<std::string>> deletes;
+    std::vector<std::vector<std::string>> upserts;
+    // Catalog entry the progress belongs to; an empty connection string
+    // matches the entry of any source
+    std::string dbEngine;
+    std::string connectionString;
+    json progress = json::object();
+    size_t elided = 0;
+    // Filled in by the apply
+    size_t deleted = 0;
+    size_t upserted = 0;
+  };
+
+  static CDCApplyBatch makeCDCApplyBatch(
+      const TableInfo &table, const std::vector<std::string> &columnNames,
+      const std::vector<std::string> &columnTypes,
+      const std::vector<std::string> &pkColumns);
+
+  std::vector<bool> applyCDCBatches(pqxx::connection &pgConn,
+                                    std::vector<CDCApplyBatch> &batches);
+
+  bool commitCDCBatch(pqxx::connection &pgConn, CDCApplyBatch &batch);
+
   size_t deleteRecordsByPrimaryKey(
       pqxx::connection &pgConn, const std::string &lowerSchemaName,
       const std::string &table_name,
@@ -121,6 +377,19 @@ public:
       const std::vector<std::vector<std::string>> &columnNames,
       const std::string &whereClause);
 
+  size_t performBulkCopy(pqxx::connection &pgConn,
+                         const std::vector<std::vector<std::string>> &results,
+                         const std::vector<std::string> &columnNames,
+                         const std::vector<std::string> &columnTypes,
+                         const std::string &lowerSchemaName,
+                         const std::string &tableName);
+
+  size_t performBulkCopy(pqxx::connection &pgConn, const RowBatch &rows,
+                         const std::vector<std::string> &columnNames,
+                         const std::vector<std::string> &columnTypes,
+                         const std::string &lowerSchemaName,
+                         const std::string &tableName);
+
   void performBulkInsert(pqxx::connection &pgConn,
                          const std::vector<std::vector<std::string>> &results,
                          const std::vector<std::string> &columnNames,
@@ -128,6 +397,39 @@ public:
                          const std::string &lowerSchemaName,
                          const std::string &tableName);
 
+  void
+  performBulkInsertValues(pqxx::connection &pgConn,
+                          const std::vector<std::vector<std::string>> &results,
+                          const std::vector<std::string> &columnNames,
+                          const std::vector<std::string> &columnTypes,
+                          const std::string &lowerSchemaName,
+                          const std::string &tableName);
+
+  void performBulkLoad(pqxx::connection &pgConn,
+                       const std::vector<std::vector<std::string>> &results,
+                       const std::vector<std::string> &columnNames,
+                       const std::vector<std::string> &columnTypes,
+                       const std::string &lowerSchemaName,
+                       const std::string &tableName,
+                       const std::string &sourceSchemaName);
+
+  void performBulkLoad(pqxx::connection &pgConn, const RowBatch &rows,
+                       const std::vector<std::string> &columnNames,
+                       const std::vector<std::string> &columnTypes,
+                       const std::string &lowerSchemaName,
+                       const std::string &tableName,
+                       const std::string &sourceSchemaName);
+
+  size_t
+  performStagedUpsert(pqxx::connection &pgConn,
+                      const std::vector<std::vector<std::string>> &results,
+                      const std::vector<std::string> &columnNames,
+                      const std::vector<std::string> &columnTypes,
+                      const std::string &lowerSchemaName,
+                      const std::string &tableName,
+                      const std::vector<std::string> &conflictColumns,
+                      bool keyIsPrimary);
+
   void performBulkUpsert(pqxx::connection &pgConn,
                          const std::vector<std::vector<std::string>> &results,
                          const std::vector<std::string> &columnNames,
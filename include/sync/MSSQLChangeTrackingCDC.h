@@ -0,0 +1,114 @@
+#ifndef MSSQLCHANGETRACKINGCDC_H
+#define MSSQLCHANGETRACKINGCDC_H
+
+#include "sync/DatabaseToPostgresSync.h"
+#include "sync/ICDCHandler.h"
+#include <functional>
+#include <optional>
+#include <pqxx/pqxx>
+#include <sql.h>
+#include <sqlext.h>
+#include <string>
+#include <vector>
+
+// CDC for SQL Server tables that reads the server's own change capture
+// instead of the ds_change_log triggers. The catalog's pk_strategy picks the
+// mechanism per table:
+//
+//   CHANGE_TRACKING  CHANGETABLE(CHANGES ...) since the last synced version
+//                    (sync_metadata.ct_version); it only records keys, so
+//                    the current rows are re-read by key.
+//   NATIVE_CDC       cdc.fn_cdc_get_net_changes_<capture instance> since the
+//                    last synced LSN (sync_metadata.cdc_lsn), which carries
+//                    full row images.
+//
+// Both report one net change per key, which goes through the same
+// delete/upsert path as the change log. The position is captured before a
+// table's full load; a table without one, or whose position the server's
+// cleanup has passed, is reloaded.
+class MSSQLChangeTrackingCDC : public DatabaseToPostgresSync,
+                               public ICDCHandler {
+public:
+  using Rows = std::vector<std::vector<std::string>>;
+
+  // Source access borrowed from MSSQLToPostgres: query returns nothing when
+  // the statement fails or produces no result set, refetch re-reads the
+  // current rows of a list of keys and returns nothing when that fails.
+  struct SourceAccess {
+    std::function<SQLHDBC(const std::string &)> connect;
+    std::function<void(SQLHDBC)> close;
+    std::function<std::optional<Rows>(SQLHDBC, const std::string &)> query;
+    std::function<std::optional<size_t>(
+        SQLHDBC, const TableInfo &, const std::vector<std::string> &,
+        const std::vector<std::string> &, const Rows &, Rows &)>
+        refetch;
+  };
+
+  static constexpr const char *CHANGE_TRACKING = "CHANGE_TRACKING";
+  static constexpr const char *NATIVE_CDC = "NATIVE_CDC";
+
+  explicit MSSQLChangeTrackingCDC(SourceAccess access)
+      : access_(std::move(access)) {}
+
+  // True for the pk_strategy values this handler serves
+  static bool handles(const std::string &pkStrategy);
+
+  // sync_metadata key holding the position of a pk_strategy
+  static std::string positionKey(const std::string &pkStrategy);
+
+  // The server's current position for a pk_strategy, or nothing if it
+  // cannot be read
+  std::optional<std::string> currentPosition(SQLHDBC mssqlConn,
+                                             const std::string &pkStrategy);
+
+  // Turns on the table's capture for its pk_strategy if it is not on yet.
+  // The database itself must already have Change Tracking or CDC enabled.
+  void enableCapture(SQLHDBC mssqlConn, const TableInfo &table);
+
+  // Applies the table's net changes since its position. Returns false when
+  // the table has been sent back to FULL_LOAD instead.
+  bool syncTable(const TableInfo &table, pqxx::connection &pgConn);
+
+  void processTableCDC(const TableInfo &table,
+                       pqxx::connection &pgConn) override;
+
+  bool supportsCDC() const override { return true; }
+  std::string getCDCMechanism() const override {
+    return "Change Tracking / native CDC net changes";
+  }
+
+protected:
+  std::string cleanValueForPostgres(const std::string &value,
+                                    const std::string &columnType) override;
+  ColumnConverter
+  compileColumnConverter(const std::string &columnType) override;
+
+private:
+  // Columns and keys of the table being synced
+  struct SourceTable {
+    std::string tableKey;
+    std::string qualifiedName;
+    std::string lowerSchemaName;
+    std::string lowerTableName;
+    std::vector<std::string> columnNames;
+    std::vector<std::string> columnTypes;
+    std::vector<std::string> pkColumns;
+    std::vector<size_t> pkPositions;
+  };
+
+  bool syncChangeTracking(pqxx::connection &pgConn, SQLHDBC mssqlConn,
+                          const TableInfo &table, const SourceTable &source,
+                          const std::string &position);
+  bool syncNativeCDC(pqxx::connection &pgConn, SQLHDBC mssqlConn,
+                     const TableInfo &table, const SourceTable &source,
+                     const std::string &position);
+  void applyChanges(pqxx::connection &pgConn, const TableInfo &table,
+                    const SourceTable &source, const Rows &deletedKeys,
+                    const Rows &upserts, const std::string &position);
+  void requestFullLoad(pqxx::connection &pgConn, const TableInfo &table,
+                       const std::string &reason);
+
+  SourceAccess access_;
+};
+
+#endif
@@ -5,14 +5,17 @@
 #include "engines/database_engine.h"
 #include "sync/DatabaseToPostgresSync.h"
 #include "sync/ICDCHandler.h"
+#include "sync/MSSQLChangeTrackingCDC.h"
 #include "sync/SchemaSync.h"
 #include "sync/TableProcessorThreadPool.h"
+#include "sync/TableScheduler.h"
 #include "third_party/json.hpp"
 
 #include <algorithm>
 #include <cctype>
 #include <chrono>
 #include <iostream>
+#include <memory>
 #include <pqxx/pqxx>
 #include <set>
 #include <sql.h>
@@ -34,8 +37,21 @@ public:
   static std::unordered_map<std::string, std::string> dataTypeMap;
   static std::unordered_map<std::string, std::string> collationMap;
 
+  struct ColumnTraits {
+    bool dateLike = false;
+    bool boolean = false;
+    bool bit = false;
+    std::string nullValue;
+  };
+
+  static ColumnTraits classifyColumnType(const std::string &columnType);
+  static std::string cleanValueWithTraits(const std::string &value,
+                                          const ColumnTraits &traits);
+
   std::string cleanValueForPostgres(const std::string &value,
                                     const std::string &columnType) override;
+  ColumnConverter
+  compileColumnConverter(const std::string &columnType) override;
 
   void processTableCDC(const DatabaseToPostgresSync::TableInfo &table,
                        pqxx::connection &pgConn) override;
@@ -184,6 +200,9 @@ public:
     }
   }
 
+  void purgeChangeLog();
+  void readChangeLogs(pqxx::connection &pgConn);
+
   std::vector<TableInfo> getActiveTables(pqxx::connection &pgConn) {
     std::vector<TableInfo> data;
 
@@ -664,6 +683,13 @@ public:
         executeQueryMSSQL(dbc, dropUpdate);
         executeQueryMSSQL(dbc, dropDelete);
 
+        // Change Tracking and native CDC tables are captured by the server
+        if (MSSQLChangeTrackingCDC::handles(table.pk_strategy)) {
+          changeTrackingCDC_.enableCapture(dbc, table);
+          closeMSSQLConnection(dbc);
+          continue;
+        }
+
         std::string createInsertTrigger =
             "CREATE TRIGGER [" + table.schema_name + "].[" + triggerInsert +
             "] ON [" + table.schema_name + "].[" + table.table_name +
@@ -1289,9 +1315,29 @@ public:
 
       auto tables = getActiveTables(pgConn);
 
+      // Listening CDC tables the change log read found no new changes for
+      // have nothing to do this cycle
+      readChangeLogs(pgConn);
+      keepDueTables("MSSQL", tables);
+      std::vector<TableInfo> dueTables = tables;
+      size_t idleTables = tables.size();
+      tables.erase(std::remove_if(tables.begin(), tables.end(),
+                                  [this](const TableInfo &t) {
+                                    return hasNoDispatchedChanges(
+                                        t.schema_name + "." + t.table_name);
+                                  }),
+                   tables.end());
+      idleTables -= tables.size();
+      if (idleTables > 0) {
+        Logger::info(LogCategory::TRANSFER,
+                     "Skipping " + std::to_string(idleTables) +
+                         " MSSQL CDC tables without new changes");
+      }
+
       if (tables.empty()) {
         Logger::info(LogCategory::TRANSFER,
                      "No active MSSQL tables found for parallel data transfer");
+        completeDueTables("MSSQL", dueTables);
         return;
       }
 
@@ -1319,9 +1365,13 @@ public:
                    "Processing " + std::to_string(tables.size()) +
                        " MSSQL tables in HYBRID parallel mode");
 
-      // Process multiple tables in parallel (bounded by config)
+      // Process multiple tables in parallel (bounded by config); the rest
+      // stay due for the next pass
       size_t tablesCap = SyncConfig::getMaxTablesPerCycle();
       if (tablesCap > 0 && tables.size() > tablesCap) {
+        TableScheduler &scheduler = TableScheduler::forEngine("MSSQL");
+        for (size_t i = tablesCap; i < tables.size(); ++i)
+          scheduler.wake(tables[i].schema_name + "." + tables[i].table_name);
         tables.resize(tablesCap);
       }
       size_t maxWorkers = std::max<size_t>(1, SyncConfig::getMaxWorkers());
@@ -1373,6 +1423,7 @@ public:
                        std::to_string(skipped) + ")");
 
       pool.waitForCompletion();
+      completeDueTables("MSSQL", dueTables);
 
       Logger::info(LogCategory::TRANSFER,
                    "Thread pool completed - Completed: " +
@@ -1783,13 +1834,25 @@ public:
         targetCount = 0;
       }
 
-      if (table.status == "FULL_LOAD" || table.status == "RESET") {
+      bool resumeFullLoad = resumesFullLoad(
+          pgConn, table, "MSSQL",
+          getPKColumnsFromCatalog(pgConn, table.schema_name, table.table_name));
+
+      if (resumeFullLoad) {
+        Logger::info(LogCategory::TRANSFER, "processTableParallel",
+                     "FULL_LOAD checkpoint found - resuming without truncate "
+                     "for " +
+                         table.schema_name + "." + table.table_name);
+      } else if (table.status == "FULL_LOAD" || table.status == "RESET") {
         Logger::info(
             LogCategory::TRANSFER, "processTableParallel",
             "FULL_LOAD/RESET detected - performing mandatory truncate for " +
                 table.schema_name + "." + table.table_name);
 
         try {
+          clearFullLoadCheckpoint(pgConn, table.schema_name, table.table_name,
+                                  "MSSQL");
+
           auto tableExistsForTruncate = [&]() {
             pqxx::work checkTxn(pgConn);
             auto result = checkTxn.exec(
@@ -1823,6 +1886,29 @@ public:
               Logger::info(LogCategory::TRANSFER, "processTableParallel",
                            "Reset last_change_id for CDC table " +
                                table.schema_name + "." + table.table_name);
+            } else if (MSSQLChangeTrackingCDC::handles(pkStrategy)) {
+              // Changes are read from the position current before the copy;
+              // those committed during it are applied again
+              auto position =
+                  changeTrackingCDC_.currentPosition(mssqlConn, pkStrategy);
+              if (position) {
+                updateTxn.exec(
+                    "UPDATE metadata.catalog SET sync_metadata = "
+                    "COALESCE(sync_metadata, '{}'::jsonb) || "
+                    "jsonb_build_object(" +
+                    updateTxn.quote(
+                        MSSQLChangeTrackingCDC::positionKey(pkStrategy)) +
+                    ", " + updateTxn.quote(*position) +
+                    ") WHERE schema_name=" +
+                    updateTxn.quote(table.schema_name) + " AND table_name=" +
+                    updateTxn.quote(table.table_name) +
+                    " AND db_engine='MSSQL'");
+              } else {
+                Logger::warning(LogCategory::TRANSFER, "processTableParallel",
+                                "Could not read the " + pkStrategy +
+                                    " position for " + table.schema_name +
+                                    "." + table.table_name);
+              }
             }
             updateTxn.commit();
           }
@@ -1844,12 +1930,25 @@ public:
                        ", pkStrategy=" + pkStrategy +
                        ", status=" + table.status);
 
-      if (pkStrategy == "CDC" && table.status != "FULL_LOAD") {
+      bool serverCapture = MSSQLChangeTrackingCDC::handles(pkStrategy);
+      if ((pkStrategy == "CDC" || serverCapture) &&
+          table.status != "FULL_LOAD") {
         Logger::info(LogCategory::TRANSFER, "processTableParallel",
                      "CDC strategy detected for " + table.schema_name + "." +
                          table.table_name + " - processing changes only");
-        processTableCDC(tableKey, mssqlConn, table, pgConn, columnNames,
-                        columnTypes);
+        if (serverCapture) {
+          TableInfo captured = table;
+          captured.pk_strategy = pkStrategy;
+          if (!changeTrackingCDC_.syncTable(captured, pgConn)) {
+            // Sent back to FULL_LOAD
+            closeMSSQLConnection(mssqlConn);
+            removeTableProcessingState(tableKey);
+            return;
+          }
+        } else {
+          processTableCDC(tableKey, mssqlConn, table, pgConn, columnNames,
+                          columnTypes);
+        }
 
         size_t finalCount = 0;
         try {
@@ -1900,59 +1999,26 @@ public:
                    "Proceeding with FULL_LOAD for " + table.schema_name + "." +
                        table.table_name);
 
-      std::thread dataFetcher(&MSSQLToPostgres::dataFetcherThread, this,
-                              tableKey, mssqlConn, table, columnNames,
-                              columnTypes);
-
-      // Start batch preparers
-      std::vector<std::thread> batchPreparers;
-      for (size_t i = 0; i < MAX_BATCH_PREPARERS; ++i) {
-        batchPreparers.emplace_back(&MSSQLToPostgres::batchPreparerThread, this,
-                                    columnNames, columnTypes);
-      }
-
-      // Start multiple batch inserters
-      std::vector<std::thread> batchInserters;
-      for (size_t i = 0; i < MAX_BATCH_INSERTERS; ++i) {
-        batchInserters.emplace_back(&MSSQLToPostgres::batchInserterThread, this,
-                                    std::ref(pgConn));
+      if (scheduleKeyRangeLoad(mssqlConn, pgConn, table, columnNames,
+                               columnTypes, sourceCount, targetCount,
+                               resumeFullLoad)) {
+        closeMSSQLConnection(mssqlConn);
+        return;
       }
 
-      // Wait for data fetcher to complete
-      if (dataFetcher.joinable()) {
-        dataFetcher.join();
+      if (!dataFetcherThread(tableKey, mssqlConn, table, columnNames,
+                             columnTypes, nullptr)) {
+        Logger::error(LogCategory::TRANSFER, "processTableParallel",
+                      "FULL_LOAD failed for " + tableKey +
+                          " - leaving it in FULL_LOAD to retry");
+        retryFullLoad(pgConn, table.schema_name, table.table_name, "MSSQL");
+        closeMSSQLConnection(mssqlConn);
+        removeTableProcessingState(tableKey);
+        return;
       }
 
       setTableProcessingState(tableKey, false);
 
-      // Signal end of data to ALL preparers (one signal per preparer)
-      for (size_t i = 0; i < MAX_BATCH_PREPARERS; ++i) {
-        DataChunk lastChunk;
-        lastChunk.isLastChunk = true;
-        rawDataQueue.push(std::move(lastChunk));
-      }
-
-      // Wait for all batch preparers to complete
-      for (auto &preparer : batchPreparers) {
-        if (preparer.joinable()) {
-          preparer.join();
-        }
-      }
-
-      // Signal end of batches to inserters
-      for (size_t i = 0; i < MAX_BATCH_INSERTERS; ++i) {
-        PreparedBatch lastBatch;
-        lastBatch.batchSize = 0;
-        preparedBatchQueue.push(std::move(lastBatch));
-      }
-
-      // Wait for all batch inserters to complete
-      for (auto &inserter : batchInserters) {
-        if (inserter.joinable()) {
-          inserter.join();
-        }
-      }
-
       size_t finalTargetCount = 0;
       try {
         pqxx::work txn(pgConn);
@@ -1985,10 +2051,146 @@ public:
     }
   }
 
-  void dataFetcherThread(const std::string &tableKey, SQLHDBC mssqlConn,
+  // Splits a large FULL_LOAD into ranges of the leading primary key column,
+  // cut at NTILE boundaries so skewed keys still give even ranges, and
+  // submits each range to the pool running this table so one big table can
+  // use every worker. Returns false, leaving the load to the caller, when the
+  // table is small, partly loaded, has no usable key or no pool is running.
+  bool scheduleKeyRangeLoad(SQLHDBC mssqlConn, pqxx::connection &pgConn,
+                            const TableInfo &table,
+                            const std::vector<std::string> &columnNames,
+                            const std::vector<std::string> &columnTypes,
+                            size_t sourceCount, size_t targetCount,
+                            bool resumeFullLoad) {
+    TableProcessorThreadPool *pool = TableProcessorThreadPool::currentPool();
+    if (!pool || pool->totalWorkers() < 2 || resumeFullLoad ||
+        targetCount > 0 || sourceCount < SyncConfig::getRangeSplitMinRows())
+      return false;
+
+    std::vector<std::string> pkColumns =
+        getPKColumnsFromCatalog(pgConn, table.schema_name, table.table_name);
+    if (findKeyPositions(columnNames, pkColumns).empty())
+      return false;
+
+    std::string keyColumn = "[" + pkColumns[0] + "]";
+    std::vector<std::string> boundaries;
+    for (const auto &row : executeQueryMSSQL(
+             mssqlConn,
+             "SELECT MAX(" + keyColumn + ") FROM (SELECT " + keyColumn +
+                 ", NTILE(" + std::to_string(pool->totalWorkers()) +
+                 ") OVER (ORDER BY " + keyColumn + ") AS bucket FROM [" +
+                 table.schema_name + "].[" + table.table_name +
+                 "]) b GROUP BY bucket ORDER BY bucket;")) {
+      if (!row.empty() && !row[0].empty() && row[0] != "NULL")
+        boundaries.push_back(row[0]);
+    }
+
+    std::vector<KeyRange> ranges = buildKeyRanges(boundaries);
+    if (ranges.size() < 2)
+      return false;
+
+    Logger::info(LogCategory::TRANSFER, "scheduleKeyRangeLoad",
+                 "Splitting FULL_LOAD of " + table.schema_name + "." +
+                     table.table_name + " into " +
+                     std::to_string(ranges.size()) + " key ranges");
+
+    auto progress = std::make_shared<KeyRangeProgress>();
+    progress->remaining = ranges.size();
+    for (const auto &range : ranges) {
+      bool submitted = pool->submitTask(
+          table, [this, columnNames, columnTypes, range,
+                  progress](const DatabaseToPostgresSync::TableInfo &t) {
+            loadKeyRange(t, columnNames, columnTypes, range, progress);
+          });
+      if (!submitted)
+        finishKeyRange(table, progress, false);
+    }
+    return true;
+  }
+
+  // Pool task loading one key range over its own MSSQL and PostgreSQL
+  // connections.
+  void loadKeyRange(const TableInfo &table,
+                    const std::vector<std::string> &columnNames,
+                    const std::vector<std::string> &columnTypes,
+                    const KeyRange &range,
+                    const std::shared_ptr<KeyRangeProgress> &progress) {
+    bool ok = false;
+    SQLHDBC mssqlConn = getMSSQLConnection(table.connection_string);
+    if (mssqlConn) {
+      ok = dataFetcherThread(table.schema_name + "." + table.table_name,
+                             mssqlConn, table, columnNames, columnTypes,
+                             &range);
+      closeMSSQLConnection(mssqlConn);
+    } else {
+      Logger::error(LogCategory::TRANSFER, "loadKeyRange",
+                    "Failed to get MSSQL connection for key range of " +
+                        table.schema_name + "." + table.table_name);
+    }
+    finishKeyRange(table, progress, ok);
+  }
+
+  // Records one finished key range. The last range of a table sets its final
+  // status: LISTENING_CHANGES with the loaded row count, or, if any range
+  // failed, an empty target back in FULL_LOAD so the next pass loads the
+  // table again.
+  void finishKeyRange(const TableInfo &table,
+                      const std::shared_ptr<KeyRangeProgress> &progress,
+                      bool ok) {
+    if (!ok)
+      progress->failed = true;
+    if (--progress->remaining > 0)
+      return;
+
+    std::string lowerSchemaName = table.schema_name;
+    std::transform(lowerSchemaName.begin(), lowerSchemaName.end(),
+                   lowerSchemaName.begin(), ::tolower);
+    std::string lowerTableName = table.table_name;
+    std::transform(lowerTableName.begin(), lowerTableName.end(),
+                   lowerTableName.begin(), ::tolower);
+
+    try {
+      pqxx::connection pgConn(DatabaseConfig::getPostgresConnectionString());
+      if (progress->failed) {
+        pqxx::work txn(pgConn);
+        txn.exec("TRUNCATE TABLE \"" + lowerSchemaName + "\".\"" +
+                 lowerTableName + "\" CASCADE;");
+        txn.commit();
+        retryFullLoad(pgConn, table.schema_name, table.table_name, "MSSQL");
+      } else {
+        size_t finalTargetCount = 0;
+        pqxx::work txn(pgConn);
+        auto res = txn.exec("SELECT COUNT(*) FROM \"" + lowerSchemaName +
+                            "\".\"" + lowerTableName + "\";");
+        if (!res.empty())
+          finalTargetCount = res[0][0].as<size_t>();
+        txn.commit();
+        updateStatus(pgConn, table.schema_name, table.table_name,
+                     "LISTENING_CHANGES", finalTargetCount);
+      }
+    } catch (const std::exception &e) {
+      Logger::error(LogCategory::TRANSFER, "finishKeyRange",
+                    "Error finalizing key range load for " +
+                        table.schema_name + "." + table.table_name + ": " +
+                        std::string(e.what()));
+    }
+
+    removeTableProcessingState(table.schema_name + "." + table.table_name);
+    Logger::info(LogCategory::TRANSFER,
+                 "Key range load completed for table " + table.schema_name +
+                     "." + table.table_name);
+  }
+
+  // Loads the table (or only the given key range of it) through the full load
+  // pipeline and returns false if writing a chunk failed. Whole-table loads
+  // checkpoint their position; range loads do not, since they only run on a
+  // fresh load.
+  bool dataFetcherThread(const std::string &tableKey, SQLHDBC mssqlConn,
                          const TableInfo &table,
                          const std::vector<std::string> &columnNames,
-                         const std::vector<std::string> &columnTypes) {
+                         const std::vector<std::string> &columnTypes,
+                         const KeyRange *range) {
+    bool ok = true;
     try {
       size_t chunkNumber = 0;
       const size_t CHUNK_SIZE = SyncConfig::getChunkSize();
@@ -2003,15 +2205,51 @@ public:
           getPKColumnsFromCatalog(pgConn, table.schema_name, table.table_name);
 
       std::string databaseName = extractDatabaseName(table.connection_string);
-      bool hasMoreData = true;
       size_t lastProcessedOffset = 0;
 
-      while (hasMoreData) {
+      // Tables with a primary key are paged by seeking past the last key of
+      // the previous chunk instead of OFFSET, which re-scans every earlier
+      // row. The last key is checkpointed so an interrupted load resumes.
+      std::vector<size_t> keyPositions =
+          findKeyPositions(columnNames, pkColumns);
+      bool useKeyset = !keyPositions.empty();
+      bool checkpointed = useKeyset && !range;
+      std::vector<std::string> lastKey;
+      if (checkpointed) {
+        lastKey = loadFullLoadCheckpoint(pgConn, table.schema_name,
+                                         table.table_name, "MSSQL", pkColumns);
+        if (!lastKey.empty()) {
+          Logger::info(LogCategory::TRANSFER, "dataFetcherThread",
+                       "Resuming FULL_LOAD from checkpoint for " +
+                           table.schema_name + "." + table.table_name);
+        }
+      }
+
+      std::vector<std::string> quotedKeyColumns;
+      for (const auto &pkColumn : pkColumns)
+        quotedKeyColumns.push_back("[" + pkColumn + "]");
+
+      std::string rangePredicate;
+      if (range && useKeyset)
+        rangePredicate =
+            buildKeyRangePredicate(quotedKeyColumns[0], *range,
+                                   KeyLiteralStyle::NationalUnicode);
+
+      std::string lowerSchemaName = table.schema_name;
+      std::transform(lowerSchemaName.begin(), lowerSchemaName.end(),
+                     lowerSchemaName.begin(), ::tolower);
+
+      // Chunks are fetched here while the pipeline converts and writes the
+      // previous ones; the checkpoint only advances once a chunk is written.
+      auto fetchChunk = [&](RowBatch &batch,
+                            std::vector<std::string> &chunkKey) {
         chunkNumber++;
 
         executeQueryMSSQL(mssqlConn, "USE [" + databaseName + "];");
 
         std::string selectQuery = "SELECT ";
+        if (useKeyset)
+          selectQuery += "TOP (" + std::to_string(CHUNK_SIZE) + ") ";
         for (size_t i = 0; i < columnNames.size(); ++i) {
           if (i > 0)
             selectQuery += ", ";
@@ -2020,6 +2258,20 @@ public:
         selectQuery +=
             " FROM [" + table.schema_name + "].[" + table.table_name + "]";
 
+        std::string wherePredicate = rangePredicate;
+        if (useKeyset && !lastKey.empty()) {
+          std::vector<std::string> quotedKeyValues;
+          for (const auto &value : lastKey)
+            quotedKeyValues.push_back(
+                quoteKeyLiteral(value, KeyLiteralStyle::NationalUnicode));
+          if (!wherePredicate.empty())
+            wherePredicate += " AND ";
+          wherePredicate +=
+              buildKeysetPredicate(quotedKeyColumns, quotedKeyValues);
+        }
+        if (!wherePredicate.empty())
+          selectQuery += " WHERE " + wherePredicate;
+
         if (!pkColumns.empty()) {
           selectQuery += " ORDER BY ";
           for (size_t i = 0; i < pkColumns.size(); ++i) {
@@ -2029,62 +2281,75 @@ public:
           }
         }
 
-        selectQuery += " OFFSET " + std::to_string(lastProcessedOffset) +
-                       " ROWS FETCH NEXT " + std::to_string(CHUNK_SIZE) +
-                       " ROWS ONLY;";
+        if (useKeyset) {
+          selectQuery += ";";
+        } else {
+          selectQuery += " OFFSET " + std::to_string(lastProcessedOffset) +
+                         " ROWS FETCH NEXT " + std::to_string(CHUNK_SIZE) +
+                         " ROWS ONLY;";
+        }
 
         Logger::info(LogCategory::TRANSFER, "dataFetcherThread",
                      "Executing query for chunk " +
                          std::to_string(chunkNumber) + " on " +
                          table.schema_name + "." + table.table_name);
 
-        std::vector<std::vector<std::string>> results =
-            executeQueryMSSQL(mssqlConn, selectQuery);
+        if (!executeQueryMSSQL(mssqlConn, selectQuery, batch))
+          throw std::runtime_error("Query failed for chunk " +
+                                   std::to_string(chunkNumber));
 
         Logger::info(LogCategory::TRANSFER, "dataFetcherThread",
-                     "Retrieved " + std::to_string(results.size()) +
+                     "Retrieved " + std::to_string(batch.rowCount()) +
                          " rows for chunk " + std::to_string(chunkNumber) +
                          " on " + table.schema_name + "." + table.table_name);
 
-        if (results.empty()) {
+        if (batch.empty()) {
           Logger::info(LogCategory::TRANSFER, "dataFetcherThread",
                        "No more data to fetch for " + table.schema_name + "." +
                            table.table_name);
-          hasMoreData = false;
-          break;
+          return false;
         }
 
-        try {
-          std::string lowerSchemaName = table.schema_name;
-          std::transform(lowerSchemaName.begin(), lowerSchemaName.end(),
-                         lowerSchemaName.begin(), ::tolower);
-
-          performBulkUpsert(pgConn, results, columnNames, columnTypes,
-                            lowerSchemaName, table.table_name,
-                            table.schema_name);
-
-          Logger::info(LogCategory::TRANSFER,
-                       "Successfully processed chunk " +
-                           std::to_string(chunkNumber) + " with " +
-                           std::to_string(results.size()) + " rows for " +
-                           table.schema_name + "." + table.table_name);
-
-          lastProcessedOffset += results.size();
+        lastProcessedOffset += batch.rowCount();
+        if (useKeyset) {
+          size_t lastRow = batch.rowCount() - 1;
+          lastKey.clear();
+          for (size_t position : keyPositions)
+            lastKey.emplace_back(batch.value(lastRow, position));
+          if (checkpointed)
+            chunkKey = lastKey;
+        }
 
-          if (results.size() < CHUNK_SIZE) {
-            Logger::info(LogCategory::TRANSFER, "dataFetcherThread",
-                         "Retrieved " + std::to_string(results.size()) +
-                             " rows (less than chunk size " +
-                             std::to_string(CHUNK_SIZE) +
-                             ") - ending data transfer");
-            hasMoreData = false;
-          }
-        } catch (const std::exception &e) {
-          Logger::error(LogCategory::TRANSFER, "dataFetcherThread",
-                        "Error processing chunk: " + std::string(e.what()));
-          hasMoreData = false;
+        if (batch.rowCount() < CHUNK_SIZE) {
+          Logger::info(LogCategory::TRANSFER, "dataFetcherThread",
+                       "Retrieved " + std::to_string(batch.rowCount()) +
+                           " rows (less than chunk size " +
+                           std::to_string(CHUNK_SIZE) +
+                           ") - ending data transfer");
+          return false;
         }
-      }
+        return true;
+      };
+
+      auto chunkWritten = [&](pqxx::connection &writerConn,
+                              const PreparedBatch &written) {
+        Logger::info(LogCategory::TRANSFER,
+                     "Successfully processed chunk " +
+                         std::to_string(written.chunkNumber) + " with " +
+                         std::to_string(written.batchSize) + " rows for " +
+                         table.schema_name + "." + table.table_name);
+        if (checkpointed && !written.lastKey.empty())
+          saveFullLoadCheckpoint(writerConn, table.schema_name,
+                                 table.table_name, "MSSQL", pkColumns,
+                                 written.lastKey);
+      };
+
+      ok = runFullLoadPipeline(lowerSchemaName, table.table_name,
+                               table.schema_name, columnNames, columnTypes,
+                               fetchChunk, chunkWritten);
+      if (ok && checkpointed)
+        clearFullLoadCheckpoint(pgConn, table.schema_name, table.table_name,
+                                "MSSQL");
 
       Logger::info(LogCategory::TRANSFER, "Data fetcher thread completed for " +
                                               table.schema_name + "." +
@@ -2093,7 +2358,9 @@ public:
     } catch (const std::exception &e) {
       Logger::error(LogCategory::TRANSFER, "dataFetcherThread",
                     "Error in data fetcher thread: " + std::string(e.what()));
+      ok = false;
     }
+    return ok;
   }
 
   void batchPreparerThread(const std::vector<std::string> &columnNames,
@@ -2121,10 +2388,10 @@ public:
         // Prepare batches from raw data
         const size_t BATCH_SIZE = SyncConfig::getChunkSize();
 
-        for (size_t batchStart = 0; batchStart < chunk.rawData.size();
+        const RowBatch &rows = chunk.rows;
+        for (size_t batchStart = 0; batchStart < rows.rowCount();
              batchStart += BATCH_SIZE) {
-          size_t batchEnd =
-              std::min(batchStart + BATCH_SIZE, chunk.rawData.size());
+          size_t batchEnd = std::min(batchStart + BATCH_SIZE, rows.rowCount());
 
           // Build batch query
           std::string lowerSchemaName = chunk.schemaName;
@@ -2177,6 +2444,9 @@ public:
             }
           }
 
+          std::vector<ColumnConverter> converters =
+              buildConverterPlan(validColumnTypes);
+
           if (validColumnNames.empty()) {
             Logger::warning(LogCategory::TRANSFER, "batchPreparerThread",
                             "No valid columns found for " + lowerSchemaName +
@@ -2207,24 +2477,22 @@ public:
           std::string valuesClause;
           size_t validRowsCount = 0;
           for (size_t i = batchStart; i < batchEnd; ++i) {
-            const auto &row = chunk.rawData[i];
-            if (row.size() != validColumnNames.size())
+            if (rows.columnCount() != validColumnNames.size())
               continue;
 
             if (validRowsCount > 0)
               valuesClause += ", ";
 
             valuesClause += "(";
-            for (size_t j = 0; j < row.size() && j < validColumnNames.size();
-                 ++j) {
+            for (size_t j = 0; j < validColumnNames.size(); ++j) {
               if (j > 0)
                 valuesClause += ", ";
 
-              if (row[j].empty()) {
+              if (rows.isNull(i, j) || rows.value(i, j).empty()) {
                 valuesClause += "NULL";
               } else {
                 std::string cleanValue =
-                    cleanValueForPostgres(row[j], validColumnTypes[j]);
+                    converters[j](std::string(rows.value(i, j)));
                 if (cleanValue == "NULL") {
                   valuesClause += "NULL";
                 } else {
@@ -2252,7 +2520,7 @@ public:
         Logger::info(LogCategory::TRANSFER,
                      "Prepared batches for chunk " +
                          std::to_string(chunk.chunkNumber) + " (" +
-                         std::to_string(chunk.rawData.size()) + " rows)");
+                         std::to_string(rows.rowCount()) + " rows)");
       }
 
       Logger::info(LogCategory::TRANSFER, "Batch preparer thread completed");
@@ -2292,6 +2560,28 @@ public:
   }
 
 private:
+  MSSQLChangeTrackingCDC changeTrackingCDC_{
+      {[this](const std::string &connectionString) {
+         return getMSSQLConnection(connectionString);
+       },
+       [this](SQLHDBC conn) { closeMSSQLConnection(conn); },
+       [this](SQLHDBC conn, const std::string &query)
+           -> std::optional<MSSQLChangeTrackingCDC::Rows> {
+         RowBatch batch;
+         if (!executeQueryMSSQL(conn, query, batch) ||
+             batch.columnCount() == 0)
+           return std::nullopt;
+         return batch.toRows("NULL");
+       },
+       [this](SQLHDBC conn, const TableInfo &table,
+              const std::vector<std::string> &pkColumns,
+              const std::vector<std::string> &columnNames,
+              const MSSQLChangeTrackingCDC::Rows &keys,
+              MSSQLChangeTrackingCDC::Rows &records) {
+         return refetchRowsByKey(conn, table, pkColumns, columnNames, keys,
+                                 records);
+       }}};
+
   std::string escapeSQL(const std::string &value) {
     if (value.empty()) {
       return value;
@@ -2315,6 +2605,13 @@ private:
                        const std::vector<std::string> &columnNames,
                        const std::vector<std::string> &columnTypes);
 
+  std::optional<size_t>
+  refetchRowsByKey(SQLHDBC mssqlConn, const TableInfo &table,
+                   const std::vector<std::string> &pkColumns,
+                   const std::vector<std::string> &columnNames,
+                   const std::vector<std::vector<std::string>> &keys,
+                   std::vector<std::vector<std::string>> &records);
+
   std::vector<std::string> getPrimaryKeyColumns(SQLHDBC mssqlConn,
                                                 const std::string &schema_name,
                                                 const std::string &table_name) {
@@ -2381,11 +2678,197 @@ private:
 
   std::vector<std::vector<std::string>>
   executeQueryMSSQL(SQLHDBC conn, const std::string &query) {
-    std::vector<std::vector<std::string>> results;
+    RowBatch batch;
+    executeQueryMSSQL(conn, query, batch);
+    return batch.toRows("NULL");
+  }
+
+  // Block cursors fetch up to this many rows per SQLFetch call, bounded by
+  // BLOCK_FETCH_BUFFER_BYTES of bound buffers. Columns wider than
+  // BLOCK_FETCH_MAX_COLUMN_SIZE (and (max)/LOB columns) are read with
+  // SQLGetData instead.
+  static constexpr size_t BLOCK_FETCH_MAX_ROWS = 4096;
+  static constexpr size_t BLOCK_FETCH_BUFFER_BYTES = 8 * 1024 * 1024;
+  static constexpr SQLULEN BLOCK_FETCH_MAX_COLUMN_SIZE = 8000;
+
+  size_t purgeChangeLogRows(SQLHDBC mssqlConn, const std::string &schemaName,
+                            const std::string &tableName,
+                            long long appliedChangeId);
+
+  // Column-wise bound buffers for one result column. Integer columns are
+  // fetched as SQL_C_SBIGINT so the driver does not format them; everything
+  // else is fetched as text into fixed-width slots.
+  struct BoundColumn {
+    bool integer = false;
+    SQLLEN width = 0;
+    std::vector<SQLBIGINT> integers;
+    std::vector<char> text;
+    std::vector<SQLLEN> indicators;
+  };
+
+  enum class BlockFetch { Unsupported, Truncated, Done, Failed };
+
+  // Drops the column bindings and rowset attributes of a block cursor so the
+  // statement can be fetched row by row again.
+  void unbindBlockCursor(SQLHSTMT stmt) {
+    SQLFreeStmt(stmt, SQL_UNBIND);
+    SQLSetStmtAttr(stmt, SQL_ATTR_ROW_ARRAY_SIZE, (SQLPOINTER)1, 0);
+    SQLSetStmtAttr(stmt, SQL_ATTR_ROWS_FETCHED_PTR, nullptr, 0);
+    SQLSetStmtAttr(stmt, SQL_ATTR_ROW_STATUS_PTR, nullptr, 0);
+  }
+
+  // Fetches the whole result set of stmt with a block cursor, writing values
+  // straight into batch. Returns Unsupported without fetching anything when
+  // the result set has a column that cannot be bound to a fixed-size buffer:
+  // the SQL Server driver does not allow SQLGetData with a rowset larger
+  // than one row, so those result sets keep the row-by-row path. A value
+  // longer than its bound buffer returns Truncated with the bindings
+  // dropped, so the caller can read the result set again row by row. A
+  // fetch error or a row the driver reports as failed returns Failed,
+  // leaving a partial batch.
+  BlockFetch fetchBlockCursor(SQLHSTMT stmt, SQLSMALLINT numCols,
+                              RowBatch &batch) {
+    std::vector<BoundColumn> columns(static_cast<size_t>(numCols));
+    size_t rowWidth = 0;
+    for (SQLSMALLINT i = 1; i <= numCols; i++) {
+      SQLCHAR name[256];
+      SQLSMALLINT nameLen = 0, dataType = 0, decimals = 0, nullable = 0;
+      SQLULEN columnSize = 0;
+      if (!SQL_SUCCEEDED(SQLDescribeCol(stmt, i, name, sizeof(name), &nameLen,
+                                        &dataType, &columnSize, &decimals,
+                                        &nullable)))
+        return BlockFetch::Unsupported;
+
+      BoundColumn &column = columns[static_cast<size_t>(i - 1)];
+      switch (dataType) {
+      case SQL_BIT:
+      case SQL_TINYINT:
+      case SQL_SMALLINT:
+      case SQL_INTEGER:
+      case SQL_BIGINT:
+        column.integer = true;
+        column.width = sizeof(SQLBIGINT);
+        break;
+      case SQL_LONGVARCHAR:
+      case SQL_WLONGVARCHAR:
+      case SQL_LONGVARBINARY:
+        return BlockFetch::Unsupported;
+      default:
+        if (columnSize == 0 || columnSize > BLOCK_FETCH_MAX_COLUMN_SIZE)
+          return BlockFetch::Unsupported;
+        // Room for UTF-8 expansion, hex-encoded binary, signs and the
+        // terminator
+        column.width = static_cast<SQLLEN>(columnSize * 4 + 16);
+        break;
+      }
+      rowWidth += static_cast<size_t>(column.width) + sizeof(SQLLEN);
+    }
+
+    size_t rowsetSize = std::clamp<size_t>(BLOCK_FETCH_BUFFER_BYTES / rowWidth,
+                                           1, BLOCK_FETCH_MAX_ROWS);
+    SQLULEN rowsFetched = 0;
+    std::vector<SQLUSMALLINT> rowStatus(rowsetSize);
+    bool bound =
+        SQL_SUCCEEDED(SQLSetStmtAttr(stmt, SQL_ATTR_ROW_BIND_TYPE,
+                                     (SQLPOINTER)SQL_BIND_BY_COLUMN, 0)) &&
+        SQL_SUCCEEDED(SQLSetStmtAttr(stmt, SQL_ATTR_ROW_ARRAY_SIZE,
+                                     (SQLPOINTER)rowsetSize, 0)) &&
+        SQL_SUCCEEDED(SQLSetStmtAttr(stmt, SQL_ATTR_ROWS_FETCHED_PTR,
+                                     &rowsFetched, 0)) &&
+        SQL_SUCCEEDED(SQLSetStmtAttr(stmt, SQL_ATTR_ROW_STATUS_PTR,
+                                     rowStatus.data(), 0));
+    for (SQLSMALLINT i = 1; bound && i <= numCols; i++) {
+      BoundColumn &column = columns[static_cast<size_t>(i - 1)];
+      column.indicators.resize(rowsetSize);
+      SQLPOINTER target;
+      if (column.integer) {
+        column.integers.resize(rowsetSize);
+        target = column.integers.data();
+      } else {
+        column.text.resize(rowsetSize * static_cast<size_t>(column.width));
+        target = column.text.data();
+      }
+      bound = SQL_SUCCEEDED(SQLBindCol(
+          stmt, i, column.integer ? SQL_C_SBIGINT : SQL_C_CHAR, target,
+          column.width, column.indicators.data()));
+    }
+    if (!bound) {
+      unbindBlockCursor(stmt);
+      return BlockFetch::Unsupported;
+    }
+
+    batch.reserve(rowsetSize);
+    while (true) {
+      SQLRETURN ret = SQLFetch(stmt);
+      if (ret == SQL_NO_DATA)
+        return BlockFetch::Done;
+      if (ret != SQL_SUCCESS && ret != SQL_SUCCESS_WITH_INFO) {
+        SQLCHAR sqlState[6] = {0};
+        SQLCHAR errorMsg[SQL_MAX_MESSAGE_LENGTH] = {0};
+        SQLINTEGER nativeError = 0;
+        SQLSMALLINT msgLen = 0;
+        SQLGetDiagRec(SQL_HANDLE_STMT, stmt, 1, sqlState, &nativeError,
+                      errorMsg, sizeof(errorMsg), &msgLen);
+        Logger::error(LogCategory::TRANSFER, "fetchBlockCursor",
+                      "SQLFetch failed after " +
+                          std::to_string(batch.rowCount()) +
+                          " rows - SQLState: " +
+                          std::string((char *)sqlState) +
+                          ", Error: " + std::string((char *)errorMsg));
+        return BlockFetch::Failed;
+      }
+      for (SQLULEN row = 0; row < rowsFetched; row++) {
+        if (rowStatus[row] == SQL_ROW_NOROW)
+          continue;
+        if (rowStatus[row] == SQL_ROW_ERROR) {
+          Logger::error(LogCategory::TRANSFER, "fetchBlockCursor",
+                        "Driver reported an error for row " +
+                            std::to_string(batch.rowCount() + 1) +
+                            " of the result set");
+          return BlockFetch::Failed;
+        }
+        for (size_t c = 0; c < columns.size(); c++) {
+          const BoundColumn &column = columns[c];
+          SQLLEN len = column.indicators[row];
+          if (len == SQL_NULL_DATA) {
+            batch.appendNull(c);
+          } else if (column.integer) {
+            batch.append(c, std::to_string(column.integers[row]));
+          } else {
+            if (len == SQL_NO_TOTAL || len >= column.width) {
+              Logger::warning(LogCategory::TRANSFER, "fetchBlockCursor",
+                              "Value in column " + std::to_string(c + 1) +
+                                  " exceeds its bound buffer, reading the "
+                                  "result set row by row");
+              SQLFreeStmt(stmt, SQL_CLOSE);
+              unbindBlockCursor(stmt);
+              return BlockFetch::Truncated;
+            }
+            batch.append(c, column.text.data() + row * column.width,
+                         len > 0 ? static_cast<size_t>(len) : 0);
+          }
+        }
+        batch.finishRow();
+      }
+    }
+  }
+
+  // Executes a query and stores the result set column-major in batch, which
+  // is cleared first so its buffers are reused between calls. Result sets whose
+  // columns all have a bounded size are fetched with a column-wise block
+  // cursor; the others fall back to SQLGetData row by row, and so does a
+  // block-fetched result set with a value longer than its binding, which is
+  // executed again rather than loaded truncated. SQL NULL values
+  // (and values that cannot be read) are stored as NULL cells. Returns false
+  // if the query failed or its rows could not all be fetched, so callers can
+  // tell a failure from an empty result.
+  bool executeQueryMSSQL(SQLHDBC conn, const std::string &query,
+                         RowBatch &batch) {
+    batch.clear();
     if (!conn) {
       Logger::error(LogCategory::TRANSFER, "executeQueryMSSQL",
                     "No valid MSSQL connection");
-      return results;
+      return false;
     }
 
     SQLHSTMT stmt;
@@ -2393,11 +2876,14 @@ private:
     if (ret != SQL_SUCCESS) {
       Logger::error(LogCategory::TRANSFER, "executeQueryMSSQL",
                     "SQLAllocHandle(STMT) failed");
-      return results;
+      return false;
     }
 
-    ret = SQLExecDirect(stmt, (SQLCHAR *)query.c_str(), SQL_NTS);
-    if (ret != SQL_SUCCESS && ret != SQL_SUCCESS_WITH_INFO) {
+    auto execute = [&]() {
+      ret = SQLExecDirect(stmt, (SQLCHAR *)query.c_str(), SQL_NTS);
+      if (ret == SQL_SUCCESS || ret == SQL_SUCCESS_WITH_INFO)
+        return true;
+
       SQLCHAR sqlState[6];
       SQLCHAR errorMsg[SQL_MAX_MESSAGE_LENGTH];
       SQLINTEGER nativeError;
@@ -2412,62 +2898,81 @@ private:
               ", NativeError: " + std::to_string(nativeError) + ", Error: " +
               std::string((char *)errorMsg) + ", Query: " + query);
       SQLFreeHandle(SQL_HANDLE_STMT, stmt);
-      return results;
-    }
+      return false;
+    };
+    if (!execute())
+      return false;
 
     // Get number of columns
-    SQLSMALLINT numCols;
+    SQLSMALLINT numCols = 0;
     SQLNumResultCols(stmt, &numCols);
+    batch.reset(numCols > 0 ? static_cast<size_t>(numCols) : 0);
 
-    // Fetch rows
-    while (SQLFetch(stmt) == SQL_SUCCESS) {
-      std::vector<std::string> row;
+    BlockFetch blockFetch = numCols > 0
+                                ? fetchBlockCursor(stmt, numCols, batch)
+                                : BlockFetch::Unsupported;
+    if (blockFetch == BlockFetch::Done || blockFetch == BlockFetch::Failed) {
+      SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+      return blockFetch == BlockFetch::Done;
+    }
+    if (blockFetch == BlockFetch::Truncated) {
+      batch.clear();
+      if (!execute())
+        return false;
+    }
+
+    // Row-by-row fallback for result sets with long or unbounded columns, or
+    // with a value longer than the block cursor binding
+    char buffer[1024];
+    const SQLLEN pieceSize = static_cast<SQLLEN>(sizeof(buffer) - 1);
+    auto isTruncated = [&](SQLRETURN rc, SQLLEN len) {
+      return rc == SQL_SUCCESS_WITH_INFO &&
+             (len == SQL_NO_TOTAL || len > pieceSize);
+    };
+    SQLRETURN fetched = SQL_NO_DATA;
+    while (numCols > 0 && SQL_SUCCEEDED(fetched = SQLFetch(stmt))) {
       for (SQLSMALLINT i = 1; i <= numCols; i++) {
-        std::string value;
-        char buffer[1024];
+        size_t column = static_cast<size_t>(i - 1);
         SQLLEN len;
-        ret = SQLGetData(stmt, i, SQL_C_CHAR, buffer, sizeof(buffer) - 1, &len);
-        if (ret == SQL_SUCCESS || ret == SQL_SUCCESS_WITH_INFO) {
-          if (len == SQL_NULL_DATA) {
-            row.push_back("NULL");
+        ret = SQLGetData(stmt, i, SQL_C_CHAR, buffer, sizeof(buffer), &len);
+        if ((ret != SQL_SUCCESS && ret != SQL_SUCCESS_WITH_INFO) ||
+            len == SQL_NULL_DATA) {
+          batch.appendNull(column);
+          continue;
+        }
+        if (!isTruncated(ret, len)) {
+          batch.append(column, buffer, len > 0 ? len : 0);
+          continue;
+        }
+
+        // Long value: read the remaining pieces straight into the arena
+        batch.append(column, buffer, pieceSize);
+        while (true) {
+          ret = SQLGetData(stmt, i, SQL_C_CHAR, buffer, sizeof(buffer), &len);
+          if (ret != SQL_SUCCESS && ret != SQL_SUCCESS_WITH_INFO)
+            break;
+          if (isTruncated(ret, len)) {
+            batch.extend(column, buffer, pieceSize);
             continue;
           }
-          if (len > 0 && len < static_cast<SQLLEN>(sizeof(buffer) - 1)) {
-            buffer[len] = '\0';
-            value = std::string(buffer, len);
-          } else if (len >= static_cast<SQLLEN>(sizeof(buffer) - 1)) {
-            buffer[sizeof(buffer) - 1] = '\0';
-            value = std::string(buffer, sizeof(buffer) - 1);
-            SQLLEN remainingLen = len - (sizeof(buffer) - 1);
-            while (remainingLen > 0 &&
-                   (ret == SQL_SUCCESS || ret == SQL_SUCCESS_WITH_INFO)) {
-              SQLLEN chunkRead;
-              ret = SQLGetData(stmt, i, SQL_C_CHAR, buffer, sizeof(buffer) - 1,
-                               &chunkRead);
-              if (chunkRead > 0 &&
-                  chunkRead < static_cast<SQLLEN>(sizeof(buffer) - 1)) {
-                buffer[chunkRead] = '\0';
-                value += std::string(buffer, chunkRead);
-                remainingLen -= chunkRead;
-              } else if (chunkRead >= static_cast<SQLLEN>(sizeof(buffer) - 1)) {
-                buffer[sizeof(buffer) - 1] = '\0';
-                value += std::string(buffer, sizeof(buffer) - 1);
-                remainingLen -= (sizeof(buffer) - 1);
-              } else {
-                break;
-              }
-            }
-          }
-          row.push_back(value);
-        } else {
-          row.push_back("NULL");
+          if (len > 0)
+            batch.extend(column, buffer, len);
+          break;
         }
       }
-      results.push_back(row);
+      batch.finishRow();
+    }
+    if (numCols > 0 && fetched != SQL_NO_DATA) {
+      Logger::error(LogCategory::TRANSFER, "executeQueryMSSQL",
+                    "SQLFetch failed after " +
+                        std::to_string(batch.rowCount()) +
+                        " rows, Query: " + query);
+      SQLFreeHandle(SQL_HANDLE_STMT, stmt);
+      return false;
     }
 
     SQLFreeHandle(SQL_HANDLE_STMT, stmt);
-    return results;
+    return true;
   }
 };
 
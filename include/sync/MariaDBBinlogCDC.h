@@ -0,0 +1,120 @@
+#ifndef MARIADBBINLOGCDC_H
+#define MARIADBBINLOGCDC_H
+
+#include "sync/DatabaseToPostgresSync.h"
+#include "sync/ICDCHandler.h"
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mariadb_rpl.h>
+#include <mysql/mysql.h>
+#include <optional>
+#include <pqxx/pqxx>
+#include <string>
+#include <vector>
+
+// CDC for MariaDB sources that reads the server's row-based binlog as a
+// replication client instead of the ds_change_log triggers, so capturing a
+// change adds no work to the source transactions. A source opts in with
+// cdc=binlog in its connection string (binlog_server_id=N overrides the
+// replica server id the client registers with); the server needs log_bin,
+// binlog_format=ROW and binlog_row_image=FULL.
+//
+// Progress is a GTID position per table, kept in sync_metadata as
+// binlog_gtid_pos and captured before the table's full load. One stream per
+// server starts from the oldest position among its listening tables, applies
+// each committed transaction to the tables that have not seen it yet, and
+// saves positions only at transaction boundaries. A table without a position,
+// or whose position the server has purged from its binlogs, is reloaded.
+class MariaDBBinlogCDC : public DatabaseToPostgresSync, public ICDCHandler {
+public:
+  using ConnectionFactory = std::function<MYSQL *(const std::string &)>;
+
+  explicit MariaDBBinlogCDC(ConnectionFactory connect)
+      : connect_(std::move(connect)) {}
+
+  static bool usesBinlog(const std::string &connectionString);
+
+  // True for the tables syncSources() streams: listening CDC tables of
+  // binlog sources
+  static bool isStreamed(const TableInfo &table);
+
+  // @@gtid_binlog_pos of the server, or nothing if it cannot be read
+  static std::optional<std::string> currentPosition(MYSQL *mariadbConn);
+
+  // Streams the binlog of every server with tables for which isStreamed()
+  // holds, once per server
+  void syncSources(pqxx::connection &pgConn,
+                   const std::vector<TableInfo> &tables);
+
+  void processTableCDC(const TableInfo &table,
+                       pqxx::connection &pgConn) override;
+
+  bool supportsCDC() const override { return true; }
+  std::string getCDCMechanism() const override {
+    return "Row-based binlog (GTID)";
+  }
+
+protected:
+  std::string cleanValueForPostgres(const std::string &value,
+                                    const std::string &columnType) override;
+  ColumnConverter
+  compileColumnConverter(const std::string &columnType) override;
+
+private:
+  // Committed row changes buffered across all tables before they are
+  // applied and the positions saved
+  static constexpr size_t BINLOG_APPLY_BATCH_CHANGES = 10000;
+  // Server id the client registers with unless the source sets
+  // binlog_server_id; it must differ from every server and replica
+  static constexpr uint32_t DEFAULT_REPLICA_SERVER_ID = 1937008195;
+  // Error the server returns when a requested GTID is no longer in its
+  // binlogs
+  static constexpr unsigned int ER_MASTER_FATAL_ERROR_READING_BINLOG = 1236;
+
+  // domain_id -> (server_id, seq_no), the form of @@gtid_binlog_pos
+  using GtidPosition = std::map<uint32_t, std::pair<uint32_t, uint64_t>>;
+
+  struct RowChange {
+    char operation;
+    std::vector<std::string> values;
+  };
+
+  struct BinlogTable {
+    TableInfo info;
+    GtidPosition position;
+    std::vector<std::string> columnNames;
+    std::vector<std::string> columnTypes;
+    // Labels of ENUM and SET columns, which the binlog logs by index
+    std::vector<std::vector<std::string>> labels;
+    std::vector<bool> setColumns;
+    // Integer columns the binlog logs as signed values of the column width
+    std::vector<bool> unsignedColumns;
+    std::vector<std::string> pkColumns;
+    std::vector<size_t> pkPositions;
+    std::vector<RowChange> pending;
+    // Set once the binlog rows no longer fit the table: its changes are
+    // dropped, its position stays and it is sent back to FULL_LOAD
+    std::string reloadReason;
+  };
+
+  static GtidPosition parseGtidPosition(const std::string &position);
+  static std::string formatGtidPosition(const GtidPosition &position);
+
+  void streamSource(pqxx::connection &pgConn,
+                    const std::string &connectionString,
+                    const std::vector<TableInfo> &tables);
+  bool loadColumns(pqxx::connection &pgConn, BinlogTable &table);
+  std::vector<std::string> rowValues(const BinlogTable &table,
+                                     const MARIADB_RPL_ROW &row);
+  void applyPending(pqxx::connection &pgConn,
+                    std::map<std::string, BinlogTable> &tables,
+                    const GtidPosition &committed);
+  void requestFullLoad(pqxx::connection &pgConn,
+                       const std::vector<TableInfo> &tables,
+                       const std::string &reason);
+
+  ConnectionFactory connect_;
+};
+
+#endif
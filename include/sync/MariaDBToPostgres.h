@@ -3,14 +3,19 @@
 
 #include "catalog/catalog_manager.h"
 #include "engines/database_engine.h"
+#include "engines/mariadb_engine.h"
 #include "sync/DatabaseToPostgresSync.h"
 #include "sync/ICDCHandler.h"
+#include "sync/MariaDBBinlogCDC.h"
 #include "sync/SchemaSync.h"
 #include "sync/TableProcessorThreadPool.h"
+#include "sync/TableScheduler.h"
 #include <algorithm>
 #include <cctype>
 #include <chrono>
 #include <iostream>
+#include <limits>
+#include <memory>
 #include <mysql/mysql.h>
 #include <pqxx/pqxx>
 #include <set>
@@ -31,8 +36,20 @@ public:
   static std::unordered_map<std::string, std::string> dataTypeMap;
   static std::unordered_map<std::string, std::string> collationMap;
 
+  struct ColumnTraits {
+    bool binary = false;
+    bool dateLike = false;
+    std::string nullValue;
+  };
+
+  static ColumnTraits classifyColumnType(const std::string &columnType);
+  static std::string cleanValueWithTraits(const std::string &value,
+                                          const ColumnTraits &traits);
+
   std::string cleanValueForPostgres(const std::string &value,
                                     const std::string &columnType) override;
+  ColumnConverter
+  compileColumnConverter(const std::string &columnType) override;
 
   void processTableCDC(const DatabaseToPostgresSync::TableInfo &table,
                        pqxx::connection &pgConn) override;
@@ -44,6 +61,9 @@ public:
 
   std::vector<TableInfo> getActiveTables(pqxx::connection &pgConn);
 
+  void purgeChangeLog();
+  void readChangeLogs(pqxx::connection &pgConn);
+
   MYSQL *getMariaDBConnection(const std::string &connectionString) {
     // Validate connection string
     if (connectionString.empty()) {
@@ -240,7 +260,12 @@ public:
               "change_time),"
               "INDEX idx_ds_change_log_table_change (schema_name, "
               "table_name, change_id)) "
-              "ENGINE=InnoDB";
+              "ENGINE=InnoDB "
+              "PARTITION BY RANGE (change_id) (PARTITION p" +
+              std::to_string(CHANGE_LOG_PARTITION_CHANGES) +
+              " VALUES LESS THAN (" +
+              std::to_string(CHANGE_LOG_PARTITION_CHANGES) +
+              "), PARTITION pmax VALUES LESS THAN MAXVALUE)";
 
       if (mysql_query(setupConn, query.c_str())) {
         Logger::error(LogCategory::TRANSFER,
@@ -404,43 +429,56 @@ public:
             triggerSchema + "', '" + triggerTable + "', " + jsonObjectOld +
             ", " + rowDataOld + ")";
 
-        if (mysql_query(mariadbConn, createInsertTrigger.c_str())) {
-          Logger::error(
-              LogCategory::TRANSFER, "setupTableTargetMariaDBToPostgres",
-              "Failed to create insert trigger for " + triggerSchema + "." +
-                  triggerTable + ": " + std::string(mysql_error(mariadbConn)));
-        } else {
+        // Binlog sources capture changes without triggers; the old ones
+        // are dropped above
+        if (MariaDBBinlogCDC::usesBinlog(table.connection_string)) {
           Logger::info(LogCategory::TRANSFER,
                        "setupTableTargetMariaDBToPostgres",
-                       "Created insert trigger for " + triggerSchema + "." +
+                       "Binlog CDC for " + triggerSchema + "." +
                            triggerTable +
-                           (hasPK ? " (with PK)" : " (no PK, using hash)"));
-        }
-
-        if (mysql_query(mariadbConn, createUpdateTrigger.c_str())) {
-          Logger::error(
-              LogCategory::TRANSFER, "setupTableTargetMariaDBToPostgres",
-              "Failed to create update trigger for " + triggerSchema + "." +
-                  triggerTable + ": " + std::string(mysql_error(mariadbConn)));
+                           " - change log triggers not installed");
         } else {
-          Logger::info(LogCategory::TRANSFER,
-                       "setupTableTargetMariaDBToPostgres",
-                       "Created update trigger for " + triggerSchema + "." +
-                           triggerTable +
-                           (hasPK ? " (with PK)" : " (no PK, using hash)"));
-        }
+          if (mysql_query(mariadbConn, createInsertTrigger.c_str())) {
+            Logger::error(
+                LogCategory::TRANSFER, "setupTableTargetMariaDBToPostgres",
+                "Failed to create insert trigger for " + triggerSchema + "." +
+                    triggerTable + ": " +
+                    std::string(mysql_error(mariadbConn)));
+          } else {
+            Logger::info(LogCategory::TRANSFER,
+                         "setupTableTargetMariaDBToPostgres",
+                         "Created insert trigger for " + triggerSchema + "." +
+                             triggerTable +
+                             (hasPK ? " (with PK)" : " (no PK, using hash)"));
+          }
 
-        if (mysql_query(mariadbConn, createDeleteTrigger.c_str())) {
-          Logger::error(
-              LogCategory::TRANSFER, "setupTableTargetMariaDBToPostgres",
-              "Failed to create delete trigger for " + triggerSchema + "." +
-                  triggerTable + ": " + std::string(mysql_error(mariadbConn)));
-        } else {
-          Logger::info(LogCategory::TRANSFER,
-                       "setupTableTargetMariaDBToPostgres",
-                       "Created delete trigger for " + triggerSchema + "." +
-                           triggerTable +
-                           (hasPK ? " (with PK)" : " (no PK, using hash)"));
+          if (mysql_query(mariadbConn, createUpdateTrigger.c_str())) {
+            Logger::error(
+                LogCategory::TRANSFER, "setupTableTargetMariaDBToPostgres",
+                "Failed to create update trigger for " + triggerSchema + "." +
+                    triggerTable + ": " +
+                    std::string(mysql_error(mariadbConn)));
+          } else {
+            Logger::info(LogCategory::TRANSFER,
+                         "setupTableTargetMariaDBToPostgres",
+                         "Created update trigger for " + triggerSchema + "." +
+                             triggerTable +
+                             (hasPK ? " (with PK)" : " (no PK, using hash)"));
+          }
+
+          if (mysql_query(mariadbConn, createDeleteTrigger.c_str())) {
+            Logger::error(
+                LogCategory::TRANSFER, "setupTableTargetMariaDBToPostgres",
+                "Failed to create delete trigger for " + triggerSchema + "." +
+                    triggerTable + ": " +
+                    std::string(mysql_error(mariadbConn)));
+          } else {
+            Logger::info(LogCategory::TRANSFER,
+                         "setupTableTargetMariaDBToPostgres",
+                         "Created delete trigger for " + triggerSchema + "." +
+                             triggerTable +
+                             (hasPK ? " (with PK)" : " (no PK, using hash)"));
+          }
         }
 
         query = "SELECT COLUMN_NAME, DATA_TYPE, IS_NULLABLE, "
@@ -672,11 +710,36 @@ public:
                    "Found " + std::to_string(tables.size()) +
                        " active MariaDB tables to process");
 
+      // Listening CDC tables the change log read found no new changes for
+      // have nothing to do this cycle; those of binlog sources are synced
+      // here by one stream per server
+      readChangeLogs(pgConn);
+      binlogCDC_.syncSources(pgConn, tables);
+      keepDueTables("MariaDB", tables);
+      std::vector<TableInfo> dueTables = tables;
+      size_t idleTables = tables.size();
+      tables.erase(std::remove_if(tables.begin(), tables.end(),
+                                  [this](const TableInfo &t) {
+                                    return MariaDBBinlogCDC::isStreamed(t) ||
+                                           hasNoDispatchedChanges(
+                                               t.schema_name + "." +
+                                               t.table_name);
+                                  }),
+                   tables.end());
+      idleTables -= tables.size();
+      if (idleTables > 0) {
+        Logger::info(LogCategory::TRANSFER,
+                     "Skipping " + std::to_string(idleTables) +
+                         " MariaDB CDC tables without new changes or "
+                         "synced from the binlog");
+      }
+
       if (tables.empty()) {
         Logger::info(
             LogCategory::TRANSFER,
             "No active MariaDB tables found - skipping transfer cycle");
         shutdownParallelProcessing();
+        completeDueTables("MariaDB", dueTables);
         return;
       }
 
@@ -700,9 +763,13 @@ public:
                   return false;
                 });
 
-      // Process multiple tables in parallel (bounded by config)
+      // Process multiple tables in parallel (bounded by config); the rest
+      // stay due for the next pass
       size_t tablesCap = SyncConfig::getMaxTablesPerCycle();
       if (tablesCap > 0 && tables.size() > tablesCap) {
+        TableScheduler &scheduler = TableScheduler::forEngine("MariaDB");
+        for (size_t i = tablesCap; i < tables.size(); ++i)
+          scheduler.wake(tables[i].schema_name + "." + tables[i].table_name);
         tables.resize(tablesCap);
       }
 
@@ -755,6 +822,7 @@ public:
                        std::to_string(skipped) + ")");
 
       pool.waitForCompletion();
+      completeDueTables("MariaDB", dueTables);
 
       Logger::info(LogCategory::TRANSFER,
                    "Thread pool completed - Completed: " +
@@ -1118,13 +1186,25 @@ public:
         targetCount = 0;
       }
 
-      if (table.status == "FULL_LOAD" || table.status == "RESET") {
+      bool resumeFullLoad = resumesFullLoad(
+          pgConn, table, "MariaDB",
+          getPKColumnsFromCatalog(pgConn, table.schema_name, table.table_name));
+
+      if (resumeFullLoad) {
+        Logger::info(LogCategory::TRANSFER, "processTableParallel",
+                     "FULL_LOAD checkpoint found - resuming without truncate "
+                     "for " +
+                         table.schema_name + "." + table.table_name);
+      } else if (table.status == "FULL_LOAD" || table.status == "RESET") {
         Logger::info(
             LogCategory::TRANSFER, "processTableParallel",
             "FULL_LOAD/RESET detected - performing mandatory truncate for " +
                 table.schema_name + "." + table.table_name);
 
         try {
+          clearFullLoadCheckpoint(pgConn, table.schema_name, table.table_name,
+                                  "MariaDB");
+
           pqxx::work txn(pgConn);
           txn.exec("TRUNCATE TABLE \"" + lowerSchemaName + "\".\"" +
                    lowerTableNamePG + "\" CASCADE;");
@@ -1133,10 +1213,19 @@ public:
               pgConn, table.schema_name, table.table_name);
 
           if (pkStrategy == "CDC") {
+            // A binlog source resumes from the position captured before
+            // the copy; changes committed during it are applied again
+            std::string binlogPosition;
+            if (MariaDBBinlogCDC::usesBinlog(table.connection_string)) {
+              auto position = MariaDBBinlogCDC::currentPosition(mariadbConn);
+              if (position)
+                binlogPosition = ", 'binlog_gtid_pos', " + txn.quote(*position);
+            }
             txn.exec(
                 "UPDATE metadata.catalog SET sync_metadata = "
                 "COALESCE(sync_metadata, '{}'::jsonb) || "
-                "jsonb_build_object('last_change_id', 0) WHERE schema_name='" +
+                "jsonb_build_object('last_change_id', 0" +
+                binlogPosition + ") WHERE schema_name='" +
                 escapeSQL(table.schema_name) + "' AND table_name='" +
                 escapeSQL(table.table_name) + "' AND db_engine='MariaDB';");
             Logger::info(LogCategory::TRANSFER, "processTableParallel",
@@ -1177,8 +1266,11 @@ public:
         Logger::info(LogCategory::TRANSFER, "processTableParallel",
                      "CDC strategy detected for " + table.schema_name + "." +
                          table.table_name + " - processing changes only");
-        processTableCDC(tableKey, mariadbConn, table, pgConn, columnNames,
-                        columnTypes);
+        if (MariaDBBinlogCDC::usesBinlog(table.connection_string))
+          binlogCDC_.processTableCDC(table, pgConn);
+        else
+          processTableCDC(tableKey, mariadbConn, table, pgConn, columnNames,
+                          columnTypes);
 
         size_t finalCount = 0;
         try {
@@ -1229,6 +1321,8 @@ public:
       if (sourceCount < targetCount && pkStrategy != "PK" &&
           pkStrategy != "CDC") {
         try {
+          clearFullLoadCheckpoint(pgConn, table.schema_name, table.table_name,
+                                  "MariaDB");
           pqxx::work truncateTxn(pgConn);
           truncateTxn.exec("TRUNCATE TABLE \"" + lowerSchemaName + "\".\"" +
                            lowerTableNamePG + "\" CASCADE;");
@@ -1247,7 +1341,23 @@ public:
       Logger::info(LogCategory::TRANSFER, "processTableParallel",
                    "Proceeding with FULL_LOAD for " + table.schema_name + "." +
                        table.table_name);
-      dataFetcherThread(tableKey, mariadbConn, table, columnNames, columnTypes);
+      if (scheduleKeyRangeLoad(mariadbConn, pgConn, table, columnNames,
+                               columnTypes, sourceCount, targetCount,
+                               resumeFullLoad)) {
+        mysql_close(mariadbConn);
+        return;
+      }
+
+      if (!dataFetcherThread(tableKey, mariadbConn, table, columnNames,
+                             columnTypes, nullptr)) {
+        Logger::error(LogCategory::TRANSFER, "processTableParallel",
+                      "FULL_LOAD failed for " + tableKey +
+                          " - leaving it in FULL_LOAD to retry");
+        retryFullLoad(pgConn, table.schema_name, table.table_name, "MariaDB");
+        mysql_close(mariadbConn);
+        removeTableProcessingState(tableKey);
+        return;
+      }
 
       size_t finalTargetCount = 0;
       try {
@@ -1288,10 +1398,146 @@ public:
     }
   }
 
-  void dataFetcherThread(const std::string &tableKey, MYSQL *mariadbConn,
+  // Splits a large FULL_LOAD into ranges of the leading primary key column,
+  // cut at NTILE boundaries so skewed keys still give even ranges, and
+  // submits each range to the pool running this table so one big table can
+  // use every worker. Returns false, leaving the load to the caller, when the
+  // table is small, partly loaded, has no usable key or no pool is running.
+  bool scheduleKeyRangeLoad(MYSQL *mariadbConn, pqxx::connection &pgConn,
+                            const TableInfo &table,
+                            const std::vector<std::string> &columnNames,
+                            const std::vector<std::string> &columnTypes,
+                            size_t sourceCount, size_t targetCount,
+                            bool resumeFullLoad) {
+    TableProcessorThreadPool *pool = TableProcessorThreadPool::currentPool();
+    if (!pool || pool->totalWorkers() < 2 || resumeFullLoad ||
+        targetCount > 0 || sourceCount < SyncConfig::getRangeSplitMinRows())
+      return false;
+
+    std::vector<std::string> pkColumns =
+        getPKColumnsFromCatalog(pgConn, table.schema_name, table.table_name);
+    if (findKeyPositions(columnNames, pkColumns).empty())
+      return false;
+
+    std::string keyColumn = "`" + pkColumns[0] + "`";
+    std::vector<std::string> boundaries;
+    for (const auto &row : executeQueryMariaDB(
+             mariadbConn,
+             "SELECT MAX(" + keyColumn + ") FROM (SELECT " + keyColumn +
+                 ", NTILE(" + std::to_string(pool->totalWorkers()) +
+                 ") OVER (ORDER BY " + keyColumn + ") AS bucket FROM `" +
+                 table.schema_name + "`.`" + table.table_name +
+                 "`) b GROUP BY bucket ORDER BY bucket;")) {
+      if (!row.empty() && !row[0].empty() && row[0] != "NULL")
+        boundaries.push_back(row[0]);
+    }
+
+    std::vector<KeyRange> ranges = buildKeyRanges(boundaries);
+    if (ranges.size() < 2)
+      return false;
+
+    Logger::info(LogCategory::TRANSFER, "scheduleKeyRangeLoad",
+                 "Splitting FULL_LOAD of " + table.schema_name + "." +
+                     table.table_name + " into " +
+                     std::to_string(ranges.size()) + " key ranges");
+
+    auto progress = std::make_shared<KeyRangeProgress>();
+    progress->remaining = ranges.size();
+    for (const auto &range : ranges) {
+      bool submitted = pool->submitTask(
+          table, [this, columnNames, columnTypes, range,
+                  progress](const DatabaseToPostgresSync::TableInfo &t) {
+            loadKeyRange(t, columnNames, columnTypes, range, progress);
+          });
+      if (!submitted)
+        finishKeyRange(table, progress, false);
+    }
+    return true;
+  }
+
+  // Pool task loading one key range over its own MariaDB and PostgreSQL
+  // connections.
+  void loadKeyRange(const TableInfo &table,
+                    const std::vector<std::string> &columnNames,
+                    const std::vector<std::string> &columnTypes,
+                    const KeyRange &range,
+                    const std::shared_ptr<KeyRangeProgress> &progress) {
+    bool ok = false;
+    MYSQL *mariadbConn = getMariaDBConnection(table.connection_string);
+    if (mariadbConn) {
+      ok = dataFetcherThread(table.schema_name + "." + table.table_name,
+                             mariadbConn, table, columnNames, columnTypes,
+                             &range);
+      mysql_close(mariadbConn);
+    } else {
+      Logger::error(LogCategory::TRANSFER, "loadKeyRange",
+                    "Failed to get MariaDB connection for key range of " +
+                        table.schema_name + "." + table.table_name);
+    }
+    finishKeyRange(table, progress, ok);
+  }
+
+  // Records one finished key range. The last range of a table sets its final
+  // status: LISTENING_CHANGES with the loaded row count, or, if any range
+  // failed, an empty target back in FULL_LOAD so the next pass loads the
+  // table again.
+  void finishKeyRange(const TableInfo &table,
+                      const std::shared_ptr<KeyRangeProgress> &progress,
+                      bool ok) {
+    if (!ok)
+      progress->failed = true;
+    if (--progress->remaining > 0)
+      return;
+
+    std::string lowerSchemaName = table.schema_name;
+    std::transform(lowerSchemaName.begin(), lowerSchemaName.end(),
+                   lowerSchemaName.begin(), ::tolower);
+    std::string lowerTableName = table.table_name;
+    std::transform(lowerTableName.begin(), lowerTableName.end(),
+                   lowerTableName.begin(), ::tolower);
+
+    try {
+      pqxx::connection pgConn(DatabaseConfig::getPostgresConnectionString());
+      if (progress->failed) {
+        pqxx::work txn(pgConn);
+        txn.exec("TRUNCATE TABLE \"" + lowerSchemaName + "\".\"" +
+                 lowerTableName + "\" CASCADE;");
+        txn.commit();
+        retryFullLoad(pgConn, table.schema_name, table.table_name, "MariaDB");
+      } else {
+        size_t finalTargetCount = 0;
+        pqxx::work txn(pgConn);
+        auto res = txn.exec("SELECT COUNT(*) FROM \"" + lowerSchemaName +
+                            "\".\"" + lowerTableName + "\";");
+        if (!res.empty())
+          finalTargetCount = res[0][0].as<size_t>();
+        txn.commit();
+        updateStatus(pgConn, table.schema_name, table.table_name,
+                     "LISTENING_CHANGES", finalTargetCount);
+      }
+    } catch (const std::exception &e) {
+      Logger::error(LogCategory::TRANSFER, "finishKeyRange",
+                    "Error finalizing key range load for " +
+                        table.schema_name + "." + table.table_name + ": " +
+                        std::string(e.what()));
+    }
+
+    removeTableProcessingState(table.schema_name + "." + table.table_name);
+    Logger::info(LogCategory::TRANSFER,
+                 "Key range load completed for table " + table.schema_name +
+                     "." + table.table_name);
+  }
+
+  // Loads the table (or only the given key range of it) through the full load
+  // pipeline and returns false if writing a chunk failed. Whole-table loads
+  // checkpoint their position; range loads do not, since they only run on a
+  // fresh load.
+  bool dataFetcherThread(const std::string &tableKey, MYSQL *mariadbConn,
                          const TableInfo &table,
                          const std::vector<std::string> &columnNames,
-                         const std::vector<std::string> &columnTypes) {
+                         const std::vector<std::string> &columnTypes,
+                         const KeyRange *range) {
+    bool ok = true;
     try {
       size_t chunkNumber = 0;
       const size_t CHUNK_SIZE = SyncConfig::getChunkSize();
@@ -1305,15 +1551,66 @@ public:
       std::vector<std::string> pkColumns =
           getPKColumnsFromCatalog(pgConn, table.schema_name, table.table_name);
 
-      bool hasMoreData = true;
       size_t lastProcessedOffset = 0;
 
-      while (hasMoreData) {
-        chunkNumber++;
+      // Tables with a primary key are paged by seeking past the last key of
+      // the previous chunk instead of OFFSET, which re-scans every earlier
+      // row. The last key is checkpointed so an interrupted load resumes.
+      std::vector<size_t> keyPositions =
+          findKeyPositions(columnNames, pkColumns);
+      bool useKeyset = !keyPositions.empty();
+      bool checkpointed = useKeyset && !range;
+      std::vector<std::string> lastKey;
+      if (checkpointed) {
+        lastKey = loadFullLoadCheckpoint(pgConn, table.schema_name,
+                                         table.table_name, "MariaDB",
+                                         pkColumns);
+        if (!lastKey.empty()) {
+          Logger::info(LogCategory::TRANSFER, "dataFetcherThread",
+                       "Resuming FULL_LOAD from checkpoint for " +
+                           table.schema_name + "." + table.table_name);
+        }
+      }
+
+      std::vector<std::string> quotedKeyColumns;
+      for (const auto &pkColumn : pkColumns)
+        quotedKeyColumns.push_back("`" + pkColumn + "`");
+
+      std::string rangePredicate;
+      if (range && useKeyset)
+        rangePredicate =
+            buildKeyRangePredicate(quotedKeyColumns[0], *range,
+                                   KeyLiteralStyle::BackslashEscapes);
+
+      std::string lowerSchemaName = table.schema_name;
+      std::transform(lowerSchemaName.begin(), lowerSchemaName.end(),
+                     lowerSchemaName.begin(), ::tolower);
 
+      // Each chunk query runs as a prepared statement, so values arrive in
+      // the binary protocol, and its rows are streamed to the pipeline in
+      // batches of at most FULL_LOAD_STREAM_BATCH_ROWS while earlier batches
+      // are converted and written. Client memory is bounded by the batch
+      // size rather than by the chunk size. The checkpoint only advances
+      // once a batch is written. Keyset chunks after the first re-execute
+      // one statement with the last key bound to its placeholders.
+      const size_t batchRows =
+          std::min(CHUNK_SIZE, FULL_LOAD_STREAM_BATCH_ROWS);
+      auto chunkQuery = [&](bool seek) {
         std::string selectQuery = "SELECT * FROM `" + table.schema_name +
                                   "`.`" + table.table_name + "`";
 
+        std::string wherePredicate = rangePredicate;
+        if (seek) {
+          std::vector<std::string> placeholders(quotedKeyColumns.size(),
+                                                "?");
+          if (!wherePredicate.empty())
+            wherePredicate += " AND ";
+          wherePredicate +=
+              buildKeysetPredicate(quotedKeyColumns, placeholders);
+        }
+        if (!wherePredicate.empty())
+          selectQuery += " WHERE " + wherePredicate;
+
         if (!pkColumns.empty()) {
           selectQuery += " ORDER BY ";
           for (size_t i = 0; i < pkColumns.size(); ++i) {
@@ -1323,85 +1620,116 @@ public:
           }
         }
 
-        selectQuery += " LIMIT " + std::to_string(CHUNK_SIZE) + " OFFSET " +
-                       std::to_string(lastProcessedOffset) + ";";
+        selectQuery += " LIMIT " + std::to_string(CHUNK_SIZE);
+        if (!useKeyset)
+          selectQuery += " OFFSET " + std::to_string(lastProcessedOffset);
+        return selectQuery + ";";
+      };
+
+      std::unique_ptr<MariaDBStatement> seekStatement;
+      std::unique_ptr<MariaDBStatement> scanStatement;
+      MariaDBStatement *stream = nullptr;
+      size_t streamedRows = 0;
+      auto fetchChunk = [&](RowBatch &batch,
+                            std::vector<std::string> &chunkKey) {
+        if (!stream) {
+          chunkNumber++;
 
-        Logger::info(LogCategory::TRANSFER, "dataFetcherThread",
-                     "Executing query for chunk " +
-                         std::to_string(chunkNumber) + " on " +
-                         table.schema_name + "." + table.table_name);
+          Logger::info(LogCategory::TRANSFER, "dataFetcherThread",
+                       "Executing query for chunk " +
+                           std::to_string(chunkNumber) + " on " +
+                           table.schema_name + "." + table.table_name);
 
-        std::vector<std::vector<std::string>> results =
-            executeQueryMariaDB(mariadbConn, selectQuery);
+          // buildKeysetPredicate repeats the leading key values in every
+          // OR branch, so branch i binds lastKey[0..i]
+          std::vector<std::string> params;
+          if (useKeyset && !lastKey.empty()) {
+            if (!seekStatement)
+              seekStatement = std::make_unique<MariaDBStatement>(
+                  mariadbConn, chunkQuery(true));
+            for (size_t i = 0; i < lastKey.size(); ++i)
+              params.insert(params.end(), lastKey.begin(),
+                            lastKey.begin() + i + 1);
+            stream = seekStatement.get();
+          } else {
+            scanStatement = std::make_unique<MariaDBStatement>(
+                mariadbConn, chunkQuery(false));
+            stream = scanStatement.get();
+          }
+          if (!stream->execute(params))
+            throw std::runtime_error("Query failed: " + stream->error());
+          streamedRows = 0;
+        }
 
+        size_t rows = stream->fetchBatch(batch, batchRows);
+        if (stream->failed())
+          throw std::runtime_error("Result fetch failed: " + stream->error());
+
+        streamedRows += rows;
+        lastProcessedOffset += rows;
+        if (rows > 0 && useKeyset) {
+          lastKey.clear();
+          for (size_t position : keyPositions)
+            lastKey.emplace_back(batch.value(rows - 1, position));
+          if (checkpointed)
+            chunkKey = lastKey;
+        }
+
+        if (rows == batchRows && streamedRows < CHUNK_SIZE)
+          return true;
+
+        stream->freeResult();
+        stream = nullptr;
         Logger::info(LogCategory::TRANSFER, "dataFetcherThread",
-                     "Retrieved " + std::to_string(results.size()) +
+                     "Retrieved " + std::to_string(streamedRows) +
                          " rows for chunk " + std::to_string(chunkNumber) +
                          " on " + table.schema_name + "." + table.table_name);
 
-        if (results.empty()) {
+        if (streamedRows < CHUNK_SIZE) {
           Logger::info(LogCategory::TRANSFER, "dataFetcherThread",
-                       "No more data to fetch for " + table.schema_name + "." +
-                           table.table_name);
-          hasMoreData = false;
-          break;
-        }
-
-        try {
-          std::string lowerSchemaName = table.schema_name;
-          std::transform(lowerSchemaName.begin(), lowerSchemaName.end(),
-                         lowerSchemaName.begin(), ::tolower);
-
-          performBulkUpsert(pgConn, results, columnNames, columnTypes,
-                            lowerSchemaName, table.table_name,
-                            table.schema_name);
-
-          Logger::info(LogCategory::TRANSFER,
-                       "Successfully processed chunk " +
-                           std::to_string(chunkNumber) + " with " +
-                           std::to_string(results.size()) + " rows for " +
-                           table.schema_name + "." + table.table_name);
-
-          lastProcessedOffset += results.size();
-
-          if (results.size() < CHUNK_SIZE) {
-            Logger::info(LogCategory::TRANSFER, "dataFetcherThread",
-                         "Retrieved " + std::to_string(results.size()) +
-                             " rows (less than chunk size " +
-                             std::to_string(CHUNK_SIZE) +
-                             ") - ending data transfer");
-            hasMoreData = false;
-          }
-        } catch (const std::exception &e) {
-          std::string errorMsg = e.what();
-          Logger::error(LogCategory::TRANSFER, "dataFetcherThread",
-                        "CRITICAL ERROR: Bulk upsert failed for chunk " +
-                            std::to_string(chunkNumber) + " in table " +
-                            table.schema_name + "." + table.table_name + ": " +
-                            errorMsg);
-
-          if (errorMsg.find("current transaction is aborted") !=
-                  std::string::npos ||
-              errorMsg.find("previously aborted") != std::string::npos ||
-              errorMsg.find("aborted transaction") != std::string::npos) {
-            Logger::error(LogCategory::TRANSFER, "dataFetcherThread",
-                          "Transaction abort detected - breaking loop");
-            hasMoreData = false;
-            break;
-          }
+                       "Retrieved " + std::to_string(streamedRows) +
+                           " rows (less than chunk size " +
+                           std::to_string(CHUNK_SIZE) +
+                           ") - ending data transfer");
+          return false;
         }
-      }
+        return true;
+      };
 
+      auto chunkWritten = [&](pqxx::connection &writerConn,
+                              const PreparedBatch &written) {
+        Logger::info(LogCategory::TRANSFER,
+                     "Successfully processed chunk " +
+                         std::to_string(written.chunkNumber) + " with " +
+                         std::to_string(written.batchSize) + " rows for " +
+                         table.schema_name + "." + table.table_name);
+        if (checkpointed && !written.lastKey.empty())
+          saveFullLoadCheckpoint(writerConn, table.schema_name,
+                                 table.table_name, "MariaDB", pkColumns,
+                                 written.lastKey);
+      };
+
+      ok = runFullLoadPipeline(lowerSchemaName, table.table_name,
+                               table.schema_name, columnNames, columnTypes,
+                               fetchChunk, chunkWritten);
+      if (ok && checkpointed)
+        clearFullLoadCheckpoint(pgConn, table.schema_name, table.table_name,
+                                "MariaDB");
     } catch (const std::exception &e) {
       Logger::error(LogCategory::TRANSFER, "dataFetcherThread",
                     "Error in data fetcher thread: " + std::string(e.what()));
+      ok = false;
     }
+    return ok;
   }
 
   void batchPreparerThread(const std::vector<std::string> &columnNames,
                            const std::vector<std::string> &columnTypes) {
 
     try {
+      std::vector<ColumnConverter> converters =
+          buildConverterPlan(columnTypes);
+
       while (true) {
         DataChunk chunk;
         if (!rawDataQueue.pop(chunk, std::chrono::milliseconds(1000))) {
@@ -1422,10 +1750,10 @@ public:
         // Prepare batches from raw data
         const size_t BATCH_SIZE = SyncConfig::getChunkSize();
 
-        for (size_t batchStart = 0; batchStart < chunk.rawData.size();
+        const RowBatch &rows = chunk.rows;
+        for (size_t batchStart = 0; batchStart < rows.rowCount();
              batchStart += BATCH_SIZE) {
-          size_t batchEnd =
-              std::min(batchStart + BATCH_SIZE, chunk.rawData.size());
+          size_t batchEnd = std::min(batchStart + BATCH_SIZE, rows.rowCount());
 
           PreparedBatch preparedBatch;
           preparedBatch.chunkNumber = chunk.chunkNumber;
@@ -1469,20 +1797,19 @@ public:
             if (i > batchStart)
               valuesClause += ", ";
 
-            const auto &row = chunk.rawData[i];
-            if (row.size() != columnNames.size())
+            if (rows.columnCount() != columnNames.size())
               continue;
 
             valuesClause += "(";
-            for (size_t j = 0; j < row.size(); ++j) {
+            for (size_t j = 0; j < columnNames.size(); ++j) {
               if (j > 0)
                 valuesClause += ", ";
 
-              if (row[j].empty()) {
+              if (rows.isNull(i, j) || rows.value(i, j).empty()) {
                 valuesClause += "NULL";
               } else {
                 std::string cleanValue =
-                    cleanValueForPostgres(row[j], columnTypes[j]);
+                    converters[j](std::string(rows.value(i, j)));
                 if (cleanValue == "NULL") {
                   valuesClause += "NULL";
                 } else {
@@ -1502,7 +1829,7 @@ public:
         Logger::info(LogCategory::TRANSFER,
                      "Prepared batches for chunk " +
                          std::to_string(chunk.chunkNumber) + " (" +
-                         std::to_string(chunk.rawData.size()) + " rows)");
+                         std::to_string(rows.rowCount()) + " rows)");
       }
 
     } catch (const std::exception &e) {
@@ -1557,6 +1884,27 @@ public:
   }
 
 private:
+  MariaDBBinlogCDC binlogCDC_{[this](const std::string &connectionString) {
+    return getMariaDBConnection(connectionString);
+  }};
+
+  // Rows per batch handed from a streamed FULL_LOAD chunk query to the
+  // pipeline; bounds the client memory held per table.
+  static constexpr size_t FULL_LOAD_STREAM_BATCH_ROWS = 5000;
+  // change_id span of one ds_change_log partition, and the most partitions
+  // added ahead of the newest change per purge cycle
+  static constexpr long long CHANGE_LOG_PARTITION_CHANGES = 1000000;
+  static constexpr int CHANGE_LOG_MAX_NEW_PARTITIONS = 16;
+  // lock_wait_timeout of the partition DDL, which runs on its own
+  // connection
+  static constexpr int CHANGE_LOG_DDL_LOCK_WAIT_SECONDS = 5;
+
+  size_t purgeChangeLogRows(MYSQL *mariadbConn, const std::string &schemaName,
+                            const std::string &tableName,
+                            long long appliedChangeId);
+  bool rotateChangeLogPartitions(MYSQL *mariadbConn, long long appliedChangeId,
+                                 size_t &droppedRows);
+
   std::string escapeSQL(const std::string &value) {
     if (value.empty()) {
       return value;
@@ -1580,6 +1928,15 @@ private:
                        const std::vector<std::string> &columnNames,
                        const std::vector<std::string> &columnTypes);
 
+  std::optional<size_t> refetchRowsByKey(
+      MYSQL *mariadbConn, const TableInfo &table,
+      const std::vector<std::string> &pkColumns,
+      const std::vector<std::string> &columnNames,
+      const std::vector<std::vector<std::string>> &keys,
+      std::unordered_map<std::string, std::unique_ptr<MariaDBStatement>>
+          &statements,
+      std::vector<std::vector<std::string>> &records);
+
   std::vector<std::string> getPrimaryKeyColumns(MYSQL *mariadbConn,
                                                 const std::string &schema_name,
                                                 const std::string &table_name) {
@@ -1628,42 +1985,37 @@ private:
 
   std::vector<std::vector<std::string>>
   executeQueryMariaDB(MYSQL *conn, const std::string &query) {
-    std::vector<std::vector<std::string>> results;
+    RowBatch batch;
+    executeQueryMariaDB(conn, query, batch);
+    return batch.toRows();
+  }
+
+  // Executes a query and stores the result set column-major in batch, which
+  // is cleared first so its buffers are reused between calls. Rows are streamed
+  // straight into the batch without a client-side copy of the result set.
+  // Values are copied with their exact lengths (binary safe) and SQL NULL is
+  // kept as a NULL cell.
+  void executeQueryMariaDB(MYSQL *conn, const std::string &query,
+                           RowBatch &batch) {
+    batch.clear();
     if (!conn) {
       Logger::warning(LogCategory::TRANSFER, "No valid MariaDB connection");
-      return results;
+      return;
     }
 
-    if (mysql_query(conn, query.c_str())) {
-      Logger::warning(
-          LogCategory::TRANSFER,
-          "Query execution failed: " + std::string(mysql_error(conn)) +
-              " for query: " + query.substr(0, 100) + "...");
-      return results;
+    MariaDBResultStream stream(conn, query);
+    if (!stream.isValid()) {
+      Logger::warning(LogCategory::TRANSFER,
+                      "Query execution failed: " + stream.error() +
+                          " for query: " + query.substr(0, 100) + "...");
+      return;
     }
 
-    MYSQL_RES *res = mysql_store_result(conn);
-    if (!res) {
-      if (mysql_field_count(conn) > 0) {
-        Logger::warning(LogCategory::TRANSFER,
-                        "mysql_store_result() failed: " +
-                            std::string(mysql_error(conn)));
-      }
-      return results;
-    }
-
-    unsigned int num_fields = mysql_num_fields(res);
-    MYSQL_ROW row;
-    while ((row = mysql_fetch_row(res))) {
-      std::vector<std::string> rowData;
-      rowData.reserve(num_fields);
-      for (unsigned int i = 0; i < num_fields; ++i) {
-        rowData.push_back(row[i] ? row[i] : "");
-      }
-      results.push_back(rowData);
+    stream.fetchBatch(batch, std::numeric_limits<size_t>::max());
+    if (stream.failed()) {
+      Logger::warning(LogCategory::TRANSFER,
+                      "Result fetch failed: " + stream.error());
     }
-    mysql_free_result(res);
-    return results;
   }
 
   // NUEVA FUNCIÓN: Verificar consistencia real de datos
@@ -7,12 +7,18 @@
 #include "sync/ICDCHandler.h"
 #include "sync/TableProcessorThreadPool.h"
 #include <algorithm>
+#include <atomic>
 #include <bson/bson.h>
 #include <chrono>
+#include <functional>
+#include <memory>
 #include <mongoc/mongoc.h>
+#include <mutex>
+#include <optional>
 #include <pqxx/pqxx>
 #include <sstream>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -25,27 +31,80 @@ public:
   static constexpr int LOG_INTERVAL = 10000;
   static constexpr size_t MONGODB_BATCH_SIZE = 10000;
   static constexpr int SYNC_INTERVAL_HOURS = 24;
+  // _id values sampled per range when a large collection is split
+  static constexpr size_t ID_SAMPLES_PER_RANGE = 64;
+  // Changes applied per CDC transaction, and how long a change stream may
+  // wait for events before the position is checkpointed anyway
+  static constexpr size_t CHANGE_STREAM_BATCH_SIZE = 500;
+  static constexpr int64_t CHANGE_STREAM_AWAIT_MS = 1000;
+  static constexpr int CHANGE_STREAM_CHECKPOINT_SECONDS = 60;
+  // Server errors meaning the resume token can no longer be used
+  static constexpr uint32_t CHANGE_STREAM_HISTORY_LOST = 286;
+  static constexpr uint32_t CHANGE_STREAM_FATAL_ERROR = 280;
 
   MongoDBToPostgres() = default;
-  ~MongoDBToPostgres() { shutdownParallelProcessing(); }
+  ~MongoDBToPostgres() {
+    stopContinuousChangeStreams();
+    shutdownParallelProcessing();
+  }
 
   static std::unordered_map<std::string, std::string> dataTypeMap;
 
+  struct ColumnTraits {
+    std::string nullValue;
+    bool json = false;
+  };
+
+  static ColumnTraits classifyColumnType(const std::string &columnType);
+  static std::string cleanValueWithTraits(const std::string &value,
+                                          const ColumnTraits &traits);
+
   std::string cleanValueForPostgres(const std::string &value,
                                     const std::string &columnType) override;
+  ColumnConverter
+  compileColumnConverter(const std::string &columnType) override;
 
   void transferDataMongoDBToPostgresParallel();
   void setupTableTargetMongoDBToPostgres();
+  void stopContinuousChangeStreams();
 
 private:
   bool shouldSyncCollection(pqxx::connection &pgConn,
                             const std::string &schema_name,
                             const std::string &table_name);
   void truncateAndLoadCollection(const TableInfo &tableInfo);
-  std::vector<std::vector<std::string>>
-  fetchCollectionData(const TableInfo &tableInfo);
+  size_t loadCollection(const TableInfo &tableInfo,
+                        const std::string &lowerSchemaName,
+                        const std::string &lowerTableName,
+                        const std::vector<std::string> &fields,
+                        const std::vector<std::string> &validFields,
+                        const std::vector<std::string> &fieldTypes,
+                        const std::vector<size_t> &fieldIndexes,
+                        size_t &documents);
+  size_t streamCollectionToTable(const TableInfo &tableInfo,
+                                 const std::string &lowerSchemaName,
+                                 const std::string &lowerTableName,
+                                 const std::vector<std::string> &fields,
+                                 const std::vector<std::string> &validFields,
+                                 const std::vector<std::string> &fieldTypes,
+                                 const std::vector<size_t> &fieldIndexes,
+                                 const bson_t *filter, size_t budgetBytes,
+                                 size_t &documents);
+  void writePreparedBatch(pqxx::connection &pgConn,
+                          const PreparedBatch &batch,
+                          const std::vector<std::string> &columnNames,
+                          const std::vector<std::string> &columnTypes,
+                          const std::string &lowerSchemaName,
+                          const std::string &tableName,
+                          const std::string &sourceSchemaName) override;
+  void writeCollectionBatch(pqxx::connection &pgConn,
+                            const std::string &fullTableName,
+                            const std::vector<std::string> &validFields,
+                            const std::vector<std::string> &fieldTypes,
+                            const RowBatch &rows);
   void
-  convertBSONToPostgresRow(bson_t *doc, const std::vector<std::string> &fields,
+  convertBSONToPostgresRow(const bson_t *doc,
+                           const std::vector<std::string> &fields,
                            std::vector<std::string> &row,
                            std::unordered_map<std::string, int> &fieldIndexMap);
   std::string inferPostgreSQLType(const bson_value_t *value);
@@ -63,6 +122,24 @@ private:
                           const std::string &table_name);
   void processTableCDC(const DatabaseToPostgresSync::TableInfo &table,
                        pqxx::connection &pgConn) override;
+  void runChangeStream(const TableInfo &table, pqxx::connection &pgConn,
+                       bool continuous);
+  std::string loadResumeToken(pqxx::connection &pgConn,
+                              const TableInfo &table);
+  void saveResumeToken(pqxx::transaction_base &txn, const TableInfo &table,
+                       const std::string &token, size_t changes);
+  std::string captureResumeToken(const TableInfo &table);
+  bool isContinuousChangeStream(pqxx::connection &pgConn,
+                                const TableInfo &table);
+  void ensureContinuousChangeStream(const TableInfo &table);
+
+  struct ContinuousChangeStream {
+    std::thread thread;
+    std::shared_ptr<std::atomic<bool>> finished;
+  };
+  std::mutex changeStreamMutex;
+  std::unordered_map<std::string, ContinuousChangeStream> changeStreams;
+  std::atomic<bool> stopChangeStreams{false};
 
   bool supportsCDC() const override { return true; }
   std::string getCDCMechanism() const override {
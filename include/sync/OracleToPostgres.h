@@ -28,8 +28,19 @@ public:
 
   static std::unordered_map<std::string, std::string> dataTypeMap;
 
+  struct ColumnTraits {
+    bool dateLike = false;
+    std::string nullValue;
+  };
+
+  static ColumnTraits classifyColumnType(const std::string &columnType);
+  static std::string cleanValueWithTraits(const std::string &value,
+                                          const ColumnTraits &traits);
+
   std::string cleanValueForPostgres(const std::string &value,
                                     const std::string &columnType) override;
+  ColumnConverter
+  compileColumnConverter(const std::string &columnType) override;
 
   std::unique_ptr<OCIConnection>
   getOracleConnection(const std::string &connectionString);
@@ -37,6 +48,7 @@ public:
   std::vector<TableInfo> getActiveTables(pqxx::connection &pgConn);
 
   void setupTableTargetOracleToPostgres();
+  void purgeChangeLog();
   void transferDataOracleToPostgres();
   void transferDataOracleToPostgresParallel();
 
@@ -50,9 +62,30 @@ public:
   }
 
 private:
+  // Array fetch sizing: up to ORACLE_FETCH_MAX_ROWS rows per OCIStmtFetch2,
+  // bounded by ORACLE_FETCH_BUFFER_BYTES of define buffers. CLOB and BLOB
+  // values are read through their locators ORACLE_LOB_PIECE_BYTES at a time;
+  // a LONG value longer than ORACLE_FETCH_MAX_VALUE_BYTES fails the fetch.
+  static constexpr size_t ORACLE_FETCH_MAX_ROWS = 2048;
+  static constexpr size_t ORACLE_FETCH_BUFFER_BYTES = 8 * 1024 * 1024;
+  static constexpr ub4 ORACLE_FETCH_MAX_VALUE_BYTES = 65535;
+  static constexpr size_t ORACLE_LOB_PIECE_BYTES = 256 * 1024;
+
   std::vector<std::vector<std::string>>
   executeQueryOracle(OCIConnection *conn, const std::string &query);
 
+  // Executes a query and stores the result set column-major in batch, which
+  // is cleared first. Rows are array-fetched with buffers sized from the
+  // describe metadata; NUMBER integers, DATE and TIMESTAMP columns are
+  // fetched natively and formatted as PostgreSQL literals. Returns false if
+  // the query or a fetch failed.
+  bool executeQueryOracle(OCIConnection *conn, const std::string &query,
+                          RowBatch &batch);
+
+  size_t purgeChangeLogRows(OCIConnection *conn, const std::string &schemaName,
+                            const std::string &tableName,
+                            long long appliedChangeId);
+
   void updateStatus(pqxx::connection &pgConn, const std::string &schema_name,
                     const std::string &table_name, const std::string &status,
                     size_t rowCount = 0);
@@ -65,6 +98,8 @@ private:
   // Helper function to safely escape and validate Oracle identifiers/values
   static std::string escapeOracleValue(const std::string &value);
   static bool isValidOracleIdentifier(const std::string &identifier);
+  static std::string oracleKeyLiteral(const std::string &value,
+                                      const std::string &dataType);
 };
 
 #endif
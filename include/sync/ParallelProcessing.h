@@ -1,54 +1,166 @@
 #ifndef PARALLELPROCESSING_H
 #define PARALLELPROCESSING_H
 
+#include "sync/RowBatch.h"
+#include <algorithm>
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <cstdint>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <string>
+#include <thread>
 #include <vector>
 
-// Thread-safe queue template
+// Wait counters shared by the pipeline queues. Producer waits are time spent
+// blocked on a full queue (the downstream stage is the bottleneck), consumer
+// waits are time spent on an empty queue (the upstream stage is).
+struct QueueWaitStats {
+  size_t producerWaits = 0;
+  size_t consumerWaits = 0;
+  size_t rejectedPushes = 0;
+  std::chrono::nanoseconds producerWaitTime{0};
+  std::chrono::nanoseconds consumerWaitTime{0};
+};
+
+class QueueWaitCounters {
+private:
+  std::atomic<size_t> producerWaits_{0};
+  std::atomic<size_t> consumerWaits_{0};
+  std::atomic<size_t> rejectedPushes_{0};
+  std::atomic<int64_t> producerWaitNs_{0};
+  std::atomic<int64_t> consumerWaitNs_{0};
+
+public:
+  void addProducerWait(std::chrono::steady_clock::duration waited) {
+    producerWaits_.fetch_add(1, std::memory_order_relaxed);
+    producerWaitNs_.fetch_add(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(waited).count(),
+        std::memory_order_relaxed);
+  }
+
+  void addConsumerWait(std::chrono::steady_clock::duration waited) {
+    consumerWaits_.fetch_add(1, std::memory_order_relaxed);
+    consumerWaitNs_.fetch_add(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(waited).count(),
+        std::memory_order_relaxed);
+  }
+
+  void addRejectedPush() {
+    rejectedPushes_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  QueueWaitStats snapshot() const {
+    QueueWaitStats stats;
+    stats.producerWaits = producerWaits_.load(std::memory_order_relaxed);
+    stats.consumerWaits = consumerWaits_.load(std::memory_order_relaxed);
+    stats.rejectedPushes = rejectedPushes_.load(std::memory_order_relaxed);
+    stats.producerWaitTime = std::chrono::nanoseconds(
+        producerWaitNs_.load(std::memory_order_relaxed));
+    stats.consumerWaitTime = std::chrono::nanoseconds(
+        consumerWaitNs_.load(std::memory_order_relaxed));
+    return stats;
+  }
+
+  void reset() {
+    producerWaits_ = 0;
+    consumerWaits_ = 0;
+    rejectedPushes_ = 0;
+    producerWaitNs_ = 0;
+    consumerWaitNs_ = 0;
+  }
+};
+
+// Thread-safe bounded queue. Producers block while the queue is full instead
+// of dropping items, so a slow consumer throttles the stages feeding it.
+// push() only gives up once the queue is shut down; tryPush() gives up after a
+// timeout and leaves the item with the caller.
 template <typename T> class ThreadSafeQueue {
 private:
   mutable std::mutex mtx;
   std::queue<T> queue;
   std::condition_variable cv;
+  std::condition_variable notFull;
   std::atomic<bool> shutdown{false};
   size_t maxSize_{10000};
+  QueueWaitCounters counters_;
+
+  // Waits on notFull until there is room or the queue is shut down. Returns
+  // false on shutdown or when the deadline passes.
+  bool waitForSpace(std::unique_lock<std::mutex> &lock,
+                    const std::chrono::steady_clock::time_point *deadline) {
+    if (queue.size() < maxSize_ && !shutdown)
+      return true;
+
+    auto waitStart = std::chrono::steady_clock::now();
+    auto hasSpace = [this] { return queue.size() < maxSize_ || shutdown; };
+    bool ready = true;
+    if (deadline)
+      ready = notFull.wait_until(lock, *deadline, hasSpace);
+    else
+      notFull.wait(lock, hasSpace);
+    counters_.addProducerWait(std::chrono::steady_clock::now() - waitStart);
+    return ready && !shutdown;
+  }
+
+  bool takeFront(T &item) {
+    if (queue.empty())
+      return false;
+    item = std::move(queue.front());
+    queue.pop();
+    notFull.notify_one();
+    return true;
+  }
 
 public:
   explicit ThreadSafeQueue(size_t maxSize = 10000) : maxSize_(maxSize) {}
 
-  void push(T item) {
-    std::lock_guard<std::mutex> lock(mtx);
-    if (queue.size() >= maxSize_) {
+  bool push(T item) {
+    std::unique_lock<std::mutex> lock(mtx);
+    if (!waitForSpace(lock, nullptr)) {
+      counters_.addRejectedPush();
       Logger::warning(LogCategory::TRANSFER, "ThreadSafeQueue",
-                      "Queue is full, dropping item");
-      return;
+                      "Queue is shut down, dropping item");
+      return false;
     }
     queue.push(std::move(item));
     cv.notify_one();
+    return true;
+  }
+
+  bool tryPush(T &item, std::chrono::milliseconds timeout) {
+    std::unique_lock<std::mutex> lock(mtx);
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    if (!waitForSpace(lock, &deadline)) {
+      counters_.addRejectedPush();
+      return false;
+    }
+    queue.push(std::move(item));
+    cv.notify_one();
+    return true;
   }
 
   bool pop(T &item,
            std::chrono::milliseconds timeout = std::chrono::milliseconds(100)) {
     std::unique_lock<std::mutex> lock(mtx);
-    if (cv.wait_for(lock, timeout,
-                    [this] { return !queue.empty() || shutdown; })) {
-      if (!queue.empty()) {
-        item = std::move(queue.front());
-        queue.pop();
-        return true;
-      }
-    }
-    return false;
+    if (takeFront(item))
+      return true;
+
+    auto waitStart = std::chrono::steady_clock::now();
+    cv.wait_for(lock, timeout, [this] { return !queue.empty() || shutdown; });
+    counters_.addConsumerWait(std::chrono::steady_clock::now() - waitStart);
+    return takeFront(item);
   }
 
   void shutdown_queue() {
-    shutdown = true;
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      shutdown = true;
+    }
     cv.notify_all();
+    notFull.notify_all();
   }
 
   void finish() { shutdown_queue(); }
@@ -56,9 +168,12 @@ public:
   void reset_queue() { shutdown = false; }
 
   void clear() {
-    std::lock_guard<std::mutex> lock(mtx);
-    std::queue<T> empty;
-    queue.swap(empty);
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      std::queue<T> empty;
+      queue.swap(empty);
+    }
+    notFull.notify_all();
   }
 
   size_t size() const {
@@ -71,28 +186,219 @@ public:
     return queue.empty();
   }
 
+  size_t capacity() const { return maxSize_; }
+
+  QueueWaitStats waitStats() const { return counters_.snapshot(); }
+  void resetWaitStats() { counters_.reset(); }
+
   bool popBlocking(T &item) {
     std::unique_lock<std::mutex> lock(mtx);
+    if (takeFront(item))
+      return true;
+
+    auto waitStart = std::chrono::steady_clock::now();
     cv.wait(lock, [this] { return !queue.empty() || shutdown; });
+    counters_.addConsumerWait(std::chrono::steady_clock::now() - waitStart);
+    return takeFront(item);
+  }
+};
+
+// Lock-free bounded multi-producer/multi-consumer ring buffer with the same
+// interface as ThreadSafeQueue. Every slot carries a sequence number that
+// tells producers and consumers whether it is free or filled for their lap
+// around the ring, so enqueue and dequeue are a single CAS on the shared
+// position in the uncontended case. The capacity is rounded up to a power of
+// two. Blocked producers and consumers spin briefly, then back off with
+// short sleeps; it is meant for the coarse chunk/batch hand-offs between the
+// fetch, prepare and insert stages where items arrive every few
+// milliseconds, not for fine-grained messaging.
+template <typename T> class LockFreeRingQueue {
+private:
+  struct Slot {
+    std::atomic<size_t> sequence{0};
+    T value{};
+  };
 
-    if (queue.empty()) {
+  static size_t roundUpToPowerOfTwo(size_t value) {
+    size_t result = 2;
+    while (result < value)
+      result <<= 1;
+    return result;
+  }
+
+  const size_t capacity_;
+  const size_t mask_;
+  std::unique_ptr<Slot[]> slots_;
+  alignas(64) std::atomic<size_t> enqueuePos_{0};
+  alignas(64) std::atomic<size_t> dequeuePos_{0};
+  std::atomic<bool> shutdown_{false};
+  QueueWaitCounters counters_;
+
+  bool tryEnqueue(T &item) {
+    size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    while (true) {
+      Slot &slot = slots_[pos & mask_];
+      size_t seq = slot.sequence.load(std::memory_order_acquire);
+      intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+      if (diff == 0) {
+        if (enqueuePos_.compare_exchange_weak(pos, pos + 1,
+                                              std::memory_order_relaxed)) {
+          slot.value = std::move(item);
+          slot.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = enqueuePos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  bool tryDequeue(T &item) {
+    size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+    while (true) {
+      Slot &slot = slots_[pos & mask_];
+      size_t seq = slot.sequence.load(std::memory_order_acquire);
+      intptr_t diff =
+          static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+      if (diff == 0) {
+        if (dequeuePos_.compare_exchange_weak(pos, pos + 1,
+                                              std::memory_order_relaxed)) {
+          item = std::move(slot.value);
+          slot.value = T{};
+          slot.sequence.store(pos + mask_ + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = dequeuePos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Spins for the first few rounds, then sleeps with a doubling interval
+  // capped at one millisecond.
+  static void backoff(size_t round) {
+    if (round < 16) {
+      std::this_thread::yield();
+      return;
+    }
+    size_t shift = std::min<size_t>(round - 16, 5);
+    std::this_thread::sleep_for(std::chrono::microseconds(32u << shift));
+  }
+
+  // Retries op until it succeeds, the queue is shut down or the deadline
+  // passes. Returns the result of the last attempt; time spent retrying is
+  // reported through onWait.
+  template <typename Op, typename OnWait>
+  bool retry(Op op, const std::chrono::steady_clock::time_point *deadline,
+             OnWait onWait) {
+    if (op())
+      return true;
+
+    auto waitStart = std::chrono::steady_clock::now();
+    bool done = false;
+    for (size_t round = 0; !done; ++round) {
+      if (shutdown_.load(std::memory_order_acquire) ||
+          (deadline && std::chrono::steady_clock::now() >= *deadline))
+        break;
+      backoff(round);
+      done = op();
+    }
+    onWait(std::chrono::steady_clock::now() - waitStart);
+    return done;
+  }
+
+public:
+  explicit LockFreeRingQueue(size_t maxSize = 1024)
+      : capacity_(roundUpToPowerOfTwo(maxSize)), mask_(capacity_ - 1),
+        slots_(new Slot[capacity_]) {
+    for (size_t i = 0; i < capacity_; ++i)
+      slots_[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  LockFreeRingQueue(const LockFreeRingQueue &) = delete;
+  LockFreeRingQueue &operator=(const LockFreeRingQueue &) = delete;
+
+  bool push(T item) {
+    if (shutdown_.load(std::memory_order_acquire) ||
+        !retry([&] { return tryEnqueue(item); }, nullptr,
+               [this](auto waited) { counters_.addProducerWait(waited); })) {
+      counters_.addRejectedPush();
+      Logger::warning(LogCategory::TRANSFER, "LockFreeRingQueue",
+                      "Queue is shut down, dropping item");
       return false;
     }
+    return true;
+  }
 
-    item = std::move(queue.front());
-    queue.pop();
+  bool tryPush(T &item, std::chrono::milliseconds timeout) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    if (shutdown_.load(std::memory_order_acquire) ||
+        !retry([&] { return tryEnqueue(item); }, &deadline,
+               [this](auto waited) { counters_.addProducerWait(waited); })) {
+      counters_.addRejectedPush();
+      return false;
+    }
     return true;
   }
+
+  // Items that were queued before shutdown are still handed out, matching
+  // ThreadSafeQueue.
+  bool pop(T &item,
+           std::chrono::milliseconds timeout = std::chrono::milliseconds(100)) {
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    return retry([&] { return tryDequeue(item); }, &deadline,
+                 [this](auto waited) { counters_.addConsumerWait(waited); }) ||
+           (shutdown_.load(std::memory_order_acquire) && tryDequeue(item));
+  }
+
+  bool popBlocking(T &item) {
+    return retry([&] { return tryDequeue(item); }, nullptr,
+                 [this](auto waited) { counters_.addConsumerWait(waited); }) ||
+           tryDequeue(item);
+  }
+
+  void shutdown_queue() { shutdown_.store(true, std::memory_order_release); }
+
+  void finish() { shutdown_queue(); }
+
+  void reset_queue() { shutdown_.store(false, std::memory_order_release); }
+
+  // Drains the ring. Like ThreadSafeQueue::clear this is meant to be called
+  // while no producers are active.
+  void clear() {
+    T item;
+    while (tryDequeue(item)) {
+    }
+  }
+
+  size_t size() const {
+    size_t enqueued = enqueuePos_.load(std::memory_order_acquire);
+    size_t dequeued = dequeuePos_.load(std::memory_order_acquire);
+    return enqueued > dequeued ? enqueued - dequeued : 0;
+  }
+
+  bool empty() const { return size() == 0; }
+
+  size_t capacity() const { return capacity_; }
+
+  QueueWaitStats waitStats() const { return counters_.snapshot(); }
+  void resetWaitStats() { counters_.reset(); }
 };
 
 // Common data structures for parallel processing
 namespace ParallelProcessing {
 struct DataChunk {
-  std::vector<std::vector<std::string>> rawData;
+  RowBatch rows;
   size_t chunkNumber;
   std::string schemaName;
   std::string tableName;
   bool isLastChunk = false;
+  // Key of the last row, checkpointed once the chunk has been written
+  std::vector<std::string> lastKey;
 };
 
 struct PreparedBatch {
@@ -101,6 +407,11 @@ struct PreparedBatch {
   size_t chunkNumber;
   std::string schemaName;
   std::string tableName;
+  // Full load pipeline: values already cleaned for PostgreSQL, plus the
+  // source values for the UPSERT fallback
+  RowBatch rows;
+  RowBatch sourceRows;
+  std::vector<std::string> lastKey;
 };
 
 struct ProcessedResult {
@@ -0,0 +1,121 @@
+#ifndef POSTGRESTOPOSTGRES_H
+#define POSTGRESTOPOSTGRES_H
+
+#include "sync/DatabaseToPostgresSync.h"
+#include "sync/ICDCHandler.h"
+#include <cstdint>
+#include <libpq-fe.h>
+#include <map>
+#include <pqxx/pqxx>
+#include <string>
+#include <vector>
+
+// Sync from PostgreSQL sources. The initial copy of a table pipes COPY ... TO
+// STDOUT on the source straight into COPY ... FROM STDIN on the target, so
+// rows are never parsed; after that, changes are streamed from a logical
+// replication slot with the pgoutput plugin. Connection strings are libpq
+// conninfo strings; the source must run with wal_level=logical and its user
+// needs the REPLICATION attribute.
+//
+// Each source database gets one slot (REPLICATION_SLOT followed by the
+// database name) and one publication (PUBLICATION) that setup adds the
+// catalog's tables to. Progress is an LSN per table, kept in sync_metadata
+// as pg_lsn and read before the table's copy starts; a change is applied to
+// a table only if its transaction committed after that LSN. The slot is
+// confirmed up to the lowest LSN of its tables, so the source keeps the WAL
+// they still need.
+class PostgresToPostgres : public DatabaseToPostgresSync, public ICDCHandler {
+public:
+  PostgresToPostgres() = default;
+
+  std::vector<TableInfo> getActiveTables(pqxx::connection &pgConn);
+
+  void setupTableTargetPostgresToPostgres();
+  void transferDataPostgresToPostgres();
+
+  void processTableCDC(const DatabaseToPostgresSync::TableInfo &table,
+                       pqxx::connection &pgConn) override;
+
+  bool supportsCDC() const override { return true; }
+  std::string getCDCMechanism() const override {
+    return "Logical replication (pgoutput)";
+  }
+
+protected:
+  // Values are read in PostgreSQL's own text format, which the target
+  // accepts as is
+  std::string cleanValueForPostgres(const std::string &value,
+                                    const std::string &columnType) override {
+    return value;
+  }
+
+private:
+  static constexpr const char *REPLICATION_SLOT = "datasync_slot";
+  static constexpr const char *PUBLICATION = "datasync_pub";
+  // Committed row changes buffered across all tables of a source before
+  // they are applied and the positions saved
+  static constexpr size_t STREAM_APPLY_BATCH_CHANGES = 10000;
+  // A stream that has caught up with the source ends after this long
+  // without messages
+  static constexpr int STREAM_IDLE_TIMEOUT_SECONDS = 5;
+  // Microseconds between the Unix and PostgreSQL epochs (2000-01-01)
+  static constexpr int64_t POSTGRES_EPOCH_OFFSET_USEC = 946684800000000LL;
+
+  struct RowChange {
+    char operation;
+    std::vector<std::string> values;
+    // An update that left out unchanged TOASTed values and carried no old
+    // row to take them from; the row is re-read from the source instead
+    bool incomplete = false;
+  };
+
+  struct StreamTable {
+    TableInfo info;
+    uint64_t position = 0;
+    std::vector<std::string> sourceColumnNames;
+    // Target column names (lowercased) and types, in source column order
+    std::vector<std::string> columnNames;
+    std::vector<std::string> columnTypes;
+    std::vector<std::string> pkColumns;
+    std::vector<size_t> pkPositions;
+    // For each column of the last Relation message, its position in
+    // columnNames, or -1 for a column the target does not have
+    std::vector<int> relationColumns;
+    std::vector<RowChange> pending;
+    // Truncated or altered on the source; reloaded instead of streamed
+    bool reload = false;
+  };
+
+  static uint64_t parseLsn(const std::string &lsn);
+  static std::string formatLsn(uint64_t lsn);
+  static std::string quoteIdentifier(const std::string &identifier);
+  static std::string slotName(const std::string &database);
+  static std::string replicationConninfo(const std::string &connectionString);
+
+  bool prepareSource(pqxx::connection &sourceConn,
+                     const std::vector<TableInfo> &tables);
+  bool createTargetTable(pqxx::connection &pgConn,
+                         pqxx::connection &sourceConn, const TableInfo &table);
+  bool loadColumns(pqxx::connection &pgConn, pqxx::connection &sourceConn,
+                   StreamTable &table);
+
+  void copyTable(pqxx::connection &pgConn, const TableInfo &table);
+  bool pipeCopy(PGconn *source, PGconn *target, const std::string &copyOut,
+                const std::string &copyIn, size_t &rows, std::string &error);
+
+  void streamSource(pqxx::connection &pgConn,
+                    const std::string &connectionString,
+                    const std::vector<TableInfo> &tables);
+  void applyPending(pqxx::connection &pgConn, pqxx::connection &sourceConn,
+                    std::map<std::string, StreamTable> &tables,
+                    uint64_t committed);
+  size_t refetchRows(pqxx::connection &sourceConn, const StreamTable &table,
+                     const std::vector<std::vector<std::string>> &keys,
+                     std::vector<std::vector<std::string>> &records);
+  bool sendFeedback(PGconn *replication, uint64_t flushed);
+
+  void requestFullLoad(pqxx::connection &pgConn, const TableInfo &table,
+                       const std::string &reason);
+};
+
+#endif
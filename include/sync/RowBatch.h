@@ -0,0 +1,146 @@
+#ifndef ROWBATCH_H
+#define ROWBATCH_H
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace ParallelProcessing {
+
+// Column-major batch of rows used by the transfer pipeline. Every column keeps
+// its values back to back in a single byte arena, an offsets array with one
+// entry per row boundary and a null bitmap, so a chunk costs a handful of
+// allocations per column instead of one per cell. clear() and reset() with
+// an unchanged column count keep the reserved capacity, which lets fetchers
+// reuse one batch for every chunk of a table; fewer columns free the arenas
+// of the dropped ones.
+//
+// Rows are built left to right with append()/appendNull() and closed with
+// finishRow(); columns that were not filled for the current row are stored as
+// NULL.
+class RowBatch {
+public:
+  RowBatch() = default;
+  explicit RowBatch(size_t columnCount) { reset(columnCount); }
+
+  void reset(size_t columnCount) {
+    columns_.resize(columnCount);
+    for (auto &column : columns_) {
+      column.data.clear();
+      column.offsets.assign(1, 0);
+      column.nulls.clear();
+    }
+    rowCount_ = 0;
+  }
+
+  void clear() { reset(columns_.size()); }
+
+  void reserve(size_t rows, size_t bytesPerValue = 16) {
+    for (auto &column : columns_) {
+      column.data.reserve(rows * bytesPerValue);
+      column.offsets.reserve(rows + 1);
+      column.nulls.reserve((rows + 63) / 64);
+    }
+  }
+
+  size_t columnCount() const { return columns_.size(); }
+  size_t rowCount() const { return rowCount_; }
+  bool empty() const { return rowCount_ == 0; }
+
+  void append(size_t column, const char *data, size_t length) {
+    Column &col = columns_[column];
+    col.data.append(data, length);
+    col.offsets.push_back(col.data.size());
+  }
+
+  void append(size_t column, std::string_view value) {
+    append(column, value.data(), value.size());
+  }
+
+  // Appends bytes to the value currently being built for column; used by
+  // fetchers that receive long values in pieces. The value must have been
+  // opened with append() for the current row.
+  void extend(size_t column, const char *data, size_t length) {
+    Column &col = columns_[column];
+    col.data.append(data, length);
+    col.offsets.back() = col.data.size();
+  }
+
+  void appendNull(size_t column) {
+    Column &col = columns_[column];
+    size_t row = col.offsets.size() - 1;
+    if (col.nulls.size() <= row / 64)
+      col.nulls.resize(row / 64 + 1, 0);
+    col.nulls[row / 64] |= (uint64_t{1} << (row % 64));
+    col.offsets.push_back(col.data.size());
+  }
+
+  void finishRow() {
+    for (size_t i = 0; i < columns_.size(); ++i) {
+      while (columns_[i].offsets.size() < rowCount_ + 2)
+        appendNull(i);
+    }
+    ++rowCount_;
+  }
+
+  void appendRow(const std::vector<std::string> &row) {
+    for (size_t i = 0; i < row.size() && i < columns_.size(); ++i)
+      append(i, row[i]);
+    finishRow();
+  }
+
+  bool isNull(size_t row, size_t column) const {
+    const Column &col = columns_[column];
+    return row / 64 < col.nulls.size() &&
+           (col.nulls[row / 64] >> (row % 64)) & 1;
+  }
+
+  std::string_view value(size_t row, size_t column) const {
+    const Column &col = columns_[column];
+    return std::string_view(col.data.data() + col.offsets[row],
+                            col.offsets[row + 1] - col.offsets[row]);
+  }
+
+  // Materializes the batch as rows of strings for code paths that still work
+  // on std::vector<std::vector<std::string>>. NULL values are rendered as
+  // nullValue.
+  std::vector<std::vector<std::string>>
+  toRows(const std::string &nullValue = "") const {
+    std::vector<std::vector<std::string>> rows(rowCount_);
+    for (size_t r = 0; r < rowCount_; ++r) {
+      rows[r].reserve(columns_.size());
+      for (size_t c = 0; c < columns_.size(); ++c) {
+        if (isNull(r, c))
+          rows[r].push_back(nullValue);
+        else
+          rows[r].emplace_back(value(r, c));
+      }
+    }
+    return rows;
+  }
+
+  size_t memoryUsage() const {
+    size_t bytes = 0;
+    for (const auto &column : columns_) {
+      bytes += column.data.capacity();
+      bytes += column.offsets.capacity() * sizeof(size_t);
+      bytes += column.nulls.capacity() * sizeof(uint64_t);
+    }
+    return bytes;
+  }
+
+private:
+  struct Column {
+    std::string data;
+    std::vector<size_t> offsets{0};
+    std::vector<uint64_t> nulls;
+  };
+
+  std::vector<Column> columns_;
+  size_t rowCount_ = 0;
+};
+
+} // namespace ParallelProcessing
+
+#endif // ROWBATCH_H
@@ -14,6 +14,7 @@
 #include "sync/MariaDBToPostgres.h"
 #include "sync/MongoDBToPostgres.h"
 #include "sync/OracleToPostgres.h"
+#include "sync/PostgresToPostgres.h"
 #include <atomic>
 #include <chrono>
 #include <condition_variable>
@@ -44,6 +45,7 @@ private:
   MSSQLToPostgres mssqlToPg;
   MongoDBToPostgres mongoToPg;
   OracleToPostgres oracleToPg;
+  PostgresToPostgres pgToPg;
   APIToDatabaseSync apiToDb;
   std::unique_ptr<CustomJobExecutor> customJobExecutor;
   CatalogManager catalogManager;
@@ -56,8 +58,10 @@ private:
   void mssqlTransferThread();
   void mongoTransferThread();
   void oracleTransferThread();
+  void postgresTransferThread();
   void apiTransferThread();
   void customJobsSchedulerThread();
+  void syncNotificationThread();
   void qualityThread();
   void maintenanceThread();
   void monitoringThread();
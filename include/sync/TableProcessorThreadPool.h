@@ -5,7 +5,9 @@
 #include "sync/DatabaseToPostgresSync.h"
 #include "sync/ParallelProcessing.h"
 #include <atomic>
+#include <condition_variable>
 #include <functional>
+#include <mutex>
 #include <thread>
 #include <vector>
 
@@ -24,11 +26,21 @@ private:
   std::atomic<bool> shutdown_{false};
   std::atomic<bool> monitoringEnabled_{false};
   std::thread monitoringThread_;
-  size_t totalTasksSubmitted_{0};
+  std::atomic<size_t> totalTasksSubmitted_{0};
   std::chrono::steady_clock::time_point startTime_;
 
+  // Tasks submitted but not finished yet, including the ones a running task
+  // submits for itself; waitForCompletion() waits for this to reach zero.
+  size_t outstandingTasks_{0};
+  std::mutex outstandingMutex_;
+  std::condition_variable outstandingCv_;
+
+  static thread_local TableProcessorThreadPool *currentPool_;
+
   void workerThread(size_t workerId);
   void monitoringThreadFunc();
+  void runTask(TableTask &task, const std::string &worker);
+  void finishTask();
 
 public:
   explicit TableProcessorThreadPool(size_t numWorkers);
@@ -38,10 +50,14 @@ public:
   TableProcessorThreadPool &
   operator=(const TableProcessorThreadPool &) = delete;
 
-  void submitTask(const DatabaseToPostgresSync::TableInfo &table,
+  bool submitTask(const DatabaseToPostgresSync::TableInfo &table,
                   std::function<void(const DatabaseToPostgresSync::TableInfo &)>
                       processor);
 
+  // Pool whose worker is running the calling thread, or nullptr outside of
+  // a pool. Lets a table task split itself into more tasks.
+  static TableProcessorThreadPool *currentPool() { return currentPool_; }
+
   void waitForCompletion();
   void shutdown();
   void enableMonitoring(bool enable = true);
@@ -51,7 +67,7 @@ public:
   size_t failedTasks() const { return failedTasks_.load(); }
   size_t pendingTasks() const { return tasks_.size(); }
   size_t totalWorkers() const { return workers_.size(); }
-  size_t totalTasksSubmitted() const { return totalTasksSubmitted_; }
+  size_t totalTasksSubmitted() const { return totalTasksSubmitted_.load(); }
   double getTasksPerSecond() const;
 };
 
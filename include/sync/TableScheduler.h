@@ -0,0 +1,94 @@
+#ifndef TABLESCHEDULER_H
+#define TABLESCHEDULER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Decides when each table of an engine is synced next, so a transfer pass
+// only runs the tables that are due instead of polling every table at the
+// same cadence. Tables are kept in a queue ordered by their next run. Each
+// has its own interval, which starts at the transfer cadence (baseInterval),
+// halves after a run that applied changes and doubles after one that found
+// none, within MIN_INTERVAL_MS and MAX_BACKOFF_FACTOR times the cadence. A
+// run that applied at least a chunk of rows left the table behind, so it is
+// due again at once. Tables that are loading keep the cadence.
+//
+// Signals make tables due regardless of their interval: the change log read
+// of a pass wakes the tables it found rows for, and a NOTIFY on
+// NOTIFY_CHANNEL wakes an engine (payload "MariaDB"), one of its tables
+// ("MariaDB:sales.orders") or every engine (empty payload).
+class TableScheduler {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  static constexpr const char *NOTIFY_CHANNEL = "datasync_sync";
+
+  // The scheduler of a db_engine, created on first use
+  static TableScheduler &forEngine(const std::string &dbEngine);
+
+  // Wakes the schedulers a NOTIFY_CHANNEL payload names
+  static void notify(const std::string &payload);
+
+  // Ends every waitUntilDue() in progress, for shutdown
+  static void interruptAll();
+
+  // max(5, sync_interval/4) seconds, the cadence of the transfer threads
+  static std::chrono::milliseconds baseInterval();
+
+  // Makes tableKeys (schema.table) the tracked tables: new ones are due at
+  // once, tables no longer listed are dropped
+  void track(const std::vector<std::string> &tableKeys);
+
+  // True if the table is due, which starts its run; the next run is then
+  // one interval away until completed() reschedules it. Untracked tables
+  // are always due.
+  bool claim(const std::string &tableKey);
+
+  // Counts rows CDC applied to the table towards its current run
+  void recordChanges(const std::string &tableKey, size_t rows);
+
+  // Ends the table's run and schedules the next from the rows it applied
+  void completed(const std::string &tableKey, bool loading);
+
+  // Makes the table due now, or right after its current run
+  void wake(const std::string &tableKey);
+  void wakeAll();
+
+  // Returns once a table is due, on wake() of an untracked table or
+  // interrupt(), and at the latest after baseInterval()
+  void waitUntilDue();
+  void interrupt();
+
+private:
+  static constexpr int64_t MIN_INTERVAL_MS = 1000;
+  static constexpr int64_t MAX_BACKOFF_FACTOR = 16;
+
+  struct TableState {
+    std::chrono::milliseconds interval{0};
+    Clock::time_point nextRun;
+    size_t changes = 0;
+    bool running = false;
+    // Woken while running
+    bool woken = false;
+  };
+
+  void schedule(const std::string &tableKey, TableState &state,
+                Clock::time_point nextRun);
+
+  std::mutex mutex_;
+  std::condition_variable wakeup_;
+  std::unordered_map<std::string, TableState> tables_;
+  // (next run, table key) of every tracked table, earliest first
+  std::set<std::pair<Clock::time_point, std::string>> queue_;
+  bool signaled_ = false;
+};
+
+#endif
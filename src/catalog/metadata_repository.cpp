@@ -172,6 +172,11 @@ void MetadataRepository::insertOrUpdateTable(
           existing[0][0].is_null() ? "" : existing[0][0].as<std::string>();
       std::string currentPKStrategy =
           existing[0][1].is_null() ? "" : existing[0][1].as<std::string>();
+      // SQL Server tables can be switched to the server's own change capture,
+      // which is still a CDC strategy
+      if (dbEngine == "MSSQL" && (currentPKStrategy == "CHANGE_TRACKING" ||
+                                  currentPKStrategy == "NATIVE_CDC"))
+        pkStrategy = currentPKStrategy;
       if (currentPKColumns != pkColumnsJSON ||
           currentPKStrategy != pkStrategy) {
         txn.exec_params("UPDATE metadata.catalog SET "
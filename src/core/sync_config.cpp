@@ -11,3 +11,9 @@ std::atomic<size_t> SyncConfig::SYNC_INTERVAL_SECONDS =
 std::atomic<size_t> SyncConfig::MAX_WORKERS = SyncConfig::DEFAULT_MAX_WORKERS;
 std::atomic<size_t> SyncConfig::MAX_TABLES_PER_CYCLE =
     SyncConfig::DEFAULT_MAX_TABLES_PER_CYCLE;
+std::atomic<size_t> SyncConfig::RANGE_SPLIT_MIN_ROWS =
+    SyncConfig::DEFAULT_RANGE_SPLIT_MIN_ROWS;
+std::atomic<size_t> SyncConfig::MONGO_CURSOR_BATCH_SIZE =
+    SyncConfig::DEFAULT_MONGO_CURSOR_BATCH_SIZE;
+std::atomic<size_t> SyncConfig::MONGO_MEMORY_BUDGET_MB =
+    SyncConfig::DEFAULT_MONGO_MEMORY_BUDGET_MB;
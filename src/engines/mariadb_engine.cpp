@@ -1,7 +1,9 @@
 #include "engines/mariadb_engine.h"
 #include "sync/MariaDBToPostgres.h"
 #include <algorithm>
+#include <charconv>
 #include <chrono>
+#include <cstdio>
 #include <pqxx/pqxx>
 #include <thread>
 #include <unordered_set>
@@ -112,38 +114,276 @@ void MariaDBEngine::setConnectionTimeouts(MYSQL *conn) {
   }
 }
 
+MariaDBResultStream::MariaDBResultStream(MYSQL *conn, const std::string &query)
+    : conn_(conn) {
+  if (!conn_ || mysql_real_query(conn_, query.data(), query.size())) {
+    failed_ = true;
+    return;
+  }
+  res_ = mysql_use_result(conn_);
+  if (res_)
+    numFields_ = mysql_num_fields(res_);
+  else
+    failed_ = mysql_field_count(conn_) > 0;
+}
+
+MariaDBResultStream::~MariaDBResultStream() {
+  if (res_)
+    mysql_free_result(res_);
+}
+
+MYSQL_ROW MariaDBResultStream::fetchRow() {
+  if (!res_)
+    return nullptr;
+  MYSQL_ROW row = mysql_fetch_row(res_);
+  if (!row && mysql_errno(conn_) != 0)
+    failed_ = true;
+  return row;
+}
+
+size_t MariaDBResultStream::fetchBatch(ParallelProcessing::RowBatch &batch,
+                                       size_t maxRows) {
+  batch.reset(numFields_);
+  size_t rows = 0;
+  MYSQL_ROW row;
+  while (rows < maxRows && (row = fetchRow())) {
+    unsigned long *fieldLengths = lengths();
+    for (unsigned int i = 0; i < numFields_; ++i) {
+      if (row[i])
+        batch.append(i, row[i], fieldLengths[i]);
+      else
+        batch.appendNull(i);
+    }
+    batch.finishRow();
+    ++rows;
+  }
+  return rows;
+}
+
+MariaDBStatement::MariaDBStatement(MYSQL *conn, const std::string &query) {
+  if (!conn)
+    return;
+  stmt_ = mysql_stmt_init(conn);
+  if (!stmt_ || mysql_stmt_prepare(stmt_, query.data(), query.size())) {
+    failed_ = true;
+    return;
+  }
+
+  MYSQL_RES *metadata = mysql_stmt_result_metadata(stmt_);
+  if (!metadata) {
+    prepared_ = true;
+    return;
+  }
+  unsigned int numFields = mysql_num_fields(metadata);
+  MYSQL_FIELD *fields = mysql_fetch_fields(metadata);
+  columns_.resize(numFields);
+  resultBinds_.assign(numFields, MYSQL_BIND{});
+  for (unsigned int i = 0; i < numFields; ++i) {
+    ResultColumn &column = columns_[i];
+    MYSQL_BIND &bind = resultBinds_[i];
+    column.type = fields[i].type;
+    bind.is_null = &column.isNull;
+    bind.length = &column.length;
+    bind.error = &column.error;
+
+    switch (fields[i].type) {
+    case MYSQL_TYPE_TINY:
+    case MYSQL_TYPE_SHORT:
+    case MYSQL_TYPE_INT24:
+    case MYSQL_TYPE_LONG:
+    case MYSQL_TYPE_LONGLONG:
+    case MYSQL_TYPE_YEAR:
+      column.kind = (fields[i].flags & UNSIGNED_FLAG)
+                        ? ResultColumn::Kind::Unsigned
+                        : ResultColumn::Kind::Signed;
+      bind.buffer_type = MYSQL_TYPE_LONGLONG;
+      bind.buffer = &column.integer;
+      bind.is_unsigned = column.kind == ResultColumn::Kind::Unsigned;
+      break;
+    case MYSQL_TYPE_FLOAT:
+      column.kind = ResultColumn::Kind::Float;
+      bind.buffer_type = MYSQL_TYPE_FLOAT;
+      bind.buffer = &column.real;
+      break;
+    case MYSQL_TYPE_DOUBLE:
+      column.kind = ResultColumn::Kind::Double;
+      bind.buffer_type = MYSQL_TYPE_DOUBLE;
+      bind.buffer = &column.doubleValue;
+      break;
+    case MYSQL_TYPE_DATE:
+    case MYSQL_TYPE_NEWDATE:
+    case MYSQL_TYPE_TIME:
+    case MYSQL_TYPE_DATETIME:
+    case MYSQL_TYPE_TIMESTAMP:
+      column.kind = ResultColumn::Kind::Temporal;
+      bind.buffer_type = fields[i].type == MYSQL_TYPE_NEWDATE
+                             ? MYSQL_TYPE_DATE
+                             : fields[i].type;
+      bind.buffer = &column.time;
+      break;
+    default:
+      // DECIMAL travels as text in the binary protocol as well
+      column.bytes.resize(std::clamp<unsigned long>(fields[i].length, 64,
+                                                    MAX_BOUND_BYTES));
+      bind.buffer_type = MYSQL_TYPE_STRING;
+      bind.buffer = column.bytes.data();
+      bind.buffer_length = column.bytes.size();
+      break;
+    }
+  }
+  mysql_free_result(metadata);
+
+  if (mysql_stmt_bind_result(stmt_, resultBinds_.data()))
+    failed_ = true;
+  else
+    prepared_ = true;
+}
+
+MariaDBStatement::~MariaDBStatement() {
+  if (stmt_)
+    mysql_stmt_close(stmt_);
+}
+
+std::string MariaDBStatement::error() const {
+  return stmt_ ? mysql_stmt_error(stmt_) : "statement not initialized";
+}
+
+bool MariaDBStatement::execute(const std::vector<std::string> &params) {
+  if (!prepared_)
+    return false;
+  freeResult();
+  failed_ = false;
+
+  std::vector<MYSQL_BIND> paramBinds(params.size(), MYSQL_BIND{});
+  std::vector<unsigned long> paramLengths(params.size());
+  for (size_t i = 0; i < params.size(); ++i) {
+    paramLengths[i] = params[i].size();
+    paramBinds[i].buffer_type = MYSQL_TYPE_STRING;
+    paramBinds[i].buffer = const_cast<char *>(params[i].data());
+    paramBinds[i].buffer_length = params[i].size();
+    paramBinds[i].length = &paramLengths[i];
+  }
+  if ((!paramBinds.empty() &&
+       mysql_stmt_bind_param(stmt_, paramBinds.data())) ||
+      mysql_stmt_execute(stmt_)) {
+    failed_ = true;
+    return false;
+  }
+  pending_ = !columns_.empty();
+  return true;
+}
+
+void MariaDBStatement::freeResult() {
+  if (pending_) {
+    mysql_stmt_free_result(stmt_);
+    pending_ = false;
+  }
+}
+
+size_t MariaDBStatement::fetchBatch(ParallelProcessing::RowBatch &batch,
+                                    size_t maxRows) {
+  batch.reset(columns_.size());
+  size_t rows = 0;
+  while (pending_ && rows < maxRows) {
+    int rc = mysql_stmt_fetch(stmt_);
+    if (rc == MYSQL_NO_DATA) {
+      pending_ = false;
+      break;
+    }
+    if (rc != 0 && rc != MYSQL_DATA_TRUNCATED) {
+      failed_ = true;
+      pending_ = false;
+      break;
+    }
+    for (unsigned int i = 0; i < columns_.size(); ++i)
+      appendValue(batch, i);
+    batch.finishRow();
+    ++rows;
+  }
+  return rows;
+}
+
+void MariaDBStatement::appendValue(ParallelProcessing::RowBatch &batch,
+                                   unsigned int index) {
+  ResultColumn &column = columns_[index];
+  if (column.isNull) {
+    batch.appendNull(index);
+    return;
+  }
+
+  char text[64];
+  std::to_chars_result result{text, std::errc()};
+  switch (column.kind) {
+  case ResultColumn::Kind::Signed:
+    result = std::to_chars(text, text + sizeof(text), column.integer);
+    break;
+  case ResultColumn::Kind::Unsigned:
+    result = std::to_chars(text, text + sizeof(text),
+                           static_cast<unsigned long long>(column.integer));
+    break;
+  case ResultColumn::Kind::Float:
+    result = std::to_chars(text, text + sizeof(text), column.real);
+    break;
+  case ResultColumn::Kind::Double:
+    result = std::to_chars(text, text + sizeof(text), column.doubleValue);
+    break;
+  case ResultColumn::Kind::Temporal: {
+    const MYSQL_TIME &t = column.time;
+    int length = 0;
+    if (column.type == MYSQL_TYPE_TIME) {
+      length = snprintf(text, sizeof(text), "%s%02u:%02u:%02u",
+                        t.neg ? "-" : "", t.day * 24 + t.hour, t.minute,
+                        t.second);
+    } else {
+      length = snprintf(text, sizeof(text), "%04u-%02u-%02u", t.year,
+                        t.month, t.day);
+      if (column.type != MYSQL_TYPE_DATE)
+        length += snprintf(text + length, sizeof(text) - length,
+                           " %02u:%02u:%02u", t.hour, t.minute, t.second);
+    }
+    if (t.second_part > 0 && column.type != MYSQL_TYPE_DATE)
+      length += snprintf(text + length, sizeof(text) - length, ".%06lu",
+                         t.second_part);
+    result.ptr = text + length;
+    break;
+  }
+  case ResultColumn::Kind::Bytes: {
+    unsigned long bound = column.bytes.size();
+    batch.append(index, column.bytes.data(), std::min(column.length, bound));
+    if (column.length > bound) {
+      // Read the rest of a long value straight from the row
+      std::vector<char> rest(column.length - bound);
+      MYSQL_BIND bind{};
+      unsigned long restLength = 0;
+      bind.buffer_type = MYSQL_TYPE_STRING;
+      bind.buffer = rest.data();
+      bind.buffer_length = rest.size();
+      bind.length = &restLength;
+      if (mysql_stmt_fetch_column(stmt_, &bind, index, bound) == 0)
+        batch.extend(index, rest.data(), std::min(restLength, rest.size()));
+    }
+    return;
+  }
+  }
+  batch.append(index, text, static_cast<size_t>(result.ptr - text));
+}
+
 std::vector<std::vector<std::string>>
 MariaDBEngine::executeQuery(MYSQL *conn, const std::string &query) {
   std::vector<std::vector<std::string>> results;
   if (!conn)
     return results;
 
-  if (mysql_query(conn, query.c_str())) {
+  MariaDBResultStream stream(conn, query);
+  if (!stream.isValid()) {
     Logger::error(LogCategory::DATABASE, "MariaDBEngine",
-                  "Query failed: " + std::string(mysql_error(conn)));
-    return results;
-  }
-
-  MYSQL_RES *res = mysql_store_result(conn);
-  if (!res) {
-    unsigned int fieldCount = mysql_field_count(conn);
-    if (fieldCount > 0) {
-      unsigned int errNo = mysql_errno(conn);
-      if (errNo != 0) {
-        Logger::error(LogCategory::DATABASE, "MariaDBEngine",
-                      "Result fetch failed: " + std::string(mysql_error(conn)) +
-                          " (error code: " + std::to_string(errNo) + ")");
-      } else {
-        Logger::error(LogCategory::DATABASE, "MariaDBEngine",
-                      "Result fetch failed: " + std::string(mysql_error(conn)));
-      }
-    }
+                  "Query failed: " + stream.error());
     return results;
   }
 
-  unsigned int numFields = mysql_num_fields(res);
+  unsigned int numFields = stream.columnCount();
   MYSQL_ROW row;
-  while ((row = mysql_fetch_row(res))) {
+  while ((row = stream.fetchRow())) {
     std::vector<std::string> rowData;
     rowData.reserve(numFields);
     for (unsigned int i = 0; i < numFields; ++i) {
@@ -151,7 +391,12 @@ MariaDBEngine::executeQuery(MYSQL *conn, const std::string &query) {
     }
     results.push_back(std::move(rowData));
   }
-  mysql_free_result(res);
+  if (stream.failed()) {
+    Logger::error(LogCategory::DATABASE, "MariaDBEngine",
+                  "Result fetch failed: " + stream.error() +
+                      " (error code: " + std::to_string(mysql_errno(conn)) +
+                      ")");
+  }
   return results;
 }
 
@@ -53,24 +53,16 @@ DataGovernanceMariaDB::executeQuery(MYSQL *conn, const std::string &query) {
     return results;
   }
 
-  if (mysql_query(conn, query.c_str())) {
+  MariaDBResultStream stream(conn, query);
+  if (!stream.isValid()) {
     Logger::error(LogCategory::GOVERNANCE, "DataGovernanceMariaDB",
-                  "Query failed: " + std::string(mysql_error(conn)));
+                  "Query failed: " + stream.error());
     return results;
   }
 
-  MYSQL_RES *res = mysql_store_result(conn);
-  if (!res) {
-    if (mysql_field_count(conn) > 0) {
-      Logger::error(LogCategory::GOVERNANCE, "DataGovernanceMariaDB",
-                    "Result fetch failed: " + std::string(mysql_error(conn)));
-    }
-    return results;
-  }
-
-  unsigned int numFields = mysql_num_fields(res);
+  unsigned int numFields = stream.columnCount();
   MYSQL_ROW row;
-  while ((row = mysql_fetch_row(res))) {
+  while ((row = stream.fetchRow())) {
     std::vector<std::string> rowData;
     rowData.reserve(numFields);
     for (unsigned int i = 0; i < numFields; ++i) {
@@ -78,7 +70,10 @@ DataGovernanceMariaDB::executeQuery(MYSQL *conn, const std::string &query) {
     }
     results.push_back(std::move(rowData));
   }
-  mysql_free_result(res);
+  if (stream.failed()) {
+    Logger::error(LogCategory::GOVERNANCE, "DataGovernanceMariaDB",
+                  "Result fetch failed: " + stream.error());
+  }
   return results;
 }
 
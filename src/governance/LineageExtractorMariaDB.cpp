@@ -58,34 +58,33 @@ LineageExtractorMariaDB::executeQuery(MYSQL *conn, const std::string &query) {
     return results;
   }
 
-  if (mysql_query(conn, query.c_str())) {
+  MariaDBResultStream stream(conn, query);
+  if (!stream.isValid()) {
     Logger::error(LogCategory::GOVERNANCE, "LineageExtractorMariaDB",
-                  "Query failed: " + std::string(mysql_error(conn)));
+                  "Query failed: " + stream.error());
     return results;
   }
 
-  MYSQL_RES *result = mysql_store_result(conn);
-  if (!result) {
-    return results;
-  }
-
-  int numFields = mysql_num_fields(result);
+  unsigned int numFields = stream.columnCount();
   MYSQL_ROW row;
 
-  while ((row = mysql_fetch_row(result))) {
+  while ((row = stream.fetchRow())) {
     std::vector<std::string> rowData;
-    unsigned long *lengths = mysql_fetch_lengths(result);
-    for (int i = 0; i < numFields; i++) {
+    unsigned long *lengths = stream.lengths();
+    for (unsigned int i = 0; i < numFields; i++) {
       if (row[i]) {
         rowData.push_back(std::string(row[i], lengths[i]));
       } else {
         rowData.push_back("");
       }
     }
-    results.push_back(rowData);
+    results.push_back(std::move(rowData));
   }
 
-  mysql_free_result(result);
+  if (stream.failed()) {
+    Logger::error(LogCategory::GOVERNANCE, "LineageExtractorMariaDB",
+                  "Result fetch failed: " + stream.error());
+  }
   return results;
 }
 
@@ -1,6 +1,7 @@
 #include "sync/ChangeLogCDC.h"
 #include "core/Config.h"
 #include "core/logger.h"
+#include "sync/ChangeCoalescer.h"
 #include <algorithm>
 #include <mutex>
 #include <pqxx/pqxx>
@@ -43,7 +44,74 @@ long long ChangeLogCDC::getLastChangeId(pqxx::connection &pgConn,
   return lastChangeId;
 }
 
-void ChangeLogCDC::processChangeLogBatch(
+// Re-reads the current source rows of the given keys,
+// CDC_REFETCH_BATCH_KEYS keys per query, and appends them to records in
+// columnNames order. A single-column key is matched with IN (...), a
+// composite one with OR-ed equality groups, which every source engine
+// accepts. Keys whose row is gone are not returned. Returns the number of
+// rows found, or nothing if a query failed.
+std::optional<size_t> ChangeLogCDC::refetchRowsByKey(
+    const TableInfo &table, const std::vector<std::string> &pkColumns,
+    const std::vector<std::string> &columnNames,
+    const std::vector<std::vector<std::string>> &keys,
+    std::vector<std::vector<std::string>> &records) {
+  std::string columnList;
+  for (size_t i = 0; i < columnNames.size(); ++i) {
+    if (i > 0)
+      columnList += ", ";
+    columnList += escapeIdentifier(columnNames[i]);
+  }
+
+  size_t found = 0;
+  for (size_t start = 0; start < keys.size();
+       start += CDC_REFETCH_BATCH_KEYS) {
+    size_t count = std::min(CDC_REFETCH_BATCH_KEYS, keys.size() - start);
+    std::string whereClause;
+    if (pkColumns.size() == 1) {
+      whereClause = escapeIdentifier(pkColumns[0]) + " IN (";
+      for (size_t k = start; k < start + count; ++k) {
+        if (k > start)
+          whereClause += ", ";
+        whereClause += "'" + escapeSQL(keys[k][0]) + "'";
+      }
+      whereClause += ")";
+    } else {
+      for (size_t k = start; k < start + count; ++k) {
+        if (k > start)
+          whereClause += " OR ";
+        whereClause += "(";
+        for (size_t i = 0; i < pkColumns.size(); ++i) {
+          if (i > 0)
+            whereClause += " AND ";
+          whereClause += escapeIdentifier(pkColumns[i]) + " = '" +
+                         escapeSQL(keys[k][i]) + "'";
+        }
+        whereClause += ")";
+      }
+    }
+
+    std::optional<std::vector<std::vector<std::string>>> rows =
+        executeSourceQuery("SELECT " + columnList + " FROM " +
+                           escapeIdentifier(table.schema_name) + "." +
+                           escapeIdentifier(table.table_name) + " WHERE " +
+                           whereClause);
+    if (!rows) {
+      Logger::error(LogCategory::TRANSFER, "refetchRowsByKey",
+                    "Re-fetch failed for " + table.schema_name + "." +
+                        table.table_name);
+      return std::nullopt;
+    }
+    for (auto &row : *rows) {
+      if (row.size() != columnNames.size())
+        continue;
+      records.push_back(std::move(row));
+      ++found;
+    }
+  }
+  return found;
+}
+
+bool ChangeLogCDC::processChangeLogBatch(
     pqxx::connection &pgConn, const TableInfo &table,
     const std::vector<ChangeLogEntry> &changes,
     const std::vector<std::string> &columnNames,
@@ -54,13 +122,26 @@ void ChangeLogCDC::processChangeLogBatch(
     Logger::warning(LogCategory::TRANSFER, "processChangeLogBatch",
                     "No PK columns found for " + table.schema_name + "." +
                         table.table_name);
-    return;
+    return false;
   }
 
   std::vector<std::vector<std::string>> deletedPKs;
   std::vector<std::vector<std::string>> recordsToUpsert;
+  std::vector<std::vector<std::string>> refetchKeys;
 
+  // Only the last change per key is applied; dump() sorts object keys, so
+  // equal keys serialize identically
+  ChangeCoalescer coalescer;
   for (const auto &change : changes) {
+    coalescer.add(change.pk_values.dump(), change.operation);
+  }
+  coalescer.finish();
+
+  for (size_t changeIndex = 0; changeIndex < changes.size(); ++changeIndex) {
+    if (!coalescer.keep(changeIndex)) {
+      continue;
+    }
+    const ChangeLogEntry &change = changes[changeIndex];
     try {
       std::vector<std::string> pkValues;
       for (const auto &pkCol : pkColumns) {
@@ -119,37 +200,7 @@ void ChangeLogCDC::processChangeLogBatch(
         }
 
         if (!useRowData) {
-          std::string whereClause = "";
-          for (size_t i = 0; i < pkColumns.size(); ++i) {
-            if (i > 0) {
-              whereClause += " AND ";
-            }
-            std::string pkValue = pkValues[i];
-            if (pkValue == "NULL") {
-              whereClause += escapeIdentifier(pkColumns[i]) + " IS NULL";
-            } else {
-              whereClause += escapeIdentifier(pkColumns[i]) + " = '" +
-                             escapeSQL(pkValue) + "'";
-            }
-          }
-
-          std::string selectQuery =
-              "SELECT * FROM " + escapeIdentifier(table.schema_name) + "." +
-              escapeIdentifier(table.table_name) + " WHERE " + whereClause;
-
-          std::vector<std::vector<std::string>> recordResult =
-              executeSourceQuery(selectQuery);
-
-          if (!recordResult.empty() &&
-              recordResult[0].size() == columnNames.size()) {
-            recordsToUpsert.push_back(recordResult[0]);
-          } else {
-            Logger::warning(LogCategory::TRANSFER, "processChangeLogBatch",
-                            "Record not found in source for " +
-                                table.schema_name + "." + table.table_name +
-                                " operation " +
-                                std::string(1, change.operation));
-          }
+          refetchKeys.push_back(pkValues);
         }
       }
     } catch (const std::exception &e) {
@@ -159,6 +210,23 @@ void ChangeLogCDC::processChangeLogBatch(
     }
   }
 
+  if (!refetchKeys.empty()) {
+    std::optional<size_t> found = refetchRowsByKey(
+        table, pkColumns, columnNames, refetchKeys, recordsToUpsert);
+    if (!found) {
+      Logger::error(LogCategory::TRANSFER, "processChangeLogBatch",
+                    "Could not re-fetch changed rows of " + table.schema_name +
+                        "." + table.table_name + "; batch not applied");
+      return false;
+    }
+    if (*found < refetchKeys.size()) {
+      Logger::warning(LogCategory::TRANSFER, "processChangeLogBatch",
+                      std::to_string(refetchKeys.size() - *found) +
+                          " changed records of " + table.schema_name + "." +
+                          table.table_name + " no longer exist in source");
+    }
+  }
+
   size_t deletedCount = 0;
   if (!deletedPKs.empty()) {
     std::string lowerSchemaName = table.schema_name;
@@ -195,7 +263,9 @@ void ChangeLogCDC::processChangeLogBatch(
                    table.table_name + " with " +
                    std::to_string(changes.size()) +
                    " changes: " + std::to_string(upsertedCount) + " upserts, " +
-                   std::to_string(deletedCount) + " deletes");
+                   std::to_string(deletedCount) + " deletes, " +
+                   std::to_string(coalescer.elided()) + " elided");
+  return true;
 }
 
 void ChangeLogCDC::updateLastChangeId(pqxx::connection &pgConn,
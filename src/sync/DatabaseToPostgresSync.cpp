@@ -1,6 +1,11 @@
 #include "sync/DatabaseToPostgresSync.h"
 #include "engines/database_engine.h"
+#include "sync/TableScheduler.h"
 #include <algorithm>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <optional>
 #include <set>
 
 std::mutex DatabaseToPostgresSync::metadataUpdateMutex;
@@ -9,7 +14,7 @@ std::mutex DatabaseToPostgresSync::metadataUpdateMutex;
 // all three queues: rawDataQueue (for raw data chunks), preparedBatchQueue
 // (for prepared SQL batches), and resultQueue (for processing results). This
 // should be called before starting any parallel data transfer operations to
-// ensure clean queue state.
+// ensure clean queue state. Also resets the queue wait counters.
 void DatabaseToPostgresSync::startParallelProcessing() {
   rawDataQueue.clear();
   preparedBatchQueue.clear();
@@ -19,6 +24,10 @@ void DatabaseToPostgresSync::startParallelProcessing() {
   preparedBatchQueue.reset_queue();
   resultQueue.reset_queue();
 
+  rawDataQueue.resetWaitStats();
+  preparedBatchQueue.resetWaitStats();
+  resultQueue.resetWaitStats();
+
   Logger::info(LogCategory::TRANSFER, "Parallel processing started");
 }
 
@@ -38,9 +47,38 @@ void DatabaseToPostgresSync::shutdownParallelProcessing() {
   }
   parallelThreads.clear();
 
+  logQueueWaitStats();
   Logger::info(LogCategory::TRANSFER, "Parallel processing shutdown completed");
 }
 
+// Logs the wait counters of one pipeline queue. Producer wait time on a
+// queue means the stage reading from it is the bottleneck; consumer wait time
+// means the stage feeding it is. Queues that never had to wait are skipped.
+static void logWaitStats(const std::string &name,
+                         const QueueWaitStats &stats) {
+  if (stats.producerWaits == 0 && stats.consumerWaits == 0 &&
+      stats.rejectedPushes == 0)
+    return;
+  auto toMs = [](std::chrono::nanoseconds ns) {
+    return std::to_string(
+        std::chrono::duration_cast<std::chrono::milliseconds>(ns).count());
+  };
+  Logger::info(LogCategory::TRANSFER, "logQueueWaitStats",
+               name + ": producers waited " +
+                   std::to_string(stats.producerWaits) + " times (" +
+                   toMs(stats.producerWaitTime) + " ms), consumers waited " +
+                   std::to_string(stats.consumerWaits) + " times (" +
+                   toMs(stats.consumerWaitTime) + " ms), rejected pushes " +
+                   std::to_string(stats.rejectedPushes));
+}
+
+// Logs the wait counters of the engine-wide pipeline queues.
+void DatabaseToPostgresSync::logQueueWaitStats() {
+  logWaitStats("rawDataQueue", rawDataQueue.waitStats());
+  logWaitStats("preparedBatchQueue", preparedBatchQueue.waitStats());
+  logWaitStats("resultQueue", resultQueue.waitStats());
+}
+
 // Parses a JSON array string into a vector of strings. Handles empty arrays
 // and empty strings by returning an empty vector. Validates that the input is
 // actually a JSON array, throwing an exception if not. Extracts only string
@@ -152,13 +190,636 @@ DatabaseToPostgresSync::getPKColumnsFromCatalog(pqxx::connection &pgConn,
   return pkColumns;
 }
 
+// Groups the active CDC tables of dbEngine by the source change log that
+// records them; sourceKey maps a connection string to the log it reaches
+// (a server, or a database for engines with one log per database). A table
+// that has not applied any change yet counts as last_change_id 0, which
+// keeps its log rows and any log-wide cleanup on hold. With listeningOnly,
+// only the CDC tables currently applying changes are returned.
+std::map<std::string, DatabaseToPostgresSync::ChangeLogSource>
+DatabaseToPostgresSync::getChangeLogSources(
+    pqxx::connection &pgConn, const std::string &dbEngine,
+    const std::function<std::string(const std::string &)> &sourceKey,
+    bool listeningOnly) {
+  std::map<std::string, ChangeLogSource> sources;
+  pqxx::work txn(pgConn);
+  auto result = txn.exec(
+      "SELECT connection_string, schema_name, table_name, "
+      "COALESCE((sync_metadata->>'last_change_id')::bigint, 0) "
+      "FROM metadata.catalog WHERE db_engine=" +
+      txn.quote(dbEngine) + " AND active = true AND " +
+      (listeningOnly ? "pk_strategy = 'CDC' AND status = 'LISTENING_CHANGES'"
+                     : "COALESCE(pk_strategy, 'CDC') IN "
+                       "('CDC', 'OFFSET', 'PK')"));
+  txn.commit();
+
+  for (const auto &row : result) {
+    if (row[0].is_null())
+      continue;
+    std::string connectionString = row[0].as<std::string>();
+    ChangeLogSource &source = sources[sourceKey(connectionString)];
+    if (source.connectionString.empty())
+      source.connectionString = connectionString;
+    auto key = std::make_pair(row[1].as<std::string>(),
+                              row[2].as<std::string>());
+    long long applied = row[3].as<long long>();
+    auto it = source.appliedChangeIds.find(key);
+    if (it == source.appliedChangeIds.end())
+      source.appliedChangeIds.emplace(key, applied);
+    else if (applied < it->second)
+      it->second = applied;
+  }
+  return sources;
+}
+
+// Reports a purge of a table's change log rows in its sync_metadata:
+// change_log_purged_rows accumulates the rows removed and change_log_rows
+// holds the (engine-estimated) size of the log after the purge.
+void DatabaseToPostgresSync::recordChangeLogPurge(
+    pqxx::connection &pgConn, const std::string &dbEngine,
+    const std::string &schemaName, const std::string &tableName,
+    size_t purgedRows, long long logRows) {
+  try {
+    std::lock_guard<std::mutex> lock(metadataUpdateMutex);
+    pqxx::work txn(pgConn);
+    txn.exec("UPDATE metadata.catalog SET sync_metadata = "
+             "COALESCE(sync_metadata, '{}'::jsonb) || jsonb_build_object("
+             "'change_log_purged_rows', "
+             "COALESCE((sync_metadata->>'change_log_purged_rows')::bigint, "
+             "0) + " +
+             std::to_string(purgedRows) + ", 'change_log_rows', " +
+             std::to_string(logRows) +
+             ", 'change_log_purged_at', NOW()) WHERE schema_name=" +
+             txn.quote(schemaName) + " AND table_name=" +
+             txn.quote(tableName) + " AND db_engine=" + txn.quote(dbEngine));
+    txn.commit();
+  } catch (const std::exception &e) {
+    Logger::error(LogCategory::TRANSFER, "recordChangeLogPurge",
+                  "Error recording change log purge for " + schemaName + "." +
+                      tableName + ": " + std::string(e.what()));
+  }
+}
+
+// Hands the rows of one change log read to the tables of source, dropping
+// those a table has already applied, so each table's CDC pass works from
+// memory instead of polling the log. committedUpTo is the change_id below
+// which no source transaction can still add a log row (change ids are taken
+// at insert time, so rows of open transactions may sit below rows already
+// read); 0 if the source could not tell. Tables the read found nothing for
+// have seen the log up to there, and their last_change_id is moved there in
+// a single statement so that the next read (and the purge) starts past
+// rows that are not theirs.
+void DatabaseToPostgresSync::dispatchChangeLog(
+    pqxx::connection &pgConn, const std::string &dbEngine,
+    const ChangeLogSource &source,
+    std::vector<std::vector<std::string>> &logRows, long long committedUpTo) {
+  std::unordered_map<std::string, long long> applied;
+  {
+    std::lock_guard<std::mutex> lock(dispatchedChangesMutex_);
+    for (const auto &entry : source.appliedChangeIds) {
+      std::string tableKey = entry.first.first + "." + entry.first.second;
+      applied[tableKey] = entry.second;
+      dispatchedChanges_[tableKey].readUpTo = committedUpTo;
+    }
+
+    // Rows are (change_id, schema_name, table_name, operation, pk_values,
+    // row_data)
+    for (auto &row : logRows) {
+      if (row.size() < 6)
+        continue;
+      std::string tableKey = row[1] + "." + row[2];
+      auto it = applied.find(tableKey);
+      if (it == applied.end())
+        continue;
+      long long changeId = 0;
+      try {
+        changeId = std::stoll(row[0]);
+      } catch (const std::exception &) {
+        continue;
+      }
+      if (changeId <= it->second)
+        continue;
+      dispatchedChanges_[tableKey].rows.push_back(
+          {std::move(row[0]), std::move(row[3]), std::move(row[4]),
+           std::move(row[5])});
+    }
+  }
+
+  // The log moved past these tables' progress: they are due whatever their
+  // schedule says
+  TableScheduler &scheduler = TableScheduler::forEngine(dbEngine);
+  for (const auto &entry : source.appliedChangeIds) {
+    std::string tableKey = entry.first.first + "." + entry.first.second;
+    if (!hasNoDispatchedChanges(tableKey))
+      scheduler.wake(tableKey);
+  }
+
+  std::vector<std::pair<std::string, std::string>> idle;
+  for (const auto &entry : source.appliedChangeIds) {
+    if (entry.second < committedUpTo &&
+        hasNoDispatchedChanges(entry.first.first + "." + entry.first.second))
+      idle.push_back(entry.first);
+  }
+  if (idle.empty())
+    return;
+
+  try {
+    std::lock_guard<std::mutex> lock(metadataUpdateMutex);
+    pqxx::work txn(pgConn);
+    std::string values;
+    for (const auto &table : idle) {
+      if (!values.empty())
+        values += ", ";
+      values += "(" + txn.quote(table.first) + ", " + txn.quote(table.second) +
+                ")";
+    }
+    txn.exec("UPDATE metadata.catalog c SET sync_metadata = "
+             "COALESCE(c.sync_metadata, '{}'::jsonb) || "
+             "jsonb_build_object('last_change_id', " +
+             std::to_string(committedUpTo) + ") FROM (VALUES " + values +
+             ") AS v(schema_name, table_name) WHERE c.schema_name = "
+             "v.schema_name AND c.table_name = v.table_name AND c.db_engine=" +
+             txn.quote(dbEngine) +
+             " AND c.status = 'LISTENING_CHANGES' AND "
+             "COALESCE((c.sync_metadata->>'last_change_id')::bigint, 0) < " +
+             std::to_string(committedUpTo));
+    txn.commit();
+  } catch (const std::exception &e) {
+    Logger::error(LogCategory::TRANSFER, "dispatchChangeLog",
+                  "Error advancing last_change_id of idle tables: " +
+                      std::string(e.what()));
+  }
+}
+
+// Moves the changes dispatched to tableKey into changes; false if the last
+// read did not cover the table, which then polls the log itself.
+bool DatabaseToPostgresSync::takeDispatchedChanges(
+    const std::string &tableKey, DispatchedChanges &changes) {
+  std::lock_guard<std::mutex> lock(dispatchedChangesMutex_);
+  auto it = dispatchedChanges_.find(tableKey);
+  if (it == dispatchedChanges_.end())
+    return false;
+  changes = std::move(it->second);
+  dispatchedChanges_.erase(it);
+  return true;
+}
+
+// True if the last read covered tableKey and found nothing for it
+bool DatabaseToPostgresSync::hasNoDispatchedChanges(
+    const std::string &tableKey) {
+  std::lock_guard<std::mutex> lock(dispatchedChangesMutex_);
+  auto it = dispatchedChanges_.find(tableKey);
+  return it != dispatchedChanges_.end() && it->second.rows.empty();
+}
+
+void DatabaseToPostgresSync::clearDispatchedChanges() {
+  std::lock_guard<std::mutex> lock(dispatchedChangesMutex_);
+  dispatchedChanges_.clear();
+}
+
+// Drops the listening tables of tables that the engine's scheduler does not
+// have due and starts the run of the others. Tables in any other status are
+// loading and run every pass.
+void DatabaseToPostgresSync::keepDueTables(const std::string &dbEngine,
+                                           std::vector<TableInfo> &tables) {
+  TableScheduler &scheduler = TableScheduler::forEngine(dbEngine);
+  std::vector<std::string> tableKeys;
+  for (const auto &table : tables)
+    tableKeys.push_back(table.schema_name + "." + table.table_name);
+  scheduler.track(tableKeys);
+
+  size_t notDue = tables.size();
+  tables.erase(std::remove_if(tables.begin(), tables.end(),
+                              [&scheduler](const TableInfo &t) {
+                                return !scheduler.claim(t.schema_name + "." +
+                                                        t.table_name) &&
+                                       t.status == "LISTENING_CHANGES";
+                              }),
+               tables.end());
+  notDue -= tables.size();
+  if (notDue > 0) {
+    Logger::info(LogCategory::TRANSFER,
+                 "Skipping " + std::to_string(notDue) + " " + dbEngine +
+                     " tables not due for sync yet");
+  }
+}
+
+// Ends the runs keepDueTables started, so each table's next run follows
+// from the rows CDC applied to it meanwhile.
+void DatabaseToPostgresSync::completeDueTables(
+    const std::string &dbEngine, const std::vector<TableInfo> &tables) {
+  TableScheduler &scheduler = TableScheduler::forEngine(dbEngine);
+  for (const auto &table : tables)
+    scheduler.completed(table.schema_name + "." + table.table_name,
+                        table.status != "LISTENING_CHANGES");
+}
+
+// Returns the position of every key column in columnNames (compared
+// case-insensitively), or an empty vector if any key column is missing from
+// the fetched columns.
+std::vector<size_t> DatabaseToPostgresSync::findKeyPositions(
+    const std::vector<std::string> &columnNames,
+    const std::vector<std::string> &keyColumns) {
+  auto lower = [](std::string value) {
+    std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+    return value;
+  };
+
+  std::vector<size_t> positions;
+  for (const auto &keyColumn : keyColumns) {
+    std::string lowerKey = lower(keyColumn);
+    size_t position = columnNames.size();
+    for (size_t i = 0; i < columnNames.size(); ++i) {
+      if (lower(columnNames[i]) == lowerKey) {
+        position = i;
+        break;
+      }
+    }
+    if (position == columnNames.size())
+      return {};
+    positions.push_back(position);
+  }
+  return positions;
+}
+
+// Quotes a key value read back from the source as a string literal of that
+// engine, for the keyset and key range predicates. The source converts the
+// literal to the key column's type.
+std::string DatabaseToPostgresSync::quoteKeyLiteral(const std::string &value,
+                                                    KeyLiteralStyle style) {
+  bool national =
+      style == KeyLiteralStyle::NationalUnicode &&
+      std::any_of(value.begin(), value.end(),
+                  [](char c) { return static_cast<unsigned char>(c) > 127; });
+  std::string literal = national ? "N'" : "'";
+  for (char c : value) {
+    if (c == '\'' ||
+        (c == '\\' && style == KeyLiteralStyle::BackslashEscapes))
+      literal += c;
+    literal += c;
+  }
+  return literal + "'";
+}
+
+// Builds the seek predicate for keyset pagination over a composite key:
+// (k1 > v1) OR (k1 = v1 AND k2 > v2) OR ... Columns and values must already
+// be quoted for the source engine. The expanded form is used instead of a
+// row-value comparison because MSSQL and Oracle do not support the latter,
+// and every branch still starts with the leading key column so the primary
+// key index can seek to the start of the next page.
+std::string DatabaseToPostgresSync::buildKeysetPredicate(
+    const std::vector<std::string> &quotedColumns,
+    const std::vector<std::string> &quotedValues) {
+  std::string predicate = "(";
+  for (size_t i = 0; i < quotedColumns.size() && i < quotedValues.size();
+       ++i) {
+    if (i > 0)
+      predicate += " OR ";
+    predicate += "(";
+    for (size_t j = 0; j < i; ++j)
+      predicate += quotedColumns[j] + " = " + quotedValues[j] + " AND ";
+    predicate += quotedColumns[i] + " > " + quotedValues[i] + ")";
+  }
+  predicate += ")";
+  return predicate;
+}
+
+// Loads the FULL_LOAD keyset checkpoint stored in sync_metadata under
+// full_load_checkpoint as {"columns": [...], "values": [...]}. The checkpoint
+// is only returned when it was written for the same key columns; otherwise
+// (or when there is none, or on error) the load starts from the beginning.
+// resumable, if given, is set when the checkpoint carries "resume": true.
+std::vector<std::string> DatabaseToPostgresSync::loadFullLoadCheckpoint(
+    pqxx::connection &pgConn, const std::string &schemaName,
+    const std::string &tableName, const std::string &dbEngine,
+    const std::vector<std::string> &keyColumns, bool *resumable) {
+  if (resumable)
+    *resumable = false;
+  try {
+    pqxx::work txn(pgConn);
+    auto result =
+        txn.exec("SELECT sync_metadata->'full_load_checkpoint' FROM "
+                 "metadata.catalog WHERE schema_name=" +
+                 txn.quote(schemaName) + " AND table_name=" +
+                 txn.quote(tableName) +
+                 " AND db_engine=" + txn.quote(dbEngine));
+    txn.commit();
+
+    if (result.empty() || result[0][0].is_null())
+      return {};
+
+    json checkpoint = json::parse(result[0][0].as<std::string>());
+    if (!checkpoint.contains("columns") || !checkpoint.contains("values") ||
+        checkpoint["columns"].get<std::vector<std::string>>() != keyColumns)
+      return {};
+
+    auto values = checkpoint["values"].get<std::vector<std::string>>();
+    if (values.size() != keyColumns.size())
+      return {};
+    if (resumable)
+      *resumable = checkpoint.value("resume", false);
+    return values;
+  } catch (const pqxx::broken_connection &) {
+    throw;
+  } catch (const std::exception &e) {
+    Logger::warning(LogCategory::TRANSFER, "loadFullLoadCheckpoint",
+                    "Ignoring FULL_LOAD checkpoint for " + schemaName + "." +
+                        tableName + ": " + std::string(e.what()));
+  }
+  return {};
+}
+
+// Decides whether a table found in FULL_LOAD continues from its checkpoint
+// instead of being truncated. Only a load that this process put back into
+// FULL_LOAD marks its checkpoint resumable. A table that entered FULL_LOAD
+// from any other status, e.g. forced by an operator after a crashed load,
+// starts over, and the caller's truncate drops the stale checkpoint.
+bool DatabaseToPostgresSync::resumesFullLoad(
+    pqxx::connection &pgConn, const TableInfo &table,
+    const std::string &dbEngine, const std::vector<std::string> &keyColumns) {
+  if (table.status != "FULL_LOAD")
+    return false;
+  bool resumable = false;
+  return !loadFullLoadCheckpoint(pgConn, table.schema_name, table.table_name,
+                                 dbEngine, keyColumns, &resumable)
+              .empty() &&
+         resumable;
+}
+
+// Persists the last key of the most recent chunk that was committed to
+// PostgreSQL, so a FULL_LOAD interrupted by a crash resumes after it instead
+// of truncating and starting over.
+void DatabaseToPostgresSync::saveFullLoadCheckpoint(
+    pqxx::connection &pgConn, const std::string &schemaName,
+    const std::string &tableName, const std::string &dbEngine,
+    const std::vector<std::string> &keyColumns,
+    const std::vector<std::string> &keyValues) {
+  try {
+    json checkpoint;
+    checkpoint["columns"] = keyColumns;
+    checkpoint["values"] = keyValues;
+
+    std::lock_guard<std::mutex> lock(metadataUpdateMutex);
+    pqxx::work txn(pgConn);
+    txn.exec("UPDATE metadata.catalog SET sync_metadata = "
+             "COALESCE(sync_metadata, '{}'::jsonb) || "
+             "jsonb_build_object('full_load_checkpoint', " +
+             txn.quote(checkpoint.dump()) +
+             "::jsonb) WHERE schema_name=" + txn.quote(schemaName) +
+             " AND table_name=" + txn.quote(tableName) +
+             " AND db_engine=" + txn.quote(dbEngine));
+    txn.commit();
+  } catch (const pqxx::broken_connection &) {
+    throw;
+  } catch (const std::exception &e) {
+    Logger::error(LogCategory::TRANSFER, "saveFullLoadCheckpoint",
+                  "Error saving FULL_LOAD checkpoint for " + schemaName + "." +
+                      tableName + ": " + std::string(e.what()));
+  }
+}
+
+// Removes the FULL_LOAD checkpoint once a load has finished or the target
+// was truncated.
+void DatabaseToPostgresSync::clearFullLoadCheckpoint(
+    pqxx::connection &pgConn, const std::string &schemaName,
+    const std::string &tableName, const std::string &dbEngine) {
+  try {
+    std::lock_guard<std::mutex> lock(metadataUpdateMutex);
+    pqxx::work txn(pgConn);
+    txn.exec("UPDATE metadata.catalog SET sync_metadata = "
+             "sync_metadata - 'full_load_checkpoint' WHERE schema_name=" +
+             txn.quote(schemaName) + " AND table_name=" +
+             txn.quote(tableName) + " AND db_engine=" + txn.quote(dbEngine) +
+             " AND sync_metadata ? 'full_load_checkpoint'");
+    txn.commit();
+  } catch (const pqxx::broken_connection &) {
+    throw;
+  } catch (const std::exception &e) {
+    Logger::error(LogCategory::TRANSFER, "clearFullLoadCheckpoint",
+                  "Error clearing FULL_LOAD checkpoint for " + schemaName +
+                      "." + tableName + ": " + std::string(e.what()));
+  }
+}
+
+// Puts a table whose FULL_LOAD failed back into FULL_LOAD so the next pass
+// retries it. Its checkpoint, if any, is marked resumable, so the retry
+// continues after the last committed chunk instead of truncating.
+void DatabaseToPostgresSync::retryFullLoad(pqxx::connection &pgConn,
+                                           const std::string &schemaName,
+                                           const std::string &tableName,
+                                           const std::string &dbEngine) {
+  try {
+    std::lock_guard<std::mutex> lock(metadataUpdateMutex);
+    pqxx::work txn(pgConn);
+    txn.exec("UPDATE metadata.catalog SET status = 'FULL_LOAD', "
+             "sync_metadata = CASE WHEN sync_metadata ? "
+             "'full_load_checkpoint' THEN jsonb_set(sync_metadata, "
+             "'{full_load_checkpoint,resume}', 'true'::jsonb) "
+             "ELSE sync_metadata END WHERE schema_name=" +
+             txn.quote(schemaName) + " AND table_name=" +
+             txn.quote(tableName) + " AND db_engine=" + txn.quote(dbEngine));
+    txn.commit();
+  } catch (const pqxx::broken_connection &) {
+    throw;
+  } catch (const std::exception &e) {
+    Logger::error(LogCategory::TRANSFER, "retryFullLoad",
+                  "Error returning " + schemaName + "." + tableName +
+                      " to FULL_LOAD: " + std::string(e.what()));
+  }
+}
+
+// Turns the ascending upper bounds of NTILE buckets over the leading key
+// column into contiguous ranges. Repeated bounds (a composite key whose
+// leading value spans buckets) are merged, and the last bound is dropped
+// because it is the column maximum, leaving the final range open so rows
+// inserted after the split are still loaded.
+std::vector<DatabaseToPostgresSync::KeyRange>
+DatabaseToPostgresSync::buildKeyRanges(
+    const std::vector<std::string> &boundaries) {
+  std::vector<std::string> bounds;
+  for (const auto &boundary : boundaries) {
+    if (bounds.empty() || bounds.back() != boundary)
+      bounds.push_back(boundary);
+  }
+  if (!bounds.empty())
+    bounds.pop_back();
+
+  std::vector<KeyRange> ranges;
+  KeyRange current;
+  for (const auto &bound : bounds) {
+    current.upperBound = bound;
+    ranges.push_back(current);
+    current.lowerBound = bound;
+    current.upperBound.reset();
+  }
+  ranges.push_back(current);
+  return ranges;
+}
+
+// Builds the WHERE condition restricting a fetch to one key range, or an
+// empty string for a fully open range. Bounds are quoted in the source
+// engine's literal style.
+std::string DatabaseToPostgresSync::buildKeyRangePredicate(
+    const std::string &quotedColumn, const KeyRange &range,
+    KeyLiteralStyle style) {
+  std::string predicate;
+  if (range.lowerBound)
+    predicate =
+        quotedColumn + " > " + quoteKeyLiteral(*range.lowerBound, style);
+  if (range.upperBound) {
+    if (!predicate.empty())
+      predicate += " AND ";
+    predicate +=
+        quotedColumn + " <= " + quoteKeyLiteral(*range.upperBound, style);
+  }
+  return predicate;
+}
+
+// Builds a PostgreSQL text[] literal from a list of nullable values. Elements
+// are double-quoted with embedded quotes and backslashes escaped; std::nullopt
+// becomes an unquoted NULL element. The result must still be quoted as a SQL
+// literal by the caller.
+static std::string
+buildTextArrayLiteral(const std::vector<std::optional<std::string>> &values) {
+  std::string literal = "{";
+  for (size_t i = 0; i < values.size(); ++i) {
+    if (i > 0)
+      literal += ",";
+    if (!values[i]) {
+      literal += "NULL";
+      continue;
+    }
+    literal += "\"";
+    for (char c : *values[i]) {
+      if (c == '"' || c == '\\')
+        literal += '\\';
+      literal += c;
+    }
+    literal += "\"";
+  }
+  literal += "}";
+  return literal;
+}
+
+// Returns the formatted type (format_type) of every column of a PostgreSQL
+// table, keyed by column name. With baseTypes the type modifiers are left
+// out (character varying instead of character varying(20)). targetTable must
+// be an already quoted schema.table name. Throws if the table does not exist.
+std::unordered_map<std::string, std::string>
+DatabaseToPostgresSync::getColumnTypesFromPostgres(
+    pqxx::work &txn, const std::string &targetTable, bool baseTypes) {
+  std::unordered_map<std::string, std::string> columnTypes;
+  auto results = txn.exec(
+      std::string("SELECT a.attname, format_type(a.atttypid, ") +
+      (baseTypes ? "NULL" : "a.atttypmod") +
+      ") FROM pg_attribute a WHERE a.attrelid = " +
+      txn.quote(targetTable) +
+      "::regclass AND a.attnum > 0 AND NOT a.attisdropped");
+  for (const auto &row : results) {
+    columnTypes[row[0].as<std::string>()] = row[1].as<std::string>();
+  }
+  return columnTypes;
+}
+
+// Deletes a batch of keys from a PostgreSQL table using set-based statements.
+// Each key column is shipped as a single text[] literal and joined back with
+// DELETE ... USING unnest(...), cast to the target column type, so the
+// statement size grows linearly and the planner sees a plain join instead of
+// a long OR chain. Keys are grouped by which of their values are NULL ("NULL"
+// or empty); each group becomes one statement that matches those columns with
+// IS NULL, so matching stays NULL-safe while the non-NULL columns keep using
+// plain equality (and the key index). In the common case of keys without
+// NULLs this is exactly one statement per batch. valueOffset is the position
+// of the first key value inside each key vector. Runs inside the caller's
+// transaction and returns the number of deleted rows.
+size_t DatabaseToPostgresSync::deleteRecordsByKeyArrays(
+    pqxx::work &txn, const std::string &lowerSchemaName,
+    const std::string &lowerTableName,
+    const std::vector<std::string> &keyColumns,
+    const std::vector<std::vector<std::string>> &keys, size_t valueOffset) {
+  std::string targetTable =
+      txn.quote_name(lowerSchemaName) + "." + txn.quote_name(lowerTableName);
+  auto targetTypes = getColumnTypesFromPostgres(txn, targetTable);
+
+  std::vector<std::string> lowerKeyColumns;
+  std::vector<std::string> keyTypes;
+  for (const auto &name : keyColumns) {
+    std::string col = name;
+    std::transform(col.begin(), col.end(), col.begin(), ::tolower);
+    auto typeIt = targetTypes.find(col);
+    if (typeIt == targetTypes.end()) {
+      throw std::runtime_error("Column " + col + " not found in " +
+                               targetTable);
+    }
+    lowerKeyColumns.push_back(col);
+    keyTypes.push_back(typeIt->second);
+  }
+
+  std::map<std::vector<bool>, std::vector<size_t>> nullPatterns;
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (keys[i].size() < valueOffset + keyColumns.size())
+      continue;
+    std::vector<bool> pattern(keyColumns.size());
+    for (size_t j = 0; j < keyColumns.size(); ++j) {
+      const std::string &value = keys[i][valueOffset + j];
+      pattern[j] = (value == "NULL" || value.empty());
+    }
+    nullPatterns[pattern].push_back(i);
+  }
+
+  size_t deletedCount = 0;
+  for (const auto &group : nullPatterns) {
+    const std::vector<bool> &pattern = group.first;
+    std::string unnestArgs;
+    std::string unnestAliases;
+    std::string whereClause;
+
+    for (size_t j = 0; j < keyColumns.size(); ++j) {
+      if (!whereClause.empty())
+        whereClause += " AND ";
+      std::string targetColumn = "t." + txn.quote_name(lowerKeyColumns[j]);
+      if (pattern[j]) {
+        whereClause += targetColumn + " IS NULL";
+        continue;
+      }
+
+      std::vector<std::optional<std::string>> values;
+      values.reserve(group.second.size());
+      for (size_t index : group.second) {
+        values.emplace_back(keys[index][valueOffset + j]);
+      }
+
+      std::string alias = "k" + std::to_string(j);
+      if (!unnestArgs.empty()) {
+        unnestArgs += ", ";
+        unnestAliases += ", ";
+      }
+      unnestArgs += txn.quote(buildTextArrayLiteral(values)) + "::text[]";
+      unnestAliases += alias;
+      whereClause += targetColumn + " = k." + alias + "::" + keyTypes[j];
+    }
+
+    std::string deleteQuery = "DELETE FROM " + targetTable + " t";
+    if (!unnestArgs.empty()) {
+      deleteQuery +=
+          " USING unnest(" + unnestArgs + ") AS k(" + unnestAliases + ")";
+    }
+    deleteQuery += " WHERE " + whereClause;
+
+    auto result = txn.exec(deleteQuery);
+    deletedCount += result.affected_rows();
+  }
+
+  return deletedCount;
+}
+
 // Deletes records from PostgreSQL by their primary key values. Takes a vector
 // of deleted primary key vectors (for composite keys) and the pkColumns
-// vector. Builds a DELETE query with OR conditions for each deleted PK,
-// handling NULL values appropriately. Escapes SQL values to prevent
-// injection. Converts table name to lowercase. Returns the number of deleted
-// rows, or 0 if deletedPKs or pkColumns is empty. Logs errors but does not
-// throw exceptions. Used for handling deleted records during incremental sync.
+// vector. Ships the keys as typed arrays through deleteRecordsByKeyArrays,
+// handling NULL values appropriately, in a single transaction. Converts table
+// name to lowercase. Returns the number of deleted rows, or 0 if deletedPKs
+// or pkColumns is empty. Logs errors but does not throw exceptions. Used for
+// handling deleted records during incremental sync.
 size_t DatabaseToPostgresSync::deleteRecordsByPrimaryKey(
     pqxx::connection &pgConn, const std::string &lowerSchemaName,
     const std::string &table_name,
@@ -185,31 +846,9 @@ size_t DatabaseToPostgresSync::deleteRecordsByPrimaryKey(
                    lowerTableName.begin(), ::tolower);
     pqxx::work txn(pgConn);
 
-    std::string deleteQuery = "DELETE FROM " + txn.quote_name(lowerSchemaName) +
-                              "." + txn.quote_name(lowerTableName) + " WHERE (";
-
-    for (size_t i = 0; i < deletedPKs.size(); ++i) {
-      if (i > 0)
-        deleteQuery += " OR ";
-      deleteQuery += "(";
-      for (size_t j = 0; j < pkColumns.size(); ++j) {
-        if (j > 0)
-          deleteQuery += " AND ";
-        std::string value = deletedPKs[i][j];
-        if (value == "NULL" || value.empty()) {
-          deleteQuery += txn.quote_name(pkColumns[j]) + " IS NULL";
-        } else {
-          deleteQuery +=
-              txn.quote_name(pkColumns[j]) + " = " + txn.quote(value);
-        }
-      }
-      deleteQuery += ")";
-    }
-    deleteQuery += ")";
-
     try {
-      auto result = txn.exec(deleteQuery);
-      deletedCount = result.affected_rows();
+      deletedCount = deleteRecordsByKeyArrays(
+          txn, lowerSchemaName, lowerTableName, pkColumns, deletedPKs, 0);
       txn.commit();
     } catch (...) {
       try {
@@ -227,6 +866,12 @@ size_t DatabaseToPostgresSync::deleteRecordsByPrimaryKey(
   return deletedCount;
 }
 
+// Deletes records from PostgreSQL for tables without a primary key. Each
+// record holds the row hash followed by the values of every column; rows are
+// matched on all columns through deleteRecordsByKeyArrays, so the whole batch
+// is removed with set-based statements in a single transaction instead of one
+// DELETE per record. Returns the number of deleted rows. Logs errors but does
+// not throw exceptions.
 size_t DatabaseToPostgresSync::deleteRecordsByHash(
     pqxx::connection &pgConn, const std::string &lowerSchemaName,
     const std::string &table_name,
@@ -245,40 +890,18 @@ size_t DatabaseToPostgresSync::deleteRecordsByHash(
                    lowerTableName.begin(), ::tolower);
     pqxx::work txn(pgConn);
 
-    for (const auto &record : deletedRecords) {
-      if (record.size() < columnNames.size() + 1) {
-        continue;
-      }
-
-      std::string deleteQuery = "DELETE FROM " +
-                                txn.quote_name(lowerSchemaName) + "." +
-                                txn.quote_name(lowerTableName) + " WHERE (";
-
-      for (size_t j = 1; j < record.size() && (j - 1) < columnNames.size();
-           ++j) {
-        if (j > 1)
-          deleteQuery += " AND ";
-        std::string value = record[j];
-        if (value == "NULL" || value.empty()) {
-          deleteQuery += txn.quote_name(columnNames[j - 1]) + " IS NULL";
-        } else {
-          deleteQuery +=
-              txn.quote_name(columnNames[j - 1]) + " = " + txn.quote(value);
-        }
-      }
-      deleteQuery += ")";
-
+    try {
+      deletedCount = deleteRecordsByKeyArrays(
+          txn, lowerSchemaName, lowerTableName, columnNames, deletedRecords, 1);
+      txn.commit();
+    } catch (...) {
       try {
-        auto result = txn.exec(deleteQuery);
-        deletedCount += result.affected_rows();
-      } catch (const std::exception &e) {
-        Logger::warning(LogCategory::TRANSFER, "deleteRecordsByHash",
-                        "Error deleting record: " + std::string(e.what()));
+        txn.abort();
+      } catch (...) {
       }
+      throw;
     }
 
-    txn.commit();
-
   } catch (const std::exception &e) {
     Logger::error(LogCategory::TRANSFER, "deleteRecordsByHash",
                   "Error deleting records by hash: " + std::string(e.what()));
@@ -287,6 +910,238 @@ size_t DatabaseToPostgresSync::deleteRecordsByHash(
   return deletedCount;
 }
 
+// Starts the CDC batch of a catalog table: target names, columns and the
+// catalog entry its progress is saved to.
+DatabaseToPostgresSync::CDCApplyBatch DatabaseToPostgresSync::makeCDCApplyBatch(
+    const TableInfo &table, const std::vector<std::string> &columnNames,
+    const std::vector<std::string> &columnTypes,
+    const std::vector<std::string> &pkColumns) {
+  CDCApplyBatch batch;
+  batch.schemaName = table.schema_name;
+  batch.tableName = table.table_name;
+  batch.lowerSchemaName = table.schema_name;
+  std::transform(batch.lowerSchemaName.begin(), batch.lowerSchemaName.end(),
+                 batch.lowerSchemaName.begin(), ::tolower);
+  batch.lowerTableName = table.table_name;
+  std::transform(batch.lowerTableName.begin(), batch.lowerTableName.end(),
+                 batch.lowerTableName.begin(), ::tolower);
+  batch.columnNames = columnNames;
+  batch.columnTypes = columnTypes;
+  batch.pkColumns = pkColumns;
+  batch.dbEngine = table.db_engine;
+  batch.connectionString = table.connection_string;
+  return batch;
+}
+
+// Applies CDC batches with as few target commits as possible. Batches are
+// grouped in order until the next one would take the group past
+// CDC_GROUP_COMMIT_MAX_ROWS rows, and each group's deletes, upserts and
+// catalog progress run in one transaction, so progress is never saved
+// without its rows or the rows without their progress. A group that fails
+// is retried one batch per transaction; a batch that still fails is applied
+// by the non-transactional path with its row-by-row recovery and its
+// progress saved afterwards, as CDC did before. Tables that were sent back
+// to FULL_LOAD or RESET meanwhile keep their progress. Returns, per batch,
+// whether its progress was saved.
+std::vector<bool>
+DatabaseToPostgresSync::applyCDCBatches(pqxx::connection &pgConn,
+                                        std::vector<CDCApplyBatch> &batches) {
+  auto rowCount = [](const CDCApplyBatch &batch) {
+    return batch.deletes.size() + batch.upserts.size();
+  };
+
+  auto saveProgress = [&batches](pqxx::work &txn, size_t begin, size_t end) {
+    std::string values;
+    for (size_t i = begin; i < end; ++i) {
+      const CDCApplyBatch &batch = batches[i];
+      if (batch.progress.empty() && batch.elided == 0)
+        continue;
+      if (!values.empty())
+        values += ", ";
+      values += "(" + txn.quote(batch.schemaName) + ", " +
+                txn.quote(batch.tableName) + ", " +
+                txn.quote(batch.dbEngine) + ", " +
+                txn.quote(batch.connectionString) + ", " +
+                txn.quote(batch.progress.dump()) + ", " +
+                std::to_string(batch.elided) + ")";
+    }
+    if (values.empty())
+      return;
+    txn.exec(
+        "UPDATE metadata.catalog c SET sync_metadata = "
+        "COALESCE(c.sync_metadata, '{}'::jsonb) || v.progress::jsonb || "
+        "CASE WHEN v.elided > 0 THEN jsonb_build_object("
+        "'cdc_changes_elided', "
+        "COALESCE((c.sync_metadata->>'cdc_changes_elided')::bigint, 0) + "
+        "v.elided) ELSE '{}'::jsonb END FROM (VALUES " +
+        values +
+        ") AS v(schema_name, table_name, db_engine, connection_string, "
+        "progress, elided) WHERE c.schema_name = v.schema_name AND "
+        "c.table_name = v.table_name AND c.db_engine = v.db_engine AND "
+        "(v.connection_string = '' OR "
+        "c.connection_string = v.connection_string) AND "
+        "c.status NOT IN ('FULL_LOAD', 'RESET')");
+  };
+
+  auto applyGroup = [&](size_t begin, size_t end) {
+    try {
+      pqxx::work txn(pgConn);
+      for (size_t i = begin; i < end; ++i) {
+        CDCApplyBatch &batch = batches[i];
+        bool hasPK = !batch.pkColumns.empty();
+        const std::vector<std::string> &keyColumns =
+            hasPK ? batch.pkColumns : batch.columnNames;
+        batch.deleted =
+            batch.deletes.empty()
+                ? 0
+                : deleteRecordsByKeyArrays(txn, batch.lowerSchemaName,
+                                           batch.lowerTableName, keyColumns,
+                                           batch.deletes, hasPK ? 0 : 1);
+        batch.upserted =
+            stageAndUpsert(txn, batch.upserts, batch.columnNames,
+                           batch.columnTypes, batch.lowerSchemaName,
+                           batch.lowerTableName, keyColumns, hasPK);
+      }
+      std::lock_guard<std::mutex> lock(metadataUpdateMutex);
+      saveProgress(txn, begin, end);
+      txn.commit();
+      return true;
+    } catch (const std::exception &e) {
+      std::string tables;
+      for (size_t i = begin; i < end; ++i)
+        tables += (i > begin ? ", " : "") + batches[i].schemaName + "." +
+                  batches[i].tableName;
+      Logger::warning(LogCategory::TRANSFER, "applyCDCBatches",
+                      "Transactional apply failed for " + tables + ": " +
+                          std::string(e.what()));
+      return false;
+    }
+  };
+
+  auto applyRecovering = [&](size_t index) {
+    CDCApplyBatch &batch = batches[index];
+    std::string tableKey = batch.schemaName + "." + batch.tableName;
+    bool hasPK = !batch.pkColumns.empty();
+    batch.deleted =
+        hasPK ? deleteRecordsByPrimaryKey(pgConn, batch.lowerSchemaName,
+                                          batch.lowerTableName, batch.deletes,
+                                          batch.pkColumns)
+              : deleteRecordsByHash(pgConn, batch.lowerSchemaName,
+                                    batch.lowerTableName, batch.deletes,
+                                    batch.columnNames);
+    batch.upserted = 0;
+    if (!batch.upserts.empty()) {
+      try {
+        if (hasPK)
+          performBulkUpsert(pgConn, batch.upserts, batch.columnNames,
+                            batch.columnTypes, batch.lowerSchemaName,
+                            batch.lowerTableName, batch.schemaName);
+        else
+          performBulkUpsertNoPK(pgConn, batch.upserts, batch.columnNames,
+                                batch.columnTypes, batch.lowerSchemaName,
+                                batch.lowerTableName, batch.schemaName);
+        batch.upserted = batch.upserts.size();
+      } catch (const std::exception &e) {
+        Logger::error(LogCategory::TRANSFER, "applyCDCBatches",
+                      "Failed to upsert records for " + tableKey + ": " +
+                          std::string(e.what()));
+      }
+    }
+    try {
+      std::lock_guard<std::mutex> lock(metadataUpdateMutex);
+      pqxx::work txn(pgConn);
+      saveProgress(txn, index, index + 1);
+      txn.commit();
+      return true;
+    } catch (const std::exception &e) {
+      Logger::error(LogCategory::TRANSFER, "applyCDCBatches",
+                    "Error saving CDC progress for " + tableKey + ": " +
+                        std::string(e.what()));
+      return false;
+    }
+  };
+
+  std::vector<bool> saved(batches.size(), false);
+  size_t begin = 0;
+  while (begin < batches.size()) {
+    size_t end = begin + 1;
+    size_t rows = rowCount(batches[begin]);
+    while (end < batches.size() &&
+           rows + rowCount(batches[end]) <= CDC_GROUP_COMMIT_MAX_ROWS) {
+      rows += rowCount(batches[end]);
+      ++end;
+    }
+
+    if (applyGroup(begin, end)) {
+      std::fill(saved.begin() + begin, saved.begin() + end, true);
+    } else {
+      for (size_t i = begin; i < end; ++i)
+        saved[i] = (end - begin > 1 && applyGroup(i, i + 1)) ||
+                   applyRecovering(i);
+    }
+    begin = end;
+  }
+
+  for (const CDCApplyBatch &batch : batches)
+    TableScheduler::forEngine(batch.dbEngine)
+        .recordChanges(batch.schemaName + "." + batch.tableName,
+                       rowCount(batch) + batch.elided);
+  return saved;
+}
+
+struct DatabaseToPostgresSync::QueuedCDCBatch {
+  CDCApplyBatch *batch;
+  bool done = false;
+  bool saved = false;
+};
+
+// Applies one table's CDC batch through the group commit and waits until it
+// is on the target. The first worker to find no commit running takes every
+// batch queued by then, its own included, and applies them together with
+// applyCDCBatches on its connection; batches queued meanwhile form the next
+// group. Under load many small table batches share one commit, and a
+// worker alone commits immediately. Returns whether the progress was saved.
+bool DatabaseToPostgresSync::commitCDCBatch(pqxx::connection &pgConn,
+                                            CDCApplyBatch &batch) {
+  QueuedCDCBatch queued{&batch};
+  std::unique_lock<std::mutex> lock(cdcCommitMutex_);
+  cdcCommitQueue_.push_back(&queued);
+  while (!queued.done) {
+    if (cdcCommitRunning_) {
+      cdcCommitDone_.wait(lock);
+      continue;
+    }
+    cdcCommitRunning_ = true;
+    std::vector<QueuedCDCBatch *> group;
+    group.swap(cdcCommitQueue_);
+    lock.unlock();
+
+    std::vector<CDCApplyBatch> batches;
+    batches.reserve(group.size());
+    for (QueuedCDCBatch *entry : group)
+      batches.push_back(std::move(*entry->batch));
+    std::vector<bool> saved;
+    try {
+      saved = applyCDCBatches(pgConn, batches);
+    } catch (const std::exception &e) {
+      Logger::error(LogCategory::TRANSFER, "commitCDCBatch",
+                    "Group commit failed: " + std::string(e.what()));
+      saved.assign(batches.size(), false);
+    }
+    for (size_t i = 0; i < group.size(); ++i)
+      *group[i]->batch = std::move(batches[i]);
+
+    lock.lock();
+    for (size_t i = 0; i < group.size(); ++i) {
+      group[i]->saved = saved[i];
+      group[i]->done = true;
+    }
+    cdcCommitRunning_ = false;
+    cdcCommitDone_.notify_all();
+  }
+  return queued.saved;
+}
+
 // Retrieves primary key column names from PostgreSQL's information_schema for
 // a specific table. Queries table_constraints and key_column_usage to find
 // PRIMARY KEY constraints. Returns columns ordered by ordinal_position for
@@ -548,14 +1403,659 @@ bool DatabaseToPostgresSync::compareAndUpdateRecord(
   }
 }
 
+// Streams rows into a PostgreSQL table with COPY ... FROM STDIN through
+// pqxx::stream_to. nextRow fills the values of the next row and returns false
+// once there are no more rows; std::nullopt is written as SQL NULL. All rows
+// are loaded in a single transaction, which is rolled back if anything fails.
+// Returns the number of rows written.
+size_t DatabaseToPostgresSync::copyRowsToTable(
+    pqxx::connection &pgConn, const std::vector<std::string> &columnNames,
+    const std::string &lowerSchemaName, const std::string &tableName,
+    const std::function<bool(std::vector<std::optional<std::string>> &)>
+        &nextRow) {
+  std::string lowerTableName = tableName;
+  std::transform(lowerTableName.begin(), lowerTableName.end(),
+                 lowerTableName.begin(), ::tolower);
+
+  pqxx::work txn(pgConn);
+  txn.exec("SET statement_timeout = '" +
+           std::to_string(STATEMENT_TIMEOUT_SECONDS) + "s'");
+
+  std::string columnList;
+  for (size_t i = 0; i < columnNames.size(); ++i) {
+    if (i > 0)
+      columnList += ", ";
+    std::string col = columnNames[i];
+    std::transform(col.begin(), col.end(), col.begin(), ::tolower);
+    columnList += txn.quote_name(col);
+  }
+
+  size_t rowsWritten = 0;
+  std::string targetTable =
+      txn.quote_name(lowerSchemaName) + "." + txn.quote_name(lowerTableName);
+  auto stream = pqxx::stream_to::raw_table(txn, targetTable, columnList);
+
+  std::vector<std::optional<std::string>> copyRow;
+  while (nextRow(copyRow)) {
+    stream.write_row(copyRow);
+    ++rowsWritten;
+  }
+
+  stream.complete();
+  txn.commit();
+  return rowsWritten;
+}
+
+// Runs a full load as a three stage pipeline so the source, the value
+// conversion and PostgreSQL work at the same time: the calling thread fetches
+// chunks with fetchChunk, a converter thread cleans them with the column
+// converter plan and a writer thread COPYs them over its own connection. The
+// stages are connected by a DataChunk and a PreparedBatch ring of
+// PIPELINE_DEPTH entries each, so at most a couple of chunks are in flight
+// and a slow stage holds the others back instead of buffering the table.
+// There is a single writer, so chunks are committed in fetch order and
+// onChunkWritten can checkpoint after each one. Once a batch is written its
+// source and converted RowBatches go back through a free ring to the fetch
+// and convert stages, which reset and refill them, so the arenas are only
+// allocated while the pipeline fills up. A write failure stops the fetch;
+// returns false in that case and true once every fetched chunk has been
+// committed.
+bool DatabaseToPostgresSync::runFullLoadPipeline(
+    const std::string &lowerSchemaName, const std::string &tableName,
+    const std::string &sourceSchemaName,
+    const std::vector<std::string> &columnNames,
+    const std::vector<std::string> &columnTypes,
+    const ChunkFetcher &fetchChunk, const ChunkWritten &onChunkWritten) {
+  LockFreeRingQueue<DataChunk> fetchedChunks(PIPELINE_DEPTH);
+  LockFreeRingQueue<PreparedBatch> convertedBatches(PIPELINE_DEPTH);
+  LockFreeRingQueue<RowBatch> freeRows(4 * PIPELINE_DEPTH + 2);
+  std::atomic<bool> failed{false};
+
+  // Hands out a drained RowBatch when one is available, otherwise a new
+  // one; callers reset it to their column count before filling it.
+  auto takeRows = [&]() {
+    RowBatch rows;
+    freeRows.pop(rows, std::chrono::milliseconds(0));
+    return rows;
+  };
+  auto recycleRows = [&](RowBatch &rows) {
+    freeRows.tryPush(rows, std::chrono::milliseconds(0));
+  };
+
+  auto abort = [&]() {
+    failed = true;
+    fetchedChunks.shutdown_queue();
+    convertedBatches.shutdown_queue();
+  };
+
+  std::thread converter([&]() {
+    try {
+      std::vector<ColumnConverter> converters =
+          buildConverterPlan(columnTypes);
+      DataChunk chunk;
+      while (fetchedChunks.popBlocking(chunk) && !chunk.isLastChunk) {
+        PreparedBatch batch;
+        batch.chunkNumber = chunk.chunkNumber;
+        batch.schemaName = chunk.schemaName;
+        batch.tableName = chunk.tableName;
+        batch.batchSize = chunk.rows.rowCount();
+        batch.rows = takeRows();
+        batch.rows.reset(chunk.rows.columnCount());
+        batch.rows.reserve(chunk.rows.rowCount());
+        for (size_t i = 0; i < chunk.rows.rowCount(); ++i) {
+          for (size_t j = 0; j < chunk.rows.columnCount(); ++j) {
+            std::string_view value = chunk.rows.value(i, j);
+            if (chunk.rows.isNull(i, j) || value.empty() ||
+                j >= converters.size()) {
+              batch.rows.appendNull(j);
+              continue;
+            }
+            std::string cleanValue = converters[j](std::string(value));
+            if (cleanValue == "NULL")
+              batch.rows.appendNull(j);
+            else
+              batch.rows.append(j, cleanValue);
+          }
+          batch.rows.finishRow();
+        }
+        batch.sourceRows = std::move(chunk.rows);
+        batch.lastKey = std::move(chunk.lastKey);
+        if (!convertedBatches.push(std::move(batch)))
+          return;
+      }
+      PreparedBatch lastBatch;
+      lastBatch.batchSize = 0;
+      convertedBatches.push(std::move(lastBatch));
+    } catch (const std::exception &e) {
+      Logger::error(LogCategory::TRANSFER, "runFullLoadPipeline",
+                    "Error converting chunk for " + lowerSchemaName + "." +
+                        tableName + ": " + std::string(e.what()));
+      abort();
+    }
+  });
+
+  std::thread writer([&]() {
+    try {
+      pqxx::connection pgConn(DatabaseConfig::getPostgresConnectionString());
+      PreparedBatch batch;
+      while (convertedBatches.popBlocking(batch) && batch.batchSize > 0) {
+        writePreparedBatch(pgConn, batch, columnNames, columnTypes,
+                           lowerSchemaName, tableName, sourceSchemaName);
+        if (onChunkWritten)
+          onChunkWritten(pgConn, batch);
+        recycleRows(batch.rows);
+        recycleRows(batch.sourceRows);
+      }
+    } catch (const std::exception &e) {
+      Logger::error(LogCategory::TRANSFER, "runFullLoadPipeline",
+                    "Error writing chunk for " + lowerSchemaName + "." +
+                        tableName + ": " + std::string(e.what()));
+      abort();
+    }
+  });
+
+  try {
+    size_t chunkNumber = 0;
+    bool moreChunks = true;
+    while (moreChunks && !failed) {
+      DataChunk chunk;
+      chunk.rows = takeRows();
+      moreChunks = fetchChunk(chunk.rows, chunk.lastKey);
+      if (chunk.rows.empty())
+        break;
+      chunk.chunkNumber = ++chunkNumber;
+      chunk.schemaName = sourceSchemaName;
+      chunk.tableName = tableName;
+      if (!fetchedChunks.push(std::move(chunk)))
+        break;
+    }
+  } catch (const std::exception &e) {
+    Logger::error(LogCategory::TRANSFER, "runFullLoadPipeline",
+                  "Error fetching chunk for " + lowerSchemaName + "." +
+                      tableName + ": " + std::string(e.what()));
+    abort();
+  }
+
+  if (!failed) {
+    DataChunk lastChunk;
+    lastChunk.isLastChunk = true;
+    fetchedChunks.push(std::move(lastChunk));
+  }
+
+  converter.join();
+  writer.join();
+
+  logWaitStats(lowerSchemaName + "." + tableName + " fetch->convert",
+               fetchedChunks.waitStats());
+  logWaitStats(lowerSchemaName + "." + tableName + " convert->write",
+               convertedBatches.waitStats());
+  return !failed;
+}
+
+// Writes one converted batch of the full load pipeline with COPY. When COPY
+// fails (typically a duplicate key from rows already in the target) the
+// source values are applied with performBulkUpsert instead, like
+// performBulkLoad does.
+void DatabaseToPostgresSync::writePreparedBatch(
+    pqxx::connection &pgConn, const PreparedBatch &batch,
+    const std::vector<std::string> &columnNames,
+    const std::vector<std::string> &columnTypes,
+    const std::string &lowerSchemaName, const std::string &tableName,
+    const std::string &sourceSchemaName) {
+  try {
+    size_t next = 0;
+    copyRowsToTable(
+        pgConn, columnNames, lowerSchemaName, tableName,
+        [&](std::vector<std::optional<std::string>> &copyRow) {
+          if (next >= batch.rows.rowCount())
+            return false;
+          copyRow.resize(batch.rows.columnCount());
+          for (size_t j = 0; j < batch.rows.columnCount(); ++j) {
+            if (batch.rows.isNull(next, j))
+              copyRow[j].reset();
+            else
+              copyRow[j] = std::string(batch.rows.value(next, j));
+          }
+          ++next;
+          return true;
+        });
+    return;
+  } catch (const pqxx::broken_connection &) {
+    throw;
+  } catch (const std::exception &e) {
+    Logger::warning(LogCategory::TRANSFER, "writePreparedBatch",
+                    "COPY failed for " + lowerSchemaName + "." + tableName +
+                        ", falling back to UPSERT: " + std::string(e.what()));
+  }
+
+  performBulkUpsert(pgConn, batch.sourceRows.toRows(), columnNames,
+                    columnTypes, lowerSchemaName, tableName, sourceSchemaName);
+}
+
+// Performs a bulk load into PostgreSQL using COPY ... FROM STDIN through
+// pqxx::stream_to. Values are cleaned with the column converters exactly like
+// the INSERT path (empty source values and a "NULL" result become SQL NULL),
+// but rows are streamed to the server instead of being rendered into a
+// quoted INSERT statement, so there is no per-value quoting, no statement
+// parsing and no MAX_QUERY_SIZE limit. All rows are loaded in a single
+// transaction; on any error the transaction is rolled back and the exception
+// is rethrown so callers can fall back to the INSERT/UPSERT paths. Returns
+// the number of rows written.
+size_t DatabaseToPostgresSync::performBulkCopy(
+    pqxx::connection &pgConn,
+    const std::vector<std::vector<std::string>> &results,
+    const std::vector<std::string> &columnNames,
+    const std::vector<std::string> &columnTypes,
+    const std::string &lowerSchemaName, const std::string &tableName) {
+  if (results.empty() || columnNames.empty() || columnTypes.empty()) {
+    return 0;
+  }
+
+  if (columnNames.size() != columnTypes.size()) {
+    Logger::error(LogCategory::TRANSFER, "performBulkCopy",
+                  "Mismatch between column names and types count");
+    throw std::invalid_argument("Column names and types count mismatch");
+  }
+
+  std::vector<ColumnConverter> converters = buildConverterPlan(columnTypes);
+  size_t next = 0;
+  return copyRowsToTable(
+      pgConn, columnNames, lowerSchemaName, tableName,
+      [&](std::vector<std::optional<std::string>> &copyRow) {
+        while (next < results.size()) {
+          const auto &row = results[next++];
+          if (row.size() != columnNames.size()) {
+            Logger::warning(LogCategory::TRANSFER, "performBulkCopy",
+                            "Row size mismatch: " +
+                                std::to_string(row.size()) + " vs " +
+                                std::to_string(columnNames.size()));
+            continue;
+          }
+          fillCopyRow(row, converters, copyRow);
+          return true;
+        }
+        return false;
+      });
+}
+
+// RowBatch overload of performBulkCopy. Values are read straight from the
+// batch arena; NULL cells are written as SQL NULL and every other value is
+// cleaned with the column converters.
+size_t DatabaseToPostgresSync::performBulkCopy(
+    pqxx::connection &pgConn, const RowBatch &rows,
+    const std::vector<std::string> &columnNames,
+    const std::vector<std::string> &columnTypes,
+    const std::string &lowerSchemaName, const std::string &tableName) {
+  if (rows.empty() || columnNames.empty() || columnTypes.empty()) {
+    return 0;
+  }
+
+  if (columnNames.size() != columnTypes.size() ||
+      rows.columnCount() != columnNames.size()) {
+    Logger::error(LogCategory::TRANSFER, "performBulkCopy",
+                  "Mismatch between batch columns, names and types count");
+    throw std::invalid_argument("Column names and types count mismatch");
+  }
+
+  std::vector<ColumnConverter> converters = buildConverterPlan(columnTypes);
+  size_t next = 0;
+  return copyRowsToTable(
+      pgConn, columnNames, lowerSchemaName, tableName,
+      [&](std::vector<std::optional<std::string>> &copyRow) {
+        if (next >= rows.rowCount())
+          return false;
+        fillCopyRow(rows, next++, converters, copyRow);
+        return true;
+      });
+}
+
+// Default converter for a column: defers to cleanValueForPostgres with the
+// column type. Engines override compileColumnConverter to resolve the type
+// once and return a converter that does no type-name parsing per value.
+DatabaseToPostgresSync::ColumnConverter
+DatabaseToPostgresSync::compileColumnConverter(const std::string &columnType) {
+  return [this, columnType](const std::string &value) {
+    return cleanValueForPostgres(value, columnType);
+  };
+}
+
+// Builds the converter plan for a set of columns: one converter per column,
+// in column order. Built once per batch or table and then applied to every
+// cell, so the per-cell loops never look at type names.
+std::vector<DatabaseToPostgresSync::ColumnConverter>
+DatabaseToPostgresSync::buildConverterPlan(
+    const std::vector<std::string> &columnTypes) {
+  std::vector<ColumnConverter> plan;
+  plan.reserve(columnTypes.size());
+  for (const auto &columnType : columnTypes) {
+    plan.push_back(compileColumnConverter(columnType));
+  }
+  return plan;
+}
+
+// Converts a source row into the nullable values written by the COPY based
+// writers. Values are cleaned with the column converters; empty source values
+// and a "NULL" result become SQL NULL, matching the INSERT ... VALUES paths.
+void DatabaseToPostgresSync::fillCopyRow(
+    const std::vector<std::string> &row,
+    const std::vector<ColumnConverter> &converters,
+    std::vector<std::optional<std::string>> &copyRow) {
+  copyRow.resize(row.size());
+  for (size_t j = 0; j < row.size() && j < converters.size(); ++j) {
+    if (row[j].empty()) {
+      copyRow[j].reset();
+      continue;
+    }
+    std::string cleanValue = converters[j](row[j]);
+    if (cleanValue == "NULL") {
+      copyRow[j].reset();
+    } else {
+      copyRow[j] = std::move(cleanValue);
+    }
+  }
+}
+
+// RowBatch overload of fillCopyRow for a single row of the batch.
+void DatabaseToPostgresSync::fillCopyRow(
+    const RowBatch &rows, size_t row,
+    const std::vector<ColumnConverter> &converters,
+    std::vector<std::optional<std::string>> &copyRow) {
+  copyRow.resize(rows.columnCount());
+  for (size_t j = 0; j < rows.columnCount() && j < converters.size(); ++j) {
+    std::string_view value = rows.value(row, j);
+    if (rows.isNull(row, j) || value.empty()) {
+      copyRow[j].reset();
+      continue;
+    }
+    std::string cleanValue = converters[j](std::string(value));
+    if (cleanValue == "NULL") {
+      copyRow[j].reset();
+    } else {
+      copyRow[j] = std::move(cleanValue);
+    }
+  }
+}
+
+// Performs a set-based UPSERT through a session staging table. The batch is
+// COPYed into a TEMP table with one TEXT column per source column (created
+// once per connection and emptied on commit), rows that cannot be cast to the
+// target column types or that carry a NULL primary key are removed with a
+// single validation statement, and the remaining rows are applied with one
+// INSERT ... SELECT ... ON CONFLICT DO UPDATE. Tables without a primary key
+// pass every column as conflict columns with keyIsPrimary false, which keeps
+// rows with NULL columns as the batched VALUES path does. When a key appears
+// more than once in the batch the last occurrence wins. Staged values are
+// cast to the base types of the target columns and only take on their
+// modifiers when inserted, so a value too long for a varchar(n) or char(n)
+// column fails the statement like a direct INSERT instead of being cut by
+// the explicit cast. Type validation relies on pg_input_is_valid and is
+// only done on PostgreSQL 16+; on older servers a bad value fails the
+// statement. Everything runs in one
+// transaction and the exception is rethrown on failure so callers can fall
+// back to the batched VALUES path. Returns the number of rows applied.
+size_t DatabaseToPostgresSync::performStagedUpsert(
+    pqxx::connection &pgConn,
+    const std::vector<std::vector<std::string>> &results,
+    const std::vector<std::string> &columnNames,
+    const std::vector<std::string> &columnTypes,
+    const std::string &lowerSchemaName, const std::string &tableName,
+    const std::vector<std::string> &conflictColumns, bool keyIsPrimary) {
+  if (results.empty() || columnNames.empty() || conflictColumns.empty()) {
+    return 0;
+  }
+
+  pqxx::work txn(pgConn);
+  size_t applied =
+      stageAndUpsert(txn, results, columnNames, columnTypes, lowerSchemaName,
+                     tableName, conflictColumns, keyIsPrimary);
+  txn.commit();
+  return applied;
+}
+
+// The staged UPSERT of performStagedUpsert inside the caller's transaction.
+// The staging table is emptied again afterwards, so several batches can be
+// staged in the same transaction.
+size_t DatabaseToPostgresSync::stageAndUpsert(
+    pqxx::work &txn, const std::vector<std::vector<std::string>> &results,
+    const std::vector<std::string> &columnNames,
+    const std::vector<std::string> &columnTypes,
+    const std::string &lowerSchemaName, const std::string &tableName,
+    const std::vector<std::string> &conflictColumns, bool keyIsPrimary) {
+  if (results.empty() || columnNames.empty() || conflictColumns.empty()) {
+    return 0;
+  }
+
+  if (columnNames.size() != columnTypes.size()) {
+    Logger::error(LogCategory::TRANSFER, "performStagedUpsert",
+                  "Mismatch between column names and types count");
+    throw std::invalid_argument("Column names and types count mismatch");
+  }
+
+  std::string lowerTableName = tableName;
+  std::transform(lowerTableName.begin(), lowerTableName.end(),
+                 lowerTableName.begin(), ::tolower);
+
+  std::vector<std::string> lowerColumns;
+  lowerColumns.reserve(columnNames.size());
+  for (const auto &name : columnNames) {
+    std::string col = name;
+    std::transform(col.begin(), col.end(), col.begin(), ::tolower);
+    lowerColumns.push_back(col);
+  }
+
+  std::vector<std::string> lowerConflictColumns;
+  lowerConflictColumns.reserve(conflictColumns.size());
+  for (const auto &name : conflictColumns) {
+    std::string col = name;
+    std::transform(col.begin(), col.end(), col.begin(), ::tolower);
+    lowerConflictColumns.push_back(col);
+  }
+
+  std::string stageSignature = lowerSchemaName + "." + lowerTableName;
+  for (const auto &col : lowerColumns)
+    stageSignature += "|" + col;
+  std::string stageName =
+      "ds_stage_" + std::to_string(std::hash<std::string>{}(stageSignature));
+
+  txn.exec("SET statement_timeout = '" +
+           std::to_string(STATEMENT_TIMEOUT_SECONDS) + "s'");
+
+  std::string targetTable =
+      txn.quote_name(lowerSchemaName) + "." + txn.quote_name(lowerTableName);
+  std::string stageTable = txn.quote_name(stageName);
+
+  auto targetTypes = getColumnTypesFromPostgres(txn, targetTable, true);
+
+  std::string stageColumns = "_ds_row BIGINT";
+  std::string copyColumns = "_ds_row";
+  std::string insertColumns;
+  std::string castColumns;
+  std::string validation;
+  bool validateTypes = txn.conn().server_version() >= 160000;
+  for (size_t i = 0; i < lowerColumns.size(); ++i) {
+    std::string quoted = txn.quote_name(lowerColumns[i]);
+    auto typeIt = targetTypes.find(lowerColumns[i]);
+    if (typeIt == targetTypes.end()) {
+      throw std::runtime_error("Column " + lowerColumns[i] +
+                               " not found in " + targetTable);
+    }
+
+    stageColumns += ", " + quoted + " TEXT";
+    copyColumns += ", " + quoted;
+    if (i > 0) {
+      insertColumns += ", ";
+      castColumns += ", ";
+    }
+    insertColumns += quoted;
+    castColumns += quoted + "::" + typeIt->second + " AS " + quoted;
+
+    if (validateTypes) {
+      if (!validation.empty())
+        validation += " AND ";
+      validation += "(" + quoted + " IS NULL OR pg_input_is_valid(" + quoted +
+                    ", " + txn.quote(typeIt->second) + "))";
+    }
+  }
+
+  std::string conflictList;
+  for (size_t i = 0; i < lowerConflictColumns.size(); ++i) {
+    if (i > 0)
+      conflictList += ", ";
+    conflictList += txn.quote_name(lowerConflictColumns[i]);
+    if (!keyIsPrimary)
+      continue;
+    if (!validation.empty())
+      validation += " AND ";
+    validation += txn.quote_name(lowerConflictColumns[i]) + " IS NOT NULL";
+  }
+
+  txn.exec("CREATE TEMP TABLE IF NOT EXISTS " + stageTable + " (" +
+           stageColumns + ") ON COMMIT DELETE ROWS");
+
+  {
+    std::vector<ColumnConverter> converters = buildConverterPlan(columnTypes);
+    auto stream = pqxx::stream_to::raw_table(txn, stageTable, copyColumns);
+    std::vector<std::optional<std::string>> copyRow;
+    std::vector<std::optional<std::string>> stageRow(lowerColumns.size() + 1);
+    size_t rowNumber = 0;
+    for (const auto &row : results) {
+      ++rowNumber;
+      if (row.size() != columnNames.size()) {
+        Logger::warning(LogCategory::TRANSFER, "performStagedUpsert",
+                        "Row size mismatch: " + std::to_string(row.size()) +
+                            " vs " + std::to_string(columnNames.size()));
+        continue;
+      }
+      fillCopyRow(row, converters, copyRow);
+      stageRow[0] = std::to_string(rowNumber);
+      std::move(copyRow.begin(), copyRow.end(), stageRow.begin() + 1);
+      stream.write_row(stageRow);
+    }
+    stream.complete();
+  }
+
+  pqxx::result badRows;
+  if (!validation.empty())
+    badRows =
+        txn.exec("WITH bad AS (DELETE FROM " + stageTable + " WHERE NOT (" +
+                 validation + ") RETURNING _ds_row) "
+                 "SELECT COUNT(*), MIN(_ds_row), MAX(_ds_row) FROM bad");
+  size_t rejected = badRows.empty() ? 0 : badRows[0][0].as<size_t>();
+  if (rejected > 0) {
+    Logger::warning(LogCategory::TRANSFER, "performStagedUpsert",
+                    "Skipped " + std::to_string(rejected) +
+                        " invalid rows for " + lowerSchemaName + "." +
+                        lowerTableName + " (batch rows " +
+                        badRows[0][1].as<std::string>() + "-" +
+                        badRows[0][2].as<std::string>() + ")");
+  }
+
+  std::string updateList;
+  for (size_t i = 0; i < lowerColumns.size(); ++i) {
+    if (i > 0)
+      updateList += ", ";
+    std::string quoted = txn.quote_name(lowerColumns[i]);
+    updateList += quoted + " = EXCLUDED." + quoted;
+  }
+
+  auto applied = txn.exec(
+      "INSERT INTO " + targetTable + " (" + insertColumns + ") "
+      "SELECT DISTINCT ON (" + conflictList + ") " + insertColumns +
+      " FROM (SELECT _ds_row, " + castColumns + " FROM " + stageTable +
+      ") staged ORDER BY " + conflictList + ", _ds_row DESC"
+      " ON CONFLICT (" + conflictList + ") DO UPDATE SET " + updateList);
+
+  txn.exec("TRUNCATE " + stageTable);
+  return applied.affected_rows();
+}
+
+// Performs a bulk INSERT into PostgreSQL for a set of rows. Uses the COPY
+// writer (performBulkCopy) by default and falls back to the INSERT ... VALUES
+// path (performBulkInsertValues) when COPY fails, e.g. because a value is
+// rejected by the target type. Throws exceptions on error to allow caller to
+// handle failures. Used for initial full loads of tables.
+void DatabaseToPostgresSync::performBulkInsert(
+    pqxx::connection &pgConn,
+    const std::vector<std::vector<std::string>> &results,
+    const std::vector<std::string> &columnNames,
+    const std::vector<std::string> &columnTypes,
+    const std::string &lowerSchemaName, const std::string &tableName) {
+  try {
+    performBulkCopy(pgConn, results, columnNames, columnTypes,
+                    lowerSchemaName, tableName);
+    return;
+  } catch (const pqxx::broken_connection &) {
+    throw;
+  } catch (const std::exception &e) {
+    Logger::warning(LogCategory::TRANSFER, "performBulkInsert",
+                    "COPY failed for " + lowerSchemaName + "." + tableName +
+                        ", falling back to INSERT: " + std::string(e.what()));
+  }
+
+  performBulkInsertValues(pgConn, results, columnNames, columnTypes,
+                          lowerSchemaName, tableName);
+}
+
+// Loads a chunk of a full load into PostgreSQL. Uses the COPY writer by
+// default since the target table has been truncated before a full load, and
+// falls back to performBulkUpsert when COPY fails (typically a duplicate key
+// when a chunk overlaps rows already present in the target). Throws
+// exceptions on error to allow caller to handle failures.
+void DatabaseToPostgresSync::performBulkLoad(
+    pqxx::connection &pgConn,
+    const std::vector<std::vector<std::string>> &results,
+    const std::vector<std::string> &columnNames,
+    const std::vector<std::string> &columnTypes,
+    const std::string &lowerSchemaName, const std::string &tableName,
+    const std::string &sourceSchemaName) {
+  try {
+    performBulkCopy(pgConn, results, columnNames, columnTypes,
+                    lowerSchemaName, tableName);
+    return;
+  } catch (const pqxx::broken_connection &) {
+    throw;
+  } catch (const std::exception &e) {
+    Logger::warning(LogCategory::TRANSFER, "performBulkLoad",
+                    "COPY failed for " + lowerSchemaName + "." + tableName +
+                        ", falling back to UPSERT: " + std::string(e.what()));
+  }
+
+  performBulkUpsert(pgConn, results, columnNames, columnTypes,
+                    lowerSchemaName, tableName, sourceSchemaName);
+}
+
+// RowBatch overload of performBulkLoad. The batch is only materialized as
+// rows of strings when COPY fails and the UPSERT fallback is needed.
+void DatabaseToPostgresSync::performBulkLoad(
+    pqxx::connection &pgConn, const RowBatch &rows,
+    const std::vector<std::string> &columnNames,
+    const std::vector<std::string> &columnTypes,
+    const std::string &lowerSchemaName, const std::string &tableName,
+    const std::string &sourceSchemaName) {
+  try {
+    performBulkCopy(pgConn, rows, columnNames, columnTypes, lowerSchemaName,
+                    tableName);
+    return;
+  } catch (const pqxx::broken_connection &) {
+    throw;
+  } catch (const std::exception &e) {
+    Logger::warning(LogCategory::TRANSFER, "performBulkLoad",
+                    "COPY failed for " + lowerSchemaName + "." + tableName +
+                        ", falling back to UPSERT: " + std::string(e.what()));
+  }
+
+  performBulkUpsert(pgConn, rows.toRows(), columnNames, columnTypes,
+                    lowerSchemaName, tableName, sourceSchemaName);
+}
+
 // Performs a bulk INSERT operation into PostgreSQL. Takes a vector of result
 // rows, column names, column types, schema name, and table name. Processes
-// rows in batches using SyncConfig::getChunkSize(). Cleans values using
-// cleanValueForPostgres and escapes SQL values. Sets statement_timeout to 600s
-// for large batches. Commits the transaction after all batches. Throws
-// exceptions on error to allow caller to handle failures. Used for initial
-// full loads of tables.
-void DatabaseToPostgresSync::performBulkInsert(
+// rows in batches using SyncConfig::getChunkSize(). Cleans values using the
+// column converter plan and escapes SQL values. Sets statement_timeout to
+// 600s for large batches. Commits the transaction after all batches. Throws
+// exceptions on error to allow caller to handle failures. Used as the
+// fallback when the COPY writer cannot load a batch.
+void DatabaseToPostgresSync::performBulkInsertValues(
     pqxx::connection &pgConn,
     const std::vector<std::vector<std::string>> &results,
     const std::vector<std::string> &columnNames,
@@ -563,13 +2063,13 @@ void DatabaseToPostgresSync::performBulkInsert(
     const std::string &lowerSchemaName, const std::string &tableName) {
   try {
     if (results.empty() || columnNames.empty() || columnTypes.empty()) {
-      Logger::warning(LogCategory::TRANSFER, "performBulkInsert",
+      Logger::warning(LogCategory::TRANSFER, "performBulkInsertValues",
                       "Empty results, columns, or types - nothing to insert");
       return;
     }
 
     if (columnNames.size() != columnTypes.size()) {
-      Logger::error(LogCategory::TRANSFER, "performBulkInsert",
+      Logger::error(LogCategory::TRANSFER, "performBulkInsertValues",
                     "Mismatch between column names and types count");
       throw std::invalid_argument("Column names and types count mismatch");
     }
@@ -588,6 +2088,8 @@ void DatabaseToPostgresSync::performBulkInsert(
             ? DEFAULT_BATCH_SIZE
             : rawBatchSize;
     size_t totalProcessed = 0;
+    std::vector<ColumnConverter> converters =
+        buildConverterPlan(columnTypes);
 
     std::string baseInsertQuery = "INSERT INTO " +
                                   txn.quote_name(lowerSchemaName) + "." +
@@ -612,7 +2114,7 @@ void DatabaseToPostgresSync::performBulkInsert(
       for (size_t i = batchStart; i < batchEnd; ++i) {
         const auto &row = results[i];
         if (row.size() != columnNames.size()) {
-          Logger::warning(LogCategory::TRANSFER, "performBulkInsert",
+          Logger::warning(LogCategory::TRANSFER, "performBulkInsertValues",
                           "Row size mismatch: " + std::to_string(row.size()) +
                               " vs " + std::to_string(columnNames.size()));
           continue;
@@ -626,8 +2128,7 @@ void DatabaseToPostgresSync::performBulkInsert(
           if (row[j].empty()) {
             rowValues += "NULL";
           } else {
-            std::string cleanValue =
-                cleanValueForPostgres(row[j], columnTypes[j]);
+            std::string cleanValue = converters[j](row[j]);
             if (cleanValue == "NULL") {
               rowValues += "NULL";
             } else {
@@ -660,7 +2161,7 @@ void DatabaseToPostgresSync::performBulkInsert(
     txn.commit();
 
   } catch (const std::exception &e) {
-    Logger::error(LogCategory::TRANSFER, "performBulkInsert",
+    Logger::error(LogCategory::TRANSFER, "performBulkInsertValues",
                   "Error in bulk insert: " + std::string(e.what()));
     throw;
   }
@@ -669,10 +2170,11 @@ void DatabaseToPostgresSync::performBulkInsert(
 // Worker thread function for parallel batch insertion. Continuously pops
 // PreparedBatch items from preparedBatchQueue and executes them. Sets
 // statement_timeout to 600s for each batch. Tracks total processed rows and
-// chunk numbers. Pushes ProcessedResult items to resultQueue after each
-// batch. Stops when a batch with batchSize == 0 is received (shutdown
-// signal). Logs errors for failed batches but continues processing. Used in
-// parallel processing pipeline for high-throughput data transfer.
+// chunk numbers. Offers ProcessedResult items to resultQueue after each
+// batch without waiting for space. Stops when a batch with batchSize == 0 is
+// received (shutdown signal). Logs errors for failed batches but continues
+// processing. Used in parallel processing pipeline for high-throughput data
+// transfer.
 void DatabaseToPostgresSync::batchInserterThread(pqxx::connection &pgConn) {
 
   try {
@@ -722,7 +2224,9 @@ void DatabaseToPostgresSync::batchInserterThread(pqxx::connection &pgConn) {
                           result.errorMessage);
       }
 
-      resultQueue.push(std::move(result));
+      // Nothing blocks on results, so a full result queue must never stall
+      // the inserter.
+      resultQueue.tryPush(result, std::chrono::milliseconds(0));
     }
 
   } catch (const std::exception &e) {
@@ -773,6 +2277,19 @@ void DatabaseToPostgresSync::performBulkUpsert(
       return;
     }
 
+    try {
+      performStagedUpsert(pgConn, results, columnNames, columnTypes,
+                          lowerSchemaName, tableName, pkColumns, true);
+      return;
+    } catch (const pqxx::broken_connection &) {
+      throw;
+    } catch (const std::exception &e) {
+      Logger::warning(LogCategory::TRANSFER, "performBulkUpsert",
+                      "Staged upsert failed for " + lowerSchemaName + "." +
+                          tableName + ", falling back to batched UPSERT: " +
+                          std::string(e.what()));
+    }
+
     std::string upsertQuery =
         buildUpsertQuery(columnNames, pkColumns, lowerSchemaName, tableName);
     std::string conflictClause =
@@ -788,6 +2305,8 @@ void DatabaseToPostgresSync::performBulkUpsert(
             ? DEFAULT_BATCH_SIZE
             : rawBatchSize;
     size_t totalProcessed = 0;
+    std::vector<ColumnConverter> converters =
+        buildConverterPlan(columnTypes);
 
     auto buildRowValues = [&](const std::vector<std::string> &row,
                               pqxx::work &workTxn) -> std::string {
@@ -798,8 +2317,7 @@ void DatabaseToPostgresSync::performBulkUpsert(
         if (row[j].empty()) {
           rowValues += "NULL";
         } else {
-          std::string cleanValue =
-              cleanValueForPostgres(row[j], columnTypes[j]);
+          std::string cleanValue = converters[j](row[j]);
           if (cleanValue == "NULL") {
             rowValues += "NULL";
           } else {
@@ -1114,6 +2632,19 @@ void DatabaseToPostgresSync::performBulkUpsertNoPK(
       throw std::invalid_argument("Column names and types count mismatch");
     }
 
+    try {
+      performStagedUpsert(pgConn, results, columnNames, columnTypes,
+                          lowerSchemaName, tableName, columnNames, false);
+      return;
+    } catch (const pqxx::broken_connection &) {
+      throw;
+    } catch (const std::exception &e) {
+      Logger::warning(LogCategory::TRANSFER, "performBulkUpsertNoPK",
+                      "Staged upsert failed for " + lowerSchemaName + "." +
+                          tableName + ", falling back to batched UPSERT: " +
+                          std::string(e.what()));
+    }
+
     std::string lowerTableName = tableName;
     std::transform(lowerTableName.begin(), lowerTableName.end(),
                    lowerTableName.begin(), ::tolower);
@@ -1160,6 +2691,8 @@ void DatabaseToPostgresSync::performBulkUpsertNoPK(
             ? DEFAULT_BATCH_SIZE
             : rawBatchSize;
     size_t totalProcessed = 0;
+    std::vector<ColumnConverter> converters =
+        buildConverterPlan(columnTypes);
 
     auto buildRowValues = [&](const std::vector<std::string> &row,
                               pqxx::work &workTxn) -> std::string {
@@ -1170,8 +2703,7 @@ void DatabaseToPostgresSync::performBulkUpsertNoPK(
         if (row[j].empty()) {
           rowValues += "NULL";
         } else {
-          std::string cleanValue =
-              cleanValueForPostgres(row[j], columnTypes[j]);
+          std::string cleanValue = converters[j](row[j]);
           if (cleanValue == "NULL") {
             rowValues += "NULL";
           } else {
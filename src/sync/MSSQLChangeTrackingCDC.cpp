@@ -0,0 +1,451 @@
+#include "sync/MSSQLChangeTrackingCDC.h"
+#include "core/Config.h"
+#include "engines/mssql_engine.h"
+#include "sync/MSSQLToPostgres.h"
+#include <algorithm>
+#include <cctype>
+
+// T-SQL string literal contents: only quotes are escaped
+static std::string escapeLiteral(const std::string &value) {
+  std::string escaped;
+  escaped.reserve(value.size());
+  for (char c : value) {
+    if (c == '\'')
+      escaped += c;
+    escaped += c;
+  }
+  return escaped;
+}
+
+static std::string lowercase(std::string value) {
+  std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+  return value;
+}
+
+static std::string uppercase(std::string value) {
+  std::transform(value.begin(), value.end(), value.begin(), ::toupper);
+  return value;
+}
+
+// First cell of a single-row result, or nothing
+static std::optional<std::string>
+singleValue(const std::optional<MSSQLChangeTrackingCDC::Rows> &rows) {
+  if (!rows || rows->empty() || (*rows)[0].empty())
+    return std::nullopt;
+  return (*rows)[0][0];
+}
+
+bool MSSQLChangeTrackingCDC::handles(const std::string &pkStrategy) {
+  return pkStrategy == CHANGE_TRACKING || pkStrategy == NATIVE_CDC;
+}
+
+std::string MSSQLChangeTrackingCDC::positionKey(const std::string &pkStrategy) {
+  return pkStrategy == NATIVE_CDC ? "cdc_lsn" : "ct_version";
+}
+
+std::optional<std::string>
+MSSQLChangeTrackingCDC::currentPosition(SQLHDBC mssqlConn,
+                                        const std::string &pkStrategy) {
+  std::string query =
+      pkStrategy == NATIVE_CDC
+          ? "SELECT CONVERT(varchar(22), sys.fn_cdc_get_max_lsn(), 1)"
+          : "SELECT CHANGE_TRACKING_CURRENT_VERSION()";
+  std::optional<std::string> position =
+      singleValue(access_.query(mssqlConn, query));
+  if (!position || *position == "NULL")
+    return std::nullopt;
+  return uppercase(*position);
+}
+
+std::string
+MSSQLChangeTrackingCDC::cleanValueForPostgres(const std::string &value,
+                                              const std::string &columnType) {
+  return MSSQLToPostgres::cleanValueWithTraits(
+      value, MSSQLToPostgres::classifyColumnType(columnType));
+}
+
+DatabaseToPostgresSync::ColumnConverter
+MSSQLChangeTrackingCDC::compileColumnConverter(const std::string &columnType) {
+  MSSQLToPostgres::ColumnTraits traits =
+      MSSQLToPostgres::classifyColumnType(columnType);
+  return [traits](const std::string &value) {
+    return MSSQLToPostgres::cleanValueWithTraits(value, traits);
+  };
+}
+
+void MSSQLChangeTrackingCDC::enableCapture(SQLHDBC mssqlConn,
+                                           const TableInfo &table) {
+  std::string tableKey = table.schema_name + "." + table.table_name;
+  std::string objectId = "OBJECT_ID(N'" +
+                         escapeLiteral("[" + table.schema_name + "].[" +
+                                       table.table_name + "]") +
+                         "')";
+
+  std::string enable;
+  std::string check;
+  if (table.pk_strategy == NATIVE_CDC) {
+    enable = "IF NOT EXISTS (SELECT 1 FROM sys.tables WHERE object_id = " +
+             objectId +
+             " AND is_tracked_by_cdc = 1) EXEC sys.sp_cdc_enable_table "
+             "@source_schema = N'" +
+             escapeLiteral(table.schema_name) + "', @source_name = N'" +
+             escapeLiteral(table.table_name) +
+             "', @role_name = NULL, @supports_net_changes = 1";
+    check = "SELECT COUNT(*) FROM sys.tables WHERE object_id = " + objectId +
+            " AND is_tracked_by_cdc = 1";
+  } else {
+    enable = "IF NOT EXISTS (SELECT 1 FROM sys.change_tracking_tables "
+             "WHERE object_id = " +
+             objectId + ") ALTER TABLE [" + table.schema_name + "].[" +
+             table.table_name + "] ENABLE CHANGE_TRACKING";
+    check = "SELECT COUNT(*) FROM sys.change_tracking_tables WHERE "
+            "object_id = " +
+            objectId;
+  }
+
+  access_.query(mssqlConn, enable);
+  if (singleValue(access_.query(mssqlConn, check)).value_or("0") == "0") {
+    Logger::error(LogCategory::TRANSFER, "enableCapture",
+                  table.pk_strategy + " could not be enabled for " + tableKey +
+                      (table.pk_strategy == NATIVE_CDC
+                           ? " - enable CDC on the database first "
+                             "(sys.sp_cdc_enable_db)"
+                           : " - enable Change Tracking on the database "
+                             "first (ALTER DATABASE ... SET CHANGE_TRACKING "
+                             "= ON)"));
+    return;
+  }
+  Logger::info(LogCategory::TRANSFER, "enableCapture",
+               table.pk_strategy + " enabled for " + tableKey);
+}
+
+void MSSQLChangeTrackingCDC::processTableCDC(const TableInfo &table,
+                                             pqxx::connection &pgConn) {
+  syncTable(table, pgConn);
+}
+
+bool MSSQLChangeTrackingCDC::syncTable(const TableInfo &table,
+                                       pqxx::connection &pgConn) {
+  SourceTable source;
+  source.tableKey = table.schema_name + "." + table.table_name;
+  source.qualifiedName = "[" + table.schema_name + "].[" + table.table_name +
+                         "]";
+  source.lowerSchemaName = lowercase(table.schema_name);
+  source.lowerTableName = lowercase(table.table_name);
+  std::string position;
+
+  try {
+    MSSQLEngine engine(table.connection_string);
+    std::vector<ColumnInfo> columns =
+        engine.getTableColumns(table.schema_name, table.table_name);
+    for (const auto &col : columns) {
+      source.columnNames.push_back(col.name);
+      source.columnTypes.push_back(col.pgType);
+    }
+    if (source.columnNames.empty()) {
+      Logger::error(LogCategory::TRANSFER, "syncTable",
+                    "No columns found for " + source.tableKey);
+      return true;
+    }
+
+    source.pkColumns =
+        getPKColumnsFromCatalog(pgConn, table.schema_name, table.table_name);
+    source.pkPositions =
+        findKeyPositions(source.columnNames, source.pkColumns);
+    if (source.pkPositions.empty()) {
+      Logger::error(LogCategory::TRANSFER, "syncTable",
+                    table.pk_strategy + " needs a primary key on " +
+                        source.tableKey + " - no changes applied");
+      return true;
+    }
+
+    pqxx::work txn(pgConn);
+    auto res = txn.exec("SELECT sync_metadata->>" +
+                        txn.quote(positionKey(table.pk_strategy)) +
+                        " FROM metadata.catalog WHERE schema_name=" +
+                        txn.quote(table.schema_name) +
+                        " AND table_name=" + txn.quote(table.table_name) +
+                        " AND db_engine='MSSQL'");
+    txn.commit();
+    if (!res.empty() && !res[0][0].is_null())
+      position = res[0][0].as<std::string>();
+  } catch (const std::exception &e) {
+    Logger::error(LogCategory::TRANSFER, "syncTable",
+                  "Error preparing " + table.pk_strategy + " sync of " +
+                      source.tableKey + ": " + std::string(e.what()));
+    return true;
+  }
+
+  if (position.empty()) {
+    requestFullLoad(pgConn, table,
+                    "no " + positionKey(table.pk_strategy) +
+                        " to read changes from");
+    return false;
+  }
+
+  SQLHDBC mssqlConn = access_.connect(table.connection_string);
+  if (!mssqlConn) {
+    Logger::error(LogCategory::TRANSFER, "syncTable",
+                  "Failed to get MSSQL connection for " + source.tableKey);
+    return true;
+  }
+
+  bool listening = true;
+  try {
+    listening = table.pk_strategy == NATIVE_CDC
+                    ? syncNativeCDC(pgConn, mssqlConn, table, source, position)
+                    : syncChangeTracking(pgConn, mssqlConn, table, source,
+                                         position);
+  } catch (const std::exception &e) {
+    Logger::error(LogCategory::TRANSFER, "syncTable",
+                  "Error applying " + table.pk_strategy + " changes to " +
+                      source.tableKey + ": " + std::string(e.what()) +
+                      " - they will be read again");
+  }
+  access_.close(mssqlConn);
+  return listening;
+}
+
+// Reads the keys changed since lastVersion up to the current version (one
+// row per key, with its last operation), re-reads the current rows of the
+// inserted and updated keys and deletes the others. A key whose row is gone
+// by the time it is re-read was deleted after the current version; its
+// delete is picked up by the next sync.
+bool MSSQLChangeTrackingCDC::syncChangeTracking(pqxx::connection &pgConn,
+                                                SQLHDBC mssqlConn,
+                                                const TableInfo &table,
+                                                const SourceTable &source,
+                                                const std::string &position) {
+  long long lastVersion = 0;
+  try {
+    lastVersion = std::stoll(position);
+  } catch (const std::exception &) {
+    requestFullLoad(pgConn, table, "invalid ct_version '" + position + "'");
+    return false;
+  }
+
+  auto versions = access_.query(
+      mssqlConn, "SELECT CHANGE_TRACKING_CURRENT_VERSION(), "
+                 "CHANGE_TRACKING_MIN_VALID_VERSION(OBJECT_ID(N'" +
+                     escapeLiteral(source.qualifiedName) + "'))");
+  if (!versions || versions->empty() || (*versions)[0].size() < 2 ||
+      (*versions)[0][0] == "NULL" || (*versions)[0][1] == "NULL") {
+    Logger::error(LogCategory::TRANSFER, "syncChangeTracking",
+                  "Change Tracking is not enabled for " + source.tableKey);
+    return true;
+  }
+  long long currentVersion = std::stoll((*versions)[0][0]);
+  long long minValidVersion = std::stoll((*versions)[0][1]);
+  if (lastVersion < minValidVersion) {
+    requestFullLoad(pgConn, table,
+                    "ct_version " + std::to_string(lastVersion) +
+                        " is older than the minimum valid version " +
+                        std::to_string(minValidVersion));
+    return false;
+  }
+  if (lastVersion >= currentVersion)
+    return true;
+
+  std::string keyList;
+  for (const auto &pk : source.pkColumns)
+    keyList += ", ct.[" + pk + "]";
+  auto changes = access_.query(
+      mssqlConn, "SELECT ct.SYS_CHANGE_OPERATION" + keyList +
+                     " FROM CHANGETABLE(CHANGES " + source.qualifiedName +
+                     ", " + std::to_string(lastVersion) +
+                     ") AS ct WHERE ct.SYS_CHANGE_VERSION <= " +
+                     std::to_string(currentVersion));
+  if (!changes) {
+    Logger::error(LogCategory::TRANSFER, "syncChangeTracking",
+                  "Failed to read Change Tracking changes of " +
+                      source.tableKey);
+    return true;
+  }
+
+  const size_t CHUNK_SIZE = SyncConfig::getChunkSize();
+  size_t upserted = 0;
+  size_t deleted = 0;
+  size_t start = 0;
+  do {
+    size_t end = std::min(start + CHUNK_SIZE, changes->size());
+    Rows deletedKeys;
+    Rows changedKeys;
+    for (size_t i = start; i < end; ++i) {
+      const auto &row = (*changes)[i];
+      if (row.size() != source.pkColumns.size() + 1)
+        continue;
+      std::vector<std::string> key(row.begin() + 1, row.end());
+      if (uppercase(row[0]) == "D")
+        deletedKeys.push_back(std::move(key));
+      else
+        changedKeys.push_back(std::move(key));
+    }
+    Rows upserts;
+    if (!changedKeys.empty() &&
+        !access_.refetch(mssqlConn, table, source.pkColumns,
+                         source.columnNames, changedKeys, upserts)) {
+      // Chunks applied so far are re-applied from the saved version
+      Logger::error(LogCategory::TRANSFER, "syncChangeTracking",
+                    "Could not re-fetch changed rows of " + source.tableKey +
+                        "; ct_version stays at " + position);
+      return false;
+    }
+    // The last chunk carries the new version
+    applyChanges(pgConn, table, source, deletedKeys, upserts,
+                 end == changes->size() ? std::to_string(currentVersion)
+                                        : std::string());
+    upserted += upserts.size();
+    deleted += deletedKeys.size();
+    start = end;
+  } while (start < changes->size());
+
+  Logger::info(LogCategory::TRANSFER, "syncChangeTracking",
+               "Applied " + std::to_string(changes->size()) +
+                   " Change Tracking changes to " + source.tableKey + ": " +
+                   std::to_string(upserted) + " upserts, " +
+                   std::to_string(deleted) + " deletes; ct_version=" +
+                   std::to_string(currentVersion));
+  return true;
+}
+
+// Reads the net changes of the table's newest capture instance after the
+// saved LSN up to the current maximum LSN. Rows carry the full image, so
+// inserts and updates are upserted as read.
+bool MSSQLChangeTrackingCDC::syncNativeCDC(pqxx::connection &pgConn,
+                                           SQLHDBC mssqlConn,
+                                           const TableInfo &table,
+                                           const SourceTable &source,
+                                           const std::string &position) {
+  std::optional<std::string> captureInstance = singleValue(access_.query(
+      mssqlConn, "SELECT TOP 1 capture_instance FROM cdc.change_tables "
+                 "WHERE source_object_id = OBJECT_ID(N'" +
+                     escapeLiteral(source.qualifiedName) +
+                     "') ORDER BY create_date DESC"));
+  if (!captureInstance) {
+    Logger::error(LogCategory::TRANSFER, "syncNativeCDC",
+                  "No CDC capture instance found for " + source.tableKey);
+    return true;
+  }
+
+  auto lsns = access_.query(
+      mssqlConn,
+      "SELECT CONVERT(varchar(22), sys.fn_cdc_get_max_lsn(), 1), "
+      "CONVERT(varchar(22), sys.fn_cdc_get_min_lsn(N'" +
+          escapeLiteral(*captureInstance) + "'), 1)");
+  if (!lsns || lsns->empty() || (*lsns)[0].size() < 2) {
+    Logger::error(LogCategory::TRANSFER, "syncNativeCDC",
+                  "Failed to read CDC LSNs for " + source.tableKey);
+    return true;
+  }
+  // CONVERT style 1 gives fixed-width 0x-prefixed hex, so LSNs compare as
+  // strings
+  std::string lastLsn = uppercase(position);
+  std::string maxLsn = uppercase((*lsns)[0][0]);
+  std::string minLsn = uppercase((*lsns)[0][1]);
+  if (lastLsn.size() != minLsn.size() || lastLsn < minLsn) {
+    requestFullLoad(pgConn, table,
+                    "cdc_lsn " + position +
+                        " is older than the capture instance minimum " +
+                        minLsn);
+    return false;
+  }
+  if (lastLsn >= maxLsn)
+    return true;
+
+  std::string columnList;
+  for (const auto &name : source.columnNames)
+    columnList += ", [" + name + "]";
+  auto changes = access_.query(
+      mssqlConn, "SELECT __$operation" + columnList +
+                     " FROM cdc.[fn_cdc_get_net_changes_" + *captureInstance +
+                     "](sys.fn_cdc_increment_lsn(CONVERT(binary(10), '" +
+                     lastLsn + "', 1)), CONVERT(binary(10), '" + maxLsn +
+                     "', 1), N'all')");
+  if (!changes) {
+    Logger::error(LogCategory::TRANSFER, "syncNativeCDC",
+                  "Failed to read CDC net changes of " + source.tableKey +
+                      " from " + *captureInstance);
+    return true;
+  }
+
+  // __$operation: 1 delete, 2 insert, 4 update
+  const size_t CHUNK_SIZE = SyncConfig::getChunkSize();
+  size_t upserted = 0;
+  size_t deleted = 0;
+  size_t start = 0;
+  do {
+    size_t end = std::min(start + CHUNK_SIZE, changes->size());
+    Rows deletedKeys;
+    Rows upserts;
+    for (size_t i = start; i < end; ++i) {
+      auto &row = (*changes)[i];
+      if (row.size() != source.columnNames.size() + 1)
+        continue;
+      if (row[0] == "1") {
+        std::vector<std::string> key;
+        for (size_t position : source.pkPositions)
+          key.push_back(row[position + 1]);
+        deletedKeys.push_back(std::move(key));
+      } else {
+        upserts.emplace_back(std::make_move_iterator(row.begin() + 1),
+                             std::make_move_iterator(row.end()));
+      }
+    }
+    // The last chunk carries the new LSN
+    applyChanges(pgConn, table, source, deletedKeys, upserts,
+                 end == changes->size() ? maxLsn : std::string());
+    upserted += upserts.size();
+    deleted += deletedKeys.size();
+    start = end;
+  } while (start < changes->size());
+
+  Logger::info(LogCategory::TRANSFER, "syncNativeCDC",
+               "Applied " + std::to_string(changes->size()) +
+                   " CDC net changes to " + source.tableKey + ": " +
+                   std::to_string(upserted) + " upserts, " +
+                   std::to_string(deleted) + " deletes; cdc_lsn=" + maxLsn);
+  return true;
+}
+
+// Applies one chunk of changes and, when position is set, the table's new
+// position, in one target transaction through the group commit.
+void MSSQLChangeTrackingCDC::applyChanges(pqxx::connection &pgConn,
+                                          const TableInfo &table,
+                                          const SourceTable &source,
+                                          const Rows &deletedKeys,
+                                          const Rows &upserts,
+                                          const std::string &position) {
+  CDCApplyBatch batch = makeCDCApplyBatch(table, source.columnNames,
+                                          source.columnTypes, source.pkColumns);
+  batch.dbEngine = "MSSQL";
+  batch.deletes = deletedKeys;
+  batch.upserts = upserts;
+  if (!position.empty())
+    batch.progress[positionKey(table.pk_strategy)] = position;
+  commitCDCBatch(pgConn, batch);
+}
+
+// Sends the table back to FULL_LOAD with its position cleared; the full
+// load captures a new one before it copies the table.
+void MSSQLChangeTrackingCDC::requestFullLoad(pqxx::connection &pgConn,
+                                             const TableInfo &table,
+                                             const std::string &reason) {
+  try {
+    std::lock_guard<std::mutex> lock(metadataUpdateMutex);
+    pqxx::work txn(pgConn);
+    txn.exec("UPDATE metadata.catalog SET status = 'FULL_LOAD', "
+             "sync_metadata = COALESCE(sync_metadata, '{}'::jsonb) - " +
+             txn.quote(positionKey(table.pk_strategy)) +
+             " WHERE schema_name=" + txn.quote(table.schema_name) +
+             " AND table_name=" + txn.quote(table.table_name) +
+             " AND db_engine='MSSQL' AND status IN ('LISTENING_CHANGES', "
+             "'IN_PROGRESS')");
+    txn.commit();
+    Logger::warning(LogCategory::TRANSFER, "requestFullLoad",
+                    "Reloading " + table.schema_name + "." +
+                        table.table_name + ": " + reason);
+  } catch (const std::exception &e) {
+    Logger::error(LogCategory::TRANSFER, "requestFullLoad",
+                  "Error requesting full load: " + std::string(e.what()));
+  }
+}
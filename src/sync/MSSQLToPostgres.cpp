@@ -3,6 +3,7 @@
 #include "core/database_config.h"
 #include "engines/database_engine.h"
 #include "engines/mssql_engine.h"
+#include "sync/ChangeCoalescer.h"
 #include "third_party/json.hpp"
 #include <algorithm>
 #include <cctype>
@@ -47,24 +48,66 @@ std::unordered_map<std::string, std::string> MSSQLToPostgres::collationMap = {
     {"SQL_Latin1_General_CP1_CS_AS", "C"},
     {"Latin1_General_CS_AS", "C"}};
 
+// Resolves everything cleanValueWithTraits needs to know about a column type
+// once: whether it is date-like (TIMESTAMP/DATETIME/DATE), boolean or bit,
+// and the value written for nulls (0 for integers, 0.0 for floats, "" for
+// strings, "1970-01-01 00:00:00" for timestamps, "false" for booleans).
+MSSQLToPostgres::ColumnTraits
+MSSQLToPostgres::classifyColumnType(const std::string &columnType) {
+  std::string upperType = columnType;
+  std::transform(upperType.begin(), upperType.end(), upperType.begin(),
+                 ::toupper);
+
+  ColumnTraits traits;
+  traits.dateLike = upperType.find("TIMESTAMP") != std::string::npos ||
+                    upperType.find("DATETIME") != std::string::npos ||
+                    upperType.find("DATE") != std::string::npos;
+  traits.boolean = upperType.find("BOOLEAN") != std::string::npos ||
+                   upperType.find("BOOL") != std::string::npos;
+  traits.bit = !traits.boolean && upperType.find("BIT") != std::string::npos;
+
+  if (upperType.find("INTEGER") != std::string::npos ||
+      upperType.find("BIGINT") != std::string::npos ||
+      upperType.find("SMALLINT") != std::string::npos) {
+    traits.nullValue = "0";
+  } else if (upperType.find("REAL") != std::string::npos ||
+             upperType.find("FLOAT") != std::string::npos ||
+             upperType.find("DOUBLE") != std::string::npos ||
+             upperType.find("NUMERIC") != std::string::npos) {
+    traits.nullValue = "0.0";
+  } else if (upperType.find("VARCHAR") != std::string::npos ||
+             upperType.find("TEXT") != std::string::npos ||
+             upperType.find("CHAR") != std::string::npos) {
+    // Empty string instead of NULL for text types to avoid NOT NULL
+    // constraint violations
+    traits.nullValue = "";
+  } else if (upperType.find("TIMESTAMP") != std::string::npos ||
+             upperType.find("DATETIME") != std::string::npos) {
+    traits.nullValue = "1970-01-01 00:00:00";
+  } else if (upperType.find("DATE") != std::string::npos) {
+    traits.nullValue = "1970-01-01";
+  } else if (upperType.find("TIME") != std::string::npos) {
+    traits.nullValue = "00:00:00";
+  } else if (traits.boolean) {
+    traits.nullValue = "false";
+  } else {
+    traits.nullValue = "DEFAULT";
+  }
+  return traits;
+}
+
 // Cleans and normalizes a value from MSSQL for insertion into PostgreSQL.
 // Handles null detection (empty strings, "NULL", invalid dates like
 // "0000-00-00", "1900-01-01", "1970-01-01"), invalid binary characters
-// (non-ASCII), and invalid date formats. For null values, returns appropriate
-// defaults based on column type (0 for integers, 0.0 for floats, "DEFAULT" for
-// strings, "1970-01-01 00:00:00" for timestamps, "false" for booleans). For
-// boolean types, normalizes values ("N"/"0"/"false" -> "false", "Y"/"1"/"true"
-// -> "true"). Removes control characters (except tab, newline, carriage return)
-// from all values. For date/timestamp types, validates format and detects
-// invalid dates containing "-00". Returns the cleaned value ready for SQL
-// insertion.
-std::string
-MSSQLToPostgres::cleanValueForPostgres(const std::string &value,
-                                       const std::string &columnType) {
+// (non-ASCII), and invalid date formats. Null values are replaced with the
+// column's nullValue. For boolean types, normalizes values ("N"/"0"/"false"
+// -> "false", "Y"/"1"/"true" -> "true"). Removes control characters (except
+// tab, newline, carriage return) from all values. For date/timestamp types,
+// validates format and detects invalid dates containing "-00". Returns the
+// cleaned value ready for SQL insertion.
+std::string MSSQLToPostgres::cleanValueWithTraits(const std::string &value,
+                                                  const ColumnTraits &traits) {
   std::string cleanValue = value;
-  std::string upperType = columnType;
-  std::transform(upperType.begin(), upperType.end(), upperType.begin(),
-                 ::toupper);
 
   bool isNull =
       (cleanValue.empty() || cleanValue == "NULL" || cleanValue == "null" ||
@@ -80,9 +123,7 @@ MSSQLToPostgres::cleanValueForPostgres(const std::string &value,
     }
   }
 
-  if (upperType.find("TIMESTAMP") != std::string::npos ||
-      upperType.find("DATETIME") != std::string::npos ||
-      upperType.find("DATE") != std::string::npos) {
+  if (traits.dateLike) {
     if (cleanValue.length() < 10 || cleanValue.find("-") == std::string::npos ||
         cleanValue.find("0000") != std::string::npos) {
       isNull = true;
@@ -96,34 +137,7 @@ MSSQLToPostgres::cleanValueForPostgres(const std::string &value,
   }
 
   if (isNull) {
-    if (upperType.find("INTEGER") != std::string::npos ||
-        upperType.find("BIGINT") != std::string::npos ||
-        upperType.find("SMALLINT") != std::string::npos) {
-      return "0";
-    } else if (upperType.find("REAL") != std::string::npos ||
-               upperType.find("FLOAT") != std::string::npos ||
-               upperType.find("DOUBLE") != std::string::npos ||
-               upperType.find("NUMERIC") != std::string::npos) {
-      return "0.0";
-    } else if (upperType.find("VARCHAR") != std::string::npos ||
-               upperType.find("TEXT") != std::string::npos ||
-               upperType.find("CHAR") != std::string::npos) {
-      // Return empty string instead of NULL for text types to avoid NOT NULL
-      // constraint violations
-      return "";
-    } else if (upperType.find("TIMESTAMP") != std::string::npos ||
-               upperType.find("DATETIME") != std::string::npos) {
-      return "1970-01-01 00:00:00";
-    } else if (upperType.find("DATE") != std::string::npos) {
-      return "1970-01-01";
-    } else if (upperType.find("TIME") != std::string::npos) {
-      return "00:00:00";
-    } else if (upperType.find("BOOLEAN") != std::string::npos ||
-               upperType.find("BOOL") != std::string::npos) {
-      return "false";
-    } else {
-      return "DEFAULT";
-    }
+    return traits.nullValue;
   }
 
   cleanValue.erase(std::remove_if(cleanValue.begin(), cleanValue.end(),
@@ -133,8 +147,7 @@ MSSQLToPostgres::cleanValueForPostgres(const std::string &value,
                                   }),
                    cleanValue.end());
 
-  if (upperType.find("BOOLEAN") != std::string::npos ||
-      upperType.find("BOOL") != std::string::npos) {
+  if (traits.boolean) {
     if (cleanValue == "N" || cleanValue == "0" || cleanValue == "false" ||
         cleanValue == "FALSE") {
       cleanValue = "false";
@@ -142,7 +155,7 @@ MSSQLToPostgres::cleanValueForPostgres(const std::string &value,
                cleanValue == "TRUE") {
       cleanValue = "true";
     }
-  } else if (upperType.find("BIT") != std::string::npos) {
+  } else if (traits.bit) {
     if (cleanValue == "0" || cleanValue == "false" || cleanValue == "FALSE") {
       cleanValue = "false";
     } else if (cleanValue == "1" || cleanValue == "true" ||
@@ -154,6 +167,89 @@ MSSQLToPostgres::cleanValueForPostgres(const std::string &value,
   return cleanValue;
 }
 
+std::string
+MSSQLToPostgres::cleanValueForPostgres(const std::string &value,
+                                       const std::string &columnType) {
+  return cleanValueWithTraits(value, classifyColumnType(columnType));
+}
+
+// Classifies the column type once and returns a converter bound to the
+// result, so batch loops skip the per-value upper-casing and substring scans.
+DatabaseToPostgresSync::ColumnConverter
+MSSQLToPostgres::compileColumnConverter(const std::string &columnType) {
+  ColumnTraits traits = classifyColumnType(columnType);
+  return [traits](const std::string &value) {
+    return cleanValueWithTraits(value, traits);
+  };
+}
+
+// Re-reads the current source rows of the given keys by joining the table
+// against a VALUES list of CDC_REFETCH_BATCH_KEYS keys per query, instead of
+// one query per change, and appends them to records in columnNames order,
+// the column list the full load writes. Keys whose row has been deleted since
+// the change was logged are not returned; their delete follows later in the
+// change log. Returns the number of rows found, or nothing if a query
+// failed, in which case the changes must not be applied.
+std::optional<size_t> MSSQLToPostgres::refetchRowsByKey(
+    SQLHDBC mssqlConn, const TableInfo &table,
+    const std::vector<std::string> &pkColumns,
+    const std::vector<std::string> &columnNames,
+    const std::vector<std::vector<std::string>> &keys,
+    std::vector<std::vector<std::string>> &records) {
+  std::string columnList;
+  for (size_t i = 0; i < columnNames.size(); ++i) {
+    if (i > 0)
+      columnList += ", ";
+    columnList += "t.[" + columnNames[i] + "]";
+  }
+  std::string keyColumns;
+  std::string joinCondition;
+  for (size_t i = 0; i < pkColumns.size(); ++i) {
+    if (i > 0) {
+      keyColumns += ", ";
+      joinCondition += " AND ";
+    }
+    keyColumns += "[" + pkColumns[i] + "]";
+    joinCondition += "t.[" + pkColumns[i] + "] = k.[" + pkColumns[i] + "]";
+  }
+
+  size_t found = 0;
+  for (size_t start = 0; start < keys.size();
+       start += CDC_REFETCH_BATCH_KEYS) {
+    size_t count = std::min(CDC_REFETCH_BATCH_KEYS, keys.size() - start);
+    std::string selectQuery = "SELECT " + columnList + " FROM [" +
+                              table.schema_name + "].[" + table.table_name +
+                              "] AS t JOIN (VALUES ";
+    for (size_t k = start; k < start + count; ++k) {
+      if (k > start)
+        selectQuery += ", ";
+      selectQuery += "(";
+      for (size_t i = 0; i < keys[k].size(); ++i) {
+        if (i > 0)
+          selectQuery += ", ";
+        selectQuery += "'" + escapeSQL(keys[k][i]) + "'";
+      }
+      selectQuery += ")";
+    }
+    selectQuery += ") AS k(" + keyColumns + ") ON " + joinCondition;
+
+    RowBatch batch;
+    if (!executeQueryMSSQL(mssqlConn, selectQuery, batch)) {
+      Logger::error(LogCategory::TRANSFER, "refetchRowsByKey",
+                    "Re-fetch failed for " + table.schema_name + "." +
+                        table.table_name);
+      return std::nullopt;
+    }
+    for (auto &row : batch.toRows("NULL")) {
+      if (row.size() != columnNames.size())
+        continue;
+      records.push_back(std::move(row));
+      ++found;
+    }
+  }
+  return found;
+}
+
 void MSSQLToPostgres::processTableCDC(
     const std::string &tableKey, SQLHDBC mssqlConn, const TableInfo &table,
     pqxx::connection &pgConn, const std::vector<std::string> &columnNames,
@@ -204,20 +300,33 @@ void MSSQLToPostgres::processTableCDC(
     bool hasMore = true;
     size_t batchNumber = 0;
 
+    // Changes the multiplexed change log read already took for this table;
+    // a table it did not cover polls the log itself
+    DispatchedChanges dispatched;
+    bool useDispatched = takeDispatchedChanges(tableKey, dispatched);
+    size_t dispatchedOffset = 0;
+
     while (hasMore) {
       batchNumber++;
-      std::string query = "SELECT change_id, operation, pk_values, row_data "
-                          "FROM datasync_metadata.ds_change_log WHERE "
-                          "schema_name='" +
-                          escapeSQL(table.schema_name) + "' AND table_name='" +
-                          escapeSQL(table.table_name) + "' AND change_id > " +
-                          std::to_string(lastChangeId) +
-                          " ORDER BY change_id OFFSET 0 ROWS "
-                          "FETCH NEXT " +
-                          std::to_string(CHUNK_SIZE) + " ROWS ONLY";
-
-      std::vector<std::vector<std::string>> rows =
-          executeQueryMSSQL(mssqlConn, query);
+      std::vector<std::vector<std::string>> rows;
+      if (useDispatched) {
+        size_t end =
+            std::min(dispatched.rows.size(), dispatchedOffset + CHUNK_SIZE);
+        rows.assign(
+            std::make_move_iterator(dispatched.rows.begin() + dispatchedOffset),
+            std::make_move_iterator(dispatched.rows.begin() + end));
+        dispatchedOffset = end;
+      } else {
+        std::string query =
+            "SELECT change_id, operation, pk_values, row_data "
+            "FROM datasync_metadata.ds_change_log WHERE schema_name='" +
+            escapeSQL(table.schema_name) + "' AND table_name='" +
+            escapeSQL(table.table_name) +
+            "' AND change_id > " + std::to_string(lastChangeId) +
+            " ORDER BY change_id OFFSET 0 ROWS FETCH NEXT " +
+            std::to_string(CHUNK_SIZE) + " ROWS ONLY";
+        rows = executeQueryMSSQL(mssqlConn, query);
+      }
 
       if (rows.empty()) {
         hasMore = false;
@@ -227,8 +336,24 @@ void MSSQLToPostgres::processTableCDC(
       long long maxChangeId = lastChangeId;
       std::vector<std::vector<std::string>> deletedPKs;
       std::vector<std::vector<std::string>> recordsToUpsert;
+      std::vector<std::vector<std::string>> refetchKeys;
+
+      // Keyed tables only apply the last change per key; rows of tables
+      // without a PK are keyed by content hash and are applied one by one.
+      // The change log triggers serialize a key the same way every time, so
+      // pk_values identifies it as is.
+      ChangeCoalescer coalescer;
+      if (hasPK) {
+        for (const auto &row : rows) {
+          coalescer.add(row.size() >= 3 ? row[2] : std::string(),
+                        row.size() >= 2 && !row[1].empty() ? row[1][0] : ' ');
+        }
+        coalescer.finish();
+      }
+      const size_t elided = coalescer.elided();
 
-      for (const auto &row : rows) {
+      for (size_t rowIndex = 0; rowIndex < rows.size(); ++rowIndex) {
+        const auto &row = rows[rowIndex];
         if (row.size() < 3) {
           continue;
         }
@@ -250,6 +375,10 @@ void MSSQLToPostgres::processTableCDC(
                             std::string(e.what()));
         }
 
+        if (hasPK && !coalescer.keep(rowIndex)) {
+          continue;
+        }
+
         try {
           json pkObject = json::parse(pkJson);
           bool isNoPKTable = !hasPK && pkObject.contains("_hash");
@@ -400,42 +529,7 @@ void MSSQLToPostgres::processTableCDC(
               }
 
               if (!useRowData) {
-                std::string whereClause = "";
-                for (size_t i = 0; i < pkColumns.size(); ++i) {
-                  if (i > 0) {
-                    whereClause += " AND ";
-                  }
-                  std::string pkValue = pkValues[i];
-                  if (pkValue == "NULL") {
-                    whereClause += "[" + pkColumns[i] + "] IS NULL";
-                  } else {
-                    whereClause +=
-                        "[" + pkColumns[i] + "] = '" + escapeSQL(pkValue) + "'";
-                  }
-                }
-
-                std::string selectQuery = "SELECT ";
-                for (size_t i = 0; i < columnNames.size(); ++i) {
-                  if (i > 0) {
-                    selectQuery += ", ";
-                  }
-                  selectQuery += "[" + columnNames[i] + "]";
-                }
-                selectQuery += " FROM [" + table.schema_name + "].[" +
-                               table.table_name + "] WHERE " + whereClause;
-
-                std::vector<std::vector<std::string>> recordResult =
-                    executeQueryMSSQL(mssqlConn, selectQuery);
-
-                if (!recordResult.empty() &&
-                    recordResult[0].size() == columnNames.size()) {
-                  recordsToUpsert.push_back(recordResult[0]);
-                } else {
-                  Logger::warning(LogCategory::TRANSFER, "processTableCDC",
-                                  "Record not found in source for " + tableKey +
-                                      " operation " + op +
-                                      " with PK: " + pkJson);
-                }
+                refetchKeys.push_back(pkValues);
               }
             }
           }
@@ -446,83 +540,57 @@ void MSSQLToPostgres::processTableCDC(
         }
       }
 
-      size_t deletedCount = 0;
-      if (!deletedPKs.empty()) {
-        std::string lowerSchemaName = table.schema_name;
-        std::transform(lowerSchemaName.begin(), lowerSchemaName.end(),
-                       lowerSchemaName.begin(), ::tolower);
-        std::string lowerTableName = table.table_name;
-        std::transform(lowerTableName.begin(), lowerTableName.end(),
-                       lowerTableName.begin(), ::tolower);
-
-        bool isNoPKTable = !hasPK;
-        if (isNoPKTable && !deletedPKs.empty()) {
-          deletedCount = deleteRecordsByHash(
-              pgConn, lowerSchemaName, lowerTableName, deletedPKs, columnNames);
-        } else if (hasPK && !deletedPKs.empty()) {
-          deletedCount = deleteRecordsByPrimaryKey(
-              pgConn, lowerSchemaName, lowerTableName, deletedPKs, pkColumns);
-        }
-      }
-
-      size_t upsertedCount = 0;
-      if (!recordsToUpsert.empty()) {
-        std::string lowerSchemaName = table.schema_name;
-        std::transform(lowerSchemaName.begin(), lowerSchemaName.end(),
-                       lowerSchemaName.begin(), ::tolower);
-        std::string lowerTableName = table.table_name;
-        std::transform(lowerTableName.begin(), lowerTableName.end(),
-                       lowerTableName.begin(), ::tolower);
-        try {
-          bool isNoPKTable = !hasPK;
-          if (isNoPKTable) {
-            performBulkUpsertNoPK(pgConn, recordsToUpsert, columnNames,
-                                  columnTypes, lowerSchemaName, lowerTableName,
-                                  table.schema_name);
-          } else {
-            performBulkUpsert(pgConn, recordsToUpsert, columnNames, columnTypes,
-                              lowerSchemaName, lowerTableName,
-                              table.schema_name);
-          }
-          upsertedCount = recordsToUpsert.size();
-        } catch (const std::exception &e) {
+      if (!refetchKeys.empty()) {
+        std::optional<size_t> found =
+            refetchRowsByKey(mssqlConn, table, pkColumns, columnNames,
+                             refetchKeys, recordsToUpsert);
+        if (!found) {
           Logger::error(LogCategory::TRANSFER, "processTableCDC",
-                        "Failed to upsert records for " + tableKey + ": " +
-                            std::string(e.what()));
+                        "Could not re-fetch changed rows of " + tableKey +
+                            "; batch not applied, last_change_id stays at " +
+                            std::to_string(lastChangeId));
+          break;
+        }
+        if (*found < refetchKeys.size()) {
+          Logger::warning(LogCategory::TRANSFER, "processTableCDC",
+                          std::to_string(refetchKeys.size() - *found) +
+                              " changed records of " + tableKey +
+                              " no longer exist in source");
         }
       }
 
-      if (maxChangeId > lastChangeId) {
-        try {
-          std::lock_guard<std::mutex> lock(metadataUpdateMutex);
-          pqxx::work txn(pgConn);
-          std::string updateQuery =
-              "UPDATE metadata.catalog SET sync_metadata = "
-              "COALESCE(sync_metadata, '{}'::jsonb) || "
-              "jsonb_build_object('last_change_id', " +
-              std::to_string(maxChangeId) +
-              ") WHERE schema_name=" + txn.quote(table.schema_name) +
-              " AND table_name=" + txn.quote(table.table_name) +
-              " AND db_engine='MSSQL'";
-          txn.exec(updateQuery);
-          txn.commit();
-          lastChangeId = maxChangeId;
-        } catch (const std::exception &e) {
-          Logger::error(LogCategory::TRANSFER, "processTableCDC",
-                        "Error updating last_change_id for " + tableKey + ": " +
-                            std::string(e.what()));
-        }
+      // The log is complete up to readUpTo, so once the read's rows are
+      // applied the table is caught up to there
+      if (useDispatched && dispatchedOffset == dispatched.rows.size()) {
+        maxChangeId = std::max(maxChangeId, dispatched.readUpTo);
       }
 
+      // Deletes, upserts and the new last_change_id reach the target in one
+      // transaction, shared with the batches other tables commit meanwhile
+      CDCApplyBatch batch =
+          makeCDCApplyBatch(table, columnNames, columnTypes, pkColumns);
+      batch.dbEngine = "MSSQL";
+      batch.deletes = std::move(deletedPKs);
+      batch.upserts = std::move(recordsToUpsert);
+      batch.progress["last_change_id"] = std::max(maxChangeId, lastChangeId);
+      batch.elided = elided;
+      if (commitCDCBatch(pgConn, batch))
+        lastChangeId = std::max(maxChangeId, lastChangeId);
+      size_t deletedCount = batch.deleted;
+      size_t upsertedCount = batch.upserted;
+
       Logger::info(
           LogCategory::TRANSFER, "processTableCDC",
           "Processed CDC batch " + std::to_string(batchNumber) + " for " +
               tableKey + " with " + std::to_string(rows.size()) +
               " changes: " + std::to_string(upsertedCount) + " upserts, " +
-              std::to_string(deletedCount) +
-              " deletes; last_change_id=" + std::to_string(lastChangeId));
+              std::to_string(deletedCount) + " deletes, " +
+              std::to_string(elided) + " elided; last_change_id=" +
+              std::to_string(lastChangeId));
 
-      if (rows.size() < CHUNK_SIZE) {
+      if (useDispatched) {
+        hasMore = dispatchedOffset < dispatched.rows.size();
+      } else if (rows.size() < CHUNK_SIZE) {
         hasMore = false;
       }
     }
@@ -535,6 +603,11 @@ void MSSQLToPostgres::processTableCDC(
 
 void MSSQLToPostgres::processTableCDC(const TableInfo &table,
                                       pqxx::connection &pgConn) {
+  if (MSSQLChangeTrackingCDC::handles(table.pk_strategy)) {
+    changeTrackingCDC_.processTableCDC(table, pgConn);
+    return;
+  }
+
   std::string tableKey = table.schema_name + "." + table.table_name;
   SQLHDBC mssqlConn = getMSSQLConnection(table.connection_string);
   if (!mssqlConn) {
@@ -574,3 +647,211 @@ void MSSQLToPostgres::processTableCDC(const TableInfo &table,
     closeMSSQLConnection(mssqlConn);
   }
 }
+
+// Deletes the change log rows of one table that every consumer has applied,
+// CHANGE_LOG_PURGE_BATCH_ROWS per DELETE TOP statement so no single delete
+// escalates to a table lock, and at most CHANGE_LOG_PURGE_MAX_BATCHES
+// statements per cycle. Returns the number of rows deleted.
+size_t MSSQLToPostgres::purgeChangeLogRows(SQLHDBC mssqlConn,
+                                           const std::string &schemaName,
+                                           const std::string &tableName,
+                                           long long appliedChangeId) {
+  if (appliedChangeId <= 0)
+    return 0;
+  // NOCOUNT keeps the DELETE from producing a result ahead of the row count
+  std::string query =
+      "SET NOCOUNT ON; DELETE TOP (" +
+      std::to_string(CHANGE_LOG_PURGE_BATCH_ROWS) +
+      ") FROM datasync_metadata.ds_change_log WHERE schema_name='" +
+      escapeSQL(schemaName) + "' AND table_name='" + escapeSQL(tableName) +
+      "' AND change_id <= " + std::to_string(appliedChangeId) +
+      "; SELECT @@ROWCOUNT;";
+
+  size_t purged = 0;
+  for (size_t batch = 0; batch < CHANGE_LOG_PURGE_MAX_BATCHES; ++batch) {
+    std::vector<std::vector<std::string>> result =
+        executeQueryMSSQL(mssqlConn, query);
+    size_t affected = 0;
+    try {
+      if (!result.empty() && !result[0].empty())
+        affected = std::stoul(result[0][0]);
+    } catch (const std::exception &) {
+    }
+    purged += affected;
+    if (affected < CHANGE_LOG_PURGE_BATCH_ROWS)
+      break;
+  }
+  return purged;
+}
+
+// Purges the ds_change_log of every MSSQL database with CDC tables (one log
+// per database) with bounded per-table deletes, and records purged rows and
+// the remaining log size in each table's sync_metadata.
+void MSSQLToPostgres::purgeChangeLog() {
+  try {
+    pqxx::connection pgConn(DatabaseConfig::getPostgresConnectionString());
+    auto sources = getChangeLogSources(
+        pgConn, "MSSQL",
+        [](const std::string &connectionString) { return connectionString; });
+
+    for (const auto &entry : sources) {
+      const ChangeLogSource &source = entry.second;
+      std::string databaseName = extractDatabaseName(source.connectionString);
+      SQLHDBC mssqlConn = getMSSQLConnection(source.connectionString);
+      if (!mssqlConn) {
+        Logger::error(LogCategory::TRANSFER, "purgeChangeLog",
+                      "Failed to connect to database " + databaseName);
+        continue;
+      }
+      executeQueryMSSQL(mssqlConn, "USE [" + databaseName + "];");
+
+      std::map<std::pair<std::string, std::string>, size_t> purged;
+      size_t purgedTotal = 0;
+      for (const auto &table : source.appliedChangeIds) {
+        size_t rows = purgeChangeLogRows(mssqlConn, table.first.first,
+                                         table.first.second, table.second);
+        purged[table.first] = rows;
+        purgedTotal += rows;
+      }
+
+      long long logRows = 0;
+      std::vector<std::vector<std::string>> sizeResult = executeQueryMSSQL(
+          mssqlConn, "SELECT SUM(rows) FROM sys.partitions WHERE object_id = "
+                     "OBJECT_ID(N'datasync_metadata.ds_change_log') AND "
+                     "index_id IN (0, 1)");
+      try {
+        if (!sizeResult.empty() && !sizeResult[0].empty() &&
+            sizeResult[0][0] != "NULL")
+          logRows = std::stoll(sizeResult[0][0]);
+      } catch (const std::exception &) {
+      }
+      closeMSSQLConnection(mssqlConn);
+
+      for (const auto &table : source.appliedChangeIds) {
+        recordChangeLogPurge(pgConn, "MSSQL", table.first.first,
+                             table.first.second, purged[table.first],
+                             logRows);
+      }
+
+      Logger::info(LogCategory::TRANSFER, "purgeChangeLog",
+                   "Purged " + std::to_string(purgedTotal) +
+                       " change log rows in database " + databaseName + "; " +
+                       std::to_string(logRows) + " rows remain");
+    }
+  } catch (const std::exception &e) {
+    Logger::error(LogCategory::TRANSFER, "purgeChangeLog",
+                  "Error purging MSSQL change logs: " + std::string(e.what()));
+  }
+}
+
+// Reads the change log of every MSSQL database with listening CDC tables
+// once per cycle, in change_id order from the lowest last_change_id among
+// them, and dispatches the rows to those tables (see dispatchChangeLog)
+// instead of each table polling the log. A database whose log has nothing
+// past that point costs a single MAX(change_id) probe. A database that
+// cannot be read is left out, and its tables poll the log themselves.
+void MSSQLToPostgres::readChangeLogs(pqxx::connection &pgConn) {
+  clearDispatchedChanges();
+  try {
+    auto sources = getChangeLogSources(
+        pgConn, "MSSQL",
+        [](const std::string &connectionString) { return connectionString; },
+        true);
+    const size_t CHUNK_SIZE = SyncConfig::getChunkSize();
+
+    for (const auto &entry : sources) {
+      const ChangeLogSource &source = entry.second;
+      std::string databaseName = extractDatabaseName(source.connectionString);
+      SQLHDBC mssqlConn = getMSSQLConnection(source.connectionString);
+      if (!mssqlConn) {
+        Logger::error(LogCategory::TRANSFER, "readChangeLogs",
+                      "Failed to connect to database " + databaseName);
+        continue;
+      }
+      executeQueryMSSQL(mssqlConn, "USE [" + databaseName + "];");
+
+      long long headChangeId = -1;
+      std::vector<std::vector<std::string>> head = executeQueryMSSQL(
+          mssqlConn, "SELECT ISNULL(MAX(change_id), 0) FROM "
+                     "datasync_metadata.ds_change_log");
+      if (!head.empty() && !head[0].empty()) {
+        try {
+          headChangeId = std::stoll(head[0][0]);
+        } catch (const std::exception &) {
+        }
+      }
+      if (headChangeId < 0) {
+        Logger::warning(LogCategory::TRANSFER, "readChangeLogs",
+                        "Cannot read the change log of database " +
+                            databaseName +
+                            " - its tables will poll it individually");
+        closeMSSQLConnection(mssqlConn);
+        continue;
+      }
+
+      long long position = source.minAppliedChangeId();
+      std::vector<std::vector<std::string>> logRows;
+      while (position < headChangeId &&
+             logRows.size() < CHANGE_LOG_READ_MAX_ROWS) {
+        std::vector<std::vector<std::string>> rows = executeQueryMSSQL(
+            mssqlConn,
+            "SELECT change_id, schema_name, table_name, operation, "
+            "pk_values, row_data FROM datasync_metadata.ds_change_log "
+            "WHERE change_id > " +
+                std::to_string(position) +
+                " ORDER BY change_id OFFSET 0 ROWS FETCH NEXT " +
+                std::to_string(CHUNK_SIZE) + " ROWS ONLY");
+        if (rows.empty() || rows.back().empty())
+          break;
+        try {
+          position = std::stoll(rows.back()[0]);
+        } catch (const std::exception &) {
+          break;
+        }
+        size_t fetched = rows.size();
+        logRows.insert(logRows.end(), std::make_move_iterator(rows.begin()),
+                       std::make_move_iterator(rows.end()));
+        if (fetched < CHUNK_SIZE)
+          break;
+      }
+
+      // An open transaction may still add rows below the change ids read.
+      // Its rows are logged after it began, so the ids logged before the
+      // oldest open transaction began are final; if that cannot be read
+      // (no VIEW SERVER STATE permission), nothing is.
+      long long committedUpTo = 0;
+      if (position > source.minAppliedChangeId()) {
+        std::vector<std::vector<std::string>> committed = executeQueryMSSQL(
+            mssqlConn,
+            "SELECT ISNULL(MAX(change_id), 0) FROM "
+            "datasync_metadata.ds_change_log WHERE change_id > " +
+                std::to_string(source.minAppliedChangeId()) +
+                " AND change_id <= " + std::to_string(position) +
+                " AND change_time < DATEADD(SECOND, -1, (SELECT "
+                "ISNULL(MIN(transaction_begin_time), GETDATE()) FROM "
+                "sys.dm_tran_active_transactions WHERE transaction_type = "
+                "1))");
+        if (!committed.empty() && !committed[0].empty()) {
+          try {
+            committedUpTo = std::stoll(committed[0][0]);
+          } catch (const std::exception &) {
+          }
+        }
+      }
+      closeMSSQLConnection(mssqlConn);
+
+      size_t readRows = logRows.size();
+      dispatchChangeLog(pgConn, "MSSQL", source, logRows, committedUpTo);
+      Logger::info(LogCategory::TRANSFER, "readChangeLogs",
+                   "Read " + std::to_string(readRows) +
+                       " change log rows of database " + databaseName +
+                       " for " +
+                       std::to_string(source.appliedChangeIds.size()) +
+                       " tables up to change_id " + std::to_string(position) +
+                       ", complete up to " + std::to_string(committedUpTo));
+    }
+  } catch (const std::exception &e) {
+    Logger::error(LogCategory::TRANSFER, "readChangeLogs",
+                  "Error reading MSSQL change logs: " + std::string(e.what()));
+  }
+}
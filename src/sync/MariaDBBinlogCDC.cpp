@@ -0,0 +1,902 @@
+#include "sync/MariaDBBinlogCDC.h"
+#include "engines/mariadb_engine.h"
+#include "sync/ChangeCoalescer.h"
+#include "sync/MariaDBToPostgres.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+
+// GTID event flag of a transaction that is a single statement without a
+// closing XID or COMMIT (DDL and other non-transactional statements)
+static constexpr uint8_t GTID_FLAG_STANDALONE = 1;
+
+static std::string trimmed(const std::string &value) {
+  size_t begin = value.find_first_not_of(" \t\r\n");
+  if (begin == std::string::npos)
+    return "";
+  size_t end = value.find_last_not_of(" \t\r\n");
+  return value.substr(begin, end - begin + 1);
+}
+
+static std::string lowercase(std::string value) {
+  std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+  return value;
+}
+
+// Value of a key=value option of a connection string (keys compared
+// case-insensitively), or an empty string if it is not set
+static std::string connectionOption(const std::string &connectionString,
+                                    const std::string &name) {
+  std::istringstream ss(connectionString);
+  std::string token;
+  while (std::getline(ss, token, ';')) {
+    auto pos = token.find('=');
+    if (pos == std::string::npos)
+      continue;
+    if (lowercase(trimmed(token.substr(0, pos))) == name)
+      return trimmed(token.substr(pos + 1));
+  }
+  return "";
+}
+
+// host:port of the server a connection string points to; one binlog stream
+// serves every database on it
+static std::string serverKey(const std::string &connectionString) {
+  std::string port = connectionOption(connectionString, "port");
+  return connectionOption(connectionString, "host") + ":" +
+         (port.empty() ? "3306" : port);
+}
+
+// Runs a query and returns its rows, SQL NULL as an empty string; nothing if
+// the query fails
+static std::optional<std::vector<std::vector<std::string>>>
+queryRows(MYSQL *conn, const std::string &query) {
+  if (mysql_query(conn, query.c_str()))
+    return std::nullopt;
+  std::vector<std::vector<std::string>> rows;
+  MYSQL_RES *result = mysql_store_result(conn);
+  if (!result) {
+    if (mysql_errno(conn))
+      return std::nullopt;
+    return rows;
+  }
+  unsigned int fields = mysql_num_fields(result);
+  MYSQL_ROW row;
+  while ((row = mysql_fetch_row(result)) != nullptr) {
+    unsigned long *lengths = mysql_fetch_lengths(result);
+    std::vector<std::string> values;
+    values.reserve(fields);
+    for (unsigned int i = 0; i < fields; ++i)
+      values.push_back(row[i] ? std::string(row[i], lengths[i]) : "");
+    rows.push_back(std::move(values));
+  }
+  mysql_free_result(result);
+  return rows;
+}
+
+static std::string escapeLiteral(const std::string &value) {
+  std::string escaped;
+  escaped.reserve(value.size());
+  for (char c : value) {
+    if (c == '\'' || c == '\\')
+      escaped += c;
+    escaped += c;
+  }
+  return escaped;
+}
+
+// Labels of an ENUM or SET COLUMN_TYPE such as enum('a','b''c'), in
+// declaration order
+static std::vector<std::string> typeLabels(const std::string &columnType) {
+  std::vector<std::string> labels;
+  size_t open = columnType.find('(');
+  if (open == std::string::npos)
+    return labels;
+  std::string label;
+  bool quoted = false;
+  for (size_t i = open + 1; i < columnType.size(); ++i) {
+    char c = columnType[i];
+    if (!quoted) {
+      if (c == '\'')
+        quoted = true;
+      else if (c == ')')
+        break;
+      continue;
+    }
+    if (c == '\'' && i + 1 < columnType.size() && columnType[i + 1] == '\'') {
+      label += '\'';
+      ++i;
+    } else if (c == '\'') {
+      labels.push_back(label);
+      label.clear();
+      quoted = false;
+    } else {
+      label += c;
+    }
+  }
+  return labels;
+}
+
+// Row operation of a rows event, or 0 for any other event
+static char rowsOperation(mariadb_rpl_event type) {
+  switch (type) {
+  case WRITE_ROWS_EVENT_V1:
+  case WRITE_ROWS_EVENT:
+  case WRITE_ROWS_COMPRESSED_EVENT_V1:
+  case WRITE_ROWS_COMPRESSED_EVENT:
+    return 'I';
+  case UPDATE_ROWS_EVENT_V1:
+  case UPDATE_ROWS_EVENT:
+  case UPDATE_ROWS_COMPRESSED_EVENT_V1:
+  case UPDATE_ROWS_COMPRESSED_EVENT:
+    return 'U';
+  case DELETE_ROWS_EVENT_V1:
+  case DELETE_ROWS_EVENT:
+  case DELETE_ROWS_COMPRESSED_EVENT_V1:
+  case DELETE_ROWS_COMPRESSED_EVENT:
+    return 'D';
+  default:
+    return 0;
+  }
+}
+
+static std::string formatTime(const MYSQL_TIME &tm, bool date, bool time) {
+  char buffer[64];
+  std::string formatted;
+  if (date) {
+    std::snprintf(buffer, sizeof(buffer), "%04u-%02u-%02u", tm.year, tm.month,
+                  tm.day);
+    formatted = buffer;
+  }
+  if (time) {
+    std::snprintf(buffer, sizeof(buffer), "%s%02u:%02u:%02u",
+                  date ? " " : (tm.neg ? "-" : ""), tm.hour, tm.minute,
+                  tm.second);
+    formatted += buffer;
+    if (tm.second_part) {
+      std::snprintf(buffer, sizeof(buffer), ".%06lu",
+                    static_cast<unsigned long>(tm.second_part));
+      formatted += buffer;
+    }
+  }
+  return formatted;
+}
+
+// Serialized key of a row image for coalescing, from its key columns
+static std::string rowKey(const std::vector<std::string> &values,
+                          const std::vector<size_t> &pkPositions) {
+  std::string key;
+  for (size_t position : pkPositions) {
+    const std::string &value = position < values.size() ? values[position] : "";
+    key += std::to_string(value.size()) + ":" + value;
+  }
+  return key;
+}
+
+bool MariaDBBinlogCDC::usesBinlog(const std::string &connectionString) {
+  return lowercase(connectionOption(connectionString, "cdc")) == "binlog";
+}
+
+bool MariaDBBinlogCDC::isStreamed(const TableInfo &table) {
+  return table.pk_strategy == "CDC" && table.status == "LISTENING_CHANGES" &&
+         usesBinlog(table.connection_string);
+}
+
+std::optional<std::string>
+MariaDBBinlogCDC::currentPosition(MYSQL *mariadbConn) {
+  auto rows = queryRows(mariadbConn, "SELECT @@gtid_binlog_pos");
+  if (!rows || rows->empty() || (*rows)[0].empty())
+    return std::nullopt;
+  return (*rows)[0][0];
+}
+
+MariaDBBinlogCDC::GtidPosition
+MariaDBBinlogCDC::parseGtidPosition(const std::string &position) {
+  GtidPosition parsed;
+  std::istringstream ss(position);
+  std::string gtid;
+  while (std::getline(ss, gtid, ',')) {
+    unsigned long domain = 0;
+    unsigned long serverId = 0;
+    unsigned long long sequence = 0;
+    if (std::sscanf(trimmed(gtid).c_str(), "%lu-%lu-%llu", &domain, &serverId,
+                    &sequence) == 3)
+      parsed[static_cast<uint32_t>(domain)] = {
+          static_cast<uint32_t>(serverId), static_cast<uint64_t>(sequence)};
+  }
+  return parsed;
+}
+
+std::string MariaDBBinlogCDC::formatGtidPosition(const GtidPosition &position) {
+  std::string formatted;
+  for (const auto &entry : position) {
+    if (!formatted.empty())
+      formatted += ",";
+    formatted += std::to_string(entry.first) + "-" +
+                 std::to_string(entry.second.first) + "-" +
+                 std::to_string(entry.second.second);
+  }
+  return formatted;
+}
+
+std::string
+MariaDBBinlogCDC::cleanValueForPostgres(const std::string &value,
+                                        const std::string &columnType) {
+  return MariaDBToPostgres::cleanValueWithTraits(
+      value, MariaDBToPostgres::classifyColumnType(columnType));
+}
+
+DatabaseToPostgresSync::ColumnConverter
+MariaDBBinlogCDC::compileColumnConverter(const std::string &columnType) {
+  MariaDBToPostgres::ColumnTraits traits =
+      MariaDBToPostgres::classifyColumnType(columnType);
+  return [traits](const std::string &value) {
+    return MariaDBToPostgres::cleanValueWithTraits(value, traits);
+  };
+}
+
+void MariaDBBinlogCDC::syncSources(pqxx::connection &pgConn,
+                                   const std::vector<TableInfo> &tables) {
+  std::map<std::string, std::vector<TableInfo>> sources;
+  for (const auto &table : tables) {
+    if (isStreamed(table))
+      sources[serverKey(table.connection_string)].push_back(table);
+  }
+  for (const auto &source : sources) {
+    streamSource(pgConn, source.second.front().connection_string,
+                 source.second);
+  }
+}
+
+void MariaDBBinlogCDC::processTableCDC(const TableInfo &table,
+                                       pqxx::connection &pgConn) {
+  streamSource(pgConn, table.connection_string, {table});
+}
+
+// Reads the source table's column list (in ordinal order, which is the order
+// of the values in a row event) along with what the binlog leaves out: the
+// labels of ENUM and SET columns and whether integer columns are unsigned.
+bool MariaDBBinlogCDC::loadColumns(pqxx::connection &pgConn,
+                                   BinlogTable &table) {
+  const TableInfo &info = table.info;
+  std::string tableKey = info.schema_name + "." + info.table_name;
+  MariaDBEngine engine(info.connection_string);
+  std::vector<ColumnInfo> columns =
+      engine.getTableColumns(info.schema_name, info.table_name);
+  if (columns.empty()) {
+    Logger::error(LogCategory::TRANSFER, "loadColumns",
+                  "No columns found for " + tableKey);
+    return false;
+  }
+
+  MYSQL *conn = connect_(info.connection_string);
+  if (!conn)
+    return false;
+  auto types = queryRows(
+      conn, "SELECT COLUMN_TYPE FROM information_schema.COLUMNS WHERE "
+            "TABLE_SCHEMA = '" +
+                escapeLiteral(info.schema_name) + "' AND TABLE_NAME = '" +
+                escapeLiteral(info.table_name) +
+                "' ORDER BY ORDINAL_POSITION");
+  mysql_close(conn);
+  if (!types || types->size() != columns.size()) {
+    Logger::error(LogCategory::TRANSFER, "loadColumns",
+                  "Failed to read column types of " + tableKey);
+    return false;
+  }
+
+  table.columnNames.clear();
+  table.columnTypes.clear();
+  table.labels.assign(columns.size(), {});
+  table.setColumns.assign(columns.size(), false);
+  table.unsignedColumns.assign(columns.size(), false);
+  for (size_t i = 0; i < columns.size(); ++i) {
+    table.columnNames.push_back(columns[i].name);
+    table.columnTypes.push_back(columns[i].pgType);
+    std::string columnType = lowercase((*types)[i].empty() ? ""
+                                                           : (*types)[i][0]);
+    if (columnType.rfind("enum(", 0) == 0 || columnType.rfind("set(", 0) == 0) {
+      table.labels[i] = typeLabels((*types)[i][0]);
+      table.setColumns[i] = columnType.rfind("set(", 0) == 0;
+    }
+    table.unsignedColumns[i] =
+        columnType.find("unsigned") != std::string::npos;
+  }
+
+  table.pkColumns =
+      getPKColumnsFromCatalog(pgConn, info.schema_name, info.table_name);
+  table.pkPositions = findKeyPositions(table.columnNames, table.pkColumns);
+  if (!table.pkColumns.empty() && table.pkPositions.empty()) {
+    Logger::error(LogCategory::TRANSFER, "loadColumns",
+                  "Primary key columns of " + tableKey +
+                      " are missing from its source columns");
+    return false;
+  }
+  return true;
+}
+
+// Converts a row image to text values in column order, formatted the way the
+// full load reads them: temporal values as ISO strings, ENUM and SET columns
+// as their labels, binary strings hex-encoded for bytea targets, and SQL
+// NULL as an empty string.
+std::vector<std::string>
+MariaDBBinlogCDC::rowValues(const BinlogTable &table,
+                            const MARIADB_RPL_ROW &row) {
+  std::vector<std::string> values;
+  values.reserve(row.column_count);
+  for (uint32_t i = 0; i < row.column_count; ++i) {
+    const MARIADB_RPL_VALUE &value = row.columns[i];
+    bool isUnsigned = i < table.unsignedColumns.size() &&
+                      table.unsignedColumns[i];
+    if (value.is_null) {
+      values.emplace_back();
+      continue;
+    }
+
+    if (i < table.labels.size() && !table.labels[i].empty()) {
+      // Logged as the 1-based label index (ENUM) or label bitmask (SET)
+      uint64_t index = 0;
+      if (value.field_type == MYSQL_TYPE_ENUM ||
+          value.field_type == MYSQL_TYPE_SET) {
+        index = value.val.ull;
+      } else {
+        for (size_t b = 0; b < value.val.str.length && b < 8; ++b)
+          index |= static_cast<uint64_t>(
+                       static_cast<unsigned char>(value.val.str.str[b]))
+                   << (8 * b);
+      }
+      const std::vector<std::string> &labels = table.labels[i];
+      std::string text;
+      if (table.setColumns[i]) {
+        for (size_t bit = 0; bit < labels.size() && bit < 64; ++bit) {
+          if (index & (uint64_t(1) << bit))
+            text += (text.empty() ? "" : ",") + labels[bit];
+        }
+      } else if (index >= 1 && index <= labels.size()) {
+        text = labels[index - 1];
+      }
+      values.push_back(text);
+      continue;
+    }
+
+    switch (value.field_type) {
+    case MYSQL_TYPE_TINY:
+      values.push_back(
+          isUnsigned ? std::to_string(static_cast<uint8_t>(value.val.ll))
+                     : std::to_string(static_cast<int8_t>(value.val.ll)));
+      break;
+    case MYSQL_TYPE_SHORT:
+      values.push_back(
+          isUnsigned ? std::to_string(static_cast<uint16_t>(value.val.ll))
+                     : std::to_string(static_cast<int16_t>(value.val.ll)));
+      break;
+    case MYSQL_TYPE_INT24:
+      values.push_back(
+          isUnsigned ? std::to_string(value.val.ull & 0xFFFFFF)
+                     : std::to_string(static_cast<int32_t>(
+                           static_cast<uint32_t>(value.val.ll << 8)) >>
+                                      8));
+      break;
+    case MYSQL_TYPE_LONG:
+      values.push_back(
+          isUnsigned ? std::to_string(static_cast<uint32_t>(value.val.ll))
+                     : std::to_string(static_cast<int32_t>(value.val.ll)));
+      break;
+    case MYSQL_TYPE_LONGLONG:
+      values.push_back(isUnsigned ? std::to_string(value.val.ull)
+                                  : std::to_string(value.val.ll));
+      break;
+    case MYSQL_TYPE_YEAR:
+    case MYSQL_TYPE_BIT:
+      values.push_back(std::to_string(value.val.ull));
+      break;
+    case MYSQL_TYPE_FLOAT: {
+      std::ostringstream ss;
+      ss << std::setprecision(std::numeric_limits<float>::max_digits10)
+         << value.val.f;
+      values.push_back(ss.str());
+      break;
+    }
+    case MYSQL_TYPE_DOUBLE: {
+      std::ostringstream ss;
+      ss << std::setprecision(std::numeric_limits<double>::max_digits10)
+         << value.val.d;
+      values.push_back(ss.str());
+      break;
+    }
+    case MYSQL_TYPE_DATE:
+    case MYSQL_TYPE_NEWDATE:
+      values.push_back(formatTime(value.val.tm, true, false));
+      break;
+    case MYSQL_TYPE_TIME:
+    case MYSQL_TYPE_TIME2:
+      values.push_back(formatTime(value.val.tm, false, true));
+      break;
+    case MYSQL_TYPE_DATETIME:
+    case MYSQL_TYPE_DATETIME2:
+    case MYSQL_TYPE_TIMESTAMP:
+    case MYSQL_TYPE_TIMESTAMP2:
+      values.push_back(formatTime(value.val.tm, true, true));
+      break;
+    default: {
+      std::string text(value.val.str.str ? value.val.str.str : "",
+                       value.val.str.length);
+      std::string upperType =
+          i < table.columnTypes.size() ? table.columnTypes[i] : "";
+      std::transform(upperType.begin(), upperType.end(), upperType.begin(),
+                     ::toupper);
+      if (upperType == "BYTEA") {
+        static const char digits[] = "0123456789abcdef";
+        std::string hex = "\\x";
+        hex.reserve(2 + text.size() * 2);
+        for (unsigned char c : text) {
+          hex += digits[c >> 4];
+          hex += digits[c & 0x0F];
+        }
+        text = std::move(hex);
+      }
+      values.push_back(std::move(text));
+      break;
+    }
+    }
+  }
+  return values;
+}
+
+// Applies the committed changes buffered for each table (the last change per
+// key for tables with a primary key) and moves every table's position up to
+// committed, the last transaction the stream has fully read. Tables waiting
+// for a reload are left at their position. The tables'
+// rows and positions are committed together by applyCDCBatches, so a
+// position is only saved along with the changes it covers.
+void MariaDBBinlogCDC::applyPending(pqxx::connection &pgConn,
+                                    std::map<std::string, BinlogTable> &tables,
+                                    const GtidPosition &committed) {
+  struct Applied {
+    const std::string *tableKey;
+    BinlogTable *table;
+    GtidPosition position;
+    size_t changes;
+  };
+  std::vector<CDCApplyBatch> batches;
+  std::vector<Applied> applied;
+
+  for (auto &entry : tables) {
+    BinlogTable &table = entry.second;
+    if (!table.reloadReason.empty()) {
+      table.pending.clear();
+      continue;
+    }
+    bool hasPK = !table.pkPositions.empty();
+    CDCApplyBatch batch = makeCDCApplyBatch(
+        table.info, table.columnNames, table.columnTypes,
+        hasPK ? table.pkColumns : std::vector<std::string>());
+    batch.dbEngine = "MariaDB";
+    if (hasPK) {
+      ChangeCoalescer coalescer;
+      for (const auto &change : table.pending)
+        coalescer.add(rowKey(change.values, table.pkPositions),
+                      change.operation);
+      coalescer.finish();
+      batch.elided = coalescer.elided();
+      for (size_t i = 0; i < table.pending.size(); ++i) {
+        if (!coalescer.keep(i))
+          continue;
+        RowChange &change = table.pending[i];
+        if (change.operation == 'D') {
+          std::vector<std::string> key;
+          for (size_t position : table.pkPositions)
+            key.push_back(change.values[position]);
+          batch.deletes.push_back(std::move(key));
+        } else {
+          batch.upserts.push_back(std::move(change.values));
+        }
+      }
+    } else {
+      for (auto &change : table.pending) {
+        if (change.operation == 'D') {
+          // Matched on every column; the hash slot is unused
+          std::vector<std::string> record{""};
+          record.insert(record.end(), change.values.begin(),
+                        change.values.end());
+          batch.deletes.push_back(std::move(record));
+        } else {
+          batch.upserts.push_back(std::move(change.values));
+        }
+      }
+    }
+    size_t changes = table.pending.size();
+    table.pending.clear();
+
+    GtidPosition next = table.position;
+    for (const auto &domain : committed) {
+      auto it = next.find(domain.first);
+      if (it == next.end() || it->second.second < domain.second.second)
+        next[domain.first] = domain.second;
+    }
+    if (next == table.position && changes == 0)
+      continue;
+    batch.progress["binlog_gtid_pos"] = formatGtidPosition(next);
+    batches.push_back(std::move(batch));
+    applied.push_back({&entry.first, &table, std::move(next), changes});
+  }
+
+  if (batches.empty())
+    return;
+
+  std::vector<bool> saved = applyCDCBatches(pgConn, batches);
+  for (size_t i = 0; i < batches.size(); ++i) {
+    if (saved[i])
+      applied[i].table->position = applied[i].position;
+    if (applied[i].changes == 0)
+      continue;
+    Logger::info(LogCategory::TRANSFER, "applyPending",
+                 "Applied " + std::to_string(applied[i].changes) +
+                     " binlog changes to " + *applied[i].tableKey + ": " +
+                     std::to_string(batches[i].upserted) + " upserts, " +
+                     std::to_string(batches[i].deleted) + " deletes, " +
+                     std::to_string(batches[i].elided) + " elided");
+  }
+}
+
+// Sends tables back to FULL_LOAD with their binlog position cleared; the
+// full load captures a new one before it copies the table.
+void MariaDBBinlogCDC::requestFullLoad(pqxx::connection &pgConn,
+                                       const std::vector<TableInfo> &tables,
+                                       const std::string &reason) {
+  try {
+    std::lock_guard<std::mutex> lock(metadataUpdateMutex);
+    pqxx::work txn(pgConn);
+    for (const auto &table : tables) {
+      txn.exec("UPDATE metadata.catalog SET status = 'FULL_LOAD', "
+               "sync_metadata = COALESCE(sync_metadata, '{}'::jsonb) - "
+               "'binlog_gtid_pos' WHERE schema_name=" +
+               txn.quote(table.schema_name) +
+               " AND table_name=" + txn.quote(table.table_name) +
+               " AND db_engine='MariaDB' AND status IN "
+               "('LISTENING_CHANGES', 'IN_PROGRESS')");
+      Logger::warning(LogCategory::TRANSFER, "requestFullLoad",
+                      "Reloading " + table.schema_name + "." +
+                          table.table_name + ": " + reason);
+    }
+    txn.commit();
+  } catch (const std::exception &e) {
+    Logger::error(LogCategory::TRANSFER, "requestFullLoad",
+                  "Error requesting full load: " + std::string(e.what()));
+  }
+}
+
+// Streams the binlog of one server for the given tables, from the oldest of
+// their positions to the current end of the binlog (a non-blocking dump) or
+// until CHANGE_LOG_READ_MAX_ROWS row changes have been read. Row events are
+// buffered per transaction and only become applicable once its XID (or
+// COMMIT) has been read; a source whose tables have all seen the server's
+// current position costs a single query.
+void MariaDBBinlogCDC::streamSource(pqxx::connection &pgConn,
+                                    const std::string &connectionString,
+                                    const std::vector<TableInfo> &tables) {
+  std::string source = serverKey(connectionString);
+  MYSQL *conn = connect_(connectionString);
+  if (!conn) {
+    Logger::error(LogCategory::TRANSFER, "streamSource",
+                  "Failed to connect to " + source);
+    return;
+  }
+
+  auto settings = queryRows(conn, "SELECT @@log_bin, @@binlog_format, "
+                                  "@@binlog_row_image, @@gtid_binlog_pos");
+  if (!settings || settings->empty() || (*settings)[0].size() < 4) {
+    Logger::error(LogCategory::TRANSFER, "streamSource",
+                  "Failed to read binlog settings of " + source + ": " +
+                      std::string(mysql_error(conn)));
+    mysql_close(conn);
+    return;
+  }
+  const std::vector<std::string> &setting = (*settings)[0];
+  if (setting[0] != "1" || lowercase(setting[1]) != "row" ||
+      lowercase(setting[2]) != "full") {
+    Logger::error(LogCategory::TRANSFER, "streamSource",
+                  "Binlog CDC on " + source +
+                      " needs log_bin=ON, binlog_format=ROW and "
+                      "binlog_row_image=FULL (found log_bin=" +
+                      setting[0] + ", binlog_format=" + setting[1] +
+                      ", binlog_row_image=" + setting[2] + ")");
+    mysql_close(conn);
+    return;
+  }
+  GtidPosition head = parseGtidPosition(setting[3]);
+
+  std::map<std::string, std::string> savedPositions;
+  try {
+    pqxx::work txn(pgConn);
+    auto result = txn.exec(
+        "SELECT schema_name, table_name, sync_metadata->>'binlog_gtid_pos' "
+        "FROM metadata.catalog WHERE db_engine='MariaDB' AND "
+        "sync_metadata ? 'binlog_gtid_pos'");
+    txn.commit();
+    for (const auto &row : result) {
+      savedPositions[row[0].as<std::string>() + "." +
+                     row[1].as<std::string>()] =
+          row[2].is_null() ? "" : row[2].as<std::string>();
+    }
+  } catch (const std::exception &e) {
+    Logger::error(LogCategory::TRANSFER, "streamSource",
+                  "Error reading binlog positions: " + std::string(e.what()));
+    mysql_close(conn);
+    return;
+  }
+
+  std::map<std::string, BinlogTable> streamed;
+  std::vector<TableInfo> unpositioned;
+  bool behind = false;
+  for (const auto &table : tables) {
+    std::string tableKey = table.schema_name + "." + table.table_name;
+    auto saved = savedPositions.find(tableKey);
+    if (saved == savedPositions.end()) {
+      unpositioned.push_back(table);
+      continue;
+    }
+    BinlogTable &state = streamed[tableKey];
+    state.info = table;
+    state.position = parseGtidPosition(saved->second);
+    for (const auto &domain : head) {
+      auto seen = state.position.find(domain.first);
+      if (seen == state.position.end() ||
+          seen->second.second < domain.second.second)
+        behind = true;
+    }
+  }
+  if (!unpositioned.empty())
+    requestFullLoad(pgConn, unpositioned, "no binlog position to start from");
+  if (!behind) {
+    mysql_close(conn);
+    return;
+  }
+
+  for (auto it = streamed.begin(); it != streamed.end();) {
+    if (loadColumns(pgConn, it->second))
+      ++it;
+    else
+      it = streamed.erase(it);
+  }
+  if (streamed.empty()) {
+    mysql_close(conn);
+    return;
+  }
+
+  // The stream starts from the oldest position: the lowest seq_no of each
+  // domain every table has seen, and from the start of the binlogs for a
+  // domain some table has not seen at all
+  GtidPosition start = streamed.begin()->second.position;
+  for (const auto &entry : streamed) {
+    const GtidPosition &position = entry.second.position;
+    for (auto it = start.begin(); it != start.end();) {
+      auto seen = position.find(it->first);
+      if (seen == position.end()) {
+        it = start.erase(it);
+        continue;
+      }
+      if (seen->second.second < it->second.second)
+        it->second = seen->second;
+      ++it;
+    }
+  }
+
+  uint32_t replicaServerId = DEFAULT_REPLICA_SERVER_ID;
+  std::string configuredId =
+      connectionOption(connectionString, "binlog_server_id");
+  if (!configuredId.empty()) {
+    try {
+      replicaServerId = static_cast<uint32_t>(std::stoul(configuredId));
+    } catch (const std::exception &) {
+      Logger::warning(LogCategory::TRANSFER, "streamSource",
+                      "Invalid binlog_server_id '" + configuredId +
+                          "' - using " + std::to_string(replicaServerId));
+    }
+  }
+
+  const std::vector<std::string> session = {
+      "SET @mariadb_slave_capability = 4",
+      "SET @slave_connect_state = '" + formatGtidPosition(start) + "'",
+      "SET @slave_gtid_strict_mode = 1",
+      "SET @master_binlog_checksum = @@global.binlog_checksum"};
+  for (const auto &statement : session) {
+    if (mysql_query(conn, statement.c_str())) {
+      Logger::error(LogCategory::TRANSFER, "streamSource",
+                    "Failed to prepare binlog stream of " + source + ": " +
+                        std::string(mysql_error(conn)));
+      mysql_close(conn);
+      return;
+    }
+  }
+
+  MARIADB_RPL *rpl = mariadb_rpl_init(conn);
+  if (!rpl) {
+    Logger::error(LogCategory::TRANSFER, "streamSource",
+                  "mariadb_rpl_init() failed for " + source);
+    mysql_close(conn);
+    return;
+  }
+  mariadb_rpl_optionsv(rpl, MARIADB_RPL_SERVER_ID, replicaServerId);
+  mariadb_rpl_optionsv(rpl, MARIADB_RPL_FLAGS,
+                       static_cast<unsigned int>(
+                           MARIADB_RPL_BINLOG_DUMP_NON_BLOCK));
+  mariadb_rpl_optionsv(rpl, MARIADB_RPL_START, 4UL);
+  mariadb_rpl_optionsv(rpl, MARIADB_RPL_EXTRACT_VALUES, 1);
+
+  GtidPosition committed = start;
+  uint32_t domainId = 0;
+  uint32_t originServerId = 0;
+  uint64_t sequence = 0;
+  bool standalone = false;
+  bool atBoundary = true;
+  size_t transactions = 0;
+  size_t pendingChanges = 0;
+  size_t readChanges = 0;
+  std::vector<std::pair<BinlogTable *, RowChange>> transaction;
+  std::map<uint64_t, MARIADB_RPL_EVENT *> tableMaps;
+
+  auto releaseTableMaps = [&tableMaps]() {
+    for (auto &entry : tableMaps)
+      mariadb_free_rpl_event(entry.second);
+    tableMaps.clear();
+  };
+  auto commit = [&]() {
+    committed[domainId] = {originServerId, sequence};
+    for (auto &change : transaction)
+      change.first->pending.push_back(std::move(change.second));
+    pendingChanges += transaction.size();
+    readChanges += transaction.size();
+    transaction.clear();
+    atBoundary = true;
+    ++transactions;
+  };
+
+  unsigned int streamError = 0;
+  std::string streamErrorText;
+  if (mariadb_rpl_open(rpl)) {
+    streamError = mysql_errno(conn);
+    streamErrorText = mysql_error(conn);
+  } else {
+    MARIADB_RPL_EVENT *event;
+    while ((event = mariadb_rpl_fetch(rpl, nullptr)) != nullptr) {
+      switch (event->event_type) {
+      case GTID_EVENT:
+        releaseTableMaps();
+        transaction.clear();
+        domainId = event->event.gtid.domain_id;
+        originServerId = event->server_id;
+        sequence = event->event.gtid.sequence_nr;
+        standalone = (event->event.gtid.flags & GTID_FLAG_STANDALONE) != 0;
+        atBoundary = false;
+        break;
+      case TABLE_MAP_EVENT: {
+        // Kept until the transaction ends; its rows events refer to it
+        MARIADB_RPL_EVENT *&tableMap =
+            tableMaps[event->event.table_map.table_id];
+        if (tableMap)
+          mariadb_free_rpl_event(tableMap);
+        tableMap = event;
+        event = nullptr;
+        break;
+      }
+      case XID_EVENT:
+        commit();
+        break;
+      case QUERY_EVENT: {
+        std::string statement(event->event.query.statement.str,
+                              event->event.query.statement.length);
+        if (standalone || statement == "COMMIT")
+          commit();
+        break;
+      }
+      default: {
+        char operation = rowsOperation(event->event_type);
+        if (operation == 0)
+          break;
+        auto tableMap = tableMaps.find(event->event.rows.table_id);
+        if (tableMap == tableMaps.end())
+          break;
+        const auto &map = tableMap->second->event.table_map;
+        auto it = streamed.find(
+            std::string(map.database.str, map.database.length) + "." +
+            std::string(map.table.str, map.table.length));
+        if (it == streamed.end())
+          break;
+        BinlogTable &table = it->second;
+        auto seen = table.position.find(domainId);
+        if (!table.reloadReason.empty() ||
+            (seen != table.position.end() && seen->second.second >= sequence))
+          break;
+        if (map.column_count != table.columnNames.size() &&
+            (!loadColumns(pgConn, table) ||
+             map.column_count != table.columnNames.size())) {
+          // Skipping the event would let the position pass changes that
+          // were never applied
+          table.reloadReason = "binlog row image has " +
+                               std::to_string(map.column_count) +
+                               " columns, the table has " +
+                               std::to_string(table.columnNames.size());
+          Logger::warning(LogCategory::TRANSFER, "streamSource",
+                          "Binlog row image of " + it->first + " has " +
+                              std::to_string(map.column_count) +
+                              " columns, the table has " +
+                              std::to_string(table.columnNames.size()) +
+                              " - dropping its changes until it is reloaded");
+          break;
+        }
+
+        for (MARIADB_RPL_ROW *row =
+                 mariadb_rpl_extract_rows(rpl, tableMap->second, event);
+             row != nullptr; row = row->next) {
+          if (operation != 'U') {
+            transaction.push_back(
+                {&table, RowChange{operation, rowValues(table, *row)}});
+            continue;
+          }
+          // Update rows come as before/after image pairs. Without a key, or
+          // when the key changed, the before image is deleted explicitly.
+          if (row->next == nullptr)
+            break;
+          std::vector<std::string> before = rowValues(table, *row);
+          row = row->next;
+          std::vector<std::string> after = rowValues(table, *row);
+          if (table.pkPositions.empty() ||
+              rowKey(before, table.pkPositions) !=
+                  rowKey(after, table.pkPositions))
+            transaction.push_back({&table, RowChange{'D', std::move(before)}});
+          transaction.push_back({&table, RowChange{'U', std::move(after)}});
+        }
+        break;
+      }
+      }
+      if (event)
+        mariadb_free_rpl_event(event);
+
+      if (atBoundary && pendingChanges >= BINLOG_APPLY_BATCH_CHANGES) {
+        applyPending(pgConn, streamed, committed);
+        pendingChanges = 0;
+      }
+      if (atBoundary && readChanges >= CHANGE_LOG_READ_MAX_ROWS)
+        break;
+    }
+    if (readChanges < CHANGE_LOG_READ_MAX_ROWS && mysql_errno(conn)) {
+      streamError = mysql_errno(conn);
+      streamErrorText = mysql_error(conn);
+    }
+  }
+
+  releaseTableMaps();
+  mariadb_rpl_close(rpl);
+  mysql_close(conn);
+
+  applyPending(pgConn, streamed, committed);
+
+  for (const auto &entry : streamed)
+    if (!entry.second.reloadReason.empty())
+      requestFullLoad(pgConn, {entry.second.info}, entry.second.reloadReason);
+
+  if (streamError == ER_MASTER_FATAL_ERROR_READING_BINLOG) {
+    std::vector<TableInfo> reload;
+    for (const auto &entry : streamed)
+      if (entry.second.reloadReason.empty())
+        reload.push_back(entry.second.info);
+    requestFullLoad(pgConn, reload,
+                    "binlog position is no longer available on " + source +
+                        " (" + streamErrorText + ")");
+  } else if (streamError) {
+    Logger::error(LogCategory::TRANSFER, "streamSource",
+                  "Binlog stream of " + source + " failed: " +
+                      streamErrorText);
+  }
+
+  Logger::info(LogCategory::TRANSFER, "streamSource",
+               "Read " + std::to_string(transactions) +
+                   " binlog transactions with " +
+                   std::to_string(readChanges) + " row changes on " + source +
+                   " for " + std::to_string(streamed.size()) +
+                   " tables; position " + formatGtidPosition(committed));
+}
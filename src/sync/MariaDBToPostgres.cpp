@@ -3,6 +3,7 @@
 #include "core/database_config.h"
 #include "engines/database_engine.h"
 #include "engines/mariadb_engine.h"
+#include "sync/ChangeCoalescer.h"
 #include "third_party/json.hpp"
 #include <algorithm>
 #include <cctype>
@@ -42,24 +43,63 @@ std::unordered_map<std::string, std::string> MariaDBToPostgres::collationMap = {
     {"latin1_swedish_ci", "C"},
     {"ascii_general_ci", "C"}};
 
+// Resolves everything cleanValueWithTraits needs to know about a column type
+// once: whether values are binary (BYTEA/BLOB/BIT) or date-like
+// (TIMESTAMP/DATETIME/DATE), and the value written for nulls (0 for integers,
+// 0.0 for floats, "DEFAULT" for strings, "1970-01-01 00:00:00" for
+// timestamps).
+MariaDBToPostgres::ColumnTraits
+MariaDBToPostgres::classifyColumnType(const std::string &columnType) {
+  std::string upperType = columnType;
+  std::transform(upperType.begin(), upperType.end(), upperType.begin(),
+                 ::toupper);
+
+  ColumnTraits traits;
+  traits.binary = upperType.find("BYTEA") != std::string::npos ||
+                  upperType.find("BLOB") != std::string::npos ||
+                  upperType.find("BIT") != std::string::npos;
+  traits.dateLike = upperType.find("TIMESTAMP") != std::string::npos ||
+                    upperType.find("DATETIME") != std::string::npos ||
+                    upperType.find("DATE") != std::string::npos;
+
+  if (upperType.find("INTEGER") != std::string::npos ||
+      upperType.find("BIGINT") != std::string::npos ||
+      upperType.find("SMALLINT") != std::string::npos) {
+    traits.nullValue = "0";
+  } else if (upperType.find("REAL") != std::string::npos ||
+             upperType.find("FLOAT") != std::string::npos ||
+             upperType.find("DOUBLE") != std::string::npos ||
+             upperType.find("NUMERIC") != std::string::npos) {
+    traits.nullValue = "0.0";
+  } else if (upperType.find("VARCHAR") != std::string::npos ||
+             upperType.find("TEXT") != std::string::npos ||
+             upperType.find("CHAR") != std::string::npos) {
+    traits.nullValue = "DEFAULT";
+  } else if (upperType.find("TIMESTAMP") != std::string::npos ||
+             upperType.find("DATETIME") != std::string::npos) {
+    traits.nullValue = "1970-01-01 00:00:00";
+  } else if (upperType.find("DATE") != std::string::npos) {
+    traits.nullValue = "1970-01-01";
+  } else if (upperType.find("TIME") != std::string::npos) {
+    traits.nullValue = "00:00:00";
+  } else {
+    traits.nullValue = "DEFAULT";
+  }
+  return traits;
+}
+
 // Cleans and normalizes a value from MariaDB for insertion into PostgreSQL.
 // Handles null detection (empty strings, "NULL", invalid dates like
 // "0000-00-00", "1900-01-01", "1970-01-01"), invalid binary characters
-// (non-ASCII), and invalid date formats. For VARCHAR/CHAR types, truncates
-// values that exceed the maximum length specified in the column type. For
-// BYTEA/BLOB/BIT types, validates hexadecimal format and truncates large binary
-// data (>1000 bytes). For null values, returns appropriate defaults based on
-// column type (0 for integers, 0.0 for floats, "DEFAULT" for strings,
-// "1970-01-01 00:00:00" for timestamps). For date/timestamp types, validates
-// format and detects invalid dates containing "-00". Returns the cleaned value
-// ready for SQL insertion.
+// (non-ASCII), and invalid date formats. For binary columns, validates
+// hexadecimal format and truncates large binary data (>1000 bytes). For
+// date-like columns, validates format and detects invalid dates containing
+// "-00". Null values are replaced with the column's nullValue. Returns the
+// cleaned value ready for SQL insertion.
 std::string
-MariaDBToPostgres::cleanValueForPostgres(const std::string &value,
-                                         const std::string &columnType) {
+MariaDBToPostgres::cleanValueWithTraits(const std::string &value,
+                                        const ColumnTraits &traits) {
   std::string cleanValue = value;
-  std::string upperType = columnType;
-  std::transform(upperType.begin(), upperType.end(), upperType.begin(),
-                 ::toupper);
 
   bool isNull =
       (cleanValue.empty() || cleanValue == "NULL" || cleanValue == "null" ||
@@ -78,10 +118,7 @@ MariaDBToPostgres::cleanValueForPostgres(const std::string &value,
   // No truncate CHAR/VARCHAR values - use TEXT type instead
   // This allows values of any length without truncation
 
-  if (upperType.find("BYTEA") != std::string::npos ||
-      upperType.find("BLOB") != std::string::npos ||
-      upperType.find("BIT") != std::string::npos) {
-
+  if (traits.binary) {
     bool hasInvalidBinaryChars = false;
     for (char c : cleanValue) {
       if (!std::isxdigit(c) && c != ' ' && c != '\\' && c != 'x') {
@@ -103,9 +140,7 @@ MariaDBToPostgres::cleanValueForPostgres(const std::string &value,
     }
   }
 
-  if (upperType.find("TIMESTAMP") != std::string::npos ||
-      upperType.find("DATETIME") != std::string::npos ||
-      upperType.find("DATE") != std::string::npos) {
+  if (traits.dateLike) {
     if (cleanValue.length() < 10 || cleanValue.find("-") == std::string::npos ||
         cleanValue.find("0000") != std::string::npos) {
       isNull = true;
@@ -119,34 +154,107 @@ MariaDBToPostgres::cleanValueForPostgres(const std::string &value,
   }
 
   if (isNull) {
-    if (upperType.find("INTEGER") != std::string::npos ||
-        upperType.find("BIGINT") != std::string::npos ||
-        upperType.find("SMALLINT") != std::string::npos) {
-      return "0";
-    } else if (upperType.find("REAL") != std::string::npos ||
-               upperType.find("FLOAT") != std::string::npos ||
-               upperType.find("DOUBLE") != std::string::npos ||
-               upperType.find("NUMERIC") != std::string::npos) {
-      return "0.0";
-    } else if (upperType.find("VARCHAR") != std::string::npos ||
-               upperType.find("TEXT") != std::string::npos ||
-               upperType.find("CHAR") != std::string::npos) {
-      return "DEFAULT";
-    } else if (upperType.find("TIMESTAMP") != std::string::npos ||
-               upperType.find("DATETIME") != std::string::npos) {
-      return "1970-01-01 00:00:00";
-    } else if (upperType.find("DATE") != std::string::npos) {
-      return "1970-01-01";
-    } else if (upperType.find("TIME") != std::string::npos) {
-      return "00:00:00";
-    } else {
-      return "DEFAULT";
-    }
+    return traits.nullValue;
   }
 
   return cleanValue;
 }
 
+std::string
+MariaDBToPostgres::cleanValueForPostgres(const std::string &value,
+                                         const std::string &columnType) {
+  return cleanValueWithTraits(value, classifyColumnType(columnType));
+}
+
+// Classifies the column type once and returns a converter bound to the
+// result, so batch loops skip the per-value upper-casing and substring scans.
+DatabaseToPostgresSync::ColumnConverter
+MariaDBToPostgres::compileColumnConverter(const std::string &columnType) {
+  ColumnTraits traits = classifyColumnType(columnType);
+  return [traits](const std::string &value) {
+    return cleanValueWithTraits(value, traits);
+  };
+}
+
+// Re-reads the current source rows of the given keys, CDC_REFETCH_BATCH_KEYS
+// keys per `WHERE (pk) IN (...)` query instead of one query per change, and
+// appends them to records in columnNames order, the column list the full
+// load writes. Keys whose row has been deleted since the change was logged
+// are not returned; their delete follows later in the change log. Returns
+// the number of rows found, or nothing if a query failed, in which case the
+// changes must not be applied.
+std::optional<size_t> MariaDBToPostgres::refetchRowsByKey(
+    MYSQL *mariadbConn, const TableInfo &table,
+    const std::vector<std::string> &pkColumns,
+    const std::vector<std::string> &columnNames,
+    const std::vector<std::vector<std::string>> &keys,
+    std::unordered_map<std::string, std::unique_ptr<MariaDBStatement>>
+        &statements,
+    std::vector<std::vector<std::string>> &records) {
+  std::string columnList;
+  for (size_t i = 0; i < columnNames.size(); ++i) {
+    if (i > 0)
+      columnList += ", ";
+    columnList += "`" + columnNames[i] + "`";
+  }
+  std::string keyList;
+  std::string keyPlaceholders;
+  for (size_t i = 0; i < pkColumns.size(); ++i) {
+    if (i > 0) {
+      keyList += ", ";
+      keyPlaceholders += ", ";
+    }
+    keyList += "`" + pkColumns[i] + "`";
+    keyPlaceholders += "?";
+  }
+  if (pkColumns.size() > 1) {
+    keyList = "(" + keyList + ")";
+    keyPlaceholders = "(" + keyPlaceholders + ")";
+  }
+
+  size_t found = 0;
+  for (size_t start = 0; start < keys.size();
+       start += CDC_REFETCH_BATCH_KEYS) {
+    size_t count = std::min(CDC_REFETCH_BATCH_KEYS, keys.size() - start);
+    std::string selectQuery = "SELECT " + columnList + " FROM `" +
+                              table.schema_name + "`.`" + table.table_name +
+                              "` WHERE " + keyList + " IN (";
+    std::vector<std::string> params;
+    params.reserve(count * pkColumns.size());
+    for (size_t k = start; k < start + count; ++k) {
+      if (k > start)
+        selectQuery += ", ";
+      selectQuery += keyPlaceholders;
+      params.insert(params.end(), keys[k].begin(), keys[k].end());
+    }
+    selectQuery += ")";
+
+    auto &statement = statements[selectQuery];
+    if (!statement)
+      statement = std::make_unique<MariaDBStatement>(mariadbConn, selectQuery);
+
+    RowBatch batch;
+    if (statement->execute(params))
+      statement->fetchBatch(batch, std::numeric_limits<size_t>::max());
+    if (!statement->isValid()) {
+      Logger::error(LogCategory::TRANSFER, "refetchRowsByKey",
+                    "Re-fetch failed for " + table.schema_name + "." +
+                        table.table_name + ": " + statement->error());
+      // Prepared again on the next attempt
+      statements.erase(selectQuery);
+      return std::nullopt;
+    }
+    if (batch.rowCount() == 0 || batch.columnCount() != columnNames.size())
+      continue;
+
+    std::vector<std::vector<std::string>> rows = batch.toRows();
+    found += rows.size();
+    records.insert(records.end(), std::make_move_iterator(rows.begin()),
+                   std::make_move_iterator(rows.end()));
+  }
+  return found;
+}
+
 void MariaDBToPostgres::processTableCDC(
     const std::string &tableKey, MYSQL *mariadbConn, const TableInfo &table,
     pqxx::connection &pgConn, const std::vector<std::string> &columnNames,
@@ -193,19 +301,38 @@ void MariaDBToPostgres::processTableCDC(
     bool hasMore = true;
     size_t batchNumber = 0;
 
+    // Re-fetch statements keyed by their SQL (which only varies with the
+    // number of keys looked up), prepared once and reused for every batch of
+    // this run
+    std::unordered_map<std::string, std::unique_ptr<MariaDBStatement>>
+        refetchStatements;
+
+    // Changes the multiplexed change log read already took for this table;
+    // a table it did not cover polls the log itself
+    DispatchedChanges dispatched;
+    bool useDispatched = takeDispatchedChanges(tableKey, dispatched);
+    size_t dispatchedOffset = 0;
+
     while (hasMore) {
       batchNumber++;
-      std::string query = "SELECT change_id, operation, pk_values, row_data "
-                          "FROM datasync_metadata.ds_change_log WHERE "
-                          "schema_name='" +
-                          escapeSQL(table.schema_name) + "' AND table_name='" +
-                          escapeSQL(table.table_name) + "' AND change_id > " +
-                          std::to_string(lastChangeId) +
-                          " ORDER BY change_id LIMIT " +
-                          std::to_string(CHUNK_SIZE);
-
-      std::vector<std::vector<std::string>> rows =
-          executeQueryMariaDB(mariadbConn, query);
+      std::vector<std::vector<std::string>> rows;
+      if (useDispatched) {
+        size_t end =
+            std::min(dispatched.rows.size(), dispatchedOffset + CHUNK_SIZE);
+        rows.assign(
+            std::make_move_iterator(dispatched.rows.begin() + dispatchedOffset),
+            std::make_move_iterator(dispatched.rows.begin() + end));
+        dispatchedOffset = end;
+      } else {
+        std::string query =
+            "SELECT change_id, operation, pk_values, row_data "
+            "FROM datasync_metadata.ds_change_log WHERE schema_name='" +
+            escapeSQL(table.schema_name) + "' AND table_name='" +
+            escapeSQL(table.table_name) +
+            "' AND change_id > " + std::to_string(lastChangeId) +
+            " ORDER BY change_id LIMIT " + std::to_string(CHUNK_SIZE);
+        rows = executeQueryMariaDB(mariadbConn, query);
+      }
 
       if (rows.empty()) {
         hasMore = false;
@@ -215,8 +342,24 @@ void MariaDBToPostgres::processTableCDC(
       long long maxChangeId = lastChangeId;
       std::vector<std::vector<std::string>> deletedPKs;
       std::vector<std::vector<std::string>> recordsToUpsert;
+      std::vector<std::vector<std::string>> refetchKeys;
+
+      // Keyed tables only apply the last change per key; rows of tables
+      // without a PK are keyed by content hash and are applied one by one.
+      // The change log triggers serialize a key the same way every time, so
+      // pk_values identifies it as is.
+      ChangeCoalescer coalescer;
+      if (hasPK) {
+        for (const auto &row : rows) {
+          coalescer.add(row.size() >= 3 ? row[2] : std::string(),
+                        row.size() >= 2 && !row[1].empty() ? row[1][0] : ' ');
+        }
+        coalescer.finish();
+      }
+      const size_t elided = coalescer.elided();
 
-      for (const auto &row : rows) {
+      for (size_t rowIndex = 0; rowIndex < rows.size(); ++rowIndex) {
+        const auto &row = rows[rowIndex];
         if (row.size() < 3) {
           continue;
         }
@@ -238,6 +381,10 @@ void MariaDBToPostgres::processTableCDC(
                             std::string(e.what()));
         }
 
+        if (hasPK && !coalescer.keep(rowIndex)) {
+          continue;
+        }
+
         try {
           json pkObject = json::parse(pkJson);
           bool isNoPKTable = !hasPK && pkObject.contains("_hash");
@@ -388,36 +535,7 @@ void MariaDBToPostgres::processTableCDC(
               }
 
               if (!useRowData) {
-                std::string whereClause = "";
-                for (size_t i = 0; i < pkColumns.size(); ++i) {
-                  if (i > 0) {
-                    whereClause += " AND ";
-                  }
-                  std::string pkValue = pkValues[i];
-                  if (pkValue == "NULL") {
-                    whereClause += "`" + pkColumns[i] + "` IS NULL";
-                  } else {
-                    whereClause +=
-                        "`" + pkColumns[i] + "` = '" + escapeSQL(pkValue) + "'";
-                  }
-                }
-
-                std::string selectQuery =
-                    "SELECT * FROM `" + table.schema_name + "`.`" +
-                    table.table_name + "` WHERE " + whereClause + " LIMIT 1";
-
-                std::vector<std::vector<std::string>> recordResult =
-                    executeQueryMariaDB(mariadbConn, selectQuery);
-
-                if (!recordResult.empty() &&
-                    recordResult[0].size() == columnNames.size()) {
-                  recordsToUpsert.push_back(recordResult[0]);
-                } else {
-                  Logger::warning(LogCategory::TRANSFER, "processTableCDC",
-                                  "Record not found in source for " + tableKey +
-                                      " operation " + op +
-                                      " with PK: " + pkJson);
-                }
+                refetchKeys.push_back(pkValues);
               }
             }
           }
@@ -428,79 +546,57 @@ void MariaDBToPostgres::processTableCDC(
         }
       }
 
-      size_t deletedCount = 0;
-      if (!deletedPKs.empty()) {
-        std::string lowerSchemaName = table.schema_name;
-        std::transform(lowerSchemaName.begin(), lowerSchemaName.end(),
-                       lowerSchemaName.begin(), ::tolower);
-
-        bool isNoPKTable = !hasPK;
-
-        if (isNoPKTable && !deletedPKs.empty()) {
-          deletedCount =
-              deleteRecordsByHash(pgConn, lowerSchemaName, table.table_name,
-                                  deletedPKs, columnNames);
-        } else if (hasPK && !deletedPKs.empty()) {
-          deletedCount = deleteRecordsByPrimaryKey(
-              pgConn, lowerSchemaName, table.table_name, deletedPKs, pkColumns);
-        }
-      }
-
-      size_t upsertedCount = 0;
-      if (!recordsToUpsert.empty()) {
-        std::string lowerSchemaName = table.schema_name;
-        std::transform(lowerSchemaName.begin(), lowerSchemaName.end(),
-                       lowerSchemaName.begin(), ::tolower);
-        try {
-          bool isNoPKTable = !hasPK;
-          if (isNoPKTable) {
-            performBulkUpsertNoPK(pgConn, recordsToUpsert, columnNames,
-                                  columnTypes, lowerSchemaName,
-                                  table.table_name, table.schema_name);
-          } else {
-            performBulkUpsert(pgConn, recordsToUpsert, columnNames, columnTypes,
-                              lowerSchemaName, table.table_name,
-                              table.schema_name);
-          }
-          upsertedCount = recordsToUpsert.size();
-        } catch (const std::exception &e) {
+      if (!refetchKeys.empty()) {
+        std::optional<size_t> found =
+            refetchRowsByKey(mariadbConn, table, pkColumns, columnNames,
+                             refetchKeys, refetchStatements, recordsToUpsert);
+        if (!found) {
           Logger::error(LogCategory::TRANSFER, "processTableCDC",
-                        "Failed to upsert records for " + tableKey + ": " +
-                            std::string(e.what()));
+                        "Could not re-fetch changed rows of " + tableKey +
+                            "; batch not applied, last_change_id stays at " +
+                            std::to_string(lastChangeId));
+          break;
+        }
+        if (*found < refetchKeys.size()) {
+          Logger::warning(LogCategory::TRANSFER, "processTableCDC",
+                          std::to_string(refetchKeys.size() - *found) +
+                              " changed records of " + tableKey +
+                              " no longer exist in source");
         }
       }
 
-      if (maxChangeId > lastChangeId) {
-        try {
-          std::lock_guard<std::mutex> lock(metadataUpdateMutex);
-          pqxx::work txn(pgConn);
-          std::string updateQuery =
-              "UPDATE metadata.catalog SET sync_metadata = "
-              "COALESCE(sync_metadata, '{}'::jsonb) || "
-              "jsonb_build_object('last_change_id', " +
-              std::to_string(maxChangeId) +
-              ") WHERE schema_name=" + txn.quote(table.schema_name) +
-              " AND table_name=" + txn.quote(table.table_name) +
-              " AND db_engine='MariaDB'";
-          txn.exec(updateQuery);
-          txn.commit();
-          lastChangeId = maxChangeId;
-        } catch (const std::exception &e) {
-          Logger::error(LogCategory::TRANSFER, "processTableCDC",
-                        "Error updating last_change_id for " + tableKey + ": " +
-                            std::string(e.what()));
-        }
+      // The log is complete up to readUpTo, so once the read's rows are
+      // applied the table is caught up to there
+      if (useDispatched && dispatchedOffset == dispatched.rows.size()) {
+        maxChangeId = std::max(maxChangeId, dispatched.readUpTo);
       }
 
+      // Deletes, upserts and the new last_change_id reach the target in one
+      // transaction, shared with the batches other tables commit meanwhile
+      CDCApplyBatch batch =
+          makeCDCApplyBatch(table, columnNames, columnTypes, pkColumns);
+      batch.dbEngine = "MariaDB";
+      batch.deletes = std::move(deletedPKs);
+      batch.upserts = std::move(recordsToUpsert);
+      batch.progress["last_change_id"] = std::max(maxChangeId, lastChangeId);
+      batch.elided = elided;
+      if (commitCDCBatch(pgConn, batch))
+        lastChangeId = std::max(maxChangeId, lastChangeId);
+      size_t deletedCount = batch.deleted;
+      size_t upsertedCount = batch.upserted;
+
       Logger::info(
           LogCategory::TRANSFER, "processTableCDC",
           "Processed CDC batch " + std::to_string(batchNumber) + " for " +
               tableKey + " with " + std::to_string(rows.size()) +
               " changes: " + std::to_string(upsertedCount) + " upserts, " +
-              std::to_string(deletedCount) +
-              " deletes; last_change_id=" + std::to_string(lastChangeId));
+              std::to_string(deletedCount) + " deletes, " +
+              std::to_string(elided) + " elided; last_change_id=" +
+              std::to_string(lastChangeId));
 
-      if (rows.size() < CHUNK_SIZE) {
+      if (useDispatched) {
+        hasMore = dispatchedOffset < dispatched.rows.size();
+      } else if (rows.size() < CHUNK_SIZE) {
         hasMore = false;
       }
     }
@@ -513,6 +609,11 @@ void MariaDBToPostgres::processTableCDC(
 
 void MariaDBToPostgres::processTableCDC(const TableInfo &table,
                                         pqxx::connection &pgConn) {
+  if (MariaDBBinlogCDC::usesBinlog(table.connection_string)) {
+    binlogCDC_.processTableCDC(table, pgConn);
+    return;
+  }
+
   std::string tableKey = table.schema_name + "." + table.table_name;
   MYSQL *mariadbConn = getMariaDBConnection(table.connection_string);
   if (!mariadbConn) {
@@ -615,3 +716,350 @@ MariaDBToPostgres::getActiveTables(pqxx::connection &pgConn) {
 
   return data;
 }
+
+// host:port a MariaDB connection string points to; the change log lives in
+// the server-wide datasync_metadata database, so that is what identifies it
+static std::string mariaDBServerKey(const std::string &connectionString) {
+  std::string host;
+  std::string port = "3306";
+  std::istringstream ss(connectionString);
+  std::string token;
+  while (std::getline(ss, token, ';')) {
+    auto pos = token.find('=');
+    if (pos == std::string::npos)
+      continue;
+    std::string key = token.substr(0, pos);
+    std::string value = token.substr(pos + 1);
+    key.erase(0, key.find_first_not_of(" \t\r\n"));
+    key.erase(key.find_last_not_of(" \t\r\n") + 1);
+    value.erase(0, value.find_first_not_of(" \t\r\n"));
+    value.erase(value.find_last_not_of(" \t\r\n") + 1);
+    if (key == "host")
+      host = value;
+    else if (key == "port" && !value.empty())
+      port = value;
+  }
+  return host + ":" + port;
+}
+
+// Deletes the change log rows of one table that every consumer has applied,
+// CHANGE_LOG_PURGE_BATCH_ROWS per statement so no single delete holds locks
+// for long, and at most CHANGE_LOG_PURGE_MAX_BATCHES statements per cycle.
+// Returns the number of rows deleted.
+size_t MariaDBToPostgres::purgeChangeLogRows(MYSQL *mariadbConn,
+                                             const std::string &schemaName,
+                                             const std::string &tableName,
+                                             long long appliedChangeId) {
+  if (appliedChangeId <= 0)
+    return 0;
+  std::string query =
+      "DELETE FROM datasync_metadata.ds_change_log WHERE schema_name='" +
+      escapeSQL(schemaName) + "' AND table_name='" + escapeSQL(tableName) +
+      "' AND change_id <= " + std::to_string(appliedChangeId) +
+      " ORDER BY change_id LIMIT " +
+      std::to_string(CHANGE_LOG_PURGE_BATCH_ROWS);
+
+  size_t purged = 0;
+  for (size_t batch = 0; batch < CHANGE_LOG_PURGE_MAX_BATCHES; ++batch) {
+    if (mysql_query(mariadbConn, query.c_str())) {
+      Logger::warning(LogCategory::TRANSFER, "purgeChangeLogRows",
+                      "Failed to purge change log of " + schemaName + "." +
+                          tableName + ": " +
+                          std::string(mysql_error(mariadbConn)));
+      break;
+    }
+    my_ulonglong affected = mysql_affected_rows(mariadbConn);
+    purged += static_cast<size_t>(affected);
+    if (affected < CHANGE_LOG_PURGE_BATCH_ROWS)
+      break;
+  }
+  return purged;
+}
+
+// Maintains a ds_change_log partitioned by RANGE (change_id): drops every
+// partition whose changes have all been applied by all consumers of the
+// server (keeping the newest bounded one) and splits new partitions off the
+// empty pmax catch-all ahead of the newest change_id. DDL that cannot get
+// its lock within CHANGE_LOG_DDL_LOCK_WAIT_SECONDS is left to the next run.
+// Returns false if the log is not partitioned, in which case rows are purged
+// with deletes.
+bool MariaDBToPostgres::rotateChangeLogPartitions(MYSQL *mariadbConn,
+                                                  long long appliedChangeId,
+                                                  size_t &droppedRows) {
+  droppedRows = 0;
+  std::vector<std::vector<std::string>> partitions = executeQueryMariaDB(
+      mariadbConn,
+      "SELECT PARTITION_NAME, PARTITION_DESCRIPTION, TABLE_ROWS "
+      "FROM information_schema.PARTITIONS "
+      "WHERE TABLE_SCHEMA = 'datasync_metadata' AND "
+      "TABLE_NAME = 'ds_change_log' AND PARTITION_NAME IS NOT NULL "
+      "ORDER BY PARTITION_ORDINAL_POSITION");
+  if (partitions.empty())
+    return false;
+
+  struct Partition {
+    std::string name;
+    long long upperBound;
+    size_t rows;
+  };
+  std::vector<Partition> bounded;
+  bool hasCatchAll = false;
+  for (const auto &row : partitions) {
+    if (row.size() < 3)
+      continue;
+    if (row[1] == "MAXVALUE") {
+      hasCatchAll = row[0] == "pmax";
+      continue;
+    }
+    try {
+      bounded.push_back({row[0], std::stoll(row[1]),
+                         row[2].empty() ? 0 : std::stoul(row[2])});
+    } catch (const std::exception &) {
+      Logger::warning(LogCategory::TRANSFER, "rotateChangeLogPartitions",
+                      "Unexpected ds_change_log partition bound: " + row[1]);
+      return true;
+    }
+  }
+
+  // The DDL waits for the metadata lock behind every open transaction on
+  // the log, and the triggers of source writes queue behind the waiting
+  // DDL. A short lock wait gives up instead; the next purge run retries.
+  std::string lockWait = "SET SESSION lock_wait_timeout = " +
+                         std::to_string(CHANGE_LOG_DDL_LOCK_WAIT_SECONDS);
+  if (mysql_query(mariadbConn, lockWait.c_str())) {
+    Logger::warning(LogCategory::TRANSFER, "rotateChangeLogPartitions",
+                    "Failed to set lock_wait_timeout, skipping rotation: " +
+                        std::string(mysql_error(mariadbConn)));
+    return true;
+  }
+
+  // A partition holds change_id < upperBound, so it is fully applied once
+  // upperBound - 1 <= appliedChangeId
+  for (size_t i = 0; i + 1 < bounded.size(); ++i) {
+    if (bounded[i].upperBound - 1 > appliedChangeId)
+      break;
+    std::string drop =
+        "ALTER TABLE datasync_metadata.ds_change_log DROP PARTITION " +
+        bounded[i].name;
+    if (mysql_query(mariadbConn, drop.c_str())) {
+      Logger::warning(LogCategory::TRANSFER, "rotateChangeLogPartitions",
+                      "Failed to drop change log partition " +
+                          bounded[i].name + ": " +
+                          std::string(mysql_error(mariadbConn)));
+      break;
+    }
+    droppedRows += bounded[i].rows;
+  }
+
+  if (!hasCatchAll)
+    return true;
+
+  long long newestChangeId = 0;
+  std::vector<std::vector<std::string>> maxResult = executeQueryMariaDB(
+      mariadbConn, "SELECT COALESCE(MAX(change_id), 0) "
+                   "FROM datasync_metadata.ds_change_log");
+  if (!maxResult.empty() && !maxResult[0].empty() &&
+      !maxResult[0][0].empty()) {
+    try {
+      newestChangeId = std::stoll(maxResult[0][0]);
+    } catch (const std::exception &) {
+    }
+  }
+
+  long long highest = bounded.empty() ? 0 : bounded.back().upperBound;
+  for (int added = 0; added < CHANGE_LOG_MAX_NEW_PARTITIONS &&
+                      highest <= newestChangeId + CHANGE_LOG_PARTITION_CHANGES;
+       ++added) {
+    long long next =
+        bounded.empty() && added == 0
+            ? (newestChangeId / CHANGE_LOG_PARTITION_CHANGES + 1) *
+                  CHANGE_LOG_PARTITION_CHANGES
+            : highest + CHANGE_LOG_PARTITION_CHANGES;
+    std::string split =
+        "ALTER TABLE datasync_metadata.ds_change_log REORGANIZE PARTITION "
+        "pmax INTO (PARTITION p" +
+        std::to_string(next) + " VALUES LESS THAN (" + std::to_string(next) +
+        "), PARTITION pmax VALUES LESS THAN MAXVALUE)";
+    if (mysql_query(mariadbConn, split.c_str())) {
+      Logger::warning(LogCategory::TRANSFER, "rotateChangeLogPartitions",
+                      "Failed to add change log partition p" +
+                          std::to_string(next) + ": " +
+                          std::string(mysql_error(mariadbConn)));
+      break;
+    }
+    highest = next;
+  }
+  return true;
+}
+
+// Purges the ds_change_log of every MariaDB server with CDC tables. A
+// partitioned log sheds whole partitions below the lowest change applied on
+// the server; an unpartitioned one (created before partitioning was
+// introduced) is purged per table with bounded deletes. Purged rows and the
+// remaining log size are recorded in each table's sync_metadata.
+void MariaDBToPostgres::purgeChangeLog() {
+  try {
+    pqxx::connection pgConn(DatabaseConfig::getPostgresConnectionString());
+    auto sources = getChangeLogSources(pgConn, "MariaDB", mariaDBServerKey);
+
+    for (const auto &entry : sources) {
+      const ChangeLogSource &source = entry.second;
+      MYSQL *mariadbConn = getMariaDBConnection(source.connectionString);
+      if (!mariadbConn) {
+        Logger::error(LogCategory::TRANSFER, "purgeChangeLog",
+                      "Failed to connect to " + entry.first);
+        continue;
+      }
+
+      size_t droppedRows = 0;
+      bool partitioned = rotateChangeLogPartitions(
+          mariadbConn, source.minAppliedChangeId(), droppedRows);
+
+      std::map<std::pair<std::string, std::string>, size_t> purged;
+      size_t purgedTotal = droppedRows;
+      if (!partitioned) {
+        for (const auto &table : source.appliedChangeIds) {
+          size_t rows = purgeChangeLogRows(mariadbConn, table.first.first,
+                                           table.first.second, table.second);
+          purged[table.first] = rows;
+          purgedTotal += rows;
+        }
+      }
+
+      long long logRows = 0;
+      std::vector<std::vector<std::string>> sizeResult = executeQueryMariaDB(
+          mariadbConn, "SELECT TABLE_ROWS FROM information_schema.TABLES "
+                       "WHERE TABLE_SCHEMA = 'datasync_metadata' AND "
+                       "TABLE_NAME = 'ds_change_log'");
+      if (!sizeResult.empty() && !sizeResult[0].empty() &&
+          !sizeResult[0][0].empty()) {
+        try {
+          logRows = std::stoll(sizeResult[0][0]);
+        } catch (const std::exception &) {
+        }
+      }
+      mysql_close(mariadbConn);
+
+      for (const auto &table : source.appliedChangeIds) {
+        recordChangeLogPurge(pgConn, "MariaDB", table.first.first,
+                             table.first.second, purged[table.first],
+                             logRows);
+      }
+
+      Logger::info(LogCategory::TRANSFER, "purgeChangeLog",
+                   "Purged " + std::to_string(purgedTotal) +
+                       " change log rows on " + entry.first +
+                       (partitioned ? " by dropping partitions" : "") +
+                       "; ~" + std::to_string(logRows) + " rows remain");
+    }
+  } catch (const std::exception &e) {
+    Logger::error(LogCategory::TRANSFER, "purgeChangeLog",
+                  "Error purging MariaDB change logs: " +
+                      std::string(e.what()));
+  }
+}
+
+// Reads the change log of every MariaDB server with listening CDC tables
+// once per cycle, in change_id order from the lowest last_change_id among
+// them, and dispatches the rows to those tables (see dispatchChangeLog)
+// instead of each table polling the log. A server whose log has nothing
+// past that point costs a single MAX(change_id) probe. A server that cannot
+// be read is left out, and its tables poll the log themselves.
+void MariaDBToPostgres::readChangeLogs(pqxx::connection &pgConn) {
+  clearDispatchedChanges();
+  try {
+    auto sources =
+        getChangeLogSources(pgConn, "MariaDB", mariaDBServerKey, true);
+    const size_t CHUNK_SIZE = SyncConfig::getChunkSize();
+
+    for (const auto &entry : sources) {
+      const ChangeLogSource &source = entry.second;
+      MYSQL *mariadbConn = getMariaDBConnection(source.connectionString);
+      if (!mariadbConn) {
+        Logger::error(LogCategory::TRANSFER, "readChangeLogs",
+                      "Failed to connect to " + entry.first);
+        continue;
+      }
+
+      long long headChangeId = -1;
+      std::vector<std::vector<std::string>> head = executeQueryMariaDB(
+          mariadbConn, "SELECT COALESCE(MAX(change_id), 0) FROM "
+                       "datasync_metadata.ds_change_log");
+      if (!head.empty() && !head[0].empty()) {
+        try {
+          headChangeId = std::stoll(head[0][0]);
+        } catch (const std::exception &) {
+        }
+      }
+      if (headChangeId < 0) {
+        Logger::warning(LogCategory::TRANSFER, "readChangeLogs",
+                        "Cannot read the change log on " + entry.first +
+                            " - its tables will poll it individually");
+        mysql_close(mariadbConn);
+        continue;
+      }
+
+      long long position = source.minAppliedChangeId();
+      std::vector<std::vector<std::string>> logRows;
+      while (position < headChangeId &&
+             logRows.size() < CHANGE_LOG_READ_MAX_ROWS) {
+        std::vector<std::vector<std::string>> rows = executeQueryMariaDB(
+            mariadbConn,
+            "SELECT change_id, schema_name, table_name, operation, "
+            "pk_values, row_data FROM datasync_metadata.ds_change_log "
+            "WHERE change_id > " +
+                std::to_string(position) + " ORDER BY change_id LIMIT " +
+                std::to_string(CHUNK_SIZE));
+        if (rows.empty() || rows.back().empty())
+          break;
+        try {
+          position = std::stoll(rows.back()[0]);
+        } catch (const std::exception &) {
+          break;
+        }
+        size_t fetched = rows.size();
+        logRows.insert(logRows.end(), std::make_move_iterator(rows.begin()),
+                       std::make_move_iterator(rows.end()));
+        if (fetched < CHUNK_SIZE)
+          break;
+      }
+
+      // An open transaction may still add rows below the change ids read.
+      // Its rows are logged after it started, so the ids logged before the
+      // oldest open transaction began are final; if that cannot be read
+      // (no PROCESS privilege), nothing is.
+      long long committedUpTo = 0;
+      if (position > source.minAppliedChangeId()) {
+        std::vector<std::vector<std::string>> committed = executeQueryMariaDB(
+            mariadbConn,
+            "SELECT COALESCE(MAX(change_id), 0) FROM "
+            "datasync_metadata.ds_change_log WHERE change_id > " +
+                std::to_string(source.minAppliedChangeId()) +
+                " AND change_id <= " + std::to_string(position) +
+                " AND change_time < (SELECT COALESCE(MIN(trx_started), "
+                "NOW()) FROM information_schema.INNODB_TRX) - INTERVAL 1 "
+                "SECOND");
+        if (!committed.empty() && !committed[0].empty()) {
+          try {
+            committedUpTo = std::stoll(committed[0][0]);
+          } catch (const std::exception &) {
+          }
+        }
+      }
+      mysql_close(mariadbConn);
+
+      size_t readRows = logRows.size();
+      dispatchChangeLog(pgConn, "MariaDB", source, logRows, committedUpTo);
+      Logger::info(LogCategory::TRANSFER, "readChangeLogs",
+                   "Read " + std::to_string(readRows) +
+                       " change log rows on " + entry.first + " for " +
+                       std::to_string(source.appliedChangeIds.size()) +
+                       " tables up to change_id " + std::to_string(position) +
+                       ", complete up to " + std::to_string(committedUpTo));
+    }
+  } catch (const std::exception &e) {
+    Logger::error(LogCategory::TRANSFER, "readChangeLogs",
+                  "Error reading MariaDB change logs: " +
+                      std::string(e.what()));
+  }
+}
@@ -5,9 +5,13 @@
 #include "sync/SchemaSync.h"
 #include "third_party/json.hpp"
 #include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <cstring>
 #include <ctime>
 #include <iomanip>
+#include <memory>
+#include <optional>
 #include <pqxx/pqxx>
 #include <set>
 #include <sstream>
@@ -20,25 +24,48 @@ std::unordered_map<std::string, std::string> MongoDBToPostgres::dataTypeMap = {
     {"date", "TIMESTAMP"}, {"objectId", "TEXT"},      {"array", "JSONB"},
     {"object", "JSONB"},   {"binary", "BYTEA"},       {"null", "TEXT"}};
 
+MongoDBToPostgres::ColumnTraits
+MongoDBToPostgres::classifyColumnType(const std::string &columnType) {
+  std::string upperType = columnType;
+  std::transform(upperType.begin(), upperType.end(), upperType.begin(),
+                 ::toupper);
+
+  ColumnTraits traits;
+  if (upperType.find("INTEGER") != std::string::npos ||
+      upperType.find("BIGINT") != std::string::npos) {
+    traits.nullValue = "0";
+  } else if (upperType.find("NUMERIC") != std::string::npos ||
+             upperType.find("REAL") != std::string::npos) {
+    traits.nullValue = "0.0";
+  } else if (upperType.find("BOOLEAN") != std::string::npos) {
+    traits.nullValue = "false";
+  } else {
+    traits.nullValue = "NULL";
+    traits.json = upperType == "JSONB";
+  }
+  return traits;
+}
+
 std::string
-MongoDBToPostgres::cleanValueForPostgres(const std::string &value,
-                                         const std::string &columnType) {
+MongoDBToPostgres::cleanValueWithTraits(const std::string &value,
+                                        const ColumnTraits &traits) {
   if (value.empty() || value == "NULL" || value == "null") {
-    std::string upperType = columnType;
-    std::transform(upperType.begin(), upperType.end(), upperType.begin(),
-                   ::toupper);
-
-    if (upperType.find("INTEGER") != std::string::npos ||
-        upperType.find("BIGINT") != std::string::npos) {
-      return "0";
-    } else if (upperType.find("NUMERIC") != std::string::npos ||
-               upperType.find("REAL") != std::string::npos) {
-      return "0.0";
-    } else if (upperType.find("BOOLEAN") != std::string::npos) {
-      return "false";
-    } else {
-      return "NULL";
+    return traits.nullValue;
+  }
+
+  // JSONB values are normalized; text that is not JSON is wrapped as
+  // {"value": ...}
+  if (traits.json) {
+    try {
+      return nlohmann::json::parse(value).dump();
+    } catch (const std::exception &e) {
+      Logger::warning(LogCategory::TRANSFER, "MongoDBToPostgres",
+                      "Failed to parse JSON value, wrapping as string: " +
+                          std::string(e.what()));
     }
+    nlohmann::json wrapper;
+    wrapper["value"] = value;
+    return wrapper.dump();
   }
 
   std::string cleanValue = value;
@@ -52,6 +79,20 @@ MongoDBToPostgres::cleanValueForPostgres(const std::string &value,
   return cleanValue;
 }
 
+std::string
+MongoDBToPostgres::cleanValueForPostgres(const std::string &value,
+                                         const std::string &columnType) {
+  return cleanValueWithTraits(value, classifyColumnType(columnType));
+}
+
+DatabaseToPostgresSync::ColumnConverter
+MongoDBToPostgres::compileColumnConverter(const std::string &columnType) {
+  ColumnTraits traits = classifyColumnType(columnType);
+  return [traits](const std::string &value) {
+    return cleanValueWithTraits(value, traits);
+  };
+}
+
 std::chrono::system_clock::time_point
 MongoDBToPostgres::parseTimestamp(const std::string &timestamp) {
   if (timestamp.empty()) {
@@ -84,7 +125,8 @@ bool MongoDBToPostgres::shouldSyncCollection(pqxx::connection &pgConn,
   try {
     pqxx::work txn(pgConn);
     auto result = txn.exec_params(
-        "SELECT status, mongo_last_sync_time FROM metadata.catalog "
+        "SELECT status, mongo_last_sync_time, pk_strategy "
+        "FROM metadata.catalog "
         "WHERE schema_name = $1 AND table_name = $2 AND db_engine = 'MongoDB'",
         schema_name, table_name);
     txn.commit();
@@ -95,6 +137,13 @@ bool MongoDBToPostgres::shouldSyncCollection(pqxx::connection &pgConn,
 
     std::string status =
         result[0][0].is_null() ? "" : result[0][0].as<std::string>();
+    std::string pkStrategy =
+        result[0][2].is_null() ? "" : result[0][2].as<std::string>();
+    // CDC collections apply their change stream every cycle; only full
+    // loads are bound to the sync interval
+    if (pkStrategy == "CDC" && status == "LISTENING_CHANGES") {
+      return true;
+    }
     if (status != "FULL_LOAD" && status != "full_load" &&
         status != "IN_PROGRESS") {
       return false;
@@ -312,7 +361,7 @@ void MongoDBToPostgres::createPostgreSQLTable(
 }
 
 void MongoDBToPostgres::convertBSONToPostgresRow(
-    bson_t *doc, const std::vector<std::string> &fields,
+    const bson_t *doc, const std::vector<std::string> &fields,
     std::vector<std::string> &row,
     std::unordered_map<std::string, int> &fieldIndexMap) {
   row.clear();
@@ -361,9 +410,10 @@ void MongoDBToPostgres::convertBSONToPostgresRow(
       case BSON_TYPE_DATE_TIME: {
         int64_t millis = value->value.v_datetime;
         std::time_t time = millis / 1000;
-        std::tm *tm = std::gmtime(&time);
+        std::tm tm{};
+        gmtime_r(&time, &tm);
         std::ostringstream oss;
-        oss << std::put_time(tm, "%Y-%m-%d %H:%M:%S");
+        oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S");
         row[index] = oss.str();
         break;
       }
@@ -386,84 +436,413 @@ void MongoDBToPostgres::convertBSONToPostgresRow(
   }
 }
 
-std::vector<std::vector<std::string>>
-MongoDBToPostgres::fetchCollectionData(const TableInfo &tableInfo) {
-  std::vector<std::vector<std::string>> results;
+using BsonPtr = std::unique_ptr<bson_t, void (*)(bson_t *)>;
 
-  try {
-    MongoDBEngine engine(tableInfo.connection_string);
-    if (!engine.isValid()) {
-      Logger::error(LogCategory::TRANSFER, "fetchCollectionData",
-                    "Failed to connect to MongoDB");
-      return results;
-    }
+static BsonPtr makeBson() { return BsonPtr(bson_new(), bson_destroy); }
 
-    mongoc_collection_t *coll = mongoc_client_get_collection(
-        engine.getClient(), tableInfo.schema_name.c_str(),
-        tableInfo.table_name.c_str());
-    if (!coll) {
-      Logger::error(LogCategory::TRANSFER, "fetchCollectionData",
-                    "Failed to get collection");
-      return results;
-    }
+static bool sameBson(const bson_t *a, const bson_t *b) {
+  return a->len == b->len &&
+         std::memcmp(bson_get_data(a), bson_get_data(b), a->len) == 0;
+}
 
-    struct ResourceGuard {
-      mongoc_collection_t *coll_;
-      mongoc_cursor_t *cursor_;
-      bson_t *query_;
-      ResourceGuard(mongoc_collection_t *c, mongoc_cursor_t *cur, bson_t *q)
-          : coll_(c), cursor_(cur), query_(q) {}
-      ~ResourceGuard() {
-        if (cursor_)
-          mongoc_cursor_destroy(cursor_);
-        if (query_)
-          bson_destroy(query_);
-        if (coll_)
-          mongoc_collection_destroy(coll_);
-      }
-    };
+static void appendStage(bson_t *stages, const char *index, const char *name,
+                        const char *field, int64_t value) {
+  bson_t stage, body;
+  BSON_APPEND_DOCUMENT_BEGIN(stages, index, &stage);
+  BSON_APPEND_DOCUMENT_BEGIN(&stage, name, &body);
+  BSON_APPEND_INT64(&body, field, value);
+  bson_append_document_end(&stage, &body);
+  bson_append_document_end(stages, &stage);
+}
 
-    std::vector<std::string> fields =
-        discoverCollectionFields(tableInfo.connection_string,
-                                 tableInfo.schema_name, tableInfo.table_name);
+// Samples _id values with $sample and returns up to ranges - 1 sorted,
+// distinct boundaries, each stored as {"v": <_id>}. Range queries only match
+// _id values of their own BSON type, so the result is empty (no split) when
+// the sample mixes types; otherwise idType is set to the sampled type.
+static std::vector<BsonPtr> sampleIdBoundaries(mongoc_collection_t *coll,
+                                               size_t ranges,
+                                               bson_type_t &idType) {
+  std::vector<BsonPtr> boundaries;
+  BsonPtr pipeline = makeBson();
+  bson_t stages;
+  BSON_APPEND_ARRAY_BEGIN(pipeline.get(), "pipeline", &stages);
+  appendStage(&stages, "0", "$sample", "size",
+              static_cast<int64_t>(std::min<size_t>(
+                  ranges * MongoDBToPostgres::ID_SAMPLES_PER_RANGE, 10000)));
+  appendStage(&stages, "1", "$project", "_id", 1);
+  appendStage(&stages, "2", "$sort", "_id", 1);
+  bson_append_array_end(pipeline.get(), &stages);
+
+  mongoc_cursor_t *cursor = mongoc_collection_aggregate(
+      coll, MONGOC_QUERY_NONE, pipeline.get(), nullptr, nullptr);
+  std::vector<BsonPtr> samples;
+  bool mixedTypes = false;
+  const bson_t *doc;
+  while (mongoc_cursor_next(cursor, &doc)) {
+    bson_iter_t iter;
+    if (!bson_iter_init_find(&iter, doc, "_id"))
+      continue;
+    bson_type_t type = bson_iter_type(&iter);
+    if (samples.empty())
+      idType = type;
+    else if (type != idType)
+      mixedTypes = true;
+    BsonPtr value = makeBson();
+    BSON_APPEND_VALUE(value.get(), "v", bson_iter_value(&iter));
+    samples.push_back(std::move(value));
+  }
+  bson_error_t error;
+  bool cursorFailed = mongoc_cursor_error(cursor, &error);
+  mongoc_cursor_destroy(cursor);
+  if (cursorFailed) {
+    Logger::warning(LogCategory::TRANSFER, "sampleIdBoundaries",
+                    "Failed to sample _id values: " +
+                        std::string(error.message));
+    return boundaries;
+  }
+  if (mixedTypes || samples.size() < ranges)
+    return boundaries;
+
+  for (size_t i = 1; i < ranges; ++i) {
+    BsonPtr &candidate = samples[i * samples.size() / ranges];
+    if (!boundaries.empty() && sameBson(boundaries.back().get(),
+                                        candidate.get()))
+      continue;
+    boundaries.push_back(std::move(candidate));
+  }
+  return boundaries;
+}
 
-    std::unordered_map<std::string, int> fieldIndexMap;
-    for (size_t i = 0; i < fields.size(); i++) {
-      fieldIndexMap[fields[i]] = i;
+static BsonPtr idRangeFilter(const bson_t *lower, const bson_t *upper) {
+  BsonPtr filter = makeBson();
+  bson_t id;
+  bson_iter_t iter;
+  BSON_APPEND_DOCUMENT_BEGIN(filter.get(), "_id", &id);
+  if (lower && bson_iter_init_find(&iter, lower, "v"))
+    BSON_APPEND_VALUE(&id, "$gte", bson_iter_value(&iter));
+  if (upper && bson_iter_init_find(&iter, upper, "v"))
+    BSON_APPEND_VALUE(&id, "$lt", bson_iter_value(&iter));
+  bson_append_document_end(filter.get(), &id);
+  return filter;
+}
+
+// Filters that together cover the collection exactly once: one per gap
+// between boundaries, plus one for _id values of any other BSON type, which
+// the range comparisons never match. Numeric types compare with each other,
+// so the last filter excludes every number when the boundaries are numeric.
+static std::vector<BsonPtr>
+buildIdRangeFilters(const std::vector<BsonPtr> &boundaries,
+                    bson_type_t idType) {
+  std::vector<BsonPtr> filters;
+  filters.push_back(idRangeFilter(nullptr, boundaries.front().get()));
+  for (size_t i = 0; i + 1 < boundaries.size(); ++i)
+    filters.push_back(
+        idRangeFilter(boundaries[i].get(), boundaries[i + 1].get()));
+  filters.push_back(idRangeFilter(boundaries.back().get(), nullptr));
+
+  BsonPtr otherTypes = makeBson();
+  bson_t id, notType;
+  BSON_APPEND_DOCUMENT_BEGIN(otherTypes.get(), "_id", &id);
+  BSON_APPEND_DOCUMENT_BEGIN(&id, "$not", &notType);
+  if (idType == BSON_TYPE_INT32 || idType == BSON_TYPE_INT64 ||
+      idType == BSON_TYPE_DOUBLE || idType == BSON_TYPE_DECIMAL128)
+    BSON_APPEND_UTF8(&notType, "$type", "number");
+  else
+    BSON_APPEND_INT32(&notType, "$type", static_cast<int32_t>(idType));
+  bson_append_document_end(&id, &notType);
+  bson_append_document_end(otherTypes.get(), &id);
+  filters.push_back(std::move(otherTypes));
+  return filters;
+}
+
+// Loads the collection with streamCollectionToTable. Collections with at
+// least range_split_min_rows documents (by the metadata estimate) are split
+// into sampled _id ranges, which are submitted as tasks to a
+// TableProcessorThreadPool of up to max_workers workers, each range with its
+// own MongoDB cursor and PostgreSQL writer and an equal share of the memory
+// budget. Collections are loaded one at a time, so there is only ever one
+// range pool and the load stays within max_workers.
+size_t MongoDBToPostgres::loadCollection(
+    const TableInfo &tableInfo, const std::string &lowerSchemaName,
+    const std::string &lowerTableName, const std::vector<std::string> &fields,
+    const std::vector<std::string> &validFields,
+    const std::vector<std::string> &fieldTypes,
+    const std::vector<size_t> &fieldIndexes, size_t &documents) {
+  const size_t budgetBytes = SyncConfig::getMongoMemoryBudgetMB() * 1024 * 1024;
+  const size_t workers = SyncConfig::getMaxWorkers();
+
+  std::vector<BsonPtr> filters;
+  if (workers >= 2) {
+    MongoDBEngine engine(tableInfo.connection_string);
+    mongoc_collection_t *coll =
+        engine.isValid() ? mongoc_client_get_collection(
+                               engine.getClient(),
+                               tableInfo.schema_name.c_str(),
+                               tableInfo.table_name.c_str())
+                         : nullptr;
+    if (coll) {
+      bson_error_t error;
+      int64_t estimated = mongoc_collection_estimated_document_count(
+          coll, nullptr, nullptr, nullptr, &error);
+      if (estimated >= 0 && static_cast<size_t>(estimated) >=
+                                SyncConfig::getRangeSplitMinRows()) {
+        bson_type_t idType = BSON_TYPE_EOD;
+        std::vector<BsonPtr> boundaries =
+            sampleIdBoundaries(coll, workers, idType);
+        if (!boundaries.empty())
+          filters = buildIdRangeFilters(boundaries, idType);
+      }
+      mongoc_collection_destroy(coll);
     }
+  }
 
-    bson_t *query = bson_new();
-    mongoc_cursor_t *cursor =
-        mongoc_collection_find_with_opts(coll, query, nullptr, nullptr);
+  if (filters.empty())
+    return streamCollectionToTable(tableInfo, lowerSchemaName,
+                                   lowerTableName, fields, validFields,
+                                   fieldTypes, fieldIndexes, nullptr,
+                                   budgetBytes, documents);
+
+  std::string fullTableName = lowerSchemaName + "." + lowerTableName;
+  Logger::info(LogCategory::TRANSFER, "loadCollection",
+               "Splitting load of " + fullTableName + " into " +
+                   std::to_string(filters.size()) + " _id ranges");
+
+  const size_t rangeWorkers = std::min(workers, filters.size());
+  const size_t rangeBudget = budgetBytes / rangeWorkers;
+  std::atomic<size_t> totalDocuments{0};
+  std::atomic<size_t> totalInserted{0};
+  std::atomic<bool> failed{false};
+
+  TableProcessorThreadPool pool(rangeWorkers);
+  for (const auto &filter : filters) {
+    const bson_t *rangeFilter = filter.get();
+    bool submitted = pool.submitTask(
+        tableInfo, [&, rangeFilter](const TableInfo &) {
+          if (failed)
+            return;
+          try {
+            size_t rangeDocuments = 0;
+            totalInserted += streamCollectionToTable(
+                tableInfo, lowerSchemaName, lowerTableName, fields,
+                validFields, fieldTypes, fieldIndexes, rangeFilter,
+                rangeBudget, rangeDocuments);
+            totalDocuments += rangeDocuments;
+          } catch (const std::exception &e) {
+            Logger::error(LogCategory::TRANSFER, "loadCollection",
+                          "Error loading _id range of " + fullTableName +
+                              ": " + std::string(e.what()));
+            failed = true;
+          }
+        });
+    if (!submitted)
+      failed = true;
+  }
+  pool.waitForCompletion();
 
-    ResourceGuard guard(coll, cursor, query);
+  documents = totalDocuments;
+  if (failed)
+    throw std::runtime_error("Range load of " + fullTableName + " failed");
+  return totalInserted;
+}
+
+// Streams the documents matching filter (the whole collection when null)
+// into the target through runFullLoadPipeline. The fetch stage reads cursor
+// batches and turns each document into a row with convertBSONToPostgresRow;
+// the pipeline cleans the rows with the column converters and writes them
+// with writePreparedBatch. Chunks are cut so the rows in flight across the
+// stages and their PIPELINE_DEPTH queues stay within budgetBytes. Returns
+// the number of rows written and stores the number of documents read in
+// documents; throws if a stage failed.
+size_t MongoDBToPostgres::streamCollectionToTable(
+    const TableInfo &tableInfo, const std::string &lowerSchemaName,
+    const std::string &lowerTableName, const std::vector<std::string> &fields,
+    const std::vector<std::string> &validFields,
+    const std::vector<std::string> &fieldTypes,
+    const std::vector<size_t> &fieldIndexes, const bson_t *filter,
+    size_t budgetBytes, size_t &documents) {
+  documents = 0;
+  MongoDBEngine engine(tableInfo.connection_string);
+  if (!engine.isValid())
+    throw std::runtime_error("Failed to connect to MongoDB");
+
+  mongoc_collection_t *coll = mongoc_client_get_collection(
+      engine.getClient(), tableInfo.schema_name.c_str(),
+      tableInfo.table_name.c_str());
+  if (!coll)
+    throw std::runtime_error("Failed to get collection");
+
+  struct ResourceGuard {
+    mongoc_collection_t *coll_;
+    mongoc_cursor_t *cursor_ = nullptr;
+    bson_t *query_ = nullptr;
+    bson_t *opts_ = nullptr;
+    explicit ResourceGuard(mongoc_collection_t *c) : coll_(c) {}
+    ~ResourceGuard() {
+      if (cursor_)
+        mongoc_cursor_destroy(cursor_);
+      if (opts_)
+        bson_destroy(opts_);
+      if (query_)
+        bson_destroy(query_);
+      if (coll_)
+        mongoc_collection_destroy(coll_);
+    }
+  };
+  ResourceGuard guard(coll);
+
+  guard.query_ = bson_new();
+  guard.opts_ = bson_new();
+  BSON_APPEND_INT32(
+      guard.opts_, "batchSize",
+      static_cast<int32_t>(SyncConfig::getMongoCursorBatchSize()));
+  guard.cursor_ = mongoc_collection_find_with_opts(
+      coll, filter ? filter : guard.query_, guard.opts_, nullptr);
+
+  // One chunk is held by the fetch stage, PIPELINE_DEPTH by each queue and
+  // about two by the converter and the writer. A converted chunk also keeps
+  // its source rows, which doubles the converter queue and the writer.
+  const size_t chunkBytes = budgetBytes / (3 * PIPELINE_DEPTH + 5);
+
+  std::unordered_map<std::string, int> fieldIndexMap;
+  for (size_t i = 0; i < fields.size(); i++) {
+    fieldIndexMap[fields[i]] = i;
+  }
 
+  std::vector<std::string> row;
+  auto fetchChunk = [&](RowBatch &batch, std::vector<std::string> &) {
+    batch.reset(validFields.size());
     const bson_t *doc;
-    int count = 0;
-    while (mongoc_cursor_next(cursor, &doc)) {
-      std::vector<std::string> row;
-      bson_t *docCopy = bson_copy(doc);
-      convertBSONToPostgresRow(docCopy, fields, row, fieldIndexMap);
-      bson_destroy(docCopy);
-      results.push_back(row);
-      count++;
-
-      if (count % MongoDBToPostgres::LOG_INTERVAL == 0) {
-        Logger::info(LogCategory::TRANSFER, "fetchCollectionData",
-                     "Fetched " + std::to_string(count) + " documents");
+    while (mongoc_cursor_next(guard.cursor_, &doc)) {
+      convertBSONToPostgresRow(doc, fields, row, fieldIndexMap);
+      // A missing field is passed as "NULL" so the column converter applies
+      // the column's default; the pipeline would write "" as SQL NULL
+      for (size_t k = 0; k < validFields.size(); k++) {
+        const std::string &value = row[fieldIndexes[k]];
+        batch.append(k, value.empty() ? std::string("NULL") : value);
+      }
+      batch.finishRow();
+      documents++;
+      if (documents % LOG_INTERVAL == 0) {
+        Logger::info(LogCategory::TRANSFER, "streamCollectionToTable",
+                     "Fetched " + std::to_string(documents) + " documents");
       }
+      if (batch.memoryUsage() >= chunkBytes ||
+          batch.rowCount() >= MONGODB_BATCH_SIZE)
+        return true;
     }
 
-    Logger::info(LogCategory::TRANSFER, "fetchCollectionData",
-                 "Fetched " + std::to_string(results.size()) +
-                     " total documents");
+    bson_error_t error;
+    if (mongoc_cursor_error(guard.cursor_, &error))
+      throw std::runtime_error("Cursor error: " + std::string(error.message));
+    return false;
+  };
+
+  size_t inserted = 0;
+  auto chunkWritten = [&](pqxx::connection &, const PreparedBatch &written) {
+    inserted += written.batchSize;
+    Logger::info(LogCategory::TRANSFER, "streamCollectionToTable",
+                 "Copied " + std::to_string(inserted) + " rows into " +
+                     lowerSchemaName + "." + lowerTableName);
+  };
+
+  if (!runFullLoadPipeline(lowerSchemaName, lowerTableName,
+                           tableInfo.schema_name, validFields, fieldTypes,
+                           fetchChunk, chunkWritten))
+    throw std::runtime_error("Streaming load of " + lowerSchemaName + "." +
+                             lowerTableName + " failed");
+  return inserted;
+}
+
+// Writes one converted chunk of the streaming load with writeCollectionBatch.
+// Column names are the document fields as they are, so the base class COPY,
+// which lowercases them, cannot be used.
+void MongoDBToPostgres::writePreparedBatch(
+    pqxx::connection &pgConn, const PreparedBatch &batch,
+    const std::vector<std::string> &columnNames,
+    const std::vector<std::string> &columnTypes,
+    const std::string &lowerSchemaName, const std::string &tableName,
+    const std::string & /* sourceSchemaName */) {
+  writeCollectionBatch(pgConn,
+                       pgConn.quote_name(lowerSchemaName) + "." +
+                           pgConn.quote_name(tableName),
+                       columnNames, columnTypes, batch.rows);
+}
 
+// Writes one batch of the streaming load with COPY in its own transaction.
+// When COPY rejects the batch it is applied with a multi-row INSERT instead.
+void MongoDBToPostgres::writeCollectionBatch(
+    pqxx::connection &pgConn, const std::string &fullTableName,
+    const std::vector<std::string> &validFields,
+    const std::vector<std::string> &fieldTypes, const RowBatch &rows) {
+  try {
+    pqxx::work copyTxn(pgConn);
+    std::string columnList;
+    for (size_t k = 0; k < validFields.size(); k++) {
+      if (k > 0)
+        columnList += ", ";
+      columnList += copyTxn.quote_name(validFields[k]);
+    }
+
+    auto stream =
+        pqxx::stream_to::raw_table(copyTxn, fullTableName, columnList);
+    std::vector<std::optional<std::string>> copyRow(validFields.size());
+    for (size_t i = 0; i < rows.rowCount(); i++) {
+      for (size_t k = 0; k < validFields.size(); k++) {
+        if (rows.isNull(i, k))
+          copyRow[k].reset();
+        else
+          copyRow[k] = std::string(rows.value(i, k));
+      }
+      stream.write_row(copyRow);
+    }
+    stream.complete();
+    copyTxn.commit();
+    return;
+  } catch (const pqxx::broken_connection &) {
+    throw;
   } catch (const std::exception &e) {
-    Logger::error(LogCategory::TRANSFER, "fetchCollectionData",
-                  "Error fetching collection data: " + std::string(e.what()));
+    Logger::warning(LogCategory::TRANSFER, "writeCollectionBatch",
+                    "COPY failed for " + fullTableName +
+                        ", falling back to INSERT: " + std::string(e.what()));
+  }
+
+  pqxx::work insertTxn(pgConn);
+  std::ostringstream insertQuery;
+  insertQuery << "INSERT INTO " << fullTableName << " (";
+  for (size_t k = 0; k < validFields.size(); k++) {
+    if (k > 0)
+      insertQuery << ", ";
+    insertQuery << insertTxn.quote_name(validFields[k]);
+  }
+  insertQuery << ") VALUES ";
+
+  for (size_t i = 0; i < rows.rowCount(); i++) {
+    if (i > 0)
+      insertQuery << ", ";
+    insertQuery << "(";
+    for (size_t k = 0; k < validFields.size(); k++) {
+      if (k > 0)
+        insertQuery << ", ";
+      if (rows.isNull(i, k)) {
+        insertQuery << "NULL";
+        continue;
+      }
+      insertQuery << insertTxn.quote(std::string(rows.value(i, k)));
+      if (validFields[k] == "_document" || fieldTypes[k] == "JSONB")
+        insertQuery << "::jsonb";
+    }
+    insertQuery << ")";
   }
 
-  return results;
+  try {
+    insertTxn.exec(insertQuery.str());
+    insertTxn.commit();
+  } catch (const std::exception &e) {
+    Logger::error(LogCategory::TRANSFER, "writeCollectionBatch",
+                  "Error inserting batch: " + std::string(e.what()) +
+                      " - Query: " + insertQuery.str().substr(0, 200));
+    throw;
+  }
 }
 
 void MongoDBToPostgres::truncateAndLoadCollection(const TableInfo &tableInfo) {
@@ -529,15 +908,6 @@ void MongoDBToPostgres::truncateAndLoadCollection(const TableInfo &tableInfo) {
                        fullTableName);
     }
 
-    std::vector<std::vector<std::string>> data = fetchCollectionData(tableInfo);
-
-    if (data.empty()) {
-      Logger::warning(LogCategory::TRANSFER, "truncateAndLoadCollection",
-                      "No data to insert for " + fullTableName);
-      updateLastSyncTime(conn, tableInfo.schema_name, tableInfo.table_name);
-      return;
-    }
-
     std::vector<std::string> fields =
         discoverCollectionFields(tableInfo.connection_string,
                                  tableInfo.schema_name, tableInfo.table_name);
@@ -629,95 +999,31 @@ void MongoDBToPostgres::truncateAndLoadCollection(const TableInfo &tableInfo) {
       }
     }
 
-    pqxx::work insertTxn(conn);
-    size_t inserted = 0;
-
-    auto buildFieldValue =
-        [&](const std::string &fieldName, const std::string &fieldType,
-            const std::string &value, pqxx::work &txn) -> std::string {
-      if (fieldName == "_document" || fieldType == "JSONB") {
-        if (value.empty() || value == "NULL" || value == "null") {
-          return "NULL";
+    std::vector<size_t> fieldIndexes;
+    fieldIndexes.reserve(validFields.size());
+    for (const auto &validField : validFields) {
+      size_t fieldIndex = 0;
+      for (size_t f = 0; f < fields.size(); f++) {
+        if (fields[f] == validField) {
+          fieldIndex = f;
+          break;
         }
-        try {
-          auto parsed = nlohmann::json::parse(value);
-          return txn.quote(parsed.dump()) + "::jsonb";
-        } catch (const nlohmann::json::exception &e) {
-          Logger::warning(LogCategory::TRANSFER, "MongoDBToPostgres",
-                          "Failed to parse JSON value, wrapping as string: " +
-                              std::string(e.what()));
-          nlohmann::json wrapper;
-          wrapper["value"] = value;
-          return txn.quote(wrapper.dump()) + "::jsonb";
-        } catch (const std::exception &e) {
-          Logger::warning(LogCategory::TRANSFER, "MongoDBToPostgres",
-                          "Error processing JSON field: " +
-                              std::string(e.what()));
-          nlohmann::json wrapper;
-          wrapper["value"] = value;
-          return txn.quote(wrapper.dump()) + "::jsonb";
-        }
-      } else {
-        return txn.quote(cleanValueForPostgres(value, fieldType));
-      }
-    };
-
-    for (size_t i = 0; i < data.size(); i += MONGODB_BATCH_SIZE) {
-      size_t batchEnd = std::min(i + MONGODB_BATCH_SIZE, data.size());
-      std::ostringstream insertQuery;
-      insertQuery << "INSERT INTO " << fullTableName << " (";
-
-      for (size_t j = 0; j < validFields.size(); j++) {
-        if (j > 0)
-          insertQuery << ", ";
-        insertQuery << insertTxn.quote_name(validFields[j]);
-      }
-      insertQuery << ") VALUES ";
-
-      for (size_t j = i; j < batchEnd; j++) {
-        if (j > i)
-          insertQuery << ", ";
-        insertQuery << "(";
-        for (size_t k = 0; k < validFields.size(); k++) {
-          if (k > 0)
-            insertQuery << ", ";
-          size_t fieldIndex = 0;
-          for (size_t f = 0; f < fields.size(); f++) {
-            if (fields[f] == validFields[k]) {
-              fieldIndex = f;
-              break;
-            }
-          }
-          if (fieldIndex < data[j].size()) {
-            insertQuery << buildFieldValue(validFields[k], fieldTypes[k],
-                                           data[j][fieldIndex], insertTxn);
-          } else {
-            insertQuery << "NULL";
-          }
-        }
-        insertQuery << ")";
       }
+      fieldIndexes.push_back(fieldIndex);
+    }
 
-      try {
-        insertTxn.exec(insertQuery.str());
-        inserted += (batchEnd - i);
-        Logger::info(LogCategory::TRANSFER, "truncateAndLoadCollection",
-                     "Inserted batch: " + std::to_string(batchEnd - i) +
-                         " rows (total: " + std::to_string(inserted) + ")");
-      } catch (const std::exception &e) {
-        Logger::error(LogCategory::TRANSFER, "truncateAndLoadCollection",
-                      "Error inserting batch: " + std::string(e.what()) +
-                          " - Query: " + insertQuery.str().substr(0, 200));
-        throw;
-      }
+    size_t documents = 0;
+    size_t inserted =
+        loadCollection(tableInfo, schemaName, tableName, fields, validFields,
+                       fieldTypes, fieldIndexes, documents);
 
-      if (inserted % MONGODB_BATCH_SIZE == 0) {
-        Logger::info(LogCategory::TRANSFER, "truncateAndLoadCollection",
-                     "Inserted " + std::to_string(inserted) + " rows");
-      }
+    if (documents == 0) {
+      Logger::warning(LogCategory::TRANSFER, "truncateAndLoadCollection",
+                      "No data to insert for " + fullTableName);
+      updateLastSyncTime(conn, tableInfo.schema_name, tableInfo.table_name);
+      return;
     }
 
-    insertTxn.commit();
     updateLastSyncTime(conn, tableInfo.schema_name, tableInfo.table_name);
 
     pqxx::work statusTxn(conn);
@@ -744,7 +1050,7 @@ void MongoDBToPostgres::truncateAndLoadCollection(const TableInfo &tableInfo) {
     Logger::info(LogCategory::TRANSFER, "truncateAndLoadCollection",
                  "Completed loading " + std::to_string(inserted) +
                      " rows into " + fullTableName + " from " +
-                     std::to_string(data.size()) + " documents");
+                     std::to_string(documents) + " documents");
 
   } catch (const std::exception &e) {
     Logger::error(LogCategory::TRANSFER, "truncateAndLoadCollection",
@@ -1050,7 +1356,11 @@ void MongoDBToPostgres::transferDataMongoDBToPostgresParallel() {
               LogCategory::TRANSFER, "transferDataMongoDBToPostgresParallel",
               "CDC strategy detected for " + tableInfo.schema_name + "." +
                   tableInfo.table_name + " - processing changes only");
-          processTableCDC(tableInfo, conn);
+          if (isContinuousChangeStream(conn, tableInfo)) {
+            ensureContinuousChangeStream(tableInfo);
+          } else {
+            processTableCDC(tableInfo, conn);
+          }
 
           size_t finalCount = 0;
           try {
@@ -1074,13 +1384,15 @@ void MongoDBToPostgres::transferDataMongoDBToPostgresParallel() {
                               std::string(e.what()));
           }
 
+          // A stream whose position was lost has already moved the
+          // collection back to FULL_LOAD
           pqxx::work statusTxn(conn);
           statusTxn.exec(
               "UPDATE metadata.catalog SET status = 'LISTENING_CHANGES' "
               "WHERE schema_name = " +
               statusTxn.quote(tableInfo.schema_name) +
               " AND table_name = " + statusTxn.quote(tableInfo.table_name) +
-              " AND db_engine = 'MongoDB'");
+              " AND db_engine = 'MongoDB' AND status = 'IN_PROGRESS'");
           statusTxn.commit();
         } else {
           if (pkStrategy == "CDC" && targetStatus == "FULL_LOAD") {
@@ -1088,6 +1400,12 @@ void MongoDBToPostgres::transferDataMongoDBToPostgresParallel() {
                 LogCategory::TRANSFER, "transferDataMongoDBToPostgresParallel",
                 "CDC table in FULL_LOAD - performing initial load for " +
                     tableInfo.schema_name + "." + tableInfo.table_name);
+            std::string token = captureResumeToken(tableInfo);
+            if (!token.empty()) {
+              pqxx::work tokenTxn(conn);
+              saveResumeToken(tokenTxn, tableInfo, token, 0);
+              tokenTxn.commit();
+            }
           }
           truncateAndLoadCollection(tableInfo);
         }
@@ -1157,16 +1475,168 @@ void MongoDBToPostgres::setupTableTargetMongoDBToPostgres() {
   }
 }
 
+static std::string resumeTokenToJson(const bson_t *token) {
+  if (!token)
+    return "";
+  char *json = bson_as_canonical_extended_json(token, nullptr);
+  if (!json)
+    return "";
+  std::string result(json);
+  bson_free(json);
+  return result;
+}
+
+// Returns the change stream resume token stored in sync_metadata as
+// canonical extended JSON, or an empty string when there is none.
+std::string MongoDBToPostgres::loadResumeToken(pqxx::connection &pgConn,
+                                               const TableInfo &table) {
+  pqxx::work txn(pgConn);
+  auto result = txn.exec(
+      "SELECT sync_metadata->>'mongo_resume_token' FROM metadata.catalog "
+      "WHERE schema_name=" +
+      txn.quote(table.schema_name) + " AND table_name=" +
+      txn.quote(table.table_name) + " AND db_engine='MongoDB'");
+  txn.commit();
+  if (result.empty() || result[0][0].is_null())
+    return "";
+  return result[0][0].as<std::string>();
+}
+
+// Stores the resume token (kept as text so its key order survives jsonb)
+// and the running change count in sync_metadata within txn, so a batch of
+// applied changes and the position it reached commit together.
+void MongoDBToPostgres::saveResumeToken(pqxx::transaction_base &txn,
+                                        const TableInfo &table,
+                                        const std::string &token,
+                                        size_t changes) {
+  txn.exec("UPDATE metadata.catalog SET sync_metadata = "
+           "COALESCE(sync_metadata, '{}'::jsonb) || "
+           "jsonb_build_object('mongo_resume_token', " +
+           txn.quote(token) + ", 'last_change_id', " +
+           std::to_string(changes) +
+           ", 'last_cdc_batch_time', NOW()) WHERE schema_name=" +
+           txn.quote(table.schema_name) + " AND table_name=" +
+           txn.quote(table.table_name) + " AND db_engine='MongoDB'");
+}
+
+// Opens a change stream on the collection and returns its current resume
+// token without consuming any change. Saved before a full load, it lets CDC
+// replay every change made while the load ran instead of starting from
+// whatever happens after the first CDC cycle; replays are idempotent
+// upserts and deletes.
+std::string MongoDBToPostgres::captureResumeToken(const TableInfo &table) {
+  MongoDBEngine engine(table.connection_string);
+  if (!engine.isValid())
+    return "";
+  mongoc_collection_t *coll = mongoc_client_get_collection(
+      engine.getClient(), table.schema_name.c_str(), table.table_name.c_str());
+  if (!coll)
+    return "";
+
+  std::string token;
+  mongoc_change_stream_t *stream =
+      mongoc_collection_watch(coll, nullptr, nullptr);
+  if (stream) {
+    token = resumeTokenToJson(mongoc_change_stream_get_resume_token(stream));
+    mongoc_change_stream_destroy(stream);
+  }
+  mongoc_collection_destroy(coll);
+  return token;
+}
+
+// Starts (or restarts, if the previous one exited) the long-lived change
+// stream thread of a collection whose sync_metadata cdc_stream_mode is
+// 'continuous'. The thread owns its own connections and applies changes
+// until stopContinuousChangeStreams is called.
+void MongoDBToPostgres::ensureContinuousChangeStream(const TableInfo &table) {
+  std::lock_guard<std::mutex> lock(changeStreamMutex);
+  if (stopChangeStreams)
+    return;
+  const std::string key = table.schema_name + "." + table.table_name;
+  auto it = changeStreams.find(key);
+  if (it != changeStreams.end()) {
+    if (!it->second.finished->load())
+      return;
+    it->second.thread.join();
+    changeStreams.erase(it);
+  }
+
+  ContinuousChangeStream stream;
+  stream.finished = std::make_shared<std::atomic<bool>>(false);
+  auto finished = stream.finished;
+  stream.thread = std::thread([this, table, finished]() {
+    try {
+      pqxx::connection conn(DatabaseConfig::getPostgresConnectionString());
+      runChangeStream(table, conn, true);
+    } catch (const std::exception &e) {
+      Logger::error(LogCategory::TRANSFER, "ensureContinuousChangeStream",
+                    "Change stream for " + table.schema_name + "." +
+                        table.table_name + " stopped: " +
+                        std::string(e.what()));
+    }
+    finished->store(true);
+  });
+  changeStreams.emplace(key, std::move(stream));
+  Logger::info(LogCategory::TRANSFER, "ensureContinuousChangeStream",
+               "Started continuous change stream for " + key);
+}
+
+void MongoDBToPostgres::stopContinuousChangeStreams() {
+  std::unordered_map<std::string, ContinuousChangeStream> streams;
+  {
+    std::lock_guard<std::mutex> lock(changeStreamMutex);
+    stopChangeStreams = true;
+    streams.swap(changeStreams);
+  }
+  for (auto &entry : streams) {
+    if (entry.second.thread.joinable())
+      entry.second.thread.join();
+  }
+}
+
+bool MongoDBToPostgres::isContinuousChangeStream(pqxx::connection &pgConn,
+                                                 const TableInfo &table) {
+  try {
+    pqxx::work txn(pgConn);
+    auto result = txn.exec(
+        "SELECT sync_metadata->>'cdc_stream_mode' FROM metadata.catalog "
+        "WHERE schema_name=" +
+        txn.quote(table.schema_name) + " AND table_name=" +
+        txn.quote(table.table_name) + " AND db_engine='MongoDB'");
+    txn.commit();
+    return !result.empty() && !result[0][0].is_null() &&
+           result[0][0].as<std::string>() == "continuous";
+  } catch (const std::exception &e) {
+    Logger::warning(LogCategory::TRANSFER, "isContinuousChangeStream",
+                    "Error reading cdc_stream_mode: " + std::string(e.what()));
+    return false;
+  }
+}
+
 void MongoDBToPostgres::processTableCDC(const TableInfo &table,
                                         pqxx::connection &pgConn) {
+  runChangeStream(table, pgConn, false);
+}
+
+// Applies change stream events to the target table. The stream resumes
+// after the token saved in sync_metadata, and changes are applied in
+// transactions of up to CHANGE_STREAM_BATCH_SIZE that also save the token
+// they reached, so a crash or restart replays at most one uncommitted batch
+// and never skips changes. A bounded run stops at mongodb_cdc_max_changes or
+// mongodb_cdc_max_duration_seconds; a continuous run keeps going until the
+// streams are stopped. If the oplog no longer holds the saved position the
+// token is dropped and the collection is queued for a full reload.
+void MongoDBToPostgres::runChangeStream(const TableInfo &table,
+                                        pqxx::connection &pgConn,
+                                        bool continuous) {
   try {
-    Logger::info(LogCategory::TRANSFER, "processTableCDC",
+    Logger::info(LogCategory::TRANSFER, "runChangeStream",
                  "Starting CDC processing for MongoDB collection " +
                      table.schema_name + "." + table.table_name);
 
     MongoDBEngine engine(table.connection_string);
     if (!engine.isValid()) {
-      Logger::error(LogCategory::TRANSFER, "processTableCDC",
+      Logger::error(LogCategory::TRANSFER, "runChangeStream",
                     "Failed to connect to MongoDB");
       return;
     }
@@ -1175,7 +1645,7 @@ void MongoDBToPostgres::processTableCDC(const TableInfo &table,
         engine.getClient(), table.schema_name.c_str(),
         table.table_name.c_str());
     if (!coll) {
-      Logger::error(LogCategory::TRANSFER, "processTableCDC",
+      Logger::error(LogCategory::TRANSFER, "runChangeStream",
                     "Failed to get collection " + table.schema_name + "." +
                         table.table_name);
       return;
@@ -1199,7 +1669,7 @@ void MongoDBToPostgres::processTableCDC(const TableInfo &table,
         table.connection_string, table.schema_name, table.table_name);
 
     if (fields.empty()) {
-      Logger::error(LogCategory::TRANSFER, "processTableCDC",
+      Logger::error(LogCategory::TRANSFER, "runChangeStream",
                     "No fields discovered for collection");
       mongoc_collection_destroy(coll);
       return;
@@ -1220,13 +1690,41 @@ void MongoDBToPostgres::processTableCDC(const TableInfo &table,
     bson_destroy(operationType);
     bson_destroy(inArray);
 
+    std::string resumeToken = loadResumeToken(pgConn, table);
+    bson_t *opts = bson_new();
+    BSON_APPEND_INT32(
+        opts, "batchSize",
+        static_cast<int32_t>(SyncConfig::getMongoCursorBatchSize()));
+    BSON_APPEND_INT64(opts, "maxAwaitTimeMS", CHANGE_STREAM_AWAIT_MS);
+    if (!resumeToken.empty()) {
+      bson_error_t error;
+      bson_t *token = bson_new_from_json(
+          reinterpret_cast<const uint8_t *>(resumeToken.data()),
+          static_cast<ssize_t>(resumeToken.size()), &error);
+      if (token) {
+        BSON_APPEND_DOCUMENT(opts, "resumeAfter", token);
+        bson_destroy(token);
+      } else {
+        Logger::warning(LogCategory::TRANSFER, "runChangeStream",
+                        "Ignoring unreadable resume token for " +
+                            table.schema_name + "." + table.table_name +
+                            ": " + std::string(error.message));
+      }
+    } else {
+      Logger::warning(LogCategory::TRANSFER, "runChangeStream",
+                      "No resume token saved for " + table.schema_name + "." +
+                          table.table_name +
+                          " - starting from the current position");
+    }
+
     mongoc_change_stream_t *stream =
-        mongoc_collection_watch(coll, pipeline, nullptr);
+        mongoc_collection_watch(coll, pipeline, opts);
     bson_destroy(pipeline);
+    bson_destroy(opts);
 
     if (!stream) {
       Logger::error(
-          LogCategory::TRANSFER, "processTableCDC",
+          LogCategory::TRANSFER, "runChangeStream",
           "Failed to create change stream. MongoDB Change Streams "
           "require a replica set or sharded cluster. Standalone "
           "instances are not supported. To enable Change Streams on "
@@ -1235,12 +1733,12 @@ void MongoDBToPostgres::processTableCDC(const TableInfo &table,
       mongoc_collection_destroy(coll);
       return;
     }
+    std::unique_ptr<mongoc_change_stream_t, void (*)(mongoc_change_stream_t *)>
+        streamGuard(stream, mongoc_change_stream_destroy);
+    std::unique_ptr<mongoc_collection_t, void (*)(mongoc_collection_t *)>
+        collGuard(coll, mongoc_collection_destroy);
 
-    const bson_t *changeDoc;
-    size_t processedCount = 0;
-    const size_t BATCH_SIZE = 100;
     size_t maxChanges = 10000;
-    auto startTime = std::chrono::steady_clock::now();
     auto maxDuration = std::chrono::seconds(300);
 
     try {
@@ -1262,27 +1760,86 @@ void MongoDBToPostgres::processTableCDC(const TableInfo &table,
     } catch (...) {
     }
 
-    while (processedCount < maxChanges) {
-      auto elapsed = std::chrono::steady_clock::now() - startTime;
-      if (elapsed > maxDuration) {
+    std::unordered_map<std::string, int> fieldIndexMap;
+    for (size_t i = 0; i < fields.size(); i++) {
+      fieldIndexMap[fields[i]] = i;
+    }
+    const std::string fullTableName = pgConn.quote_name(lowerSchemaName) +
+                                      "." + pgConn.quote_name(lowerTableName);
+
+    size_t processedCount = 0;
+    size_t pendingCount = 0;
+    std::unique_ptr<pqxx::work> batchTxn;
+    std::string savedToken = resumeToken;
+    auto startTime = std::chrono::steady_clock::now();
+    auto lastSave = startTime;
+    bool applyFailed = false;
+    bool historyLost = false;
+
+    // Commits the open batch together with the token the stream reached;
+    // with no batch open, only saves the token if it moved (the server
+    // advances it past events the pipeline filters out)
+    auto commitBatch = [&]() {
+      std::string token =
+          resumeTokenToJson(mongoc_change_stream_get_resume_token(stream));
+      if (!batchTxn) {
+        if (token.empty() || token == savedToken)
+          return;
+        batchTxn = std::make_unique<pqxx::work>(pgConn);
+      }
+      if (!token.empty())
+        saveResumeToken(*batchTxn, table, token, processedCount);
+      batchTxn->commit();
+      batchTxn.reset();
+      if (!token.empty())
+        savedToken = token;
+      if (pendingCount > 0)
+        Logger::info(LogCategory::TRANSFER, "runChangeStream",
+                     "Applied " + std::to_string(pendingCount) +
+                         " changes for " + table.schema_name + "." +
+                         table.table_name);
+      pendingCount = 0;
+      lastSave = std::chrono::steady_clock::now();
+    };
+
+    while (continuous ? !stopChangeStreams.load()
+                      : processedCount < maxChanges) {
+      auto now = std::chrono::steady_clock::now();
+      if (!continuous && now - startTime > maxDuration) {
         Logger::info(
-            LogCategory::TRANSFER, "processTableCDC",
+            LogCategory::TRANSFER, "runChangeStream",
             "Max duration reached, saving progress and continuing later");
         break;
       }
 
+      const bson_t *changeDoc;
       if (!mongoc_change_stream_next(stream, &changeDoc)) {
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        bson_error_t error;
+        const bson_t *reply = nullptr;
+        if (mongoc_change_stream_error_document(stream, &error, &reply)) {
+          historyLost = error.code == CHANGE_STREAM_HISTORY_LOST ||
+                        error.code == CHANGE_STREAM_FATAL_ERROR;
+          Logger::error(LogCategory::TRANSFER, "runChangeStream",
+                        "Change stream error for " + table.schema_name + "." +
+                            table.table_name + ": " +
+                            std::string(error.message));
+          break;
+        }
+        if (pendingCount > 0 ||
+            now - lastSave >=
+                std::chrono::seconds(CHANGE_STREAM_CHECKPOINT_SECONDS))
+          commitBatch();
         continue;
       }
+
       bson_iter_t iter;
       if (!bson_iter_init(&iter, changeDoc)) {
         continue;
       }
 
       std::string operationType;
-      bson_t *fullDocument = nullptr;
-      bson_t *documentKey = nullptr;
+      BsonPtr fullDocument(nullptr, bson_destroy);
+      BsonPtr documentKey(nullptr, bson_destroy);
 
       while (bson_iter_next(&iter)) {
         const char *key = bson_iter_key(&iter);
@@ -1293,57 +1850,42 @@ void MongoDBToPostgres::processTableCDC(const TableInfo &table,
           const uint8_t *docData;
           uint32_t docLen;
           bson_iter_document(&iter, &docLen, &docData);
-          fullDocument = bson_new_from_data(docData, docLen);
+          fullDocument.reset(bson_new_from_data(docData, docLen));
         } else if (strcmp(key, "documentKey") == 0 &&
                    BSON_ITER_HOLDS_DOCUMENT(&iter)) {
           const uint8_t *keyData;
           uint32_t keyLen;
           bson_iter_document(&iter, &keyLen, &keyData);
-          documentKey = bson_new_from_data(keyData, keyLen);
+          documentKey.reset(bson_new_from_data(keyData, keyLen));
         }
       }
 
       if (operationType.empty()) {
-        if (fullDocument)
-          bson_destroy(fullDocument);
-        if (documentKey)
-          bson_destroy(documentKey);
         continue;
       }
 
       try {
-        pqxx::work txn(pgConn);
-        std::string fullTableName = txn.quote_name(lowerSchemaName) + "." +
-                                    txn.quote_name(lowerTableName);
+        if (!batchTxn)
+          batchTxn = std::make_unique<pqxx::work>(pgConn);
+        pqxx::work &txn = *batchTxn;
 
         if (operationType == "insert" || operationType == "replace" ||
             operationType == "update") {
-          bson_t *docToProcess = fullDocument;
+          BsonPtr docToProcess = std::move(fullDocument);
           if (!docToProcess && documentKey) {
-            bson_t *query = bson_copy(documentKey);
-            mongoc_cursor_t *cursor =
-                mongoc_collection_find_with_opts(coll, query, nullptr, nullptr);
-            bson_destroy(query);
-
+            mongoc_cursor_t *cursor = mongoc_collection_find_with_opts(
+                coll, documentKey.get(), nullptr, nullptr);
             const bson_t *foundDoc;
             if (mongoc_cursor_next(cursor, &foundDoc)) {
-              docToProcess = bson_copy(foundDoc);
+              docToProcess.reset(bson_copy(foundDoc));
             }
             mongoc_cursor_destroy(cursor);
           }
 
           if (docToProcess) {
-            std::unordered_map<std::string, int> fieldIndexMap;
-            for (size_t i = 0; i < fields.size(); i++) {
-              fieldIndexMap[fields[i]] = i;
-            }
-
             std::vector<std::string> row;
-            convertBSONToPostgresRow(docToProcess, fields, row, fieldIndexMap);
-
-            if (docToProcess != fullDocument) {
-              bson_destroy(docToProcess);
-            }
+            convertBSONToPostgresRow(docToProcess.get(), fields, row,
+                                     fieldIndexMap);
 
             std::ostringstream upsertQuery;
             upsertQuery << "INSERT INTO " << fullTableName << " (";
@@ -1380,12 +1922,12 @@ void MongoDBToPostgres::processTableCDC(const TableInfo &table,
             }
 
             txn.exec(upsertQuery.str());
-            txn.commit();
             processedCount++;
+            pendingCount++;
           }
         } else if (operationType == "delete" && documentKey) {
           bson_iter_t idIter;
-          if (bson_iter_init(&idIter, documentKey) &&
+          if (bson_iter_init(&idIter, documentKey.get()) &&
               bson_iter_find(&idIter, "_id")) {
             std::string idValue;
             if (BSON_ITER_HOLDS_UTF8(&idIter)) {
@@ -1402,93 +1944,67 @@ void MongoDBToPostgres::processTableCDC(const TableInfo &table,
             }
 
             if (!idValue.empty()) {
-              std::string deleteQuery = "DELETE FROM " + fullTableName +
-                                        " WHERE _id = " + txn.quote(idValue);
-              txn.exec(deleteQuery);
-              txn.commit();
+              txn.exec("DELETE FROM " + fullTableName +
+                       " WHERE _id = " + txn.quote(idValue));
               processedCount++;
+              pendingCount++;
             }
           }
-          bson_destroy(documentKey);
-        }
-
-        if (fullDocument && fullDocument != documentKey) {
-          bson_destroy(fullDocument);
-        }
-
-        if (processedCount % BATCH_SIZE == 0) {
-          pqxx::work updateTxn(pgConn);
-          updateTxn.exec(
-              "UPDATE metadata.catalog SET sync_metadata = "
-              "COALESCE(sync_metadata, '{}'::jsonb) || "
-              "jsonb_build_object('last_change_id', " +
-              std::to_string(processedCount) +
-              ", 'last_cdc_batch_time', NOW()) WHERE schema_name=" +
-              updateTxn.quote(table.schema_name) + " AND table_name=" +
-              updateTxn.quote(table.table_name) + " AND db_engine='MongoDB'");
-          updateTxn.commit();
-
-          Logger::info(LogCategory::TRANSFER, "processTableCDC",
-                       "Processed " + std::to_string(processedCount) +
-                           " changes for " + table.schema_name + "." +
-                           table.table_name);
         }
 
+        if (pendingCount >= CHANGE_STREAM_BATCH_SIZE)
+          commitBatch();
+      } catch (const pqxx::broken_connection &) {
+        throw;
       } catch (const std::exception &e) {
-        Logger::error(LogCategory::TRANSFER, "processTableCDC",
-                      "Error processing change: " + std::string(e.what()));
-        if (fullDocument)
-          bson_destroy(fullDocument);
-        if (documentKey)
-          bson_destroy(documentKey);
+        Logger::error(LogCategory::TRANSFER, "runChangeStream",
+                      "Error applying change batch for " + table.schema_name +
+                          "." + table.table_name + ": " +
+                          std::string(e.what()) +
+                          " - resuming from the last saved token");
+        applyFailed = true;
+        break;
       }
     }
 
-    {
-      pqxx::work finalUpdateTxn(pgConn);
-      if (processedCount > 0) {
-        finalUpdateTxn.exec(
-            "UPDATE metadata.catalog SET sync_metadata = "
-            "COALESCE(sync_metadata, '{}'::jsonb) || "
-            "jsonb_build_object('last_change_id', " +
-            std::to_string(processedCount) +
-            ", 'last_cdc_batch_time', NOW()) WHERE schema_name=" +
-            finalUpdateTxn.quote(table.schema_name) +
-            " AND table_name=" + finalUpdateTxn.quote(table.table_name) +
-            " AND db_engine='MongoDB'");
-      }
+    if (applyFailed) {
+      batchTxn.reset();
+      processedCount -= pendingCount;
+    } else if (!historyLost) {
+      commitBatch();
+    }
 
-      if (processedCount < maxChanges) {
-        finalUpdateTxn.exec(
-            "UPDATE metadata.catalog SET status = 'LISTENING_CHANGES' "
-            "WHERE schema_name=" +
-            finalUpdateTxn.quote(table.schema_name) +
-            " AND table_name=" + finalUpdateTxn.quote(table.table_name) +
-            " AND db_engine='MongoDB'");
-      } else {
-        Logger::info(LogCategory::TRANSFER, "processTableCDC",
-                     "Reached max changes limit, will continue in next cycle");
-        finalUpdateTxn.exec(
-            "UPDATE metadata.catalog SET status = 'LISTENING_CHANGES' "
-            "WHERE schema_name=" +
-            finalUpdateTxn.quote(table.schema_name) +
-            " AND table_name=" + finalUpdateTxn.quote(table.table_name) +
-            " AND db_engine='MongoDB'");
-      }
-      finalUpdateTxn.commit();
+    if (historyLost) {
+      batchTxn.reset();
+      pqxx::work resetTxn(pgConn);
+      resetTxn.exec(
+          "UPDATE metadata.catalog SET status = 'FULL_LOAD', "
+          "mongo_last_sync_time = NULL, sync_metadata = "
+          "COALESCE(sync_metadata, '{}'::jsonb) - 'mongo_resume_token' "
+          "WHERE schema_name=" +
+          resetTxn.quote(table.schema_name) +
+          " AND table_name=" + resetTxn.quote(table.table_name) +
+          " AND db_engine='MongoDB'");
+      resetTxn.commit();
+      Logger::error(LogCategory::TRANSFER, "runChangeStream",
+                    "Saved change stream position for " + table.schema_name +
+                        "." + table.table_name +
+                        " is no longer in the oplog - scheduling full reload");
+      return;
     }
 
-    mongoc_change_stream_destroy(stream);
-    mongoc_collection_destroy(coll);
+    if (!continuous && processedCount >= maxChanges) {
+      Logger::info(LogCategory::TRANSFER, "runChangeStream",
+                   "Reached max changes limit, will continue in next cycle");
+    }
 
-    Logger::info(LogCategory::TRANSFER, "processTableCDC",
+    Logger::info(LogCategory::TRANSFER, "runChangeStream",
                  "Completed CDC processing for " + table.schema_name + "." +
-                     table.table_name + " - processed " +
-                     std::to_string(processedCount) +
-                     " changes, status updated to LISTENING_CHANGES");
+                     table.table_name + " - applied " +
+                     std::to_string(processedCount) + " changes");
 
   } catch (const std::exception &e) {
-    Logger::error(LogCategory::TRANSFER, "processTableCDC",
+    Logger::error(LogCategory::TRANSFER, "runChangeStream",
                   "Error in CDC processing: " + std::string(e.what()));
   }
 }
@@ -7,6 +7,8 @@
 #include "third_party/json.hpp"
 #include <algorithm>
 #include <cctype>
+#include <cstdio>
+#include <cstdlib>
 #include <pqxx/pqxx>
 #include <sstream>
 
@@ -42,19 +44,37 @@ std::unordered_map<std::string, std::string> OracleToPostgres::dataTypeMap = {
     {"XMLTYPE", "XML"},
     {"JSON", "JSONB"}};
 
-std::string
-OracleToPostgres::cleanValueForPostgres(const std::string &value,
-                                        const std::string &columnType) {
-  std::string cleanValue = value;
+OracleToPostgres::ColumnTraits
+OracleToPostgres::classifyColumnType(const std::string &columnType) {
   std::string upperType = columnType;
   std::transform(upperType.begin(), upperType.end(), upperType.begin(),
                  ::toupper);
 
+  ColumnTraits traits;
+  traits.dateLike = upperType.find("TIMESTAMP") != std::string::npos ||
+                    upperType.find("DATE") != std::string::npos;
+
+  if (upperType.find("INTEGER") != std::string::npos ||
+      upperType.find("NUMERIC") != std::string::npos ||
+      upperType.find("REAL") != std::string::npos ||
+      upperType.find("DOUBLE") != std::string::npos) {
+    traits.nullValue = "0";
+  } else if (traits.dateLike) {
+    traits.nullValue = "1970-01-01 00:00:00";
+  } else if (upperType.find("BOOLEAN") != std::string::npos) {
+    traits.nullValue = "false";
+  }
+  return traits;
+}
+
+std::string OracleToPostgres::cleanValueWithTraits(const std::string &value,
+                                                   const ColumnTraits &traits) {
+  std::string cleanValue = value;
+
   bool isNull =
       (cleanValue.empty() || cleanValue == "NULL" || cleanValue == "null");
 
-  if (upperType.find("TIMESTAMP") != std::string::npos ||
-      upperType.find("DATE") != std::string::npos) {
+  if (traits.dateLike) {
     if (cleanValue.find("0000-") != std::string::npos ||
         cleanValue.find("1900-01-01") != std::string::npos ||
         cleanValue.find("1970-01-01") != std::string::npos) {
@@ -63,19 +83,7 @@ OracleToPostgres::cleanValueForPostgres(const std::string &value,
   }
 
   if (isNull) {
-    if (upperType.find("INTEGER") != std::string::npos ||
-        upperType.find("NUMERIC") != std::string::npos ||
-        upperType.find("REAL") != std::string::npos ||
-        upperType.find("DOUBLE") != std::string::npos) {
-      return "0";
-    } else if (upperType.find("TIMESTAMP") != std::string::npos ||
-               upperType.find("DATE") != std::string::npos) {
-      return "1970-01-01 00:00:00";
-    } else if (upperType.find("BOOLEAN") != std::string::npos) {
-      return "false";
-    } else {
-      return "";
-    }
+    return traits.nullValue;
   }
 
   size_t pos = 0;
@@ -87,6 +95,20 @@ OracleToPostgres::cleanValueForPostgres(const std::string &value,
   return cleanValue;
 }
 
+std::string
+OracleToPostgres::cleanValueForPostgres(const std::string &value,
+                                        const std::string &columnType) {
+  return cleanValueWithTraits(value, classifyColumnType(columnType));
+}
+
+DatabaseToPostgresSync::ColumnConverter
+OracleToPostgres::compileColumnConverter(const std::string &columnType) {
+  ColumnTraits traits = classifyColumnType(columnType);
+  return [traits](const std::string &value) {
+    return cleanValueWithTraits(value, traits);
+  };
+}
+
 std::unique_ptr<OCIConnection>
 OracleToPostgres::getOracleConnection(const std::string &connectionString) {
   if (connectionString.empty()) {
@@ -105,35 +127,171 @@ OracleToPostgres::getOracleConnection(const std::string &connectionString) {
   return conn;
 }
 
+// How a result column is defined for array fetch. Text columns are fetched
+// as SQLT_STR into fixed-width slots; the other kinds use native buffers and
+// are formatted here, which skips Oracle's string conversion and does not
+// depend on the session's NLS date formats. CLOB and BLOB columns are fetched
+// as LOB locators and read in full with OCILobRead2.
+enum class OracleFetchKind { Text, Integer, Date, Timestamp, Lob };
+
+struct OracleFetchColumn {
+  OracleFetchKind kind = OracleFetchKind::Text;
+  ub2 dataType = 0;
+  ub4 width = 0;
+  ub4 descriptorType = 0;
+  std::vector<char> text;
+  std::vector<int64_t> integers;
+  std::vector<OCIDateTime *> timestamps;
+  std::vector<OCILobLocator *> lobs;
+  std::vector<sb2> indicators;
+  std::vector<ub2> lengths;
+  std::vector<ub2> returnCodes;
+};
+
+// Oracle DATE values are 7 bytes: century and year in excess-100 notation,
+// then month, day, and hour/minute/second in excess-1 notation.
+static size_t formatOracleDate(const ub1 *date, char *out) {
+  int year = (date[0] - 100) * 100 + (date[1] - 100);
+  return static_cast<size_t>(snprintf(out, 32, "%04d-%02d-%02d %02d:%02d:%02d",
+                                      year, date[2], date[3], date[4] - 1,
+                                      date[5] - 1, date[6] - 1));
+}
+
+static size_t formatOracleTimestamp(OCIEnv *env, OCIError *err,
+                                    OCIDateTime *value, bool withTimeZone,
+                                    char *out) {
+  sb2 year = 0;
+  ub1 month = 0, day = 0, hour = 0, minute = 0, second = 0;
+  ub4 fraction = 0;
+  if (OCIDateTimeGetDate(env, err, value, &year, &month, &day) != OCI_SUCCESS ||
+      OCIDateTimeGetTime(env, err, value, &hour, &minute, &second,
+                         &fraction) != OCI_SUCCESS)
+    return 0;
+
+  int length = snprintf(out, 64, "%04d-%02d-%02d %02d:%02d:%02d", year, month,
+                        day, hour, minute, second);
+  if (fraction > 0)
+    length += snprintf(out + length, 64 - length, ".%09u", fraction);
+  if (withTimeZone) {
+    sb1 tzHour = 0, tzMinute = 0;
+    if (OCIDateTimeGetTimeZoneOffset(env, err, value, &tzHour, &tzMinute) ==
+        OCI_SUCCESS)
+      length += snprintf(out + length, 64 - length, "%c%02d:%02d",
+                         tzHour < 0 || tzMinute < 0 ? '-' : '+',
+                         std::abs(tzHour), std::abs(tzMinute));
+  }
+  return static_cast<size_t>(length);
+}
+
+// Reads a whole LOB in pieces of buffer's size and stores it as the next
+// value of column in batch. BLOB bytes are hex-encoded like Oracle's own
+// RAW to string conversion. Returns false if a read failed.
+static bool readOracleLob(OCISvcCtx *svc, OCIEnv *env, OCIError *err,
+                          OCILobLocator *lob, bool binary,
+                          std::vector<char> &buffer, std::string &hex,
+                          RowBatch &batch, size_t column) {
+  static const char HEX_DIGITS[] = "0123456789ABCDEF";
+  ub1 charsetForm = SQLCS_IMPLICIT;
+  if (!binary)
+    OCILobCharSetForm(env, err, lob, &charsetForm);
+
+  batch.append(column, "", 0);
+  ub1 piece = OCI_FIRST_PIECE;
+  sword status;
+  do {
+    oraub8 byteAmount = 0;
+    oraub8 charAmount = 0;
+    status = OCILobRead2(svc, err, lob, &byteAmount, &charAmount, 1,
+                         buffer.data(), buffer.size(), piece, nullptr,
+                         nullptr, 0, charsetForm);
+    if (status != OCI_SUCCESS && status != OCI_NEED_DATA)
+      return false;
+    if (binary) {
+      hex.resize(static_cast<size_t>(byteAmount) * 2);
+      for (size_t i = 0; i < byteAmount; ++i) {
+        ub1 byte = static_cast<ub1>(buffer[i]);
+        hex[2 * i] = HEX_DIGITS[byte >> 4];
+        hex[2 * i + 1] = HEX_DIGITS[byte & 0x0F];
+      }
+      batch.extend(column, hex.data(), hex.size());
+    } else {
+      batch.extend(column, buffer.data(), static_cast<size_t>(byteAmount));
+    }
+    piece = OCI_NEXT_PIECE;
+  } while (status == OCI_NEED_DATA);
+  return true;
+}
+
+// Renders a key value read back by executeQueryOracle as a literal of the
+// key column's type for the keyset predicate. DATE and TIMESTAMP values come
+// back in ISO form, which Oracle only parses with an explicit format instead
+// of the session's NLS formats (ORA-01861 otherwise).
+std::string OracleToPostgres::oracleKeyLiteral(const std::string &value,
+                                               const std::string &dataType) {
+  std::string literal = quoteKeyLiteral(value, KeyLiteralStyle::Standard);
+
+  if (dataType == "DATE")
+    return "TO_DATE(" + literal + ", 'YYYY-MM-DD HH24:MI:SS')";
+  if (dataType.compare(0, 9, "TIMESTAMP") != 0)
+    return literal;
+  // Fractional seconds are only written when non-zero
+  std::string format = "YYYY-MM-DD HH24:MI:SS";
+  if (value.find('.') != std::string::npos)
+    format += ".FF";
+  if (dataType.find("WITH TIME ZONE") != std::string::npos)
+    return "TO_TIMESTAMP_TZ(" + literal + ", '" + format + "TZH:TZM')";
+  return "TO_TIMESTAMP(" + literal + ", '" + format + "')";
+}
+
 std::vector<std::vector<std::string>>
 OracleToPostgres::executeQueryOracle(OCIConnection *conn,
                                      const std::string &query) {
-  std::vector<std::vector<std::string>> results;
+  RowBatch batch;
+  executeQueryOracle(conn, query, batch);
+  return batch.toRows("NULL");
+}
+
+bool OracleToPostgres::executeQueryOracle(OCIConnection *conn,
+                                          const std::string &query,
+                                          RowBatch &batch) {
+  batch.clear();
   if (!conn || !conn->isValid()) {
     Logger::error(LogCategory::TRANSFER, "executeQueryOracle",
                   "Invalid Oracle connection");
-    return results;
+    return false;
   }
 
   if (query.empty()) {
     Logger::error(LogCategory::TRANSFER, "executeQueryOracle",
                   "Empty query provided");
-    return results;
+    return false;
   }
 
   OCIStmt *stmt = nullptr;
   OCIError *err = conn->getErr();
   OCISvcCtx *svc = conn->getSvc();
   OCIEnv *env = conn->getEnv();
+  std::vector<OracleFetchColumn> columns;
 
   struct StmtGuard {
     OCIStmt *stmt_;
-    OCIError *err_;
-    StmtGuard(OCIStmt *s, OCIError *e) : stmt_(s), err_(e) {}
+    std::vector<OracleFetchColumn> &columns_;
+    StmtGuard(OCIStmt *s, std::vector<OracleFetchColumn> &c)
+        : stmt_(s), columns_(c) {}
     ~StmtGuard() {
       if (stmt_) {
         OCIHandleFree(stmt_, OCI_HTYPE_STMT);
       }
+      for (auto &column : columns_) {
+        for (OCIDateTime *value : column.timestamps) {
+          if (value)
+            OCIDescriptorFree(value, column.descriptorType);
+        }
+        for (OCILobLocator *lob : column.lobs) {
+          if (lob)
+            OCIDescriptorFree(lob, OCI_DTYPE_LOB);
+        }
+      }
     }
   };
 
@@ -142,24 +300,32 @@ OracleToPostgres::executeQueryOracle(OCIConnection *conn,
   if (status != OCI_SUCCESS) {
     Logger::error(LogCategory::TRANSFER, "executeQueryOracle",
                   "OCIHandleAlloc(STMT) failed");
-    return results;
+    return false;
   }
 
-  StmtGuard guard(stmt, err);
+  StmtGuard guard(stmt, columns);
 
   status = OCIStmtPrepare(stmt, err, (OraText *)query.c_str(), query.length(),
                           OCI_NTV_SYNTAX, OCI_DEFAULT);
   if (status != OCI_SUCCESS) {
     Logger::error(LogCategory::TRANSFER, "executeQueryOracle",
                   "OCIStmtPrepare failed for query: " + query);
-    return results;
+    return false;
   }
 
+  // Let the execute round trip bring back the first rows as well
+  ub4 prefetchRows = ORACLE_FETCH_MAX_ROWS;
+  ub4 prefetchMemory = ORACLE_FETCH_BUFFER_BYTES;
+  OCIAttrSet(stmt, OCI_HTYPE_STMT, &prefetchRows, 0, OCI_ATTR_PREFETCH_ROWS,
+             err);
+  OCIAttrSet(stmt, OCI_HTYPE_STMT, &prefetchMemory, 0,
+             OCI_ATTR_PREFETCH_MEMORY, err);
+
   status = OCIStmtExecute(svc, stmt, err, 0, 0, nullptr, nullptr, OCI_DEFAULT);
   if (status != OCI_SUCCESS && status != OCI_SUCCESS_WITH_INFO) {
     Logger::error(LogCategory::TRANSFER, "executeQueryOracle",
                   "OCIStmtExecute failed for query: " + query);
-    return results;
+    return false;
   }
 
   ub4 numCols = 0;
@@ -167,43 +333,220 @@ OracleToPostgres::executeQueryOracle(OCIConnection *conn,
              err);
 
   if (numCols == 0) {
-    return results;
+    return true;
   }
 
-  std::vector<OCIDefine *> defines(numCols);
-  std::vector<std::vector<char>> buffers(numCols);
-  std::vector<ub2> lengths(numCols, 0);
-  std::vector<sb2> inds(numCols, -1);
+  // Size each column from the describe metadata, then fit as many rows per
+  // fetch as the buffer budget allows
+  columns.resize(numCols);
+  size_t rowWidth = 0;
+  for (ub4 i = 0; i < numCols; ++i) {
+    OCIParam *param = nullptr;
+    if (OCIParamGet(stmt, OCI_HTYPE_STMT, err, (void **)&param, i + 1) !=
+        OCI_SUCCESS) {
+      Logger::error(LogCategory::TRANSFER, "executeQueryOracle",
+                    "OCIParamGet failed for column " + std::to_string(i + 1));
+      return false;
+    }
+    OracleFetchColumn &column = columns[i];
+    ub2 dataSize = 0;
+    sb2 precision = 0;
+    sb1 scale = 0;
+    OCIAttrGet(param, OCI_DTYPE_PARAM, &column.dataType, nullptr,
+               OCI_ATTR_DATA_TYPE, err);
+    OCIAttrGet(param, OCI_DTYPE_PARAM, &dataSize, nullptr, OCI_ATTR_DATA_SIZE,
+               err);
+    OCIAttrGet(param, OCI_DTYPE_PARAM, &precision, nullptr,
+               OCI_ATTR_PRECISION, err);
+    OCIAttrGet(param, OCI_DTYPE_PARAM, &scale, nullptr, OCI_ATTR_SCALE, err);
+    OCIDescriptorFree(param, OCI_DTYPE_PARAM);
+
+    switch (column.dataType) {
+    case SQLT_NUM:
+      if (scale == 0 && precision > 0 && precision <= 18) {
+        column.kind = OracleFetchKind::Integer;
+        column.width = sizeof(int64_t);
+      } else {
+        column.width = 64;
+      }
+      break;
+    case SQLT_DAT:
+      column.kind = OracleFetchKind::Date;
+      column.width = 7;
+      break;
+    case SQLT_TIMESTAMP:
+      column.kind = OracleFetchKind::Timestamp;
+      column.descriptorType = OCI_DTYPE_TIMESTAMP;
+      column.width = sizeof(OCIDateTime *);
+      break;
+    case SQLT_TIMESTAMP_TZ:
+      column.kind = OracleFetchKind::Timestamp;
+      column.descriptorType = OCI_DTYPE_TIMESTAMP_TZ;
+      column.width = sizeof(OCIDateTime *);
+      break;
+    case SQLT_TIMESTAMP_LTZ:
+      column.kind = OracleFetchKind::Timestamp;
+      column.descriptorType = OCI_DTYPE_TIMESTAMP_LTZ;
+      column.width = sizeof(OCIDateTime *);
+      break;
+    case SQLT_CLOB:
+    case SQLT_BLOB:
+      column.kind = OracleFetchKind::Lob;
+      column.width = sizeof(OCILobLocator *);
+      break;
+    case SQLT_LNG:
+    case SQLT_LBI:
+      column.width = ORACLE_FETCH_MAX_VALUE_BYTES;
+      break;
+    default:
+      // Room for the client character set and hex-encoded RAW, plus the
+      // terminator
+      column.width = std::min<ub4>(ORACLE_FETCH_MAX_VALUE_BYTES,
+                                   std::max<ub4>(dataSize, 1) * 4 + 1);
+      break;
+    }
+    rowWidth += column.width + sizeof(sb2) + 2 * sizeof(ub2);
+  }
 
+  ub4 arraySize = static_cast<ub4>(std::clamp<size_t>(
+      ORACLE_FETCH_BUFFER_BYTES / rowWidth, 1, ORACLE_FETCH_MAX_ROWS));
   for (ub4 i = 0; i < numCols; ++i) {
-    buffers[i].resize(4000, 0);
-    status =
-        OCIDefineByPos(stmt, &defines[i], err, i + 1, buffers[i].data(), 4000,
-                       SQLT_STR, &inds[i], &lengths[i], nullptr, OCI_DEFAULT);
+    OracleFetchColumn &column = columns[i];
+    column.indicators.resize(arraySize);
+    column.lengths.resize(arraySize);
+    column.returnCodes.resize(arraySize);
+
+    void *target = nullptr;
+    ub2 defineType = SQLT_STR;
+    switch (column.kind) {
+    case OracleFetchKind::Integer:
+      column.integers.resize(arraySize);
+      target = column.integers.data();
+      defineType = SQLT_INT;
+      break;
+    case OracleFetchKind::Date:
+      column.text.resize(static_cast<size_t>(arraySize) * column.width);
+      target = column.text.data();
+      defineType = SQLT_DAT;
+      break;
+    case OracleFetchKind::Timestamp:
+      column.timestamps.resize(arraySize, nullptr);
+      for (auto &value : column.timestamps) {
+        if (OCIDescriptorAlloc(env, (void **)&value, column.descriptorType, 0,
+                               nullptr) != OCI_SUCCESS) {
+          Logger::error(LogCategory::TRANSFER, "executeQueryOracle",
+                        "OCIDescriptorAlloc failed for column " +
+                            std::to_string(i + 1));
+          return false;
+        }
+      }
+      target = column.timestamps.data();
+      defineType = static_cast<ub2>(column.dataType);
+      break;
+    case OracleFetchKind::Lob:
+      column.lobs.resize(arraySize, nullptr);
+      for (auto &lob : column.lobs) {
+        if (OCIDescriptorAlloc(env, (void **)&lob, OCI_DTYPE_LOB, 0,
+                               nullptr) != OCI_SUCCESS) {
+          Logger::error(LogCategory::TRANSFER, "executeQueryOracle",
+                        "OCIDescriptorAlloc failed for column " +
+                            std::to_string(i + 1));
+          return false;
+        }
+      }
+      target = column.lobs.data();
+      defineType = static_cast<ub2>(column.dataType);
+      break;
+    case OracleFetchKind::Text:
+      column.text.resize(static_cast<size_t>(arraySize) * column.width);
+      target = column.text.data();
+      break;
+    }
+
+    OCIDefine *define = nullptr;
+    status = OCIDefineByPos(stmt, &define, err, i + 1, target,
+                            static_cast<sb4>(column.width), defineType,
+                            column.indicators.data(), column.lengths.data(),
+                            column.returnCodes.data(), OCI_DEFAULT);
     if (status != OCI_SUCCESS) {
       Logger::error(LogCategory::TRANSFER, "executeQueryOracle",
                     "OCIDefineByPos failed for column " +
                         std::to_string(i + 1));
-      return results;
+      return false;
     }
   }
 
+  batch.reset(numCols);
+  batch.reserve(arraySize);
+  std::vector<char> lobBuffer;
+  std::string lobHex;
+  char formatted[64];
   sword fetchStatus;
-  while ((fetchStatus = OCIStmtFetch(stmt, err, 1, OCI_FETCH_NEXT,
-                                     OCI_DEFAULT)) == OCI_SUCCESS) {
-    std::vector<std::string> row;
-    row.reserve(numCols);
-    for (ub4 i = 0; i < numCols; ++i) {
-      if (inds[i] == -1) {
-        row.push_back("NULL");
-      } else if (lengths[i] > 0 && lengths[i] <= 4000) {
-        row.push_back(std::string(buffers[i].data(), lengths[i]));
-      } else {
-        row.push_back("");
+  do {
+    fetchStatus =
+        OCIStmtFetch2(stmt, err, arraySize, OCI_FETCH_NEXT, 0, OCI_DEFAULT);
+    if (fetchStatus != OCI_SUCCESS && fetchStatus != OCI_SUCCESS_WITH_INFO &&
+        fetchStatus != OCI_NO_DATA)
+      break;
+
+    // The last fetch reports OCI_NO_DATA but may still carry rows
+    ub4 rowsFetched = 0;
+    OCIAttrGet(stmt, OCI_HTYPE_STMT, &rowsFetched, nullptr,
+               OCI_ATTR_ROWS_FETCHED, err);
+    for (ub4 row = 0; row < rowsFetched; ++row) {
+      for (ub4 i = 0; i < numCols; ++i) {
+        OracleFetchColumn &column = columns[i];
+        if (column.indicators[row] == OCI_IND_NULL) {
+          batch.appendNull(i);
+          continue;
+        }
+        switch (column.kind) {
+        case OracleFetchKind::Integer:
+          batch.append(i, std::to_string(column.integers[row]));
+          break;
+        case OracleFetchKind::Date:
+          batch.append(i, formatted,
+                       formatOracleDate(reinterpret_cast<const ub1 *>(
+                                            column.text.data() +
+                                            row * column.width),
+                                        formatted));
+          break;
+        case OracleFetchKind::Timestamp:
+          batch.append(i, formatted,
+                       formatOracleTimestamp(
+                           env, err, column.timestamps[row],
+                           column.descriptorType == OCI_DTYPE_TIMESTAMP_TZ,
+                           formatted));
+          break;
+        case OracleFetchKind::Lob:
+          lobBuffer.resize(ORACLE_LOB_PIECE_BYTES);
+          if (!readOracleLob(svc, env, err, column.lobs[row],
+                             column.dataType == SQLT_BLOB, lobBuffer, lobHex,
+                             batch, i)) {
+            Logger::error(LogCategory::TRANSFER, "executeQueryOracle",
+                          "OCILobRead2 failed for column " +
+                              std::to_string(i + 1));
+            return false;
+          }
+          break;
+        case OracleFetchKind::Text:
+          // A non-zero indicator means the value did not fit its slot; fail
+          // rather than load a cut value
+          if (column.indicators[row] != 0) {
+            Logger::error(LogCategory::TRANSFER, "executeQueryOracle",
+                          "Value in column " + std::to_string(i + 1) +
+                              " exceeds " + std::to_string(column.width - 1) +
+                              " bytes");
+            return false;
+          }
+          batch.append(i, column.text.data() + row * column.width,
+                       column.lengths[row]);
+          break;
+        }
       }
+      batch.finishRow();
     }
-    results.push_back(row);
-  }
+  } while (fetchStatus != OCI_NO_DATA);
 
   if (fetchStatus != OCI_NO_DATA) {
     char errbuf[512];
@@ -211,11 +554,10 @@ OracleToPostgres::executeQueryOracle(OCIConnection *conn,
     OCIErrorGet(err, 1, nullptr, &errcode, (OraText *)errbuf, sizeof(errbuf),
                 OCI_HTYPE_ERROR);
     Logger::error(LogCategory::TRANSFER, "executeQueryOracle",
-                  "OCIStmtFetch error: " + std::string(errbuf));
+                  "OCIStmtFetch2 error: " + std::string(errbuf));
+    return false;
   }
-
-  guard.stmt_ = nullptr;
-  return results;
+  return true;
 }
 
 std::vector<DatabaseToPostgresSync::TableInfo>
@@ -816,9 +1158,10 @@ void OracleToPostgres::transferDataOracleToPostgres() {
     }
 
     auto tables = getActiveTables(pgConn);
+    keepDueTables("Oracle", tables);
     if (tables.empty()) {
       Logger::info(LogCategory::TRANSFER,
-                   "No active Oracle tables found for data transfer");
+                   "No active Oracle tables due for data transfer");
       return;
     }
 
@@ -911,8 +1254,19 @@ void OracleToPostgres::transferDataOracleToPostgres() {
                           "." + lowerTable + ": " + std::string(e.what()));
       }
 
+      // A FULL_LOAD that left a key checkpoint behind resumes where it
+      // stopped; everything else starts from an empty target table.
+      bool resumeFullLoad = resumesFullLoad(
+          pgConn, table, "Oracle",
+          getPKColumnsFromCatalog(pgConn, schema_name, table_name));
+
       // Handle FULL_LOAD status - truncate and reset
-      if (table.status == "FULL_LOAD" || table.status == "RESET") {
+      if (resumeFullLoad) {
+        Logger::info(LogCategory::TRANSFER, "transferDataOracleToPostgres",
+                     "FULL_LOAD checkpoint found - resuming without truncate "
+                     "for " +
+                         schema_name + "." + table_name);
+      } else if (table.status == "FULL_LOAD" || table.status == "RESET") {
         try {
           pqxx::work truncateTxn(pgConn);
           truncateTxn.exec("TRUNCATE TABLE \"" + lowerSchema + "\".\"" +
@@ -969,18 +1323,21 @@ void OracleToPostgres::transferDataOracleToPostgres() {
       }
 
       std::string columnQuery =
-          "SELECT column_name FROM all_tab_columns WHERE owner = '" +
+          "SELECT column_name, data_type FROM all_tab_columns "
+          "WHERE owner = '" +
           escapeOracleValue(upperSchema) + "' AND table_name = '" +
           escapeOracleValue(upperTable) + "' ORDER BY column_id";
       auto columnResults = executeQueryOracle(oracleConn.get(), columnQuery);
 
       std::vector<std::string> columnNames;
+      std::vector<std::string> oracleDataTypes;
       for (const auto &row : columnResults) {
-        if (!row.empty()) {
+        if (row.size() >= 2) {
           std::string colName = row[0];
           std::transform(colName.begin(), colName.end(), colName.begin(),
                          ::tolower);
           columnNames.push_back(colName);
+          oracleDataTypes.push_back(row[1]);
         }
       }
 
@@ -991,6 +1348,8 @@ void OracleToPostgres::transferDataOracleToPostgres() {
         continue;
       }
 
+      std::vector<std::string> columnTypes(columnNames.size(), "TEXT");
+
       std::string pkStrategy =
           getPKStrategyFromCatalog(pgConn, schema_name, table_name);
 
@@ -1034,87 +1393,103 @@ void OracleToPostgres::transferDataOracleToPostgres() {
       const size_t CHUNK_SIZE =
           (rawChunkSize == 0 || rawChunkSize > 10000) ? 1000 : rawChunkSize;
 
-      while (hasMoreData) {
+      // With a primary key each chunk seeks past the last key of the previous
+      // one instead of re-reading OFFSET rows, and that key is checkpointed
+      // so an interrupted load resumes mid-table.
+      std::vector<size_t> keyPositions =
+          findKeyPositions(columnNames, pkColumns);
+      bool useKeyset = !keyPositions.empty();
+      std::vector<std::string> upperPkColumns;
+      for (const auto &pkColumn : pkColumns) {
+        std::string upperPkCol = pkColumn;
+        std::transform(upperPkCol.begin(), upperPkCol.end(),
+                       upperPkCol.begin(), ::toupper);
+        upperPkColumns.push_back(upperPkCol);
+      }
+      std::vector<std::string> lastKey;
+      if (useKeyset) {
+        lastKey = loadFullLoadCheckpoint(pgConn, schema_name, table_name,
+                                         "Oracle", pkColumns);
+        if (!lastKey.empty()) {
+          hasMoreData = true;
+          Logger::info(LogCategory::TRANSFER, "transferDataOracleToPostgres",
+                       "Resuming FULL_LOAD from checkpoint for " +
+                           schema_name + "." + table_name);
+        }
+      }
+
+      // Chunks are fetched here while the pipeline converts and writes the
+      // previous ones; the checkpoint only advances once a chunk is written.
+      size_t fetchedCount = targetCount;
+      auto fetchChunk = [&](RowBatch &batch,
+                            std::vector<std::string> &chunkKey) {
         chunkNumber++;
         std::string selectQuery =
             "SELECT * FROM " + upperSchema + "." + upperTable;
 
-        if (!pkColumns.empty()) {
-          std::string upperPkCol = pkColumns[0];
-          std::transform(upperPkCol.begin(), upperPkCol.end(),
-                         upperPkCol.begin(), ::toupper);
-          selectQuery += " ORDER BY " + upperPkCol;
-        } else {
-          selectQuery += " ORDER BY ROWID";
-        }
-        selectQuery += " OFFSET " + std::to_string(lastProcessedOffset) +
-                       " ROWS FETCH NEXT " + std::to_string(CHUNK_SIZE) +
-                       " ROWS ONLY";
-
-        auto results = executeQueryOracle(oracleConn.get(), selectQuery);
-        if (results.empty()) {
-          hasMoreData = false;
-          break;
-        }
-
-        try {
-          pqxx::work txn(pgConn);
-
-          std::ostringstream insertQuery;
-          insertQuery << "INSERT INTO " << txn.quote_name(lowerSchema) << "."
-                      << txn.quote_name(lowerTable) << " (";
-
-          for (size_t i = 0; i < columnNames.size(); ++i) {
-            if (i > 0)
-              insertQuery << ", ";
-            insertQuery << txn.quote_name(columnNames[i]);
+        if (useKeyset) {
+          if (!lastKey.empty()) {
+            std::vector<std::string> quotedKeyValues;
+            for (size_t i = 0; i < lastKey.size(); ++i)
+              quotedKeyValues.push_back(oracleKeyLiteral(
+                  lastKey[i], oracleDataTypes[keyPositions[i]]));
+            selectQuery += " WHERE " + buildKeysetPredicate(upperPkColumns,
+                                                            quotedKeyValues);
           }
-          insertQuery << ") VALUES ";
-
-          for (size_t i = 0; i < results.size(); ++i) {
+          selectQuery += " ORDER BY ";
+          for (size_t i = 0; i < upperPkColumns.size(); ++i) {
             if (i > 0)
-              insertQuery << ", ";
-            insertQuery << "(";
-            for (size_t j = 0; j < columnNames.size() && j < results[i].size();
-                 ++j) {
-              if (j > 0)
-                insertQuery << ", ";
-              if (results[i][j] == "NULL" || results[i][j].empty()) {
-                insertQuery << "NULL";
-              } else {
-                std::string cleanValue =
-                    cleanValueForPostgres(results[i][j], "TEXT");
-                insertQuery << txn.quote(cleanValue);
-              }
-            }
-            insertQuery << ")";
-          }
-
-          try {
-            txn.exec(insertQuery.str());
-            txn.commit();
-            targetCount += results.size();
-          } catch (...) {
-            try {
-              txn.abort();
-            } catch (...) {
-            }
-            throw;
+              selectQuery += ", ";
+            selectQuery += upperPkColumns[i];
           }
+          selectQuery +=
+              " FETCH FIRST " + std::to_string(CHUNK_SIZE) + " ROWS ONLY";
+        } else {
+          if (!pkColumns.empty())
+            selectQuery += " ORDER BY " + upperPkColumns[0];
+          else
+            selectQuery += " ORDER BY ROWID";
+          selectQuery += " OFFSET " + std::to_string(lastProcessedOffset) +
+                         " ROWS FETCH NEXT " + std::to_string(CHUNK_SIZE) +
+                         " ROWS ONLY";
+        }
 
-          targetCount += results.size();
-          lastProcessedOffset += results.size();
-
-          if (results.size() < CHUNK_SIZE || targetCount >= sourceCount) {
-            hasMoreData = false;
-          }
-        } catch (const std::exception &e) {
-          Logger::error(LogCategory::TRANSFER, "transferDataOracleToPostgres",
-                        "Error inserting data: " + std::string(e.what()));
-          updateStatus(pgConn, schema_name, table_name, "ERROR");
-          hasMoreData = false;
-          break;
+        // A failed chunk ends the load with the checkpoint kept
+        if (!executeQueryOracle(oracleConn.get(), selectQuery, batch))
+          throw std::runtime_error("Query failed for chunk " +
+                                   std::to_string(chunkNumber));
+        size_t rows = batch.rowCount();
+        if (rows == 0)
+          return false;
+
+        fetchedCount += rows;
+        lastProcessedOffset += rows;
+        if (useKeyset) {
+          lastKey.clear();
+          for (size_t position : keyPositions)
+            lastKey.emplace_back(batch.value(rows - 1, position));
+          chunkKey = lastKey;
+        }
+        return rows >= CHUNK_SIZE && fetchedCount < sourceCount;
+      };
+
+      auto chunkWritten = [&](pqxx::connection &writerConn,
+                              const PreparedBatch &written) {
+        targetCount += written.batchSize;
+        if (useKeyset && !written.lastKey.empty())
+          saveFullLoadCheckpoint(writerConn, schema_name, table_name,
+                                 "Oracle", pkColumns, written.lastKey);
+      };
+
+      if (hasMoreData) {
+        if (!runFullLoadPipeline(lowerSchema, lowerTable, schema_name,
+                                 columnNames, columnTypes, fetchChunk,
+                                 chunkWritten)) {
+          retryFullLoad(pgConn, schema_name, table_name, "Oracle");
+          continue;
         }
+        if (useKeyset)
+          clearFullLoadCheckpoint(pgConn, schema_name, table_name, "Oracle");
       }
 
       if (targetCount >= sourceCount) {
@@ -1122,6 +1497,7 @@ void OracleToPostgres::transferDataOracleToPostgres() {
                      targetCount);
       }
     }
+    completeDueTables("Oracle", tables);
   } catch (const std::exception &e) {
     Logger::error(LogCategory::TRANSFER, "transferDataOracleToPostgres",
                   "Error in transferDataOracleToPostgres: " +
@@ -1474,78 +1850,20 @@ void OracleToPostgres::processTableCDC(const TableInfo &table,
         }
       }
 
-      size_t deletedCount = 0;
-      if (!deletedPKs.empty()) {
-        std::string lowerSchemaName = table.schema_name;
-        std::transform(lowerSchemaName.begin(), lowerSchemaName.end(),
-                       lowerSchemaName.begin(), ::tolower);
-        std::string lowerTableName = table.table_name;
-        std::transform(lowerTableName.begin(), lowerTableName.end(),
-                       lowerTableName.begin(), ::tolower);
-
-        bool isNoPKTable = !hasPK;
-        if (isNoPKTable && !deletedPKs.empty()) {
-          deletedCount = deleteRecordsByHash(
-              pgConn, lowerSchemaName, lowerTableName, deletedPKs, columnNames);
-        } else if (hasPK && !deletedPKs.empty()) {
-          deletedCount = deleteRecordsByPrimaryKey(
-              pgConn, lowerSchemaName, lowerTableName, deletedPKs, pkColumns);
-        }
-      }
-
-      size_t upsertedCount = 0;
-      if (!recordsToUpsert.empty()) {
-        std::string lowerSchemaName = table.schema_name;
-        std::transform(lowerSchemaName.begin(), lowerSchemaName.end(),
-                       lowerSchemaName.begin(), ::tolower);
-        std::string lowerTableName = table.table_name;
-        std::transform(lowerTableName.begin(), lowerTableName.end(),
-                       lowerTableName.begin(), ::tolower);
-        try {
-          bool isNoPKTable = !hasPK;
-          if (isNoPKTable) {
-            performBulkUpsertNoPK(pgConn, recordsToUpsert, columnNames,
-                                  columnTypes, lowerSchemaName, lowerTableName,
-                                  table.schema_name);
-          } else {
-            performBulkUpsert(pgConn, recordsToUpsert, columnNames, columnTypes,
-                              lowerSchemaName, lowerTableName,
-                              table.schema_name);
-          }
-          upsertedCount = recordsToUpsert.size();
-          totalUpsertedCount += upsertedCount;
-        } catch (const std::exception &e) {
-          Logger::error(LogCategory::TRANSFER, "processTableCDC",
-                        "Failed to upsert records for " + table.schema_name +
-                            "." + table.table_name + ": " +
-                            std::string(e.what()));
-        }
-      }
-
+      // Deletes, upserts and the new last_change_id reach the target in one
+      // transaction, shared with the batches other tables commit meanwhile
+      CDCApplyBatch batch =
+          makeCDCApplyBatch(table, columnNames, columnTypes, pkColumns);
+      batch.dbEngine = "Oracle";
+      batch.deletes = std::move(deletedPKs);
+      batch.upserts = std::move(recordsToUpsert);
+      batch.progress["last_change_id"] = std::max(maxChangeId, lastChangeId);
+      if (commitCDCBatch(pgConn, batch))
+        lastChangeId = std::max(maxChangeId, lastChangeId);
+      size_t deletedCount = batch.deleted;
+      size_t upsertedCount = batch.upserted;
       totalDeletedCount += deletedCount;
-
-      if (maxChangeId > lastChangeId) {
-        try {
-          std::lock_guard<std::mutex> lock(metadataUpdateMutex);
-          pqxx::work txn(pgConn);
-          std::string updateQuery =
-              "UPDATE metadata.catalog SET sync_metadata = "
-              "COALESCE(sync_metadata, '{}'::jsonb) || "
-              "jsonb_build_object('last_change_id', " +
-              std::to_string(maxChangeId) +
-              ") WHERE schema_name=" + txn.quote(table.schema_name) +
-              " AND table_name=" + txn.quote(table.table_name) +
-              " AND db_engine='Oracle'";
-          txn.exec(updateQuery);
-          txn.commit();
-          lastChangeId = maxChangeId;
-        } catch (const std::exception &e) {
-          Logger::error(LogCategory::TRANSFER, "processTableCDC",
-                        "Error updating last_change_id for " +
-                            table.schema_name + "." + table.table_name + ": " +
-                            std::string(e.what()));
-        }
-      }
+      totalUpsertedCount += upsertedCount;
 
       Logger::info(
           LogCategory::TRANSFER, "processTableCDC",
@@ -1602,3 +1920,123 @@ void OracleToPostgres::processTableCDC(const TableInfo &table,
                       table.table_name + ": " + std::string(e.what()));
   }
 }
+
+// Deletes the change log rows of one table that every consumer has applied
+// with a PL/SQL loop that deletes and commits CHANGE_LOG_PURGE_BATCH_ROWS
+// rows at a time, at most CHANGE_LOG_PURGE_MAX_BATCHES times per cycle. The
+// block adds up SQL%ROWCOUNT and returns it through the :purged bind, since
+// executeQueryOracle reports no DML row counts. Returns the number of rows
+// deleted, 0 if the block failed.
+size_t OracleToPostgres::purgeChangeLogRows(OCIConnection *conn,
+                                            const std::string &schemaName,
+                                            const std::string &tableName,
+                                            long long appliedChangeId) {
+  if (appliedChangeId <= 0 || !conn || !conn->isValid())
+    return 0;
+  std::string predicate = "schema_name = '" + escapeOracleValue(schemaName) +
+                          "' AND table_name = '" +
+                          escapeOracleValue(tableName) +
+                          "' AND change_id <= " +
+                          std::to_string(appliedChangeId);
+  std::string block =
+      "DECLARE n NUMBER := 0; BEGIN FOR i IN 1.." +
+      std::to_string(CHANGE_LOG_PURGE_MAX_BATCHES) +
+      " LOOP DELETE FROM datasync_metadata.ds_change_log WHERE " + predicate +
+      " AND ROWNUM <= " + std::to_string(CHANGE_LOG_PURGE_BATCH_ROWS) +
+      "; n := n + SQL%ROWCOUNT; EXIT WHEN SQL%ROWCOUNT = 0; COMMIT; "
+      "END LOOP; COMMIT; :purged := n; END;";
+
+  OCIStmt *stmt = nullptr;
+  OCIError *err = conn->getErr();
+  if (OCIHandleAlloc((dvoid *)conn->getEnv(), (dvoid **)&stmt, OCI_HTYPE_STMT,
+                     0, nullptr) != OCI_SUCCESS) {
+    Logger::error(LogCategory::TRANSFER, "purgeChangeLogRows",
+                  "OCIHandleAlloc(STMT) failed");
+    return 0;
+  }
+
+  int64_t purged = 0;
+  sb2 indicator = 0;
+  OCIBind *bind = nullptr;
+  const std::string placeholder = ":purged";
+  sword status = OCIStmtPrepare(stmt, err, (OraText *)block.c_str(),
+                                block.length(), OCI_NTV_SYNTAX, OCI_DEFAULT);
+  if (status == OCI_SUCCESS)
+    status = OCIBindByName(stmt, &bind, err,
+                           (const OraText *)placeholder.c_str(),
+                           static_cast<sb4>(placeholder.length()), &purged,
+                           sizeof(purged), SQLT_INT, &indicator, nullptr,
+                           nullptr, 0, nullptr, OCI_DEFAULT);
+  if (status == OCI_SUCCESS)
+    status = OCIStmtExecute(conn->getSvc(), stmt, err, 1, 0, nullptr, nullptr,
+                            OCI_DEFAULT);
+  OCIHandleFree(stmt, OCI_HTYPE_STMT);
+
+  if (status != OCI_SUCCESS && status != OCI_SUCCESS_WITH_INFO) {
+    char errbuf[512] = {0};
+    sb4 errcode = 0;
+    OCIErrorGet(err, 1, nullptr, &errcode, (OraText *)errbuf, sizeof(errbuf),
+                OCI_HTYPE_ERROR);
+    Logger::error(LogCategory::TRANSFER, "purgeChangeLogRows",
+                  "Failed to purge change log of " + schemaName + "." +
+                      tableName + ": " + std::string(errbuf));
+    return 0;
+  }
+  return indicator == OCI_IND_NULL ? 0 : static_cast<size_t>(purged);
+}
+
+// Purges the ds_change_log of every Oracle source with CDC tables with
+// bounded per-table deletes, and records purged rows and the remaining log
+// size (from optimizer statistics) in each table's sync_metadata.
+void OracleToPostgres::purgeChangeLog() {
+  try {
+    pqxx::connection pgConn(DatabaseConfig::getPostgresConnectionString());
+    auto sources = getChangeLogSources(
+        pgConn, "Oracle",
+        [](const std::string &connectionString) { return connectionString; });
+
+    for (const auto &entry : sources) {
+      const ChangeLogSource &source = entry.second;
+      auto conn = getOracleConnection(source.connectionString);
+      if (!conn) {
+        Logger::error(LogCategory::TRANSFER, "purgeChangeLog",
+                      "Failed to get Oracle connection for change log purge");
+        continue;
+      }
+
+      std::map<std::pair<std::string, std::string>, size_t> purged;
+      size_t purgedTotal = 0;
+      for (const auto &table : source.appliedChangeIds) {
+        size_t rows = purgeChangeLogRows(conn.get(), table.first.first,
+                                         table.first.second, table.second);
+        purged[table.first] = rows;
+        purgedTotal += rows;
+      }
+
+      long long logRows = 0;
+      std::vector<std::vector<std::string>> sizeResult = executeQueryOracle(
+          conn.get(), "SELECT NVL(NUM_ROWS, 0) FROM ALL_TABLES WHERE OWNER = "
+                      "'DATASYNC_METADATA' AND TABLE_NAME = 'DS_CHANGE_LOG'");
+      try {
+        if (!sizeResult.empty() && !sizeResult[0].empty())
+          logRows = std::stoll(sizeResult[0][0]);
+      } catch (const std::exception &) {
+      }
+
+      for (const auto &table : source.appliedChangeIds) {
+        recordChangeLogPurge(pgConn, "Oracle", table.first.first,
+                             table.first.second, purged[table.first],
+                             logRows);
+      }
+
+      Logger::info(LogCategory::TRANSFER, "purgeChangeLog",
+                   "Purged " + std::to_string(purgedTotal) +
+                       " Oracle change log rows; ~" +
+                       std::to_string(logRows) + " rows remain");
+    }
+  } catch (const std::exception &e) {
+    Logger::error(LogCategory::TRANSFER, "purgeChangeLog",
+                  "Error purging Oracle change logs: " +
+                      std::string(e.what()));
+  }
+}
@@ -0,0 +1,1162 @@
+#include "sync/PostgresToPostgres.h"
+#include "core/Config.h"
+#include "core/database_config.h"
+#include "sync/ChangeCoalescer.h"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <set>
+#include <sys/select.h>
+
+// Session settings that make text output unambiguous input for the target
+// whatever the source's defaults are
+static const char *const TEXT_FORMAT_SETTINGS =
+    "SET DateStyle = 'ISO, YMD'; SET IntervalStyle = 'postgres'; "
+    "SET extra_float_digits = 3; SET bytea_output = 'hex'";
+
+static std::string lowercase(std::string value) {
+  std::transform(value.begin(), value.end(), value.begin(), ::tolower);
+  return value;
+}
+
+static uint64_t readUInt(const char *data, size_t bytes) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < bytes; ++i)
+    value = (value << 8) | static_cast<unsigned char>(data[i]);
+  return value;
+}
+
+static void writeUInt(char *data, uint64_t value, size_t bytes) {
+  for (size_t i = 0; i < bytes; ++i)
+    data[i] = static_cast<char>((value >> (8 * (bytes - 1 - i))) & 0xFF);
+}
+
+// Sequential reader over one pgoutput message. Reads past the end leave it
+// failed and return zero values, so a malformed message is dropped as a
+// whole instead of being applied in part.
+class MessageReader {
+public:
+  MessageReader(const char *data, size_t size) : data_(data), size_(size) {}
+
+  bool ok() const { return ok_; }
+
+  uint64_t uint(size_t bytes) {
+    if (!take(bytes))
+      return 0;
+    return readUInt(data_ + offset_ - bytes, bytes);
+  }
+
+  char byte() { return static_cast<char>(uint(1)); }
+
+  std::string string() {
+    const void *end = ok_ ? std::memchr(data_ + offset_, '\0', size_ - offset_)
+                          : nullptr;
+    if (!end) {
+      ok_ = false;
+      return "";
+    }
+    std::string value(data_ + offset_, static_cast<const char *>(end));
+    offset_ += value.size() + 1;
+    return value;
+  }
+
+  std::string bytes(size_t count) {
+    if (!take(count))
+      return "";
+    return std::string(data_ + offset_ - count, count);
+  }
+
+private:
+  bool take(size_t bytes) {
+    if (!ok_ || size_ - offset_ < bytes) {
+      ok_ = false;
+      return false;
+    }
+    offset_ += bytes;
+    return true;
+  }
+
+  const char *data_;
+  size_t size_;
+  size_t offset_ = 0;
+  bool ok_ = true;
+};
+
+// Values of a TupleData section in relation column order. SQL NULL is an
+// empty string; an unchanged TOASTed value is flagged in unchanged.
+static std::vector<std::string> readTuple(MessageReader &reader,
+                                          std::vector<bool> &unchanged) {
+  size_t columns = reader.uint(2);
+  std::vector<std::string> values(columns);
+  unchanged.assign(columns, false);
+  for (size_t i = 0; i < columns && reader.ok(); ++i) {
+    char kind = reader.byte();
+    if (kind == 't')
+      values[i] = reader.bytes(reader.uint(4));
+    else if (kind == 'u')
+      unchanged[i] = true;
+  }
+  return values;
+}
+
+// Serialized key of a row image for coalescing, from its key columns
+static std::string rowKey(const std::vector<std::string> &values,
+                          const std::vector<size_t> &pkPositions) {
+  std::string key;
+  for (size_t position : pkPositions) {
+    const std::string &value = position < values.size() ? values[position] : "";
+    key += std::to_string(value.size()) + ":" + value;
+  }
+  return key;
+}
+
+uint64_t PostgresToPostgres::parseLsn(const std::string &lsn) {
+  unsigned int high = 0;
+  unsigned int low = 0;
+  if (std::sscanf(lsn.c_str(), "%X/%X", &high, &low) != 2)
+    return 0;
+  return (static_cast<uint64_t>(high) << 32) | low;
+}
+
+std::string PostgresToPostgres::formatLsn(uint64_t lsn) {
+  char buffer[32];
+  std::snprintf(buffer, sizeof(buffer), "%X/%X",
+                static_cast<unsigned int>(lsn >> 32),
+                static_cast<unsigned int>(lsn & 0xFFFFFFFF));
+  return buffer;
+}
+
+std::string PostgresToPostgres::quoteIdentifier(const std::string &identifier) {
+  std::string quoted = "\"";
+  for (char c : identifier) {
+    if (c == '"')
+      quoted += c;
+    quoted += c;
+  }
+  return quoted + "\"";
+}
+
+// Slot names are cluster-wide and limited to lowercase letters, digits and
+// underscores, so the database name is folded into that alphabet
+std::string PostgresToPostgres::slotName(const std::string &database) {
+  std::string name = std::string(REPLICATION_SLOT) + "_";
+  for (char c : lowercase(database))
+    name += std::isalnum(static_cast<unsigned char>(c)) ? c : '_';
+  return name.substr(0, 63);
+}
+
+std::string
+PostgresToPostgres::replicationConninfo(const std::string &connectionString) {
+  if (connectionString.find("://") != std::string::npos)
+    return connectionString +
+           (connectionString.find('?') == std::string::npos ? "?" : "&") +
+           "replication=database";
+  return connectionString + " replication=database";
+}
+
+std::vector<DatabaseToPostgresSync::TableInfo>
+PostgresToPostgres::getActiveTables(pqxx::connection &pgConn) {
+  std::vector<TableInfo> data;
+  try {
+    pqxx::work txn(pgConn);
+    auto results =
+        txn.exec("SELECT schema_name, table_name, cluster_name, db_engine, "
+                 "connection_string, status, pk_strategy, pk_columns "
+                 "FROM metadata.catalog "
+                 "WHERE active=true AND db_engine='PostgreSQL' AND "
+                 "status != 'NO_DATA' "
+                 "ORDER BY schema_name, table_name;");
+    txn.commit();
+
+    for (const auto &row : results) {
+      TableInfo t;
+      t.schema_name = row[0].is_null() ? "" : row[0].as<std::string>();
+      t.table_name = row[1].is_null() ? "" : row[1].as<std::string>();
+      t.cluster_name = row[2].is_null() ? "" : row[2].as<std::string>();
+      t.db_engine = row[3].is_null() ? "" : row[3].as<std::string>();
+      t.connection_string = row[4].is_null() ? "" : row[4].as<std::string>();
+      t.status = row[5].is_null() ? "" : row[5].as<std::string>();
+      t.pk_strategy = row[6].is_null() ? "" : row[6].as<std::string>();
+      t.pk_columns = row[7].is_null() ? "" : row[7].as<std::string>();
+      t.has_pk = !parseJSONArray(t.pk_columns).empty();
+      data.push_back(t);
+    }
+  } catch (const std::exception &e) {
+    Logger::error(LogCategory::TRANSFER, "getActiveTables",
+                  "Error getting active PostgreSQL tables: " +
+                      std::string(e.what()));
+  }
+  return data;
+}
+
+// Makes sure the source can serve logical replication for the tables: the
+// publication exists and includes them, tables without a primary key log
+// full old rows, and the database's slot exists. The slot is created before
+// any copy reads its LSN so the WAL after it is retained.
+bool PostgresToPostgres::prepareSource(pqxx::connection &sourceConn,
+                                       const std::vector<TableInfo> &tables) {
+  try {
+    pqxx::nontransaction txn(sourceConn);
+    auto walLevel = txn.exec("SHOW wal_level");
+    if (walLevel.empty() || walLevel[0][0].as<std::string>() != "logical") {
+      Logger::error(LogCategory::TRANSFER, "prepareSource",
+                    "Source database " + sourceConn.dbname() +
+                        " needs wal_level=logical for change streaming");
+      return false;
+    }
+
+    if (txn.exec_params("SELECT 1 FROM pg_publication WHERE pubname = $1",
+                        std::string(PUBLICATION))
+            .empty()) {
+      txn.exec("CREATE PUBLICATION " + quoteIdentifier(PUBLICATION));
+      Logger::info(LogCategory::TRANSFER, "prepareSource",
+                   "Created publication " + std::string(PUBLICATION) +
+                       " on " + sourceConn.dbname());
+    }
+
+    for (const auto &table : tables) {
+      std::string qualified = quoteIdentifier(table.schema_name) + "." +
+                              quoteIdentifier(table.table_name);
+      if (txn.exec_params("SELECT 1 FROM pg_publication_tables WHERE "
+                          "pubname = $1 AND schemaname = $2 AND "
+                          "tablename = $3",
+                          std::string(PUBLICATION), table.schema_name,
+                          table.table_name)
+              .empty()) {
+        txn.exec("ALTER PUBLICATION " + quoteIdentifier(PUBLICATION) +
+                 " ADD TABLE " + qualified);
+      }
+      if (!table.has_pk &&
+          txn.exec_params("SELECT 1 FROM pg_class WHERE oid = "
+                          "to_regclass($1) AND relreplident = 'f'",
+                          qualified)
+              .empty()) {
+        txn.exec("ALTER TABLE " + qualified + " REPLICA IDENTITY FULL");
+      }
+    }
+
+    std::string slot = slotName(sourceConn.dbname());
+    if (txn.exec_params("SELECT 1 FROM pg_replication_slots WHERE "
+                        "slot_name = $1",
+                        slot)
+            .empty()) {
+      txn.exec_params(
+          "SELECT pg_create_logical_replication_slot($1, 'pgoutput')", slot);
+      Logger::info(LogCategory::TRANSFER, "prepareSource",
+                   "Created replication slot " + slot + " on " +
+                       sourceConn.dbname());
+    }
+    return true;
+  } catch (const std::exception &e) {
+    Logger::error(LogCategory::TRANSFER, "prepareSource",
+                  "Error preparing source " + sourceConn.dbname() +
+                      " for replication: " + std::string(e.what()));
+    return false;
+  }
+}
+
+// Creates the target table from the source's column list. Built-in types
+// are kept as they are; types defined in the source database (enums,
+// domains, composites) become text on the target.
+bool PostgresToPostgres::createTargetTable(pqxx::connection &pgConn,
+                                           pqxx::connection &sourceConn,
+                                           const TableInfo &table) {
+  std::string tableKey = table.schema_name + "." + table.table_name;
+  try {
+    pqxx::work sourceTxn(sourceConn);
+    auto columns = sourceTxn.exec_params(
+        "SELECT a.attname, CASE WHEN t.typnamespace = "
+        "'pg_catalog'::regnamespace THEN format_type(a.atttypid, "
+        "a.atttypmod) ELSE 'text' END, a.attnotnull "
+        "FROM pg_attribute a JOIN pg_type t ON t.oid = a.atttypid "
+        "WHERE a.attrelid = to_regclass($1) AND a.attnum > 0 AND "
+        "NOT a.attisdropped ORDER BY a.attnum",
+        quoteIdentifier(table.schema_name) + "." +
+            quoteIdentifier(table.table_name));
+    sourceTxn.commit();
+    if (columns.empty()) {
+      Logger::error(LogCategory::TRANSFER, "createTargetTable",
+                    "No columns found for " + tableKey + " on the source");
+      return false;
+    }
+
+    std::string lowerSchema = lowercase(table.schema_name);
+    std::string createQuery = "CREATE TABLE IF NOT EXISTS " +
+                              quoteIdentifier(lowerSchema) + "." +
+                              quoteIdentifier(lowercase(table.table_name)) +
+                              " (";
+    for (const auto &column : columns) {
+      createQuery += quoteIdentifier(lowercase(column[0].as<std::string>())) +
+                     " " + column[1].as<std::string>();
+      if (column[2].as<bool>())
+        createQuery += " NOT NULL";
+      createQuery += ", ";
+    }
+    std::vector<std::string> pkColumns = parseJSONArray(table.pk_columns);
+    if (!pkColumns.empty()) {
+      createQuery += "PRIMARY KEY (";
+      for (size_t i = 0; i < pkColumns.size(); ++i) {
+        if (i > 0)
+          createQuery += ", ";
+        createQuery += quoteIdentifier(lowercase(pkColumns[i]));
+      }
+      createQuery += ")";
+    } else {
+      createQuery.erase(createQuery.size() - 2);
+    }
+    createQuery += ")";
+
+    pqxx::work txn(pgConn);
+    txn.exec("CREATE SCHEMA IF NOT EXISTS " + quoteIdentifier(lowerSchema));
+    txn.exec(createQuery);
+    txn.commit();
+    return true;
+  } catch (const std::exception &e) {
+    Logger::error(LogCategory::TRANSFER, "createTargetTable",
+                  "Error creating target table for " + tableKey + ": " +
+                      std::string(e.what()));
+    return false;
+  }
+}
+
+void PostgresToPostgres::setupTableTargetPostgresToPostgres() {
+  Logger::info(LogCategory::TRANSFER, "Starting PostgreSQL table target setup");
+  try {
+    pqxx::connection pgConn(DatabaseConfig::getPostgresConnectionString());
+    auto tables = getActiveTables(pgConn);
+    if (tables.empty()) {
+      Logger::info(LogCategory::TRANSFER,
+                   "No active PostgreSQL tables found to setup");
+      return;
+    }
+
+    std::map<std::string, std::vector<TableInfo>> sources;
+    for (const auto &table : tables)
+      sources[table.connection_string].push_back(table);
+
+    for (const auto &source : sources) {
+      try {
+        pqxx::connection sourceConn(source.first);
+        prepareSource(sourceConn, source.second);
+        for (const auto &table : source.second)
+          createTargetTable(pgConn, sourceConn, table);
+      } catch (const std::exception &e) {
+        Logger::error(LogCategory::TRANSFER,
+                      "setupTableTargetPostgresToPostgres",
+                      "Error setting up tables of a PostgreSQL source: " +
+                          std::string(e.what()));
+      }
+    }
+  } catch (const std::exception &e) {
+    Logger::error(LogCategory::TRANSFER, "setupTableTargetPostgresToPostgres",
+                  "Error in setupTableTargetPostgresToPostgres: " +
+                      std::string(e.what()));
+  }
+}
+
+// Copies the rows COPY TO STDOUT produces on the source into COPY FROM STDIN
+// on the target, buffer by buffer. Both ends use the text format and the
+// same session settings, so no value is parsed or converted on the way.
+bool PostgresToPostgres::pipeCopy(PGconn *source, PGconn *target,
+                                  const std::string &copyOut,
+                                  const std::string &copyIn, size_t &rows,
+                                  std::string &error) {
+  PGresult *res = PQexec(source, copyOut.c_str());
+  bool copyingOut = PQresultStatus(res) == PGRES_COPY_OUT;
+  if (!copyingOut)
+    error = "COPY TO STDOUT failed: " + std::string(PQerrorMessage(source));
+  PQclear(res);
+  if (!copyingOut)
+    return false;
+
+  res = PQexec(target, copyIn.c_str());
+  bool copyingIn = PQresultStatus(res) == PGRES_COPY_IN;
+  if (!copyingIn)
+    error = "COPY FROM STDIN failed: " + std::string(PQerrorMessage(target));
+  PQclear(res);
+
+  bool ok = copyingIn;
+  char *buffer = nullptr;
+  int length;
+  while ((length = PQgetCopyData(source, &buffer, 0)) > 0) {
+    if (ok && PQputCopyData(target, buffer, length) != 1) {
+      error = "Writing COPY data failed: " +
+              std::string(PQerrorMessage(target));
+      ok = false;
+    }
+    PQfreemem(buffer);
+  }
+  if (length == -2) {
+    error = "Reading COPY data failed: " + std::string(PQerrorMessage(source));
+    ok = false;
+  }
+  while ((res = PQgetResult(source)) != nullptr) {
+    if (ok && PQresultStatus(res) != PGRES_COMMAND_OK) {
+      error = "COPY TO STDOUT failed: " + std::string(PQerrorMessage(source));
+      ok = false;
+    }
+    PQclear(res);
+  }
+
+  if (!copyingIn)
+    return false;
+  PQputCopyEnd(target, ok ? nullptr : "source copy failed");
+  while ((res = PQgetResult(target)) != nullptr) {
+    if (PQresultStatus(res) == PGRES_COMMAND_OK) {
+      rows = std::strtoull(PQcmdTuples(res), nullptr, 10);
+    } else if (ok) {
+      error = "COPY FROM STDIN failed: " + std::string(PQerrorMessage(target));
+      ok = false;
+    }
+    PQclear(res);
+  }
+  return ok;
+}
+
+// Full load of one table. The source's current WAL position is read before
+// the copy's snapshot is taken, so every transaction the snapshot misses
+// commits after it and is streamed; those the snapshot did see are applied
+// again, which upserts make harmless. The target is truncated and refilled
+// in one transaction.
+void PostgresToPostgres::copyTable(pqxx::connection &pgConn,
+                                   const TableInfo &table) {
+  std::string tableKey = table.schema_name + "." + table.table_name;
+  std::string lsn;
+  std::vector<std::string> sourceColumns;
+  try {
+    pqxx::connection sourceConn(table.connection_string);
+    if (!prepareSource(sourceConn, {table}) ||
+        !createTargetTable(pgConn, sourceConn, table))
+      return;
+
+    pqxx::work txn(sourceConn);
+    auto columns = txn.exec_params(
+        "SELECT attname FROM pg_attribute WHERE attrelid = to_regclass($1) "
+        "AND attnum > 0 AND NOT attisdropped ORDER BY attnum",
+        quoteIdentifier(table.schema_name) + "." +
+            quoteIdentifier(table.table_name));
+    auto current = txn.exec("SELECT pg_current_wal_lsn()::text");
+    txn.commit();
+    for (const auto &column : columns)
+      sourceColumns.push_back(column[0].as<std::string>());
+    lsn = current[0][0].as<std::string>();
+  } catch (const std::exception &e) {
+    Logger::error(LogCategory::TRANSFER, "copyTable",
+                  "Error preparing copy of " + tableKey + ": " +
+                      std::string(e.what()));
+    return;
+  }
+
+  std::string sourceList;
+  std::string targetList;
+  for (const auto &column : sourceColumns) {
+    if (!sourceList.empty()) {
+      sourceList += ", ";
+      targetList += ", ";
+    }
+    sourceList += quoteIdentifier(column);
+    targetList += quoteIdentifier(lowercase(column));
+  }
+  std::string targetTable = quoteIdentifier(lowercase(table.schema_name)) +
+                            "." +
+                            quoteIdentifier(lowercase(table.table_name));
+
+  PGconn *source = PQconnectdb(table.connection_string.c_str());
+  PGconn *target =
+      PQconnectdb(DatabaseConfig::getPostgresConnectionString().c_str());
+  auto run = [](PGconn *conn, const std::string &query) {
+    PGresult *res = PQexec(conn, query.c_str());
+    bool ok = PQresultStatus(res) == PGRES_COMMAND_OK;
+    PQclear(res);
+    return ok;
+  };
+
+  size_t rows = 0;
+  std::string error;
+  bool ok = PQstatus(source) == CONNECTION_OK &&
+            PQstatus(target) == CONNECTION_OK;
+  if (!ok) {
+    error = "connection failed: " +
+            std::string(PQerrorMessage(PQstatus(source) == CONNECTION_OK
+                                           ? target
+                                           : source));
+  } else {
+    ok = run(source, TEXT_FORMAT_SETTINGS) &&
+         run(target, TEXT_FORMAT_SETTINGS) &&
+         run(source, "BEGIN ISOLATION LEVEL REPEATABLE READ READ ONLY") &&
+         run(target, "BEGIN") && run(target, "TRUNCATE TABLE " + targetTable);
+    if (!ok)
+      error = "preparing the copy failed: " +
+              std::string(PQerrorMessage(target)) +
+              std::string(PQerrorMessage(source));
+    ok = ok &&
+         pipeCopy(source, target,
+                  "COPY " + quoteIdentifier(table.schema_name) + "." +
+                      quoteIdentifier(table.table_name) + " (" + sourceList +
+                      ") TO STDOUT",
+                  "COPY " + targetTable + " (" + targetList + ") FROM STDIN",
+                  rows, error);
+    run(source, "COMMIT");
+    if (ok && !run(target, "COMMIT")) {
+      error = "commit failed: " + std::string(PQerrorMessage(target));
+      ok = false;
+    }
+    if (!ok)
+      run(target, "ROLLBACK");
+  }
+  PQfinish(source);
+  PQfinish(target);
+
+  if (!ok) {
+    Logger::error(LogCategory::TRANSFER, "copyTable",
+                  "Copy of " + tableKey + " failed - " + error);
+    return;
+  }
+
+  try {
+    std::lock_guard<std::mutex> lock(metadataUpdateMutex);
+    pqxx::work txn(pgConn);
+    txn.exec("UPDATE metadata.catalog SET status = 'LISTENING_CHANGES', "
+             "sync_metadata = COALESCE(sync_metadata, '{}'::jsonb) || "
+             "jsonb_build_object('pg_lsn', " +
+             txn.quote(lsn) + ") WHERE schema_name=" +
+             txn.quote(table.schema_name) +
+             " AND table_name=" + txn.quote(table.table_name) +
+             " AND db_engine='PostgreSQL' AND connection_string=" +
+             txn.quote(table.connection_string));
+    txn.commit();
+  } catch (const std::exception &e) {
+    Logger::error(LogCategory::TRANSFER, "copyTable",
+                  "Error saving the position of " + tableKey + ": " +
+                      std::string(e.what()));
+    return;
+  }
+  Logger::info(LogCategory::TRANSFER, "copyTable",
+               "Copied " + std::to_string(rows) + " rows of " + tableKey +
+                   "; streaming changes after " + lsn);
+}
+
+void PostgresToPostgres::requestFullLoad(pqxx::connection &pgConn,
+                                         const TableInfo &table,
+                                         const std::string &reason) {
+  try {
+    std::lock_guard<std::mutex> lock(metadataUpdateMutex);
+    pqxx::work txn(pgConn);
+    txn.exec("UPDATE metadata.catalog SET status = 'FULL_LOAD', "
+             "sync_metadata = COALESCE(sync_metadata, '{}'::jsonb) - "
+             "'pg_lsn' WHERE schema_name=" +
+             txn.quote(table.schema_name) +
+             " AND table_name=" + txn.quote(table.table_name) +
+             " AND db_engine='PostgreSQL' AND connection_string=" +
+             txn.quote(table.connection_string));
+    txn.commit();
+    Logger::warning(LogCategory::TRANSFER, "requestFullLoad",
+                    "Reloading " + table.schema_name + "." +
+                        table.table_name + ": " + reason);
+  } catch (const std::exception &e) {
+    Logger::error(LogCategory::TRANSFER, "requestFullLoad",
+                  "Error requesting full load: " + std::string(e.what()));
+  }
+}
+
+void PostgresToPostgres::transferDataPostgresToPostgres() {
+  try {
+    pqxx::connection pgConn(DatabaseConfig::getPostgresConnectionString());
+    auto tables = getActiveTables(pgConn);
+    if (tables.empty()) {
+      Logger::info(LogCategory::TRANSFER,
+                   "No active PostgreSQL tables found - skipping transfer "
+                   "cycle");
+      return;
+    }
+
+    // A stream confirms its slot for every table of the source, so a source
+    // is streamed for all of its listening tables once any of them is due
+    std::vector<TableInfo> dueTables = tables;
+    keepDueTables("PostgreSQL", dueTables);
+    std::set<std::string> dueSources;
+    for (const auto &table : dueTables) {
+      if (table.status == "FULL_LOAD" || table.status == "RESET")
+        copyTable(pgConn, table);
+      else if (table.status == "LISTENING_CHANGES")
+        dueSources.insert(table.connection_string);
+    }
+
+    std::map<std::string, std::vector<TableInfo>> listening;
+    for (const auto &table : tables) {
+      if (table.status == "LISTENING_CHANGES" &&
+          dueSources.count(table.connection_string) != 0)
+        listening[table.connection_string].push_back(table);
+    }
+    for (const auto &source : listening)
+      streamSource(pgConn, source.first, source.second);
+    completeDueTables("PostgreSQL", dueTables);
+  } catch (const std::exception &e) {
+    Logger::error(LogCategory::TRANSFER, "transferDataPostgresToPostgres",
+                  "Error in PostgreSQL transfer: " + std::string(e.what()));
+  }
+}
+
+void PostgresToPostgres::processTableCDC(const TableInfo &table,
+                                         pqxx::connection &pgConn) {
+  streamSource(pgConn, table.connection_string, {table});
+}
+
+// Reads the table's columns from the source (the order of the values in
+// replication messages), maps them to the target's lowercased columns and
+// finds the key columns among them.
+bool PostgresToPostgres::loadColumns(pqxx::connection &pgConn,
+                                     pqxx::connection &sourceConn,
+                                     StreamTable &table) {
+  const TableInfo &info = table.info;
+  std::string tableKey = info.schema_name + "." + info.table_name;
+  pqxx::work txn(sourceConn);
+  auto columns = txn.exec_params(
+      "SELECT a.attname, format_type(a.atttypid, a.atttypmod) "
+      "FROM pg_attribute a WHERE a.attrelid = to_regclass($1) AND "
+      "a.attnum > 0 AND NOT a.attisdropped ORDER BY a.attnum",
+      quoteIdentifier(info.schema_name) + "." +
+          quoteIdentifier(info.table_name));
+  txn.commit();
+  if (columns.empty()) {
+    Logger::error(LogCategory::TRANSFER, "loadColumns",
+                  "No columns found for " + tableKey);
+    return false;
+  }
+
+  table.sourceColumnNames.clear();
+  table.columnNames.clear();
+  table.columnTypes.clear();
+  for (const auto &column : columns) {
+    table.sourceColumnNames.push_back(column[0].as<std::string>());
+    table.columnNames.push_back(lowercase(column[0].as<std::string>()));
+    table.columnTypes.push_back(column[1].as<std::string>());
+  }
+  table.pkColumns.clear();
+  for (const auto &pk :
+       getPKColumnsFromCatalog(pgConn, info.schema_name, info.table_name))
+    table.pkColumns.push_back(lowercase(pk));
+  table.pkPositions = findKeyPositions(table.columnNames, table.pkColumns);
+  if (!table.pkColumns.empty() && table.pkPositions.empty()) {
+    Logger::error(LogCategory::TRANSFER, "loadColumns",
+                  "Primary key columns of " + tableKey +
+                      " are missing from its source columns");
+    return false;
+  }
+  table.relationColumns.clear();
+  return true;
+}
+
+// Re-reads the current source rows of the given keys, CDC_REFETCH_BATCH_KEYS
+// keys per query, in columnNames order. Keys whose row has been deleted
+// since are not returned; their delete follows later in the stream.
+size_t PostgresToPostgres::refetchRows(
+    pqxx::connection &sourceConn, const StreamTable &table,
+    const std::vector<std::vector<std::string>> &keys,
+    std::vector<std::vector<std::string>> &records) {
+  std::string columnList;
+  for (const auto &column : table.sourceColumnNames) {
+    if (!columnList.empty())
+      columnList += ", ";
+    columnList += "t." + quoteIdentifier(column);
+  }
+  std::string keyList;
+  for (size_t position : table.pkPositions) {
+    if (!keyList.empty())
+      keyList += ", ";
+    keyList += "t." + quoteIdentifier(table.sourceColumnNames[position]);
+  }
+
+  size_t found = 0;
+  pqxx::work txn(sourceConn);
+  txn.exec(TEXT_FORMAT_SETTINGS);
+  for (size_t start = 0; start < keys.size();
+       start += CDC_REFETCH_BATCH_KEYS) {
+    size_t count = std::min(CDC_REFETCH_BATCH_KEYS, keys.size() - start);
+    std::string query = "SELECT " + columnList + " FROM " +
+                        quoteIdentifier(table.info.schema_name) + "." +
+                        quoteIdentifier(table.info.table_name) +
+                        " AS t WHERE (" + keyList + ") IN (";
+    for (size_t k = start; k < start + count; ++k) {
+      if (k > start)
+        query += ", ";
+      query += "(";
+      for (size_t i = 0; i < keys[k].size(); ++i) {
+        if (i > 0)
+          query += ", ";
+        query += txn.quote(keys[k][i]);
+      }
+      query += ")";
+    }
+    query += ")";
+    for (const auto &row : txn.exec(query)) {
+      std::vector<std::string> values;
+      values.reserve(row.size());
+      for (const auto &field : row)
+        values.push_back(field.is_null() ? "" : field.as<std::string>());
+      records.push_back(std::move(values));
+      ++found;
+    }
+  }
+  txn.commit();
+  return found;
+}
+
+// Applies the committed changes buffered for each table (the last change
+// per key for tables with a primary key) and moves every table's position
+// up to committed. Rows and positions are committed together by
+// applyCDCBatches. A table whose incomplete rows cannot be re-read keeps
+// its position, so the next stream replays its changes.
+void PostgresToPostgres::applyPending(
+    pqxx::connection &pgConn, pqxx::connection &sourceConn,
+    std::map<std::string, StreamTable> &tables, uint64_t committed) {
+  struct Applied {
+    const std::string *tableKey;
+    StreamTable *table;
+    uint64_t position;
+    size_t changes;
+  };
+  std::vector<CDCApplyBatch> batches;
+  std::vector<Applied> applied;
+
+  for (auto &entry : tables) {
+    StreamTable &table = entry.second;
+    if (table.reload)
+      continue;
+    bool hasPK = !table.pkPositions.empty();
+    CDCApplyBatch batch = makeCDCApplyBatch(
+        table.info, table.columnNames, table.columnTypes,
+        hasPK ? table.pkColumns : std::vector<std::string>());
+    batch.dbEngine = "PostgreSQL";
+    size_t changes = table.pending.size();
+    try {
+      if (hasPK) {
+        ChangeCoalescer coalescer;
+        for (const auto &change : table.pending)
+          coalescer.add(rowKey(change.values, table.pkPositions),
+                        change.operation);
+        coalescer.finish();
+        batch.elided = coalescer.elided();
+        std::vector<std::vector<std::string>> refetchKeys;
+        for (size_t i = 0; i < table.pending.size(); ++i) {
+          if (!coalescer.keep(i))
+            continue;
+          RowChange &change = table.pending[i];
+          if (change.operation == 'D' || change.incomplete) {
+            std::vector<std::string> key;
+            for (size_t position : table.pkPositions)
+              key.push_back(change.values[position]);
+            (change.operation == 'D' ? batch.deletes : refetchKeys)
+                .push_back(std::move(key));
+          } else {
+            batch.upserts.push_back(std::move(change.values));
+          }
+        }
+        if (!refetchKeys.empty())
+          refetchRows(sourceConn, table, refetchKeys, batch.upserts);
+      } else {
+        for (auto &change : table.pending) {
+          if (change.operation == 'D') {
+            // Matched on every column; the hash slot is unused
+            std::vector<std::string> record{""};
+            record.insert(record.end(), change.values.begin(),
+                          change.values.end());
+            batch.deletes.push_back(std::move(record));
+          } else {
+            batch.upserts.push_back(std::move(change.values));
+          }
+        }
+      }
+    } catch (const std::exception &e) {
+      Logger::error(LogCategory::TRANSFER, "applyPending",
+                    "Failed to re-read changed rows of " + entry.first +
+                        ": " + std::string(e.what()) +
+                        " - its changes will be replayed");
+      table.pending.clear();
+      continue;
+    }
+    table.pending.clear();
+
+    if (committed <= table.position && changes == 0)
+      continue;
+    uint64_t position = std::max(table.position, committed);
+    batch.progress["pg_lsn"] = formatLsn(position);
+    batches.push_back(std::move(batch));
+    applied.push_back({&entry.first, &table, position, changes});
+  }
+
+  if (batches.empty())
+    return;
+
+  std::vector<bool> saved = applyCDCBatches(pgConn, batches);
+  for (size_t i = 0; i < batches.size(); ++i) {
+    if (saved[i])
+      applied[i].table->position = applied[i].position;
+    if (applied[i].changes == 0)
+      continue;
+    Logger::info(LogCategory::TRANSFER, "applyPending",
+                 "Applied " + std::to_string(applied[i].changes) +
+                     " streamed changes to " + *applied[i].tableKey + ": " +
+                     std::to_string(batches[i].upserted) + " upserts, " +
+                     std::to_string(batches[i].deleted) + " deletes, " +
+                     std::to_string(batches[i].elided) + " elided");
+  }
+}
+
+// Standby status update: the slot may discard everything before flushed
+bool PostgresToPostgres::sendFeedback(PGconn *replication, uint64_t flushed) {
+  char message[34];
+  message[0] = 'r';
+  writeUInt(message + 1, flushed, 8);
+  writeUInt(message + 9, flushed, 8);
+  writeUInt(message + 17, flushed, 8);
+  int64_t now = std::chrono::duration_cast<std::chrono::microseconds>(
+                    std::chrono::system_clock::now().time_since_epoch())
+                    .count() -
+                POSTGRES_EPOCH_OFFSET_USEC;
+  writeUInt(message + 25, static_cast<uint64_t>(now), 8);
+  message[33] = 0;
+  return PQputCopyData(replication, message, sizeof(message)) == 1 &&
+         PQflush(replication) == 0;
+}
+
+// Streams the source's slot for the given tables, from the lowest of their
+// positions until the stream has caught up with the WAL position read at
+// the start (or CHANGE_LOG_READ_MAX_ROWS changes have been read). Changes
+// are buffered per transaction and only become applicable at its commit;
+// at the end the slot is confirmed up to the lowest table position.
+void PostgresToPostgres::streamSource(pqxx::connection &pgConn,
+                                      const std::string &connectionString,
+                                      const std::vector<TableInfo> &tables) {
+  std::map<std::string, StreamTable> streamed;
+  std::unique_ptr<pqxx::connection> sourceConn;
+  uint64_t head = 0;
+  std::string database;
+  try {
+    std::map<std::string, std::string> positions;
+    {
+      pqxx::work txn(pgConn);
+      auto result = txn.exec(
+          "SELECT schema_name, table_name, sync_metadata->>'pg_lsn' FROM "
+          "metadata.catalog WHERE db_engine='PostgreSQL' AND "
+          "connection_string=" +
+          txn.quote(connectionString) + " AND sync_metadata ? 'pg_lsn'");
+      txn.commit();
+      for (const auto &row : result)
+        positions[row[0].as<std::string>() + "." + row[1].as<std::string>()] =
+            row[2].is_null() ? "" : row[2].as<std::string>();
+    }
+
+    for (const auto &table : tables) {
+      std::string tableKey = table.schema_name + "." + table.table_name;
+      auto saved = positions.find(tableKey);
+      if (saved == positions.end() || parseLsn(saved->second) == 0) {
+        requestFullLoad(pgConn, table, "no pg_lsn to stream from");
+        continue;
+      }
+      StreamTable &state = streamed[tableKey];
+      state.info = table;
+      state.position = parseLsn(saved->second);
+    }
+    if (streamed.empty())
+      return;
+
+    sourceConn = std::make_unique<pqxx::connection>(connectionString);
+    database = sourceConn->dbname();
+    {
+      pqxx::work txn(*sourceConn);
+      auto current = txn.exec("SELECT pg_current_wal_lsn()::text");
+      head = parseLsn(current[0][0].as<std::string>());
+      txn.commit();
+    }
+    bool behind = false;
+    for (const auto &entry : streamed)
+      behind = behind || entry.second.position < head;
+    if (!behind)
+      return;
+
+    for (auto it = streamed.begin(); it != streamed.end();) {
+      if (loadColumns(pgConn, *sourceConn, it->second))
+        ++it;
+      else
+        it = streamed.erase(it);
+    }
+    if (streamed.empty())
+      return;
+  } catch (const std::exception &e) {
+    Logger::error(LogCategory::TRANSFER, "streamSource",
+                  "Error preparing PostgreSQL change stream: " +
+                      std::string(e.what()));
+    return;
+  }
+
+  uint64_t start = head;
+  for (const auto &entry : streamed)
+    start = std::min(start, entry.second.position);
+
+  PGconn *replication =
+      PQconnectdb(replicationConninfo(connectionString).c_str());
+  if (PQstatus(replication) != CONNECTION_OK) {
+    Logger::error(LogCategory::TRANSFER, "streamSource",
+                  "Replication connection to " + database + " failed: " +
+                      std::string(PQerrorMessage(replication)));
+    PQfinish(replication);
+    return;
+  }
+  PGresult *res = PQexec(replication, TEXT_FORMAT_SETTINGS);
+  PQclear(res);
+  std::string startQuery = "START_REPLICATION SLOT " +
+                           quoteIdentifier(slotName(database)) + " LOGICAL " +
+                           formatLsn(start) +
+                           " (proto_version '1', publication_names '" +
+                           quoteIdentifier(PUBLICATION) + "')";
+  res = PQexec(replication, startQuery.c_str());
+  bool streaming = PQresultStatus(res) == PGRES_COPY_BOTH;
+  PQclear(res);
+  if (!streaming) {
+    Logger::error(LogCategory::TRANSFER, "streamSource",
+                  "START_REPLICATION on " + database + " failed: " +
+                      std::string(PQerrorMessage(replication)));
+    PQfinish(replication);
+    return;
+  }
+
+  std::map<uint32_t, StreamTable *> relations;
+  std::vector<std::pair<StreamTable *, RowChange>> transaction;
+  std::vector<StreamTable *> truncated;
+  bool inTransaction = false;
+  uint64_t committed = start;
+  size_t transactions = 0;
+  size_t pendingChanges = 0;
+  size_t readChanges = 0;
+  std::string streamError;
+  auto lastMessage = std::chrono::steady_clock::now();
+
+  // Decodes a tuple into target column order; an update's unchanged TOASTed
+  // values are taken from the old row when there is one
+  auto decodeRow = [](StreamTable &table, MessageReader &reader,
+                      const std::vector<std::string> *oldValues,
+                      bool &incomplete) {
+    std::vector<bool> unchanged;
+    std::vector<std::string> tuple = readTuple(reader, unchanged);
+    std::vector<std::string> values(table.columnNames.size());
+    incomplete = false;
+    for (size_t i = 0; i < tuple.size() && i < table.relationColumns.size();
+         ++i) {
+      int position = table.relationColumns[i];
+      if (position < 0)
+        continue;
+      if (!unchanged[i])
+        values[position] = std::move(tuple[i]);
+      else if (oldValues)
+        values[position] = (*oldValues)[position];
+      else
+        incomplete = true;
+    }
+    return values;
+  };
+
+  while (true) {
+    char *buffer = nullptr;
+    int length = PQgetCopyData(replication, &buffer, 1);
+    if (length == 0) {
+      auto idle = std::chrono::duration_cast<std::chrono::seconds>(
+                      std::chrono::steady_clock::now() - lastMessage)
+                      .count();
+      if (idle >= STREAM_IDLE_TIMEOUT_SECONDS && !inTransaction)
+        break;
+      int socket = PQsocket(replication);
+      fd_set readSet;
+      FD_ZERO(&readSet);
+      FD_SET(socket, &readSet);
+      timeval timeout{1, 0};
+      if (select(socket + 1, &readSet, nullptr, nullptr, &timeout) < 0 ||
+          !PQconsumeInput(replication)) {
+        streamError = PQerrorMessage(replication);
+        break;
+      }
+      continue;
+    }
+    if (length < 0) {
+      if (length == -2)
+        streamError = PQerrorMessage(replication);
+      break;
+    }
+    lastMessage = std::chrono::steady_clock::now();
+
+    bool caughtUp = false;
+    if (buffer[0] == 'k' && length >= 18) {
+      // Keepalive: the server has sent everything up to walEnd
+      uint64_t walEnd = readUInt(buffer + 1, 8);
+      if (buffer[17])
+        sendFeedback(replication, committed);
+      if (!inTransaction && walEnd >= head) {
+        committed = std::max(committed, walEnd);
+        caughtUp = true;
+      }
+    } else if (buffer[0] == 'w' && length > 25) {
+      MessageReader reader(buffer + 25, static_cast<size_t>(length) - 25);
+      char type = reader.byte();
+      if (type == 'B') {
+        inTransaction = true;
+        transaction.clear();
+        truncated.clear();
+      } else if (type == 'C') {
+        reader.byte();
+        reader.uint(8);
+        uint64_t endLsn = reader.uint(8);
+        for (auto &change : transaction) {
+          if (change.first->position < endLsn && !change.first->reload) {
+            change.first->pending.push_back(std::move(change.second));
+            ++pendingChanges;
+          }
+        }
+        for (StreamTable *table : truncated) {
+          if (table->position < endLsn)
+            table->reload = true;
+        }
+        readChanges += transaction.size();
+        transaction.clear();
+        truncated.clear();
+        committed = std::max(committed, endLsn);
+        inTransaction = false;
+        ++transactions;
+        caughtUp = endLsn >= head;
+      } else if (type == 'R') {
+        uint32_t relid = static_cast<uint32_t>(reader.uint(4));
+        std::string tableKey = reader.string();
+        tableKey += "." + reader.string();
+        reader.byte();
+        size_t columns = reader.uint(2);
+        std::vector<std::string> names;
+        for (size_t i = 0; i < columns && reader.ok(); ++i) {
+          reader.byte();
+          names.push_back(lowercase(reader.string()));
+          reader.uint(8);
+        }
+        auto it = streamed.find(tableKey);
+        if (it == streamed.end() || !reader.ok()) {
+          relations.erase(relid);
+        } else {
+          StreamTable &table = it->second;
+          bool known = std::all_of(
+              names.begin(), names.end(), [&table](const std::string &n) {
+                return std::find(table.columnNames.begin(),
+                                 table.columnNames.end(),
+                                 n) != table.columnNames.end();
+              });
+          try {
+            if (!known && !loadColumns(pgConn, *sourceConn, table))
+              table.reload = true;
+          } catch (const std::exception &e) {
+            Logger::error(LogCategory::TRANSFER, "streamSource",
+                          "Error reloading columns of " + tableKey + ": " +
+                              std::string(e.what()));
+            table.reload = true;
+          }
+          table.relationColumns.clear();
+          for (const auto &name : names) {
+            auto column = std::find(table.columnNames.begin(),
+                                    table.columnNames.end(), name);
+            table.relationColumns.push_back(
+                column == table.columnNames.end()
+                    ? -1
+                    : static_cast<int>(column - table.columnNames.begin()));
+          }
+          relations[relid] = &table;
+        }
+      } else if (type == 'I' || type == 'U' || type == 'D') {
+        auto relation =
+            relations.find(static_cast<uint32_t>(reader.uint(4)));
+        if (relation != relations.end()) {
+          StreamTable &table = *relation->second;
+          char section = reader.byte();
+          bool incomplete = false;
+          std::vector<RowChange> changes;
+          if (type == 'I') {
+            changes.push_back({'I', decodeRow(table, reader, nullptr,
+                                              incomplete)});
+          } else {
+            std::vector<std::string> oldValues;
+            bool hasOld = section == 'K' || section == 'O';
+            if (hasOld) {
+              oldValues = decodeRow(table, reader, nullptr, incomplete);
+              if (type == 'U')
+                section = reader.byte();
+            }
+            if (type == 'D') {
+              changes.push_back({'D', std::move(oldValues)});
+            } else {
+              RowChange after{'U', decodeRow(table, reader,
+                                             section == 'N' && hasOld &&
+                                                     table.pkPositions.empty()
+                                                 ? &oldValues
+                                                 : nullptr,
+                                             incomplete)};
+              after.incomplete = incomplete;
+              // An old row comes with a changed key (K) or a table without
+              // one (O); either way the old row is deleted first
+              if (hasOld)
+                changes.push_back({'D', std::move(oldValues)});
+              changes.push_back(std::move(after));
+            }
+          }
+          if (reader.ok()) {
+            for (auto &change : changes)
+              transaction.push_back({&table, std::move(change)});
+          }
+        }
+      } else if (type == 'T') {
+        size_t count = reader.uint(4);
+        reader.byte();
+        for (size_t i = 0; i < count && reader.ok(); ++i) {
+          auto relation =
+              relations.find(static_cast<uint32_t>(reader.uint(4)));
+          if (relation != relations.end())
+            truncated.push_back(relation->second);
+        }
+      }
+    }
+    PQfreemem(buffer);
+
+    if (!inTransaction && pendingChanges >= STREAM_APPLY_BATCH_CHANGES) {
+      applyPending(pgConn, *sourceConn, streamed, committed);
+      pendingChanges = 0;
+    }
+    if (caughtUp || (!inTransaction && readChanges >= CHANGE_LOG_READ_MAX_ROWS))
+      break;
+  }
+
+  applyPending(pgConn, *sourceConn, streamed, committed);
+
+  uint64_t confirmed = committed;
+  for (const auto &entry : streamed) {
+    if (!entry.second.reload)
+      confirmed = std::min(confirmed, entry.second.position);
+  }
+  sendFeedback(replication, confirmed);
+  PQputCopyEnd(replication, nullptr);
+  while ((res = PQgetResult(replication)) != nullptr)
+    PQclear(res);
+  PQfinish(replication);
+
+  for (const auto &entry : streamed) {
+    if (entry.second.reload)
+      requestFullLoad(pgConn, entry.second.info,
+                      "truncated or altered on the source");
+  }
+  if (!streamError.empty()) {
+    Logger::error(LogCategory::TRANSFER, "streamSource",
+                  "Change stream of " + database + " failed: " + streamError);
+  }
+  Logger::info(LogCategory::TRANSFER, "streamSource",
+               "Read " + std::to_string(transactions) +
+                   " transactions with " + std::to_string(readChanges) +
+                   " row changes from " + database + " for " +
+                   std::to_string(streamed.size()) + " tables; position " +
+                   formatLsn(committed));
+}
@@ -3,6 +3,7 @@
 #include "core/database_config.h"
 #include "governance/QueryActivityLogger.h"
 #include "governance/QueryStoreCollector.h"
+#include "sync/TableScheduler.h"
 #include "third_party/json.hpp"
 #include <chrono>
 #include <ctime>
@@ -13,6 +14,20 @@
 
 using json = nlohmann::json;
 
+namespace {
+// Hands the notifications of TableScheduler::NOTIFY_CHANNEL to the table
+// schedulers
+class SyncNotificationReceiver : public pqxx::notification_receiver {
+public:
+  explicit SyncNotificationReceiver(pqxx::connection &conn)
+      : pqxx::notification_receiver(conn, TableScheduler::NOTIFY_CHANNEL) {}
+
+  void operator()(const std::string &payload, int backendPid) override {
+    TableScheduler::notify(payload);
+  }
+};
+} // namespace
+
 // Constructor initializes API sync component with PostgreSQL connection string
 StreamingData::StreamingData()
     : apiToDb(DatabaseConfig::getPostgresConnectionString()) {}
@@ -73,13 +88,15 @@ void StreamingData::run(std::function<bool()> shutdownCheck) {
 
   Logger::info(LogCategory::MONITORING,
                "Launching transfer threads (MariaDB, MSSQL, MongoDB, Oracle, "
-               "API, Custom Jobs)");
+               "PostgreSQL, API, Custom Jobs, Sync Notifications)");
   threads.emplace_back(&StreamingData::mariaTransferThread, this);
   threads.emplace_back(&StreamingData::mssqlTransferThread, this);
   threads.emplace_back(&StreamingData::mongoTransferThread, this);
   threads.emplace_back(&StreamingData::oracleTransferThread, this);
+  threads.emplace_back(&StreamingData::postgresTransferThread, this);
   threads.emplace_back(&StreamingData::apiTransferThread, this);
   threads.emplace_back(&StreamingData::customJobsSchedulerThread, this);
+  threads.emplace_back(&StreamingData::syncNotificationThread, this);
 
   Logger::info(LogCategory::MONITORING,
                "Transfer threads launched successfully");
@@ -172,6 +189,7 @@ void StreamingData::shutdown() {
   }
   Logger::info(LogCategory::MONITORING, "Shutting down DataSync system");
   running = false;
+  TableScheduler::interruptAll();
 
   Logger::info(LogCategory::MONITORING,
                "Waiting for all threads to finish (max 30 seconds)");
@@ -242,8 +260,9 @@ void StreamingData::shutdown() {
 }
 
 // Loads configuration parameters from metadata.config table in PostgreSQL.
-// Queries for chunk_size, sync_interval, max_workers, and
-// max_tables_per_cycle. Validates connection is open before and after
+// Queries for chunk_size, sync_interval, max_workers, max_tables_per_cycle,
+// range_split_min_rows, mongo_cursor_batch_size and mongo_memory_budget_mb.
+// Validates connection is open before and after
 // transaction. Validates numeric values and ranges before updating
 // SyncConfig. Only updates if the new value differs from current value.
 // Handles SQL errors, connection errors, and general exceptions, logging them
@@ -265,7 +284,8 @@ void StreamingData::loadConfigFromDatabase(pqxx::connection &pgConn) {
     auto results =
         txn.exec("SELECT key, value FROM metadata.config WHERE key IN "
                  "('chunk_size', 'sync_interval', 'max_workers', "
-                 "'max_tables_per_cycle');");
+                 "'max_tables_per_cycle', 'range_split_min_rows', "
+                 "'mongo_cursor_batch_size', 'mongo_memory_budget_mb');");
 
     Logger::info(LogCategory::MONITORING,
                  "Configuration query executed, found " +
@@ -382,6 +402,66 @@ void StreamingData::loadConfigFromDatabase(pqxx::connection &pgConn) {
                         "Failed to parse max_tables_per_cycle value '" + value +
                             "': " + std::string(e.what()));
         }
+      } else if (key == "range_split_min_rows") {
+        try {
+          if (value.empty() || value.length() > 20) {
+            throw std::invalid_argument(
+                "Invalid range_split_min_rows value length");
+          }
+          size_t v = std::stoul(value);
+          if (v != SyncConfig::getRangeSplitMinRows()) {
+            Logger::info(
+                LogCategory::MONITORING,
+                "Updating range_split_min_rows from " +
+                    std::to_string(SyncConfig::getRangeSplitMinRows()) +
+                    " to " + std::to_string(v));
+            SyncConfig::setRangeSplitMinRows(v);
+          }
+        } catch (const std::exception &e) {
+          Logger::error(LogCategory::MONITORING,
+                        "Failed to parse range_split_min_rows value '" + value +
+                            "': " + std::string(e.what()));
+        }
+      } else if (key == "mongo_cursor_batch_size") {
+        try {
+          if (value.empty() || value.length() > 20) {
+            throw std::invalid_argument(
+                "Invalid mongo_cursor_batch_size value length");
+          }
+          size_t v = std::stoul(value);
+          if (v != SyncConfig::getMongoCursorBatchSize()) {
+            Logger::info(
+                LogCategory::MONITORING,
+                "Updating mongo_cursor_batch_size from " +
+                    std::to_string(SyncConfig::getMongoCursorBatchSize()) +
+                    " to " + std::to_string(v));
+            SyncConfig::setMongoCursorBatchSize(v);
+          }
+        } catch (const std::exception &e) {
+          Logger::error(LogCategory::MONITORING,
+                        "Failed to parse mongo_cursor_batch_size value '" +
+                            value + "': " + std::string(e.what()));
+        }
+      } else if (key == "mongo_memory_budget_mb") {
+        try {
+          if (value.empty() || value.length() > 20) {
+            throw std::invalid_argument(
+                "Invalid mongo_memory_budget_mb value length");
+          }
+          size_t v = std::stoul(value);
+          if (v != SyncConfig::getMongoMemoryBudgetMB()) {
+            Logger::info(
+                LogCategory::MONITORING,
+                "Updating mongo_memory_budget_mb from " +
+                    std::to_string(SyncConfig::getMongoMemoryBudgetMB()) +
+                    " to " + std::to_string(v));
+            SyncConfig::setMongoMemoryBudgetMB(v);
+          }
+        } catch (const std::exception &e) {
+          Logger::error(LogCategory::MONITORING,
+                        "Failed to parse mongo_memory_budget_mb value '" +
+                            value + "': " + std::string(e.what()));
+        }
       }
     }
 
@@ -534,6 +614,18 @@ void StreamingData::initializeDatabaseTables() {
                   "CRITICAL ERROR in Oracle table setup: " +
                       std::string(e.what()) + " - Oracle sync may fail");
   }
+
+  try {
+    Logger::info(LogCategory::MONITORING,
+                 "Setting up PostgreSQL target tables");
+    pgToPg.setupTableTargetPostgresToPostgres();
+    Logger::info(LogCategory::MONITORING,
+                 "PostgreSQL target tables setup completed");
+  } catch (const std::exception &e) {
+    Logger::error(LogCategory::MONITORING, "initializeDatabaseTables",
+                  "CRITICAL ERROR in PostgreSQL table setup: " +
+                      std::string(e.what()) + " - PostgreSQL sync may fail");
+  }
 }
 
 void StreamingData::catalogSyncThread() {
@@ -614,6 +706,23 @@ void StreamingData::performCatalogSyncs(
     }
   });
 
+  syncThreads.emplace_back([this, &exceptions, &exceptionMutex]() {
+    try {
+      Logger::info(LogCategory::MONITORING,
+                   "Starting PostgreSQL catalog sync");
+      catalogManager.syncCatalogPostgresToPostgres();
+      Logger::info(LogCategory::MONITORING,
+                   "PostgreSQL catalog sync completed successfully");
+    } catch (const std::exception &e) {
+      Logger::error(LogCategory::MONITORING, "performCatalogSyncs",
+                    "ERROR in PostgreSQL catalog sync: " +
+                        std::string(e.what()) +
+                        " - PostgreSQL catalog may be out of sync");
+      std::lock_guard<std::mutex> lock(exceptionMutex);
+      exceptions.push_back(std::current_exception());
+    }
+  });
+
   syncThreads.emplace_back([this, &exceptions, &exceptionMutex]() {
     try {
       Logger::info(LogCategory::MONITORING, "Starting MongoDB catalog sync");
@@ -685,11 +794,12 @@ void StreamingData::performCatalogMaintenance() {
 
 // MariaDB transfer thread that runs continuously while the system is running.
 // Performs periodic data transfer from MariaDB to PostgreSQL using parallel
-// processing. Measures and logs transfer duration. Sleeps for
-// max(5, sync_interval/4) seconds between cycles to avoid overwhelming the
-// system. Handles exceptions by logging errors and continuing to the next
-// cycle. This thread is responsible for keeping MariaDB data synchronized
-// with PostgreSQL.
+// processing. Measures and logs transfer duration. Between cycles it waits
+// for the engine's TableScheduler to have a table due, for
+// max(5, sync_interval/4) seconds at most, and each cycle only syncs the
+// tables that are due. Handles exceptions by logging errors and continuing
+// to the next cycle. This thread is responsible for keeping MariaDB data
+// synchronized with PostgreSQL.
 void StreamingData::mariaTransferThread() {
   Logger::info(LogCategory::MONITORING, "MariaDB transfer thread started");
   while (running) {
@@ -716,22 +826,19 @@ void StreamingData::mariaTransferThread() {
               std::to_string(SyncConfig::getSyncInterval()) + " seconds");
     }
 
-    size_t interval = SyncConfig::getSyncInterval();
-    size_t sleepSeconds = (interval > 0 && interval >= 4) ? (interval / 4) : 5;
-    if (sleepSeconds < 5)
-      sleepSeconds = 5;
-    std::this_thread::sleep_for(std::chrono::seconds(sleepSeconds));
+    TableScheduler::forEngine("MariaDB").waitUntilDue();
   }
   Logger::info(LogCategory::MONITORING, "MariaDB transfer thread stopped");
 }
 
 // MSSQL transfer thread that runs continuously while the system is running.
 // Performs periodic data transfer from MSSQL to PostgreSQL using parallel
-// processing. Measures and logs transfer duration. Sleeps for
-// max(5, sync_interval/4) seconds between cycles to avoid overwhelming the
-// system. Handles exceptions by logging errors and continuing to the next
-// cycle. This thread is responsible for keeping MSSQL data synchronized with
-// PostgreSQL.
+// processing. Measures and logs transfer duration. Between cycles it waits
+// for the engine's TableScheduler to have a table due, for
+// max(5, sync_interval/4) seconds at most, and each cycle only syncs the
+// tables that are due. Handles exceptions by logging errors and continuing
+// to the next cycle. This thread is responsible for keeping MSSQL data
+// synchronized with PostgreSQL.
 void StreamingData::mssqlTransferThread() {
   Logger::info(LogCategory::MONITORING, "MSSQL transfer thread started");
   while (running) {
@@ -758,11 +865,7 @@ void StreamingData::mssqlTransferThread() {
               std::to_string(SyncConfig::getSyncInterval()) + " seconds");
     }
 
-    size_t interval = SyncConfig::getSyncInterval();
-    size_t sleepSeconds = (interval > 0 && interval >= 4) ? (interval / 4) : 5;
-    if (sleepSeconds < 5)
-      sleepSeconds = 5;
-    std::this_thread::sleep_for(std::chrono::seconds(sleepSeconds));
+    TableScheduler::forEngine("MSSQL").waitUntilDue();
   }
   Logger::info(LogCategory::MONITORING, "MSSQL transfer thread stopped");
 }
@@ -803,11 +906,12 @@ void StreamingData::mongoTransferThread() {
 
 // Oracle transfer thread that runs continuously while the system is running.
 // Performs periodic data transfer from Oracle to PostgreSQL using parallel
-// processing. Measures and logs transfer duration. Sleeps for
-// max(5, sync_interval/4) seconds between cycles to avoid overwhelming the
-// system. Handles exceptions by logging errors and continuing to the next
-// cycle. This thread is responsible for keeping Oracle data synchronized with
-// PostgreSQL.
+// processing. Measures and logs transfer duration. Between cycles it waits
+// for the engine's TableScheduler to have a table due, for
+// max(5, sync_interval/4) seconds at most, and each cycle only syncs the
+// tables that are due. Handles exceptions by logging errors and continuing
+// to the next cycle. This thread is responsible for keeping Oracle data
+// synchronized with PostgreSQL.
 void StreamingData::oracleTransferThread() {
   Logger::info(LogCategory::MONITORING, "Oracle transfer thread started");
   while (running) {
@@ -834,15 +938,70 @@ void StreamingData::oracleTransferThread() {
               std::to_string(SyncConfig::getSyncInterval()) + " seconds");
     }
 
-    size_t interval = SyncConfig::getSyncInterval();
-    size_t sleepSeconds = (interval > 0 && interval >= 4) ? (interval / 4) : 5;
-    if (sleepSeconds < 5)
-      sleepSeconds = 5;
-    std::this_thread::sleep_for(std::chrono::seconds(sleepSeconds));
+    TableScheduler::forEngine("Oracle").waitUntilDue();
   }
   Logger::info(LogCategory::MONITORING, "Oracle transfer thread stopped");
 }
 
+// PostgreSQL transfer thread that runs continuously while the system is
+// running. Each cycle copies the tables waiting for a full load and streams
+// the changes of the listening ones from their sources' replication slots.
+// Waits for the engine's TableScheduler between cycles, like the other
+// transfer threads, and logs errors without stopping.
+void StreamingData::postgresTransferThread() {
+  Logger::info(LogCategory::MONITORING, "PostgreSQL transfer thread started");
+  while (running) {
+    try {
+      Logger::info(LogCategory::MONITORING,
+                   "Starting PostgreSQL transfer cycle - sync interval: " +
+                       std::to_string(SyncConfig::getSyncInterval()) +
+                       " seconds");
+
+      auto startTime = std::chrono::high_resolution_clock::now();
+      pgToPg.transferDataPostgresToPostgres();
+      auto endTime = std::chrono::high_resolution_clock::now();
+
+      auto duration =
+          std::chrono::duration_cast<std::chrono::seconds>(endTime - startTime);
+      Logger::info(LogCategory::MONITORING,
+                   "PostgreSQL transfer cycle completed successfully in " +
+                       std::to_string(duration.count()) + " seconds");
+    } catch (const std::exception &e) {
+      Logger::error(LogCategory::MONITORING, "postgresTransferThread",
+                    "CRITICAL ERROR in PostgreSQL transfer cycle: " +
+                        std::string(e.what()) +
+                        " - PostgreSQL data sync failed, retrying in " +
+                        std::to_string(SyncConfig::getSyncInterval()) +
+                        " seconds");
+    }
+
+    TableScheduler::forEngine("PostgreSQL").waitUntilDue();
+  }
+  Logger::info(LogCategory::MONITORING, "PostgreSQL transfer thread stopped");
+}
+
+// Listens on TableScheduler::NOTIFY_CHANNEL of the metadata database, so a
+// NOTIFY makes the transfer threads sync the engine or table it names right
+// away instead of at its next scheduled run. Checks for shutdown every
+// second and reconnects 5 seconds after a connection error.
+void StreamingData::syncNotificationThread() {
+  Logger::info(LogCategory::MONITORING, "Sync notification thread started");
+  while (running) {
+    try {
+      pqxx::connection conn(DatabaseConfig::getPostgresConnectionString());
+      SyncNotificationReceiver receiver(conn);
+      while (running)
+        conn.await_notification(1, 0);
+    } catch (const std::exception &e) {
+      Logger::error(LogCategory::MONITORING, "syncNotificationThread",
+                    "Error listening for sync notifications: " +
+                        std::string(e.what()) + " - reconnecting in 5 seconds");
+      std::this_thread::sleep_for(std::chrono::seconds(5));
+    }
+  }
+  Logger::info(LogCategory::MONITORING, "Sync notification thread stopped");
+}
+
 // API transfer thread that runs continuously while the system is running.
 // Performs periodic data synchronization from APIs to target databases.
 // Measures and logs transfer duration. Sleeps for max(5, sync_interval/4)
@@ -1101,7 +1260,8 @@ void StreamingData::qualityThread() {
 
 // Maintenance thread that runs continuously while the system is running.
 // Performs periodic maintenance tasks: MariaDB table setup, MSSQL catalog
-// sync, catalog cleanup, no-data table deactivation, and metrics collection.
+// sync, catalog cleanup, no-data table deactivation, purging of applied rows
+// from the source change logs, and metrics collection.
 // Measures and logs maintenance cycle duration. Each maintenance task is
 // wrapped in try-catch to prevent one failure from stopping the entire cycle.
 // Sleeps for sync_interval * 4 seconds between cycles. This thread ensures
@@ -1166,6 +1326,21 @@ void StreamingData::maintenanceThread() {
                           " - Inactive tables may not be properly marked");
       }
 
+      try {
+        Logger::info(LogCategory::MONITORING,
+                     "Performing source change log purge maintenance");
+        mariaToPg.purgeChangeLog();
+        mssqlToPg.purgeChangeLog();
+        oracleToPg.purgeChangeLog();
+        Logger::info(LogCategory::MONITORING,
+                     "Source change log purge maintenance completed");
+      } catch (const std::exception &e) {
+        Logger::error(LogCategory::MONITORING, "maintenanceThread",
+                      "ERROR in source change log purge maintenance: " +
+                          std::string(e.what()) +
+                          " - Source change logs may keep growing");
+      }
+
       try {
         Logger::info(LogCategory::MONITORING,
                      "Performing metrics collection maintenance");
@@ -29,16 +29,18 @@ TableProcessorThreadPool::TableProcessorThreadPool(size_t numWorkers) {
 // threads are properly joined and resources are cleaned up.
 TableProcessorThreadPool::~TableProcessorThreadPool() { shutdown(); }
 
+thread_local TableProcessorThreadPool *TableProcessorThreadPool::currentPool_ =
+    nullptr;
+
 // Main worker thread function that processes tasks from the queue. Continuously
-// pops tasks from the blocking queue until shutdown is requested. For each
-// task, increments activeWorkers counter, executes the processor function,
-// increments completedTasks on success or failedTasks on exception, then
-// decrements activeWorkers. Logs all processing activity including start,
-// completion, and failures. Thread-safe through atomic counters and thread-safe
-// queue.
+// pops tasks from the blocking queue until shutdown is requested. Each task is
+// run through runTask() and then counted as finished. Marks the thread as
+// belonging to this pool so tasks can submit follow-up tasks.
 void TableProcessorThreadPool::workerThread(size_t workerId) {
-  Logger::info(LogCategory::TRANSFER,
-               "Worker #" + std::to_string(workerId) + " started");
+  currentPool_ = this;
+  std::string worker = "Worker #" + std::to_string(workerId);
+
+  Logger::info(LogCategory::TRANSFER, worker + " started");
 
   while (!shutdown_.load()) {
     TableTask task;
@@ -46,69 +48,108 @@ void TableProcessorThreadPool::workerThread(size_t workerId) {
       break;
     }
 
-    activeWorkers_++;
-
-    try {
-      Logger::info(LogCategory::TRANSFER,
-                   "Worker #" + std::to_string(workerId) +
-                       " processing table: " + task.table.schema_name + "." +
-                       task.table.table_name);
-
-      task.processor(task.table);
-
-      completedTasks_++;
+    runTask(task, worker);
+    finishTask();
+  }
 
-      Logger::info(LogCategory::TRANSFER,
-                   "Worker #" + std::to_string(workerId) +
-                       " completed table: " + task.table.schema_name + "." +
-                       task.table.table_name + " (Total: " +
-                       std::to_string(completedTasks_.load()) + ")");
-
-    } catch (const std::exception &e) {
-      failedTasks_++;
-      Logger::error(LogCategory::TRANSFER,
-                    "Worker #" + std::to_string(workerId) +
-                        " failed processing table: " + task.table.schema_name +
-                        "." + task.table.table_name +
-                        " - Error: " + std::string(e.what()));
-    }
+  Logger::info(LogCategory::TRANSFER, worker + " stopped");
+}
 
-    activeWorkers_--;
+// Executes one task. Increments activeWorkers while the processor runs and
+// completedTasks on success or failedTasks on exception. Logs start,
+// completion, and failures.
+void TableProcessorThreadPool::runTask(TableTask &task,
+                                       const std::string &worker) {
+  activeWorkers_++;
+
+  try {
+    Logger::info(LogCategory::TRANSFER,
+                 worker + " processing table: " + task.table.schema_name +
+                     "." + task.table.table_name);
+
+    task.processor(task.table);
+
+    completedTasks_++;
+
+    Logger::info(LogCategory::TRANSFER,
+                 worker + " completed table: " + task.table.schema_name + "." +
+                     task.table.table_name + " (Total: " +
+                     std::to_string(completedTasks_.load()) + ")");
+
+  } catch (const std::exception &e) {
+    failedTasks_++;
+    Logger::error(LogCategory::TRANSFER,
+                  worker + " failed processing table: " +
+                      task.table.schema_name + "." + task.table.table_name +
+                      " - Error: " + std::string(e.what()));
   }
 
-  Logger::info(LogCategory::TRANSFER,
-               "Worker #" + std::to_string(workerId) + " stopped");
+  activeWorkers_--;
+}
+
+// Marks one submitted task as finished and wakes waitForCompletion() when
+// none are left.
+void TableProcessorThreadPool::finishTask() {
+  std::lock_guard<std::mutex> lock(outstandingMutex_);
+  if (outstandingTasks_ > 0 && --outstandingTasks_ == 0)
+    outstandingCv_.notify_all();
 }
 
 // Submits a new task to the thread pool for processing. Takes a TableInfo
 // struct and a processor function that will be called with that table. If the
-// thread pool is shutting down, logs a warning and returns without adding the
-// task. Otherwise, pushes the task to the queue and increments
-// totalTasksSubmitted. Thread-safe through atomic shutdown flag and
-// thread-safe queue.
-void TableProcessorThreadPool::submitTask(
+// thread pool is shutting down, logs a warning and returns false without
+// adding the task. A task submitted from one of this pool's own workers never
+// blocks on a full queue, since every worker could end up waiting on it; it
+// runs inline on the submitting worker instead. Thread-safe through atomic
+// shutdown flag and thread-safe queue.
+bool TableProcessorThreadPool::submitTask(
     const DatabaseToPostgresSync::TableInfo &table,
     std::function<void(const DatabaseToPostgresSync::TableInfo &)> processor) {
   if (shutdown_.load()) {
     Logger::warning(LogCategory::TRANSFER, "submitTask",
                     "Cannot submit task - thread pool is shutting down: " +
                         table.schema_name + "." + table.table_name);
-    return;
+    return false;
   }
 
-  tasks_.push(TableTask{table, std::move(processor)});
+  {
+    std::lock_guard<std::mutex> lock(outstandingMutex_);
+    outstandingTasks_++;
+  }
   totalTasksSubmitted_++;
+
+  TableTask task{table, std::move(processor)};
+  if (currentPool_ == this) {
+    if (!tasks_.tryPush(task, std::chrono::milliseconds(0))) {
+      runTask(task, "Submitting worker");
+      finishTask();
+    }
+    return true;
+  }
+
+  if (!tasks_.push(std::move(task))) {
+    finishTask();
+    return false;
+  }
+  return true;
 }
 
-// Waits for all submitted tasks to complete. Signals the queue to finish
-// accepting new tasks, then joins all worker threads. Blocks until all tasks
-// are processed. Logs completion statistics including completed and failed task
-// counts. This method should be called before destroying the thread pool to
-// ensure clean shutdown.
+// Waits for all submitted tasks to complete, including tasks submitted by
+// running tasks, then signals the queue to finish accepting new tasks and
+// joins all worker threads. Logs completion statistics including completed
+// and failed task counts. This method should be called before destroying the
+// thread pool to ensure clean shutdown.
 void TableProcessorThreadPool::waitForCompletion() {
   Logger::info(LogCategory::TRANSFER, "TableProcessorThreadPool",
                "Waiting for all tasks to complete...");
 
+  {
+    std::unique_lock<std::mutex> lock(outstandingMutex_);
+    outstandingCv_.wait(lock, [this] {
+      return outstandingTasks_ == 0 || shutdown_.load();
+    });
+  }
+
   tasks_.finish();
 
   for (auto &worker : workers_) {
@@ -140,6 +181,11 @@ void TableProcessorThreadPool::shutdown() {
     monitoringThread_.join();
   }
 
+  {
+    std::lock_guard<std::mutex> lock(outstandingMutex_);
+    outstandingCv_.notify_all();
+  }
+
   tasks_.finish();
 
   for (auto &worker : workers_) {
@@ -197,7 +243,7 @@ void TableProcessorThreadPool::monitoringThreadFunc() {
                    "═══ ThreadPool Monitor ═══ Active: " +
                        std::to_string(active) + "/" + std::to_string(total) +
                        " | Completed: " + std::to_string(completed) + "/" +
-                       std::to_string(totalTasksSubmitted_) +
+                       std::to_string(totalTasksSubmitted_.load()) +
                        " | Failed: " + std::to_string(failed) +
                        " | Pending: " + std::to_string(pending) + " | Speed: " +
                        std::to_string(static_cast<int>(speed)) + " tbl/s");
@@ -0,0 +1,184 @@
+#include "sync/TableScheduler.h"
+#include "core/sync_config.h"
+#include <algorithm>
+#include <map>
+#include <memory>
+
+namespace {
+std::mutex schedulersMutex;
+std::map<std::string, std::unique_ptr<TableScheduler>> schedulers;
+} // namespace
+
+TableScheduler &TableScheduler::forEngine(const std::string &dbEngine) {
+  std::lock_guard<std::mutex> lock(schedulersMutex);
+  auto &scheduler = schedulers[dbEngine];
+  if (!scheduler)
+    scheduler = std::make_unique<TableScheduler>();
+  return *scheduler;
+}
+
+// Payloads are "", "<db_engine>" or "<db_engine>:<schema>.<table>". Engines
+// without a scheduler yet have no transfer thread waiting and are ignored.
+void TableScheduler::notify(const std::string &payload) {
+  size_t colon = payload.find(':');
+  std::string dbEngine = payload.substr(0, colon);
+  std::string tableKey =
+      colon == std::string::npos ? "" : payload.substr(colon + 1);
+
+  std::vector<TableScheduler *> targets;
+  {
+    std::lock_guard<std::mutex> lock(schedulersMutex);
+    for (auto &entry : schedulers)
+      if (dbEngine.empty() || entry.first == dbEngine)
+        targets.push_back(entry.second.get());
+  }
+  for (TableScheduler *scheduler : targets) {
+    if (tableKey.empty())
+      scheduler->wakeAll();
+    else
+      scheduler->wake(tableKey);
+  }
+}
+
+void TableScheduler::interruptAll() {
+  std::lock_guard<std::mutex> lock(schedulersMutex);
+  for (auto &entry : schedulers)
+    entry.second->interrupt();
+}
+
+std::chrono::milliseconds TableScheduler::baseInterval() {
+  size_t seconds = SyncConfig::getSyncInterval() / 4;
+  return std::chrono::seconds(std::max<size_t>(5, seconds));
+}
+
+void TableScheduler::track(const std::vector<std::string> &tableKeys) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::set<std::string> listed(tableKeys.begin(), tableKeys.end());
+  for (auto it = tables_.begin(); it != tables_.end();) {
+    if (listed.count(it->first) == 0) {
+      queue_.erase({it->second.nextRun, it->first});
+      it = tables_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+
+  Clock::time_point now = Clock::now();
+  for (const auto &tableKey : listed) {
+    if (tables_.count(tableKey) != 0)
+      continue;
+    TableState &state = tables_[tableKey];
+    state.interval = baseInterval();
+    state.nextRun = now;
+    queue_.insert({now, tableKey});
+  }
+}
+
+bool TableScheduler::claim(const std::string &tableKey) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = tables_.find(tableKey);
+  if (it == tables_.end())
+    return true;
+  TableState &state = it->second;
+  Clock::time_point now = Clock::now();
+  if (state.nextRun > now)
+    return false;
+  state.running = true;
+  state.woken = false;
+  state.changes = 0;
+  schedule(tableKey, state, now + state.interval);
+  return true;
+}
+
+void TableScheduler::recordChanges(const std::string &tableKey, size_t rows) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = tables_.find(tableKey);
+  if (it != tables_.end())
+    it->second.changes += rows;
+}
+
+void TableScheduler::completed(const std::string &tableKey, bool loading) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto it = tables_.find(tableKey);
+  if (it == tables_.end() || !it->second.running)
+    return;
+  TableState &state = it->second;
+  state.running = false;
+
+  std::chrono::milliseconds base = baseInterval();
+  std::chrono::milliseconds minInterval(MIN_INTERVAL_MS);
+  std::chrono::milliseconds maxInterval = base * MAX_BACKOFF_FACTOR;
+  Clock::time_point now = Clock::now();
+  bool behind = false;
+  if (loading) {
+    state.interval = base;
+  } else if (state.changes > 0) {
+    state.interval = std::max(minInterval, state.interval / 2);
+    behind = state.changes >= SyncConfig::getChunkSize();
+  } else {
+    state.interval = std::min(maxInterval, state.interval * 2);
+  }
+  state.interval = std::min(maxInterval, std::max(minInterval, state.interval));
+
+  schedule(tableKey, state,
+           behind || state.woken ? now : now + state.interval);
+  state.woken = false;
+}
+
+void TableScheduler::wake(const std::string &tableKey) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = tables_.find(tableKey);
+    if (it == tables_.end())
+      signaled_ = true;
+    else if (it->second.running)
+      it->second.woken = true;
+    else
+      schedule(tableKey, it->second, Clock::now());
+  }
+  wakeup_.notify_all();
+}
+
+void TableScheduler::wakeAll() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Clock::time_point now = Clock::now();
+    for (auto &entry : tables_) {
+      if (entry.second.running)
+        entry.second.woken = true;
+      else
+        schedule(entry.first, entry.second, now);
+    }
+    signaled_ = true;
+  }
+  wakeup_.notify_all();
+}
+
+void TableScheduler::waitUntilDue() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  Clock::time_point deadline = Clock::now() + baseInterval();
+  while (!signaled_) {
+    Clock::time_point until = deadline;
+    if (!queue_.empty() && queue_.begin()->first < until)
+      until = queue_.begin()->first;
+    if (until <= Clock::now())
+      break;
+    wakeup_.wait_until(lock, until);
+  }
+  signaled_ = false;
+}
+
+void TableScheduler::interrupt() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    signaled_ = true;
+  }
+  wakeup_.notify_all();
+}
+
+void TableScheduler::schedule(const std::string &tableKey, TableState &state,
+                              Clock::time_point nextRun) {
+  queue_.erase({state.nextRun, tableKey});
+  state.nextRun = nextRun;
+  queue_.insert({nextRun, tableKey});
+}
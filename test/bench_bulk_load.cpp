@@ -0,0 +1,109 @@
+#include "core/database_config.h"
+#include "sync/MariaDBToPostgres.h"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Loads the same synthetic rows into PostgreSQL twice: once through the COPY
+// writer (performBulkCopy) and once through the INSERT ... VALUES fallback
+// (performBulkInsertValues), and prints the throughput of each. Connects with
+// the PostgreSQL settings of config.json, works in a scratch schema
+// bench_bulk_load and drops it on exit. Exits with 1 if either path leaves a
+// different row count than it was given.
+//
+// Usage: bench_bulk_load [rows]   (default 1000000)
+
+namespace {
+
+const std::string SCHEMA = "bench_bulk_load";
+const std::string TABLE = "synthetic";
+
+const std::vector<std::string> COLUMN_NAMES = {
+    "id",   "name",     "created_at", "amount",
+    "memo", "quantity", "ship_date",  "ratio"};
+const std::vector<std::string> COLUMN_TYPES = {
+    "bigint", "varchar(255)", "datetime", "decimal(12,2)",
+    "text",   "int",          "date",     "double"};
+
+std::vector<std::string> sampleRow(size_t row) {
+  return {std::to_string(row),
+          "customer " + std::to_string(row % 1000),
+          "2024-03-" + std::to_string(10 + row % 18) + " 12:34:56",
+          std::to_string(row % 100000) + ".25",
+          "free text value with some length " + std::to_string(row % 97),
+          std::to_string(row % 5000),
+          "2023-11-0" + std::to_string(1 + row % 9),
+          "3.14159"};
+}
+
+void recreateTable(pqxx::connection &conn) {
+  pqxx::work txn(conn);
+  txn.exec("DROP SCHEMA IF EXISTS " + SCHEMA + " CASCADE");
+  txn.exec("CREATE SCHEMA " + SCHEMA);
+  txn.exec("CREATE TABLE " + SCHEMA + "." + TABLE +
+           " (id BIGINT, name VARCHAR(255), created_at TIMESTAMP, "
+           "amount NUMERIC(12,2), memo TEXT, quantity INTEGER, "
+           "ship_date DATE, ratio DOUBLE PRECISION)");
+  txn.commit();
+}
+
+long long countRows(pqxx::connection &conn) {
+  pqxx::work txn(conn);
+  return txn.query_value<long long>("SELECT COUNT(*) FROM " + SCHEMA + "." +
+                                    TABLE);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  size_t rowCount = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+  DatabaseConfig::loadFromFile("config.json");
+  if (!DatabaseConfig::isInitialized()) {
+    std::cerr << "PostgreSQL configuration failed to initialize" << std::endl;
+    return 1;
+  }
+
+  std::vector<std::vector<std::string>> rows;
+  rows.reserve(rowCount);
+  for (size_t r = 0; r < rowCount; ++r)
+    rows.push_back(sampleRow(r));
+
+  MariaDBToPostgres sync;
+  pqxx::connection conn(DatabaseConfig::getPostgresConnectionString());
+  using Clock = std::chrono::steady_clock;
+  bool countsMatch = true;
+
+  recreateTable(conn);
+  Clock::time_point start = Clock::now();
+  sync.performBulkCopy(conn, rows, COLUMN_NAMES, COLUMN_TYPES, SCHEMA, TABLE);
+  double copy = std::chrono::duration<double>(Clock::now() - start).count();
+  countsMatch = countsMatch && countRows(conn) == (long long)rowCount;
+
+  recreateTable(conn);
+  start = Clock::now();
+  sync.performBulkInsertValues(conn, rows, COLUMN_NAMES, COLUMN_TYPES, SCHEMA,
+                               TABLE);
+  double values = std::chrono::duration<double>(Clock::now() - start).count();
+  countsMatch = countsMatch && countRows(conn) == (long long)rowCount;
+
+  {
+    pqxx::work txn(conn);
+    txn.exec("DROP SCHEMA IF EXISTS " + SCHEMA + " CASCADE");
+    txn.commit();
+  }
+
+  std::cout << rowCount << " rows, " << COLUMN_NAMES.size() << " columns\n"
+            << "COPY:              " << copy << " s (" << rowCount / copy
+            << " rows/s)\n"
+            << "INSERT ... VALUES: " << values << " s ("
+            << rowCount / values << " rows/s)\n"
+            << "speedup: " << values / copy << "x" << std::endl;
+  if (!countsMatch) {
+    std::cerr << "Row count mismatch after load" << std::endl;
+    return 1;
+  }
+  return 0;
+}
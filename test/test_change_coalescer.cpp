@@ -0,0 +1,94 @@
+#include "sync/ChangeCoalescer.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+#define CHECK(condition)                                                       \
+  do {                                                                         \
+    if (!(condition)) {                                                        \
+      std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: "           \
+                << #condition << std::endl;                                    \
+      ++failures;                                                              \
+    }                                                                          \
+  } while (0)
+
+struct Change {
+  std::string key;
+  char operation;
+};
+
+static std::vector<bool> coalesce(const std::vector<Change> &changes,
+                                  size_t &elided) {
+  ChangeCoalescer coalescer;
+  for (const auto &change : changes)
+    coalescer.add(change.key, change.operation);
+  coalescer.finish();
+  elided = coalescer.elided();
+  std::vector<bool> kept;
+  for (size_t i = 0; i < changes.size(); ++i)
+    kept.push_back(coalescer.keep(i));
+  return kept;
+}
+
+static void testKeepsLastChangePerKey() {
+  size_t elided = 0;
+  auto kept = coalesce({{"1", 'I'}, {"1", 'U'}, {"1", 'U'}}, elided);
+  CHECK((kept == std::vector<bool>{false, false, true}));
+  CHECK(elided == 2);
+}
+
+static void testUpdateThenDeleteKeepsDelete() {
+  size_t elided = 0;
+  auto kept = coalesce({{"1", 'U'}, {"1", 'D'}}, elided);
+  CHECK((kept == std::vector<bool>{false, true}));
+  CHECK(elided == 1);
+}
+
+static void testInsertThenDeleteKeepsDelete() {
+  // The row may already be on the target when the log is replayed after a
+  // full load, so the delete must still be applied
+  size_t elided = 0;
+  auto kept = coalesce({{"1", 'I'}, {"1", 'D'}}, elided);
+  CHECK((kept == std::vector<bool>{false, true}));
+  CHECK(elided == 1);
+}
+
+static void testDeleteThenInsertKeepsInsert() {
+  size_t elided = 0;
+  auto kept = coalesce({{"1", 'D'}, {"1", 'I'}}, elided);
+  CHECK((kept == std::vector<bool>{false, true}));
+  CHECK(elided == 1);
+}
+
+static void testKeysAreIndependent() {
+  size_t elided = 0;
+  auto kept = coalesce(
+      {{"1", 'I'}, {"2", 'I'}, {"1", 'D'}, {"3", 'U'}, {"2", 'U'}}, elided);
+  CHECK((kept == std::vector<bool>{false, false, true, true, true}));
+  CHECK(elided == 2);
+}
+
+static void testEmptyBatch() {
+  size_t elided = 0;
+  auto kept = coalesce({}, elided);
+  CHECK(kept.empty());
+  CHECK(elided == 0);
+}
+
+int main() {
+  testKeepsLastChangePerKey();
+  testUpdateThenDeleteKeepsDelete();
+  testInsertThenDeleteKeepsDelete();
+  testDeleteThenInsertKeepsInsert();
+  testKeysAreIndependent();
+  testEmptyBatch();
+
+  if (failures > 0) {
+    std::cerr << failures << " check(s) failed" << std::endl;
+    return 1;
+  }
+  std::cout << "All ChangeCoalescer tests passed" << std::endl;
+  return 0;
+}
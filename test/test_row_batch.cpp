@@ -0,0 +1,140 @@
+#include "sync/RowBatch.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+using ParallelProcessing::RowBatch;
+
+static int failures = 0;
+
+#define CHECK(condition)                                                       \
+  do {                                                                         \
+    if (!(condition)) {                                                        \
+      std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: "           \
+                << #condition << std::endl;                                    \
+      ++failures;                                                              \
+    }                                                                          \
+  } while (0)
+
+static void testAppendAndRead() {
+  RowBatch batch(2);
+  batch.append(0, "1");
+  batch.append(1, "alpha");
+  batch.finishRow();
+  batch.append(0, "2");
+  batch.appendNull(1);
+  batch.finishRow();
+
+  CHECK(batch.rowCount() == 2);
+  CHECK(batch.columnCount() == 2);
+  CHECK(batch.value(0, 1) == "alpha");
+  CHECK(!batch.isNull(0, 1));
+  CHECK(batch.isNull(1, 1));
+  CHECK(batch.value(1, 1).empty());
+}
+
+static void testUnfilledColumnsAreNull() {
+  RowBatch batch(3);
+  batch.append(0, "only");
+  batch.finishRow();
+  CHECK(batch.rowCount() == 1);
+  CHECK(!batch.isNull(0, 0));
+  CHECK(batch.isNull(0, 1));
+  CHECK(batch.isNull(0, 2));
+}
+
+static void testEmptyStringIsNotNull() {
+  RowBatch batch(1);
+  batch.append(0, "");
+  batch.finishRow();
+  CHECK(!batch.isNull(0, 0));
+  CHECK(batch.value(0, 0).empty());
+}
+
+static void testBinarySafeAndExtend() {
+  RowBatch batch(1);
+  const char bytes[] = {'a', '\0', 'b'};
+  batch.append(0, bytes, sizeof(bytes));
+  batch.extend(0, "cd", 2);
+  batch.finishRow();
+  CHECK(batch.value(0, 0) == std::string("a\0bcd", 5));
+}
+
+static void testNullBitmapPastOneWord() {
+  RowBatch batch(1);
+  for (size_t i = 0; i < 130; ++i) {
+    if (i % 3 == 0)
+      batch.appendNull(0);
+    else
+      batch.append(0, std::to_string(i));
+    batch.finishRow();
+  }
+  bool matches = true;
+  for (size_t i = 0; i < 130; ++i) {
+    if (batch.isNull(i, 0) != (i % 3 == 0))
+      matches = false;
+    if (i % 3 != 0 && batch.value(i, 0) != std::to_string(i))
+      matches = false;
+  }
+  CHECK(matches);
+}
+
+static void testToRows() {
+  RowBatch batch(2);
+  batch.appendRow({"1", "x"});
+  batch.append(0, "2");
+  batch.finishRow();
+  auto rows = batch.toRows("NULL");
+  CHECK(rows.size() == 2);
+  CHECK((rows[0] == std::vector<std::string>{"1", "x"}));
+  CHECK((rows[1] == std::vector<std::string>{"2", "NULL"}));
+}
+
+static void testClearKeepsColumnsAndCapacity() {
+  RowBatch batch(2);
+  batch.reserve(1000);
+  for (size_t i = 0; i < 1000; ++i)
+    batch.appendRow({std::to_string(i), "value"});
+  size_t memory = batch.memoryUsage();
+
+  batch.clear();
+  CHECK(batch.empty());
+  CHECK(batch.columnCount() == 2);
+  CHECK(batch.memoryUsage() == memory);
+
+  batch.reset(2);
+  CHECK(batch.memoryUsage() == memory);
+
+  batch.appendRow({"a", "b"});
+  CHECK(batch.rowCount() == 1);
+  CHECK(batch.value(0, 0) == "a");
+  CHECK(!batch.isNull(0, 1));
+}
+
+static void testResetChangesColumnCount() {
+  RowBatch batch(2);
+  batch.appendRow({"1", "2"});
+  batch.reset(3);
+  CHECK(batch.empty());
+  CHECK(batch.columnCount() == 3);
+  batch.appendRow({"a", "b", "c"});
+  CHECK(batch.value(0, 2) == "c");
+}
+
+int main() {
+  testAppendAndRead();
+  testUnfilledColumnsAreNull();
+  testEmptyStringIsNotNull();
+  testBinarySafeAndExtend();
+  testNullBitmapPastOneWord();
+  testToRows();
+  testClearKeepsColumnsAndCapacity();
+  testResetChangesColumnCount();
+
+  if (failures > 0) {
+    std::cerr << failures << " check(s) failed" << std::endl;
+    return 1;
+  }
+  std::cout << "All RowBatch tests passed" << std::endl;
+  return 0;
+}
@@ -0,0 +1,154 @@
+#include "core/sync_config.h"
+#include "sync/TableScheduler.h"
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+static int failures = 0;
+
+#define CHECK(condition)                                                       \
+  do {                                                                         \
+    if (!(condition)) {                                                        \
+      std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK failed: "           \
+                << #condition << std::endl;                                    \
+      ++failures;                                                              \
+    }                                                                          \
+  } while (0)
+
+static void testNewTablesAreDueOnce() {
+  TableScheduler scheduler;
+  scheduler.track({"s.a", "s.b"});
+  CHECK(scheduler.claim("s.a"));
+  CHECK(!scheduler.claim("s.a"));
+  CHECK(scheduler.claim("s.b"));
+  CHECK(scheduler.claim("s.untracked"));
+}
+
+static void testIdleRunBacksOffUntilWoken() {
+  TableScheduler scheduler;
+  scheduler.track({"s.a"});
+  CHECK(scheduler.claim("s.a"));
+  scheduler.completed("s.a", false);
+  CHECK(!scheduler.claim("s.a"));
+  scheduler.wake("s.a");
+  CHECK(scheduler.claim("s.a"));
+}
+
+static void testTableBehindIsDueAgain() {
+  TableScheduler scheduler;
+  scheduler.track({"s.a"});
+  CHECK(scheduler.claim("s.a"));
+  scheduler.recordChanges("s.a", SyncConfig::getChunkSize());
+  scheduler.completed("s.a", false);
+  CHECK(scheduler.claim("s.a"));
+
+  // Fewer changes than a chunk shorten the interval but wait for it
+  scheduler.recordChanges("s.a", 1);
+  scheduler.completed("s.a", false);
+  CHECK(!scheduler.claim("s.a"));
+}
+
+static void testWakeDuringRunReschedulesAtOnce() {
+  TableScheduler scheduler;
+  scheduler.track({"s.a"});
+  CHECK(scheduler.claim("s.a"));
+  scheduler.wake("s.a");
+  CHECK(!scheduler.claim("s.a"));
+  scheduler.completed("s.a", false);
+  CHECK(scheduler.claim("s.a"));
+}
+
+static void testWakeAll() {
+  TableScheduler scheduler;
+  scheduler.track({"s.a", "s.b"});
+  CHECK(scheduler.claim("s.a"));
+  CHECK(scheduler.claim("s.b"));
+  scheduler.completed("s.a", false);
+  scheduler.completed("s.b", false);
+  scheduler.wakeAll();
+  CHECK(scheduler.claim("s.a"));
+  CHECK(scheduler.claim("s.b"));
+}
+
+static void testUntrackedTablesAreDropped() {
+  TableScheduler scheduler;
+  scheduler.track({"s.a", "s.b"});
+  CHECK(scheduler.claim("s.a"));
+  scheduler.completed("s.a", false);
+  CHECK(!scheduler.claim("s.a"));
+  scheduler.track({"s.b"});
+  CHECK(scheduler.claim("s.a"));
+
+  // Tracked again, the table starts over and is due at once
+  scheduler.track({"s.a", "s.b"});
+  CHECK(scheduler.claim("s.a"));
+}
+
+static void testNotifyPayloads() {
+  TableScheduler &mariadb = TableScheduler::forEngine("TestMariaDB");
+  TableScheduler &mssql = TableScheduler::forEngine("TestMSSQL");
+  CHECK(&mariadb == &TableScheduler::forEngine("TestMariaDB"));
+  mariadb.track({"s.a"});
+  mssql.track({"s.a"});
+  CHECK(mariadb.claim("s.a"));
+  CHECK(mssql.claim("s.a"));
+  mariadb.completed("s.a", false);
+  mssql.completed("s.a", false);
+
+  TableScheduler::notify("TestMariaDB:s.a");
+  CHECK(mariadb.claim("s.a"));
+  CHECK(!mssql.claim("s.a"));
+  mariadb.completed("s.a", false);
+
+  TableScheduler::notify("TestMSSQL");
+  CHECK(!mariadb.claim("s.a"));
+  CHECK(mssql.claim("s.a"));
+  mssql.completed("s.a", false);
+
+  TableScheduler::notify("");
+  CHECK(mariadb.claim("s.a"));
+  CHECK(mssql.claim("s.a"));
+}
+
+static void testWaitUntilDue() {
+  using Clock = std::chrono::steady_clock;
+  TableScheduler scheduler;
+
+  // A due table ends the wait at once
+  scheduler.track({"s.a"});
+  Clock::time_point start = Clock::now();
+  scheduler.waitUntilDue();
+  CHECK(Clock::now() - start < std::chrono::seconds(1));
+
+  // With nothing due, interrupt() ends it
+  CHECK(scheduler.claim("s.a"));
+  scheduler.completed("s.a", false);
+  std::thread interrupter([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    scheduler.interrupt();
+  });
+  start = Clock::now();
+  scheduler.waitUntilDue();
+  Clock::duration waited = Clock::now() - start;
+  interrupter.join();
+  CHECK(waited >= std::chrono::milliseconds(50));
+  CHECK(waited < TableScheduler::baseInterval());
+}
+
+int main() {
+  testNewTablesAreDueOnce();
+  testIdleRunBacksOffUntilWoken();
+  testTableBehindIsDueAgain();
+  testWakeDuringRunReschedulesAtOnce();
+  testWakeAll();
+  testUntrackedTablesAreDropped();
+  testNotifyPayloads();
+  testWaitUntilDue();
+
+  if (failures > 0) {
+    std::cerr << failures << " check(s) failed" << std::endl;
+    return 1;
+  }
+  std::cout << "All TableScheduler tests passed" << std::endl;
+  return 0;
+}